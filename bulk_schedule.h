@@ -0,0 +1,119 @@
+/*
+ * FORMAT OUTPUT /api/schedule/bulk (JSON & CSV)
+ * Dipakai firmware dan CLI host (test/bulk_schedule_cli.cpp) sehingga keduanya
+ * menghasilkan byte yang sama. Tanpa dependensi Arduino.
+ */
+
+#ifndef JWS_BULK_SCHEDULE_H
+#define JWS_BULK_SCHEDULE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "solar_math.h"
+
+#define BULK_NAME_LEN 64               // NAMA TERPANJANG DI cities.json = 44 BYTE
+#define BULK_ESCAPED_LEN ((BULK_NAME_LEN - 1) * 6 + 1)   // TERBURUK: SEMUA \u00XX
+#define BULK_RECORD_MAX (BULK_ESCAPED_LEN + 192)         // 1 KOTA, JSON ATAU CSV
+
+// SALIN NAMA TANPA MEMOTONG DI TENGAH KARAKTER UTF-8
+inline size_t bulkCopyName(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (len >= size) {
+    len = size - 1;
+    // MUNDUR KE AWAL KARAKTER: BYTE LANJUTAN BERPOLA 10xxxxxx
+    while (len > 0 && ((uint8_t)src[len] & 0xC0) == 0x80) len--;
+  }
+  memcpy(dst, src, len);
+  dst[len] = '\0';
+  return len;
+}
+
+// JSON: \" \\ DAN KARAKTER KONTROL; CSV: " MENJADI ""
+// size >= BULK_ESCAPED_LEN CUKUP UNTUK NAMA DARI bulkCopyName
+inline size_t bulkEscapeName(char *dst, size_t size, const char *src, bool csv) {
+  size_t n = 0;
+  for (const char *p = src; *p; p++) {
+    uint8_t c = (uint8_t)*p;
+    char esc[7];
+    size_t len;
+
+    if (csv) {
+      if (c == '"') {
+        esc[0] = '"';
+        esc[1] = '"';
+        len = 2;
+      } else if (c < 0x20) {
+        esc[0] = ' ';
+        len = 1;
+      } else {
+        esc[0] = (char)c;
+        len = 1;
+      }
+    } else if (c == '"' || c == '\\') {
+      esc[0] = '\\';
+      esc[1] = (char)c;
+      len = 2;
+    } else if (c < 0x20) {
+      len = snprintf(esc, sizeof(esc), "\\u%04x", c);
+    } else {
+      esc[0] = (char)c;
+      len = 1;
+    }
+
+    if (n + len >= size) break;
+    memcpy(dst + n, esc, len);
+    n += len;
+  }
+  dst[n] = '\0';
+  return n;
+}
+
+inline size_t bulkRenderHeader(char *out, size_t size, bool csv, const char *date) {
+  int n = csv ?
+    snprintf(out, size, "city,lat,lon,imsak,subuh,terbit,zuhur,ashar,maghrib,isya\n") :
+    snprintf(out, size, "{\"date\":\"%s\",\"cities\":[", date);
+  return (n > 0 && (size_t)n < size) ? n : 0;
+}
+
+// KEMBALIKAN 0 JIKA TIDAK MUAT; PEMANGGIL MENGIRIM SISA BUFFER DULU LALU MENCOBA LAGI
+inline size_t bulkRenderCity(char *out, size_t size, bool csv, bool comma,
+                             const char *name, const CityBatch &batch, uint8_t i) {
+  char t[BULK_TIME_COUNT][6];
+  for (uint8_t k = 0; k < BULK_TIME_COUNT; k++) {
+    formatBulkTime(batch.times[k][i], t[k]);
+  }
+
+  char escaped[BULK_ESCAPED_LEN];
+  bulkEscapeName(escaped, sizeof(escaped), name, csv);
+
+  const char *fmt = csv ?
+    "%s\"%s\",%.4f,%.4f,%s,%s,%s,%s,%s,%s,%s\n" :
+    "%s{\"city\":\"%s\",\"lat\":%.4f,\"lon\":%.4f,\"imsak\":\"%s\",\"subuh\":\"%s\","
+    "\"terbit\":\"%s\",\"zuhur\":\"%s\",\"ashar\":\"%s\",\"maghrib\":\"%s\",\"isya\":\"%s\"}";
+
+  int n = snprintf(out, size, fmt,
+    (!csv && comma) ? "," : "",
+    escaped, batch.lat[i], batch.lon[i],
+    t[BULK_IMSAK], t[BULK_SUBUH], t[BULK_TERBIT], t[BULK_ZUHUR],
+    t[BULK_ASHAR], t[BULK_MAGHRIB], t[BULK_ISYA]);
+  return (n > 0 && (size_t)n < size) ? n : 0;
+}
+
+inline size_t bulkRenderFooter(char *out, size_t size, bool csv, uint16_t count,
+                               uint32_t dayCycles, uint32_t kernelCycles, uint32_t kernelUs) {
+  if (csv) return 0;
+  int n = snprintf(out, size,
+    "],\"count\":%u,\"fastMath\":%s,\"dayCycles\":%lu,\"cyclesPerCity\":%lu,"
+    "\"kernelUs\":%lu,\"citiesPerSec\":%lu}",
+    count,
+    SOLAR_FAST_MATH ? "true" : "false",
+    (unsigned long)dayCycles,
+    count > 0 ? (unsigned long)(kernelCycles / count) : 0UL,
+    (unsigned long)kernelUs,
+    kernelUs > 0 ? (unsigned long)(count * 1000000ULL / kernelUs) : 0UL);
+  return (n > 0 && (size_t)n < size) ? n : 0;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * SUMBER DETIK clockTickTask: SQW DS3231 ATAU TIMER INTERNAL
+ * Akuntansi detik murni: tepi yang tergabung, tepi hilang, kembali ke timer
+ * setelah RTC_SQW_MAX_MISSED, dan penghitung sinkron NTP dalam DETIK yang benar-benar
+ * diterapkan ke currentTime (bukan jumlah putaran loop). Diuji di host oleh
+ * test/clock_source_test.cpp dengan sumber SQW simulasi.
+ */
+
+#ifndef JWS_CLOCK_SOURCE_H
+#define JWS_CLOCK_SOURCE_H
+
+#include <stdint.h>
+
+#define RTC_SQW_TIMEOUT_MS 1500   // TANPA TEPI SELAMA INI = SATU TEPI HILANG
+#define RTC_SQW_MAX_MISSED 5      // BERTURUT-TURUT -> KEMBALI KE TIMER INTERNAL
+
+enum ClockWake : uint8_t {
+  CLOCK_WAKE_TIMER,       // vTaskDelayUntil 1 DETIK
+  CLOCK_WAKE_EDGE,        // SATU ATAU LEBIH TEPI SQW
+  CLOCK_WAKE_MISSED,      // TIMEOUT: TETAP MAJU SATU DETIK
+  CLOCK_WAKE_SQW_LOST     // TIMEOUT KE-RTC_SQW_MAX_MISSED: PAKAI TIMER INTERNAL
+};
+
+struct ClockTickState {
+  uint32_t pendingTicks;  // DETIK YANG BELUM DITERAPKAN (timeMutex SIBUK)
+  uint32_t sqwMissed;     // TIMEOUT BERTURUT-TURUT
+  uint32_t syncElapsedS;  // DETIK SEJAK SINKRON NTP OTOMATIS TERAKHIR
+};
+
+// edges = HASIL ulTaskNotifyTake (0 = TIMEOUT); DIABAIKAN SAAT !sqwActive
+inline ClockWake clockTickWake(ClockTickState &s, bool sqwActive, uint32_t edges) {
+  if (!sqwActive) {
+    s.pendingTicks++;
+    return CLOCK_WAKE_TIMER;
+  }
+  if (edges > 0) {
+    s.sqwMissed = 0;
+    s.pendingTicks += edges;
+    return CLOCK_WAKE_EDGE;
+  }
+  // TEPI HILANG: TETAP MAJU SATU DETIK, TEPI BERIKUTNYA MENYAMBUNG LAGI
+  s.pendingTicks++;
+  if (++s.sqwMissed >= RTC_SQW_MAX_MISSED) {
+    // SETIAP TIMEOUT MEMAKAN 1.5 s TAPI HANYA MENAMBAH 1 s: KEMBALIKAN SELISIHNYA
+    s.pendingTicks += RTC_SQW_MAX_MISSED * (RTC_SQW_TIMEOUT_MS - 1000) / 1000;
+    s.sqwMissed = 0;
+    return CLOCK_WAKE_SQW_LOST;
+  }
+  return CLOCK_WAKE_MISSED;
+}
+
+// DIPANGGIL DI BAWAH timeMutex: DETIK YANG DITAMBAHKAN KE currentTime
+inline uint32_t clockTickTake(ClockTickState &s) {
+  uint32_t n = s.pendingTicks;
+  s.pendingTicks = 0;
+  return n;
+}
+
+// appliedS = HASIL clockTickTake YANG SUDAH DITERAPKAN; TRUE = WAKTUNYA SINKRON NTP
+inline bool clockSyncDue(ClockTickState &s, uint32_t appliedS, uint32_t intervalS) {
+  s.syncElapsedS += appliedS;
+  if (s.syncElapsedS < intervalS) return false;
+  s.syncElapsedS = 0;
+  return true;
+}
+
+// TUNGGU SATU TEPI BARU DENGAN BATAS WAKTU; FALSE = SQW MATI DI TENGAH INISIALISASI
+template <typename Now, typename Wait>
+bool clockAwaitEdge(const volatile uint32_t &edges, uint32_t startEdges, uint32_t timeoutMs, Now now, Wait wait) {
+  uint32_t start = now();
+  while (edges == startEdges) {
+    if (now() - start >= timeoutMs) return false;
+    wait();
+  }
+  return true;
+}
+
+#endif
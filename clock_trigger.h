@@ -0,0 +1,34 @@
+/*
+ * KEPUTUSAN PEMICU 1 Hz: KEDIP WAKTU SHALAT & ALARM
+ * Murni (menit/detik lokal masuk, indeks keluar) sehingga checkPrayerTime /
+ * checkAlarmTime di uiTask dan pemutar ulang trace di host memakai aturan yang sama.
+ */
+
+#ifndef JWS_CLOCK_TRIGGER_H
+#define JWS_CLOCK_TRIGGER_H
+
+#include <stdint.h>
+
+#define CLOCK_TRIGGER_WINDOW_S 5       // DETIK 0-4: TICK YANG TERLEWAT TETAP MEMICU
+
+// INDEKS WAKTU SHALAT YANG MULAI PADA MENIT INI (BUZZER AKTIF), -1 JIKA TIDAK ADA.
+// JADWAL TANPA SATU PUN MENIT > 0 = BELUM DIMUAT; lastMinute MENCEGAH PEMICU GANDA
+inline int prayerTriggerIndex(const int16_t *minutes, uint8_t enabledMask, int count,
+                              int minuteKey, int sec, int lastMinute) {
+  bool anyScheduled = false;
+  for (int i = 0; i < count; i++) anyScheduled |= minutes[i] > 0;
+  if (!anyScheduled) return -1;
+
+  if (sec >= CLOCK_TRIGGER_WINDOW_S || minuteKey == lastMinute) return -1;
+  for (int i = 0; i < count; i++) {
+    if (minutes[i] == minuteKey && (enabledMask & (1u << i))) return i;
+  }
+  return -1;
+}
+
+inline bool alarmTriggered(int alarmMinute, int minuteKey, int sec, int lastMinute) {
+  return alarmMinute >= 0 && minuteKey == alarmMinute &&
+         minuteKey != lastMinute && sec < CLOCK_TRIGGER_WINDOW_S;
+}
+
+#endif
@@ -0,0 +1,259 @@
+/*
+ * DRIVER DFPLAYER TANPA HARDWARE: FRAME SERIAL + KEPUTUSAN PEMUTARAN
+ * dfSendCommand (dfBuildFrame) -> UART -> dfOnReceive (dfParserFeed) ->
+ * dfHandleFrame (dfFrameEvents) -> notifikasi AUDIO_EVT_* -> audioTask
+ * (audioPlaybackStep). Efek samping (UART, notifikasi, callback, log) tetap di
+ * jws.ino; test/dfplayer_emulator_test.cpp memutar logika ini terhadap emulator
+ * DFPlayer dengan waktu virtual.
+ */
+
+#ifndef JWS_DFPLAYER_DRIVER_H
+#define JWS_DFPLAYER_DRIVER_H
+
+#include <stdint.h>
+#include <string.h>
+
+// FRAME: 7E FF 06 CMD ACK PH PL CKH CKL EF
+#define DF_FRAME_SIZE        10
+#define DF_CMD_PLAY_TRACK    0x03
+#define DF_CMD_VOLUME        0x06
+#define DF_CMD_STOP          0x16
+#define DF_CMD_QUERY_STATUS  0x42     // BALASAN: BYTE RENDAH 0 = BERHENTI, 1 = MEMUTAR
+#define DF_EVT_CARD_INSERTED 0x3A
+#define DF_EVT_CARD_REMOVED  0x3B
+#define DF_EVT_USB_FINISHED  0x3C
+#define DF_EVT_SD_FINISHED   0x3D
+#define DF_EVT_FLASH_FINISHED 0x3E
+#define DF_EVT_ERROR         0x40
+
+// BIT NOTIFIKASI audioTask
+#define AUDIO_EVT_QUEUE      (1UL << 0)
+#define AUDIO_EVT_FINISHED   (1UL << 1)
+#define AUDIO_EVT_REMOVED    (1UL << 2)
+#define AUDIO_EVT_ERROR      (1UL << 3)
+#define AUDIO_EVT_STOP       (1UL << 4)
+#define AUDIO_EVT_REPLACE    (1UL << 5)   // DIGANTI audioPlay: HENTIKAN TANPA CALLBACK
+#define AUDIO_EVT_STATUS     (1UL << 6)
+
+#define AUDIO_MAX_DURATION   600000   // ms - BATAS AMAN SATU TRACK
+#define AUDIO_FINISH_GUARD   1000     // ms - FRAME SELESAI DITAHAN DULU SETELAH PLAY
+#define AUDIO_STATUS_TIMEOUT 500      // ms - BATAS MENUNGGU BALASAN QUERY STATUS
+#define AUDIO_QUEUE_LENGTH   4
+#define AUDIO_WAIT_FOREVER   UINT32_MAX
+
+enum AudioResult {
+  AUDIO_FINISHED,
+  AUDIO_STOPPED,
+  AUDIO_CARD_REMOVED,
+  AUDIO_ERROR,
+  AUDIO_TIMEOUT
+};
+
+typedef void (*AudioDoneCallback)(uint16_t track, AudioResult result);
+
+struct AudioJob {
+  uint16_t track;
+  AudioDoneCallback onDone;
+};
+
+struct AudioPlayback {
+  bool active;
+  bool finishLatched;          // FRAME SELESAI DATANG DALAM JENDELA GUARD
+  bool statusQueried;          // MENUNGGU BALASAN DF_CMD_QUERY_STATUS
+  AudioJob job;
+  uint32_t startTime;
+  uint32_t queryTime;
+  volatile uint16_t playingTrack;  // DIBACA TASK UART (dfFrameEvents); 0 = TIDAK MEMUTAR
+};
+
+// ============================================
+// FRAME SERIAL
+// ============================================
+inline void dfBuildFrame(uint8_t cmd, uint16_t param, uint8_t *frame) {
+  const uint8_t head[7] = { 0x7E, 0xFF, 0x06, cmd, 0x00, (uint8_t)(param >> 8), (uint8_t)(param & 0xFF) };
+  memcpy(frame, head, sizeof(head));
+
+  uint16_t sum = 0;
+  for (int i = 1; i < 7; i++) sum += frame[i];
+  uint16_t checksum = 0 - sum;
+  frame[7] = checksum >> 8;
+  frame[8] = checksum & 0xFF;
+  frame[9] = 0xEF;
+}
+
+inline uint16_t dfFrameParam(const uint8_t *frame) {
+  return ((uint16_t)frame[5] << 8) | frame[6];
+}
+
+struct DfParser {
+  uint8_t frame[DF_FRAME_SIZE];
+  uint8_t pos;
+};
+
+// FRAME RUSAK: BUANG BYTE PERTAMA, LANJUT DARI 0x7E BERIKUTNYA. FRAME SAH BISA
+// DIMULAI DI TENGAH FRAME YANG TERPOTONG, JADI SISA BYTE TIDAK IKUT DIBUANG
+inline void dfParserResync(DfParser &p) {
+  uint8_t k = 1;
+  while (k < p.pos && p.frame[k] != 0x7E) k++;
+  memmove(p.frame, p.frame + k, p.pos - k);
+  p.pos -= k;
+}
+
+// true = p.frame BERISI FRAME SAH (HEADER, PANJANG, CHECKSUM, EF)
+inline bool dfParserFeed(DfParser &p, uint8_t b) {
+  if (p.pos == 0 && b != 0x7E) return false;
+  p.frame[p.pos++] = b;
+
+  while (p.pos > 0) {
+    bool bad = (p.pos > 1 && p.frame[1] != 0xFF) || (p.pos > 2 && p.frame[2] != 0x06);
+    if (!bad && p.pos < DF_FRAME_SIZE) return false;
+
+    if (!bad) {
+      uint16_t sum = 0;
+      for (int i = 1; i < 7; i++) sum += p.frame[i];
+      uint16_t checksum = ((uint16_t)p.frame[7] << 8) | p.frame[8];
+      if (p.frame[9] == 0xEF && (uint16_t)(sum + checksum) == 0) {
+        p.pos = 0;
+        return true;
+      }
+    }
+    dfParserResync(p);
+  }
+  return false;
+}
+
+// FRAME SAH -> BIT AUDIO_EVT_*. FRAME SELESAI UNTUK TRACK LAIN (DUPLIKAT TERLAMBAT
+// DARI TRACK SEBELUMNYA) DIBUANG DI SINI, SEBELUM BIT-NYA BERGABUNG DENGAN FRAME SAH
+inline uint32_t dfFrameEvents(const uint8_t *frame, uint16_t playingTrack) {
+  switch (frame[3]) {
+    case DF_EVT_USB_FINISHED:
+    case DF_EVT_SD_FINISHED:
+    case DF_EVT_FLASH_FINISHED:
+      return (playingTrack != 0 && dfFrameParam(frame) == playingTrack) ? AUDIO_EVT_FINISHED : 0;
+    case DF_EVT_CARD_REMOVED:
+      return AUDIO_EVT_REMOVED;
+    case DF_EVT_ERROR:
+      return AUDIO_EVT_ERROR;
+    case DF_CMD_QUERY_STATUS:
+      return AUDIO_EVT_STATUS;
+    default:
+      return 0;
+  }
+}
+
+// ============================================
+// KEPUTUSAN PEMUTARAN (DIJALANKAN audioTask)
+// ============================================
+struct AudioAction {
+  bool sendQuery;              // KIRIM DF_CMD_QUERY_STATUS
+  bool sendStop;               // KIRIM DF_CMD_STOP
+  bool done;                   // PANGGIL job.onDone(job.track, result)
+  AudioResult result;
+  AudioJob job;
+};
+
+inline void audioPlaybackStart(AudioPlayback &pb, const AudioJob &job, uint32_t nowMs) {
+  pb.job = job;
+  pb.startTime = nowMs;
+  pb.finishLatched = false;
+  pb.statusQueried = false;
+  pb.active = true;
+  pb.playingTrack = job.track;
+}
+
+// BATAS TIDUR xTaskNotifyWait: BATAS DURASI, AKHIR GUARD, ATAU TENGGAT BALASAN STATUS
+inline uint32_t audioPlaybackWaitMs(const AudioPlayback &pb, uint32_t nowMs) {
+  if (!pb.active) return AUDIO_WAIT_FOREVER;
+
+  uint32_t elapsed = nowMs - pb.startTime;
+  uint32_t until = AUDIO_MAX_DURATION;
+  if (pb.statusQueried) {
+    uint32_t q = pb.queryTime - pb.startTime + AUDIO_STATUS_TIMEOUT;
+    if (q < until) until = q;
+  } else if (pb.finishLatched && AUDIO_FINISH_GUARD < until) {
+    until = AUDIO_FINISH_GUARD;
+  }
+  return elapsed >= until ? 0 : until - elapsed;
+}
+
+// FRAME SELESAI DALAM JENDELA GUARD BISA DUPLIKAT DARI PEMUTARAN SEBELUMNYA,
+// JADI DITAHAN LALU DIPERIKSA ULANG KE DFPLAYER SETELAH GUARD HABIS.
+// busyLevel: -1 = TANPA PIN BUSY, SELAIN ITU LEVEL PIN (1 = DIAM).
+// true = PEMUTARAN BENAR-BENAR SELESAI.
+inline bool audioCheckLatchedFinish(AudioPlayback &pb, uint32_t events, uint32_t nowMs,
+                                    uint8_t playStatus, int busyLevel, AudioAction &act) {
+  if (!pb.finishLatched || nowMs - pb.startTime < AUDIO_FINISH_GUARD) return false;
+
+  if (busyLevel >= 0) {
+    pb.finishLatched = false;
+    return busyLevel == 1;
+  }
+
+  if (!pb.statusQueried) {
+    pb.statusQueried = true;
+    pb.queryTime = nowMs;
+    act.sendQuery = true;
+    return false;
+  }
+
+  bool answered = (events & AUDIO_EVT_STATUS) != 0;
+  if (!answered && nowMs - pb.queryTime < AUDIO_STATUS_TIMEOUT) return false;
+
+  pb.finishLatched = false;
+  pb.statusQueried = false;
+  // TANPA BALASAN: PERCAYA FRAME, TRACK-NYA SUDAH COCOK SAAT DITAHAN
+  return !answered || playStatus != 1;
+}
+
+// SATU KALI BANGUN audioTask SELAMA pb.active. events = BIT YANG DITERIMA,
+// playStatus = BALASAN QUERY TERAKHIR. REPLACE MENGHENTIKAN TANPA done
+// (CALLBACK JOB LAMA AKAN MEMBERSIHKAN STATE YANG BARU SAJA DIISI PEMANGGIL)
+inline AudioAction audioPlaybackStep(AudioPlayback &pb, uint32_t events, uint32_t nowMs,
+                                     uint8_t playStatus, int busyLevel) {
+  AudioAction act = {};
+  if (!pb.active) return act;
+
+  uint32_t elapsed = nowMs - pb.startTime;
+
+  // DFPLAYER SERING MENGIRIM FRAME SELESAI DUA KALI: DALAM GUARD DITAHAN,
+  // BUKAN DIBUANG, AGAR TRACK PENDEK TIDAK MENGGANTUNG SAMPAI BATAS DURASI
+  bool finished = false;
+  if (events & AUDIO_EVT_FINISHED) {
+    if (elapsed >= AUDIO_FINISH_GUARD) finished = true;
+    else pb.finishLatched = true;
+  }
+  if (!finished) finished = audioCheckLatchedFinish(pb, events, nowMs, playStatus, busyLevel, act);
+
+  if (events & AUDIO_EVT_REPLACE) {
+    act.sendStop = true;
+  } else if (events & AUDIO_EVT_STOP) {
+    act.sendStop = true;
+    act.done = true;
+    act.result = AUDIO_STOPPED;
+  } else if (events & AUDIO_EVT_REMOVED) {
+    act.done = true;
+    act.result = AUDIO_CARD_REMOVED;
+  } else if (events & AUDIO_EVT_ERROR) {
+    act.done = true;
+    act.result = AUDIO_ERROR;
+  } else if (finished) {
+    act.done = true;
+    act.result = AUDIO_FINISHED;
+  } else if (elapsed >= AUDIO_MAX_DURATION) {
+    act.sendStop = true;
+    act.done = true;
+    act.result = AUDIO_TIMEOUT;
+  } else {
+    return act;
+  }
+
+  // SELESAI (DENGAN ATAU TANPA CALLBACK)
+  act.job = pb.job;
+  pb.active = false;
+  pb.playingTrack = 0;
+  // QUERY YANG BARU DIKIRIM TIDAK PERLU LAGI
+  act.sendQuery = false;
+  return act;
+}
+
+#endif
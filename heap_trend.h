@@ -0,0 +1,139 @@
+/*
+ * TREN HEAP JANGKA PANJANG: SAMPEL PER JAM + DETEKSI KEBOCORAN/FRAGMENTASI
+ * Tanpa dependensi Arduino: jws.ino memanggilnya di bawah heapTrendMux dengan
+ * angka ESP.getFreeHeap()/getMaxAllocHeap(), test/heap_soak.cpp dengan heap
+ * simulasi selama satu tahun virtual.
+ *
+ * Satu sampel per jam: heap bebas terendah, blok terbesar terendah, dan rasio
+ * blok terbesar / heap bebas terendah. Rasio dihitung dari pasangan angka yang
+ * diambil pada saat yang sama, bukan dari dua minimum yang terjadi di menit
+ * berbeda. Kebocoran = minimum per jam turun hampir monoton dengan kemiringan
+ * melewati ambang; fragmentasi = rasio terus turun dengan pola yang sama.
+ */
+
+#ifndef JWS_HEAP_TREND_H
+#define JWS_HEAP_TREND_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define HEAP_TREND_SLOTS     48        // 2 HARI RIWAYAT
+#define HEAP_TREND_WINDOW    12        // JAM TERAKHIR YANG DIANALISIS
+#define HEAP_LEAK_SLOPE_BPH  200       // TURUN > 200 BYTE/JAM = CURIGA BOCOR
+#define HEAP_FRAG_SLOPE_PMPH 5         // RASIO TURUN > 5 PERMIL/JAM = CURIGA FRAGMENTASI
+#define HEAP_MONOTONIC_PCT   80        // % LANGKAH YANG HARUS BENAR-BENAR MENURUN
+#define HEAP_HOUR_MS         3600000UL
+
+struct HeapSample {
+  uint32_t hour;        // JAM UPTIME
+  uint32_t minFree;
+  uint32_t minLargest;
+  uint32_t minFragPermil;  // MIN(largest * 1000 / free) DARI SAMPEL YANG SAMA
+};
+
+struct HeapTrend {
+  HeapSample samples[HEAP_TREND_SLOTS];
+  uint8_t head;
+  uint8_t count;
+  uint32_t hours;
+  uint32_t hourMinFree;
+  uint32_t hourMinLargest;
+  uint32_t hourMinFragPermil;
+  uint32_t hourStart;
+  int32_t freeSlopeBph;
+  int32_t fragSlopePmph;
+  bool leakSuspected;
+  bool fragSuspected;
+};
+
+struct HeapTrendVerdict {
+  int n;
+  float freeSlope;      // BYTE/JAM
+  float fragSlope;      // PERMIL/JAM
+  int freeDown;
+  int fragDown;
+  bool leak;
+  bool frag;
+};
+
+inline uint32_t heapFragPermil(uint32_t freeHeap, uint32_t largest) {
+  return freeHeap ? (uint32_t)((uint64_t)largest * 1000 / freeHeap) : 0;
+}
+
+// KEMIRINGAN KUADRAT TERKECIL PER SAMPEL; *downSteps = LANGKAH YANG TURUN (DATAR TIDAK DIHITUNG)
+inline float heapSlope(const int32_t *v, int n, int *downSteps) {
+  float sx = 0, sy = 0, sxx = 0, sxy = 0;
+  *downSteps = 0;
+  for (int i = 0; i < n; i++) {
+    sx += i;
+    sy += v[i];
+    sxx += (float)i * i;
+    sxy += (float)i * v[i];
+    if (i > 0 && v[i] < v[i - 1]) (*downSteps)++;
+  }
+  float den = n * sxx - sx * sx;
+  return den != 0 ? (n * sxy - sx * sy) / den : 0;
+}
+
+// SATU PENGUKURAN (webTask: TIAP 30 DETIK); TRUE = SATU JAM DITUTUP, SAATNYA ANALISIS
+inline bool heapTrendAdd(HeapTrend &t, uint32_t freeHeap, uint32_t largest, uint32_t nowMs) {
+  uint32_t frag = heapFragPermil(freeHeap, largest);
+
+  if (t.hourStart == 0 && t.hourMinFree == 0) {
+    t.hourStart = nowMs;
+    t.hourMinFree = freeHeap;
+    t.hourMinLargest = largest;
+    t.hourMinFragPermil = frag;
+  }
+  if (freeHeap < t.hourMinFree) t.hourMinFree = freeHeap;
+  if (largest < t.hourMinLargest) t.hourMinLargest = largest;
+  if (frag < t.hourMinFragPermil) t.hourMinFragPermil = frag;
+
+  if (nowMs - t.hourStart < HEAP_HOUR_MS) return false;
+
+  HeapSample &h = t.samples[t.head];
+  h.hour = ++t.hours;
+  h.minFree = t.hourMinFree;
+  h.minLargest = t.hourMinLargest;
+  h.minFragPermil = t.hourMinFragPermil;
+  t.head = (t.head + 1) % HEAP_TREND_SLOTS;
+  if (t.count < HEAP_TREND_SLOTS) t.count++;
+
+  t.hourStart = nowMs;
+  t.hourMinFree = freeHeap;
+  t.hourMinLargest = largest;
+  t.hourMinFragPermil = frag;
+  return true;
+}
+
+inline const HeapSample &heapTrendAt(const HeapTrend &t, int i) {
+  return t.samples[(t.head + HEAP_TREND_SLOTS - t.count + i) % HEAP_TREND_SLOTS];
+}
+
+// ANALISIS HEAP_TREND_WINDOW JAM TERAKHIR; TIDAK MENGUBAH t
+inline HeapTrendVerdict heapTrendEvaluate(const HeapTrend &t) {
+  HeapTrendVerdict v;
+  memset(&v, 0, sizeof(v));
+
+  int32_t freeSeries[HEAP_TREND_WINDOW];
+  int32_t fragSeries[HEAP_TREND_WINDOW];
+  v.n = t.count < HEAP_TREND_WINDOW ? t.count : HEAP_TREND_WINDOW;
+  for (int i = 0; i < v.n; i++) {
+    const HeapSample &h = heapTrendAt(t, t.count - v.n + i);
+    freeSeries[i] = (int32_t)h.minFree;
+    fragSeries[i] = (int32_t)h.minFragPermil;
+  }
+  if (v.n < 3) return v;
+
+  v.freeSlope = heapSlope(freeSeries, v.n, &v.freeDown);
+  v.fragSlope = heapSlope(fragSeries, v.n, &v.fragDown);
+  int needDown = (v.n - 1) * HEAP_MONOTONIC_PCT / 100;
+
+  v.leak = (v.n >= HEAP_TREND_WINDOW) &&
+           v.freeSlope < -HEAP_LEAK_SLOPE_BPH && v.freeDown >= needDown;
+  v.frag = (v.n >= HEAP_TREND_WINDOW) &&
+           v.fragSlope < -HEAP_FRAG_SLOPE_PMPH && v.fragDown >= needDown;
+  return v;
+}
+
+#endif
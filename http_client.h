@@ -0,0 +1,691 @@
+/*
+ * KLIEN HTTP/1.1 NON-BLOCKING DI ATAS SOKET BSD (LWIP DI ESP32, POSIX DI HOST)
+ * Koneksi keep-alive per host + cache DNS, khusus scheduleTask. Setiap HttpFetch
+ * adalah state machine sendiri (DNS -> CONNECT -> KIRIM -> TERIMA) yang dimajukan
+ * httpPoll(), sehingga beberapa penyedia bisa dibalap dalam satu select(). Resolusi
+ * DNS juga asinkron: lookup yang lambat untuk satu penyedia tidak menahan yang lain.
+ * Tenggat absolut & pembatalan diperiksa tiap HTTPC_POLL_MS. Body dialirkan ke
+ * callback (tanpa String).
+ *
+ * Pemakai menyediakan hook waktu & DNS di bawah: jws.ino memakai millis() dan
+ * dns_gethostbyname LWIP, test/http_client_test.cpp memakai jam host dan resolver
+ * stand-in dengan latensi yang disuntikkan.
+ */
+
+#ifndef JWS_HTTP_CLIENT_H
+#define JWS_HTTP_CLIENT_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#ifdef ARDUINO
+#include "lwip/sockets.h"
+#else
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#define HTTPC_DNS_DONE -1              // HASIL httpcDnsStart/httpcDnsPoll SELAIN TIKET
+#define HTTPC_DNS_FAIL -2
+#define HTTPC_DNS_PENDING -3
+
+// HOOK PEMAKAI
+uint32_t httpcNowMs();
+// >= 0 = TIKET LOOKUP BERJALAN; HTTPC_DNS_DONE (addr TERISI) ATAU HTTPC_DNS_FAIL
+int httpcDnsStart(const char *host, uint32_t &addr);
+// HTTPC_DNS_PENDING, HTTPC_DNS_DONE (addr TERISI) ATAU HTTPC_DNS_FAIL; TIKET BEBAS SETELAH SELESAI
+int httpcDnsPoll(int ticket, uint32_t &addr);
+// FETCH SELESAI SEBELUM LOOKUP: JAWABAN YANG DATANG BELAKANGAN DIBUANG
+void httpcDnsCancel(int ticket);
+// TIDAK ADA SOKET UNTUK DITUNGGU (SEMUA FETCH MASIH DI DNS)
+void httpcIdle(uint32_t ms);
+
+#define HTTPC_DNS_SLOTS 2
+#define HTTPC_DNS_TTL_MS 600000        // LWIP TIDAK MENGEMBALIKAN TTL ASLI
+#define HTTPC_CONN_SLOTS 2             // SATU PER PENYEDIA YANG DIBALAP
+#define HTTPC_IDLE_CLOSE_MS 20000      // SERVER BIASANYA MENUTUP KEEP-ALIVE LEBIH DULU
+#define HTTPC_POLL_MS 100
+#define HTTPC_DNS_POLL_MS 10           // JAWABAN DNS TIDAK PUNYA SOKET: DIPERIKSA LEBIH SERING
+#define HTTPC_LINE_MAX 160             // BARIS HEADER LEBIH PANJANG DIPOTONG
+#define HTTPC_REQUEST_MAX 320
+
+enum HttpFetchError : int {
+  FETCH_ERR_DNS = -1,
+  FETCH_ERR_CONNECT = -2,
+  FETCH_ERR_SEND = -3,
+  FETCH_ERR_TIMEOUT = -4,
+  FETCH_ERR_CANCELLED = -5,
+  FETCH_ERR_PROTOCOL = -6,
+  FETCH_ERR_CLOSED = -7,
+  FETCH_ERR_BUSY = -8                  // SEMUA SLOT KONEKSI TERPAKAI
+};
+
+enum HttpPhase : uint8_t {
+  HTTP_IDLE = 0,
+  HTTP_RESOLVING,
+  HTTP_CONNECTING,
+  HTTP_SENDING,
+  HTTP_RECEIVING,
+  HTTP_DONE
+};
+
+enum HttpChunkState : uint8_t {
+  CHUNK_SIZE = 0,
+  CHUNK_DATA,
+  CHUNK_DATA_END,
+  CHUNK_TRAILER
+};
+
+struct HttpBody {
+  bool chunked;
+  bool closeDelimited;
+  bool done;
+  bool overrun;                        // BYTE SISA SETELAH PESAN - KONEKSI TIDAK DIPAKAI ULANG
+  HttpChunkState chunkState;
+  int32_t remaining;
+  uint8_t lineLen;
+  char line[20];
+};
+
+struct HttpFetch {
+  const char *host;
+  uint16_t port;
+  const char *path;
+  uint32_t deadlineMs;                 // httpcNowMs() ABSOLUT
+  bool (*onBody)(const uint8_t *data, size_t len, void *ctx);  // HANYA STATUS 200; false = BATAL
+  bool (*cancelled)(void *ctx);
+  void *ctx;
+
+  int result;                          // 0 = BERJALAN, >0 STATUS HTTP, <0 FETCH_ERR_*
+  int status;
+  bool dnsCached;
+  bool reused;
+  uint32_t dnsMs;
+  uint32_t connectMs;
+  uint32_t ttfbMs;
+  uint32_t totalMs;
+  uint32_t bodyBytes;
+
+  // INTERNAL
+  HttpPhase phase;
+  int8_t conn;
+  int8_t dnsTicket;
+  bool retried;
+  bool gotBytes;
+  bool statusSeen;
+  bool inBody;
+  bool framed;
+  bool keepAlive;
+  int32_t contentLength;
+  uint32_t startMs;
+  uint32_t phaseMs;
+  uint16_t requestLen;
+  uint16_t sent;
+  uint16_t lineLen;
+  HttpBody body;
+  char request[HTTPC_REQUEST_MAX];
+  char line[HTTPC_LINE_MAX];
+};
+
+struct DnsCacheEntry {
+  char host[48];
+  uint32_t addr;                       // URUTAN BYTE JARINGAN
+  uint32_t expiresMs;
+};
+
+struct HttpConn {
+  int fd;
+  bool busy;
+  uint16_t port;
+  uint32_t lastUsedMs;
+  char host[48];
+};
+
+static_assert(HTTPC_CONN_SLOTS == 2, "perbarui penginisialisasi httpConns");
+
+DnsCacheEntry dnsCache[HTTPC_DNS_SLOTS] = {};
+HttpConn httpConns[HTTPC_CONN_SLOTS] = {
+  { -1, false, 0, 0, "" },
+  { -1, false, 0, 0, "" }
+};
+
+bool dnsCacheFind(const char *host, uint32_t &addr) {
+  uint32_t now = httpcNowMs();
+  for (DnsCacheEntry &e : dnsCache) {
+    if (e.host[0] != '\0' && strcmp(e.host, host) == 0 && (int32_t)(e.expiresMs - now) > 0) {
+      addr = e.addr;
+      return true;
+    }
+  }
+  return false;
+}
+
+void dnsCacheStore(const char *host, uint32_t addr) {
+  // SLOT HOST YANG SAMA, SLOT KOSONG, ATAU YANG PALING DULU KEDALUWARSA
+  DnsCacheEntry *slot = &dnsCache[0];
+  for (DnsCacheEntry &e : dnsCache) {
+    if (e.host[0] == '\0' || strcmp(e.host, host) == 0) {
+      slot = &e;
+      break;
+    }
+    if ((int32_t)(e.expiresMs - slot->expiresMs) < 0) slot = &e;
+  }
+  snprintf(slot->host, sizeof(slot->host), "%s", host);
+  slot->addr = addr;
+  slot->expiresMs = httpcNowMs() + HTTPC_DNS_TTL_MS;
+}
+
+// CONNECT GAGAL: ALAMAT MUNGKIN SUDAH BERUBAH
+void dnsCacheForget(const char *host) {
+  for (DnsCacheEntry &e : dnsCache) {
+    if (strcmp(e.host, host) == 0) e.host[0] = '\0';
+  }
+}
+
+void httpConnClose(HttpConn &c) {
+  if (c.fd >= 0) {
+    close(c.fd);
+    c.fd = -1;
+  }
+}
+
+// DIPANGGIL SAAT LAYANAN IDLE AGAR SOKET TIDAK MENGGANTUNG DI LWIP
+void httpConnReap() {
+  for (HttpConn &c : httpConns) {
+    if (!c.busy && c.fd >= 0 && httpcNowMs() - c.lastUsedMs > HTTPC_IDLE_CLOSE_MS) {
+      httpConnClose(c);
+    }
+  }
+}
+
+// EOF ATAU DATA TAK DIMINTA = SERVER SUDAH MENUTUP / KONEKSI KOTOR
+bool httpConnAlive(HttpConn &c) {
+  if (c.fd < 0) return false;
+  if (httpcNowMs() - c.lastUsedMs > HTTPC_IDLE_CLOSE_MS) {
+    httpConnClose(c);
+    return false;
+  }
+
+  uint8_t probe;
+  int r = recv(c.fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (r >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+    httpConnClose(c);
+    return false;
+  }
+  return true;
+}
+
+int8_t httpConnAcquire(const char *host, uint16_t port, bool &reused) {
+  for (int8_t i = 0; i < HTTPC_CONN_SLOTS; i++) {
+    HttpConn &c = httpConns[i];
+    if (c.busy || c.fd < 0 || c.port != port || strcmp(c.host, host) != 0) continue;
+    if (httpConnAlive(c)) {
+      c.busy = true;
+      reused = true;
+      return i;
+    }
+  }
+
+  // SLOT KOSONG, ATAU KORBANKAN KONEKSI MENGANGGUR YANG PALING LAMA
+  int8_t pick = -1;
+  for (int8_t i = 0; i < HTTPC_CONN_SLOTS; i++) {
+    HttpConn &c = httpConns[i];
+    if (c.busy) continue;
+    if (c.fd < 0) {
+      pick = i;
+      break;
+    }
+    if (pick < 0 || (int32_t)(c.lastUsedMs - httpConns[pick].lastUsedMs) < 0) pick = i;
+  }
+  if (pick < 0) return -1;
+
+  HttpConn &c = httpConns[pick];
+  httpConnClose(c);
+  c.busy = true;
+  c.port = port;
+  snprintf(c.host, sizeof(c.host), "%s", host);
+  reused = false;
+  return pick;
+}
+
+int httpFetchFd(const HttpFetch &f) {
+  return f.conn >= 0 ? httpConns[f.conn].fd : -1;
+}
+
+bool httpFetchActive(const HttpFetch &f) {
+  return f.phase != HTTP_IDLE && f.phase != HTTP_DONE;
+}
+
+void httpFinish(HttpFetch &f, int result) {
+  if (f.phase == HTTP_RESOLVING && f.dnsTicket >= 0) httpcDnsCancel(f.dnsTicket);
+  f.dnsTicket = -1;
+  f.result = result;
+  f.phase = HTTP_DONE;
+  f.totalMs = httpcNowMs() - f.startMs;
+
+  if (f.conn >= 0) {
+    HttpConn &c = httpConns[f.conn];
+    c.lastUsedMs = httpcNowMs();
+    if (result < 0 || !f.keepAlive || f.body.overrun) httpConnClose(c);
+    c.busy = false;
+    f.conn = -1;
+  }
+}
+
+// PEMBATALAN DARI LUAR (MISAL KALAH BALAPAN): SOKET DITUTUP KARENA
+// RESPONS YANG BELUM SELESAI TIDAK BISA DILANJUTKAN PERMINTAAN LAIN
+void httpAbort(HttpFetch &f) {
+  if (httpFetchActive(f)) httpFinish(f, FETCH_ERR_CANCELLED);
+}
+
+void httpResetResponse(HttpFetch &f) {
+  f.status = 0;
+  f.sent = 0;
+  f.gotBytes = false;
+  f.statusSeen = false;
+  f.inBody = false;
+  f.framed = false;
+  f.keepAlive = true;
+  f.contentLength = -1;
+  f.lineLen = 0;
+  f.bodyBytes = 0;
+  memset(&f.body, 0, sizeof(f.body));
+}
+
+// SOKET BARU UNTUK SLOT f.conn; CONNECT NON-BLOCKING DISELESAIKAN httpPoll()
+int httpConnect(HttpFetch &f, uint32_t addr) {
+  int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (fd < 0) return FETCH_ERR_CONNECT;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  struct sockaddr_in sa = {};
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(f.port);
+  sa.sin_addr.s_addr = addr;
+
+  if (connect(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0 && errno != EINPROGRESS) {
+    close(fd);
+    dnsCacheForget(f.host);
+    return FETCH_ERR_CONNECT;
+  }
+
+  httpConns[f.conn].fd = fd;
+  f.phase = HTTP_CONNECTING;
+  f.phaseMs = httpcNowMs();
+  return 0;
+}
+
+// ALAMAT DARI CACHE LANGSUNG CONNECT; SELAIN ITU LOOKUP DIMULAI DAN
+// httpPoll() MENUNGGU JAWABANNYA DI HTTP_RESOLVING TANPA MENAHAN FETCH LAIN
+int httpOpen(HttpFetch &f) {
+  uint32_t addr;
+  f.dnsCached = dnsCacheFind(f.host, addr);
+  if (f.dnsCached) return httpConnect(f, addr);
+
+  f.phaseMs = httpcNowMs();
+  int r = httpcDnsStart(f.host, addr);
+  if (r == HTTPC_DNS_FAIL) return FETCH_ERR_DNS;
+  if (r == HTTPC_DNS_DONE) {
+    dnsCacheStore(f.host, addr);
+    f.dnsMs = httpcNowMs() - f.phaseMs;
+    return httpConnect(f, addr);
+  }
+  f.dnsTicket = (int8_t)r;
+  f.phase = HTTP_RESOLVING;
+  return 0;
+}
+
+// false = FETCH SELESAI (GAGAL); true = MASIH MENUNGGU ATAU SUDAH CONNECTING
+bool httpResolveStep(HttpFetch &f) {
+  uint32_t addr;
+  int r = httpcDnsPoll(f.dnsTicket, addr);
+  if (r == HTTPC_DNS_PENDING) return true;
+
+  f.dnsTicket = -1;
+  f.dnsMs = httpcNowMs() - f.phaseMs;
+  if (r != HTTPC_DNS_DONE) {
+    httpFinish(f, FETCH_ERR_DNS);
+    return false;
+  }
+  dnsCacheStore(f.host, addr);
+  r = httpConnect(f, addr);
+  if (r < 0) {
+    httpFinish(f, r);
+    return false;
+  }
+  return true;
+}
+
+// KONEKSI KEEP-ALIVE DITUTUP SERVER SEBELUM ADA RESPONS: ULANG SEKALI LEWAT SOKET BARU
+bool httpRetryFresh(HttpFetch &f) {
+  if (!f.reused || f.retried || f.gotBytes) return false;
+
+  httpConnClose(httpConns[f.conn]);
+  f.retried = true;
+  f.reused = false;
+  httpResetResponse(f);
+
+  int r = httpOpen(f);
+  if (r < 0) {
+    httpFinish(f, r);
+  }
+  return true;
+}
+
+void httpBegin(HttpFetch &f) {
+  f.result = 0;
+  f.dnsCached = false;
+  f.reused = false;
+  f.retried = false;
+  f.dnsMs = f.connectMs = f.ttfbMs = f.totalMs = 0;
+  f.conn = -1;
+  f.dnsTicket = -1;
+  f.startMs = httpcNowMs();
+  httpResetResponse(f);
+
+  int len = snprintf(f.request, sizeof(f.request),
+    "GET %s HTTP/1.1\r\n"
+    "Host: %s\r\n"
+    "User-Agent: JWS-ESP32\r\n"
+    "Accept: application/json\r\n"
+    "Connection: keep-alive\r\n\r\n",
+    f.path, f.host);
+  f.phase = HTTP_CONNECTING;
+  if (len <= 0 || len >= (int)sizeof(f.request)) {
+    httpFinish(f, FETCH_ERR_PROTOCOL);
+    return;
+  }
+  f.requestLen = (uint16_t)len;
+
+  f.conn = httpConnAcquire(f.host, f.port, f.reused);
+  if (f.conn < 0) {
+    httpFinish(f, FETCH_ERR_BUSY);
+    return;
+  }
+
+  if (f.reused) {
+    f.dnsCached = true;
+    f.phase = HTTP_SENDING;
+    f.phaseMs = httpcNowMs();
+    return;
+  }
+
+  int r = httpOpen(f);
+  if (r < 0) httpFinish(f, r);
+}
+
+bool httpBodyDeliver(HttpFetch &f, const uint8_t *data, size_t len) {
+  f.bodyBytes += len;
+  // NON-200 TETAP DIBACA HABIS AGAR KONEKSI BISA DIPAKAI ULANG
+  if (f.status != 200 || f.onBody == NULL) return true;
+  return f.onBody(data, len, f.ctx);
+}
+
+// false = PROTOKOL RUSAK ATAU CALLBACK MEMBATALKAN
+bool httpBodyFeed(HttpFetch &f, HttpBody &b, const uint8_t *data, size_t len) {
+  size_t i = 0;
+  while (i < len && !b.done) {
+    if (!b.chunked) {
+      size_t take = len - i;
+      if (!b.closeDelimited) {
+        if (take > (size_t)b.remaining) take = (size_t)b.remaining;
+        b.remaining -= take;
+        if (b.remaining == 0) b.done = true;
+      }
+      if (!httpBodyDeliver(f, data + i, take)) return false;
+      i += take;
+      continue;
+    }
+
+    if (b.chunkState == CHUNK_DATA) {
+      size_t take = len - i;
+      if (take > (size_t)b.remaining) take = (size_t)b.remaining;
+      if (!httpBodyDeliver(f, data + i, take)) return false;
+      i += take;
+      b.remaining -= take;
+      if (b.remaining == 0) b.chunkState = CHUNK_DATA_END;
+      continue;
+    }
+
+    char c = (char)data[i++];
+    if (c != '\n') {
+      if (c != '\r' && b.lineLen < sizeof(b.line) - 1) b.line[b.lineLen++] = c;
+      continue;
+    }
+    b.line[b.lineLen] = '\0';
+    bool empty = (b.lineLen == 0);
+    b.lineLen = 0;
+
+    if (b.chunkState == CHUNK_SIZE) {
+      char *end = NULL;
+      unsigned long size = strtoul(b.line, &end, 16);
+      if (end == b.line) return false;
+      if (size == 0) {
+        b.chunkState = CHUNK_TRAILER;
+      } else {
+        b.remaining = (int32_t)size;
+        b.chunkState = CHUNK_DATA;
+      }
+    } else if (b.chunkState == CHUNK_DATA_END) {
+      if (!empty) return false;
+      b.chunkState = CHUNK_SIZE;
+    } else if (empty) {
+      b.done = true;
+    }
+  }
+
+  if (i < len) b.overrun = true;
+  return true;
+}
+
+// STATUS LINE & HEADER DIPROSES PER BARIS - HEADER PANJANG (CDN) TIDAK DISIMPAN.
+// MENGEMBALIKAN JUMLAH BYTE YANG DIPAKAI, -1 BILA STATUS LINE RUSAK.
+int httpHeaderFeed(HttpFetch &f, const uint8_t *data, size_t len) {
+  size_t off = 0;
+  while (!f.inBody && off < len) {
+    char c = (char)data[off++];
+    if (c != '\n') {
+      if (f.lineLen < sizeof(f.line) - 1) f.line[f.lineLen++] = c;
+      continue;
+    }
+    if (f.lineLen > 0 && f.line[f.lineLen - 1] == '\r') f.lineLen--;
+    f.line[f.lineLen] = '\0';
+
+    if (!f.statusSeen) {
+      if (strncmp(f.line, "HTTP/1.", 7) != 0 || f.lineLen < 12) return -1;
+      f.status = atoi(f.line + 9);
+      f.keepAlive = (f.line[7] == '1');
+      f.statusSeen = true;
+    } else if (f.lineLen == 0) {
+      f.inBody = true;
+    } else if (strncasecmp(f.line, "Content-Length:", 15) == 0) {
+      f.contentLength = atol(f.line + 15);
+    } else if (strncasecmp(f.line, "Transfer-Encoding:", 18) == 0) {
+      f.body.chunked = (strstr(f.line + 18, "chunked") != NULL);
+    } else if (strncasecmp(f.line, "Connection:", 11) == 0) {
+      if (strstr(f.line + 11, "close") != NULL) f.keepAlive = false;
+    }
+    f.lineLen = 0;
+  }
+  return (int)off;
+}
+
+void httpFrameBody(HttpFetch &f) {
+  f.framed = true;
+  if (f.status == 204 || f.status == 304 || f.contentLength == 0) {
+    f.body.done = true;
+  } else if (f.body.chunked) {
+    f.body.chunkState = CHUNK_SIZE;
+  } else if (f.contentLength > 0) {
+    f.body.remaining = f.contentLength;
+  } else {
+    f.body.closeDelimited = true;
+    f.keepAlive = false;
+  }
+}
+
+// DIPANGGIL httpPoll() SAAT SOKET SIAP; TIDAK PERNAH MENUNGGU
+void httpStep(HttpFetch &f) {
+  int fd = httpFetchFd(f);
+
+  if (f.phase == HTTP_CONNECTING) {
+    int err = 0;
+    socklen_t errLen = sizeof(err);
+    getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &errLen);
+    if (err != 0) {
+      dnsCacheForget(f.host);
+      httpFinish(f, FETCH_ERR_CONNECT);
+      return;
+    }
+    f.connectMs = httpcNowMs() - f.phaseMs;
+    f.phase = HTTP_SENDING;
+    f.phaseMs = httpcNowMs();
+  }
+
+  if (f.phase == HTTP_SENDING) {
+    while (f.sent < f.requestLen) {
+      int n = send(fd, f.request + f.sent, f.requestLen - f.sent, MSG_DONTWAIT);
+      if (n > 0) {
+        f.sent += n;
+      } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return;
+      } else {
+        if (!httpRetryFresh(f)) httpFinish(f, FETCH_ERR_SEND);
+        return;
+      }
+    }
+    f.phase = HTTP_RECEIVING;
+    f.phaseMs = httpcNowMs();
+    return;
+  }
+
+  uint8_t buf[512];
+  while (f.phase == HTTP_RECEIVING) {
+    int n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+      if (!httpRetryFresh(f)) httpFinish(f, f.gotBytes ? FETCH_ERR_PROTOCOL : FETCH_ERR_CLOSED);
+      return;
+    }
+
+    if (n == 0) {
+      if (f.inBody && f.body.closeDelimited) {
+        f.body.done = true;
+        httpFinish(f, f.status);
+      } else if (!httpRetryFresh(f)) {
+        httpFinish(f, f.gotBytes ? FETCH_ERR_PROTOCOL : FETCH_ERR_CLOSED);
+      }
+      return;
+    }
+
+    if (!f.gotBytes) {
+      f.gotBytes = true;
+      f.ttfbMs = httpcNowMs() - f.phaseMs;
+    }
+
+    int off = 0;
+    if (!f.inBody) {
+      off = httpHeaderFeed(f, buf, n);
+      if (off < 0) {
+        httpFinish(f, FETCH_ERR_PROTOCOL);
+        return;
+      }
+      if (!f.inBody) continue;
+    }
+    if (!f.framed) httpFrameBody(f);
+
+    if (off < n && !f.body.done && !httpBodyFeed(f, f.body, buf + off, n - off)) {
+      bool cancelled = (f.cancelled != NULL && f.cancelled(f.ctx));
+      httpFinish(f, cancelled ? FETCH_ERR_CANCELLED : FETCH_ERR_PROTOCOL);
+      return;
+    }
+
+    if (f.body.done) httpFinish(f, f.status);
+  }
+}
+
+// SATU PUTARAN select() ATAS SEMUA FETCH AKTIF, PALING LAMA HTTPC_POLL_MS.
+// FETCH YANG DIBATALKAN ATAU LEWAT TENGGAT DISELESAIKAN DI SINI.
+void httpPoll(HttpFetch *const *fetches, size_t count) {
+  fd_set rd, wr;
+  FD_ZERO(&rd);
+  FD_ZERO(&wr);
+  int maxFd = -1;
+  bool resolving = false;
+  uint32_t now = httpcNowMs();
+  int32_t slice = HTTPC_POLL_MS;
+
+  for (size_t i = 0; i < count; i++) {
+    HttpFetch &f = *fetches[i];
+    if (!httpFetchActive(f)) continue;
+
+    if (f.cancelled != NULL && f.cancelled(f.ctx)) {
+      httpFinish(f, FETCH_ERR_CANCELLED);
+      continue;
+    }
+    int32_t left = (int32_t)(f.deadlineMs - now);
+    if (left <= 0) {
+      if (f.phase == HTTP_CONNECTING) dnsCacheForget(f.host);
+      httpFinish(f, FETCH_ERR_TIMEOUT);
+      continue;
+    }
+    if (left < slice) slice = left;
+
+    if (f.phase == HTTP_RESOLVING) {
+      if (!httpResolveStep(f)) continue;
+      if (f.phase == HTTP_RESOLVING) {
+        resolving = true;
+        continue;
+      }
+    }
+
+    int fd = httpFetchFd(f);
+    FD_SET(fd, f.phase == HTTP_RECEIVING ? &rd : &wr);
+    if (fd > maxFd) maxFd = fd;
+  }
+  if (resolving && slice > HTTPC_DNS_POLL_MS) slice = HTTPC_DNS_POLL_MS;
+  if (maxFd < 0) {
+    if (resolving) httpcIdle((uint32_t)slice);
+    return;
+  }
+
+  struct timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = slice * 1000;
+  if (select(maxFd + 1, &rd, &wr, NULL, &tv) <= 0) return;
+
+  for (size_t i = 0; i < count; i++) {
+    HttpFetch &f = *fetches[i];
+    if (!httpFetchActive(f)) continue;
+    int fd = httpFetchFd(f);
+    if (fd < 0) continue;
+    if (FD_ISSET(fd, &rd) || FD_ISSET(fd, &wr)) httpStep(f);
+  }
+}
+
+const char *httpFetchErrorName(int code) {
+  switch (code) {
+    case FETCH_ERR_DNS:       return "DNS";
+    case FETCH_ERR_CONNECT:   return "CONNECT";
+    case FETCH_ERR_SEND:      return "KIRIM";
+    case FETCH_ERR_TIMEOUT:   return "TIMEOUT";
+    case FETCH_ERR_CANCELLED: return "DIBATALKAN";
+    case FETCH_ERR_PROTOCOL:  return "PROTOKOL";
+    case FETCH_ERR_CLOSED:    return "DITUTUP SERVER";
+    case FETCH_ERR_BUSY:      return "SLOT PENUH";
+    default:                  return "HTTP";
+  }
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * ANTRIAN JOB WEB: TIPE JOB + PAPAN STATUS TANPA FREERTOS
+ * Callback AsyncTCP tidak boleh blok: rute hanya memvalidasi lalu mengantrekan
+ * job; jobTask yang menulis LittleFS / I2C. Di sini: struct yang disalin
+ * xQueueSend, slot status per id (/api/jobs) dan penggabungan bit persist.
+ * Pemanggil memegang jobMux di sekitar setiap fungsi jobBoard*; jws.ino memegang
+ * antrean FreeRTOS, test/job_queue_load_test.cpp mensimulasikan rute + jobTask.
+ */
+
+#ifndef JWS_JOB_QUEUE_H
+#define JWS_JOB_QUEUE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Payload berupa char[] tetap (bukan String) karena xQueueSend menyalin
+// struct byte-per-byte.
+#define JOB_QUEUE_LENGTH 6
+#define JOB_STATUS_SLOTS 8
+#define JOB_RESULT_LEN 128
+#define JOB_PERSIST_DRAIN_MS 1000   // BATAS TUNDA BIT PERSIST SAAT ANTRIAN PENUH
+
+// ANTREAN PENUH + 1 JOB BERJALAN HARUS MUAT DI SLOT, AGAR jobBoardOpen SELALU
+// MENEMUKAN SLOT YANG TIDAK SEDANG DIPAKAI
+static_assert(JOB_QUEUE_LENGTH + 1 < JOB_STATUS_SLOTS, "slot status job terlalu sedikit");
+
+enum JobType : uint8_t {
+  JOB_APPLY_SETTINGS,
+  JOB_SYNC_TIME,
+  JOB_PERSIST
+};
+
+#define PERSIST_BUZZER 0x01
+#define PERSIST_ALARM  0x02
+#define PERSIST_PRAYER 0x04
+#define PERSIST_MIRROR 0x08
+#define PERSIST_ADZAN  0x10
+#define PERSIST_SPLASH 0x20
+
+enum JobState : uint8_t {
+  JOB_QUEUED,
+  JOB_RUNNING,
+  JOB_DONE,
+  JOB_FAILED
+};
+
+struct SettingsPatch {
+  bool force;                  // RUTE LAMA: SIMPAN & PERBARUI WALAU NILAI SAMA
+  bool hasCity;
+  bool hasCoords;
+  bool hasMethod;
+  bool hasTimezone;
+  bool hasTune[7];
+  char cityApi[101];
+  char cityName[101];
+  char lat[21];
+  char lon[21];
+  char methodName[101];
+  int32_t methodId;
+  int32_t offset;
+  int32_t tune[7];
+};
+
+struct TimeSyncJob {
+  int32_t y, m, d, h, i, s;
+};
+
+struct Job {
+  uint32_t id;
+  JobType type;
+  unsigned long queuedAt;
+  union {
+    SettingsPatch settings;
+    TimeSyncJob time;
+  };
+};
+
+struct JobStatus {
+  uint32_t id;
+  JobType type;
+  JobState state;
+  unsigned long queuedAt;
+  uint32_t waitMs;
+  uint32_t runMs;
+  char result[JOB_RESULT_LEN];   // OBJEK JSON ATAU PESAN ERROR
+};
+
+struct JobBoard {
+  JobStatus status[JOB_STATUS_SLOTS];
+  uint32_t nextId;               // 0 = BELUM DIPAKAI (MULAI DARI 1)
+  uint8_t persistPending;        // MASK PERSIST_*
+};
+
+inline bool jobSlotBusy(const JobStatus &st) {
+  return st.id != 0 && (st.state == JOB_QUEUED || st.state == JOB_RUNNING);
+}
+
+// BERI ID (TIDAK PERNAH 0) DAN TANDAI SLOT-NYA QUEUED. SLOT = id % JOB_STATUS_SLOTS.
+// ID YANG SLOTNYA MASIH DIPAKAI JOB QUEUED/RUNNING DILEWATI: REQUEST YANG DITOLAK
+// 503 JUGA MENGHABISKAN ID, JADI TANPA INI BADAI 503 MENIMPA STATUS JOB BERJALAN
+inline uint32_t jobBoardOpen(JobBoard &b, Job &job, unsigned long nowMs) {
+  for (int tries = 0; tries < JOB_STATUS_SLOTS; tries++) {
+    if (b.nextId == 0) b.nextId = 1;
+    job.id = b.nextId++;
+    if (!jobSlotBusy(b.status[job.id % JOB_STATUS_SLOTS])) break;
+  }
+  if (b.nextId == 0) b.nextId = 1;
+
+  JobStatus &st = b.status[job.id % JOB_STATUS_SLOTS];
+  st.id = job.id;
+  st.type = job.type;
+  st.state = JOB_QUEUED;
+  st.queuedAt = nowMs;
+  st.waitMs = 0;
+  st.runMs = 0;
+  st.result[0] = '\0';
+  return job.id;
+}
+
+// ANTREAN PENUH: SLOT DIKOSONGKAN LAGI (BILA BELUM DIPAKAI ID LAIN)
+inline void jobBoardDrop(JobBoard &b, uint32_t id) {
+  JobStatus &st = b.status[id % JOB_STATUS_SLOTS];
+  if (st.id == id) st.id = 0;
+}
+
+inline void jobBoardUpdate(JobBoard &b, uint32_t id, JobState state, uint32_t waitMs, uint32_t runMs,
+                           const char *result) {
+  JobStatus &st = b.status[id % JOB_STATUS_SLOTS];
+  if (st.id != id) return;
+  st.state = state;
+  st.waitMs = waitMs;
+  st.runMs = runMs;
+  if (result != NULL) {
+    size_t n = strnlen(result, sizeof(st.result) - 1);
+    memcpy(st.result, result, n);
+    st.result[n] = '\0';
+  }
+}
+
+// NULL = ID TIDAK DIKENAL ATAU SLOT SUDAH DIPAKAI JOB YANG LEBIH BARU
+inline const JobStatus *jobBoardFind(const JobStatus *status, uint32_t id) {
+  const JobStatus &st = status[id % JOB_STATUS_SLOTS];
+  return (id != 0 && st.id == id) ? &st : NULL;
+}
+
+// SATU JOB PERSIST MENGANTRE PALING BANYAK: PERUBAHAN BERUNTUN (SLIDER VOLUME)
+// HANYA MENAMBAH BIT. true = BELUM ADA YANG MENUNGGU, PEMANGGIL MENGANTREKAN JOB
+inline bool jobBoardAddPersist(JobBoard &b, uint8_t mask) {
+  bool first = (b.persistPending == 0);
+  b.persistPending |= mask;
+  return first;
+}
+
+// DIPANGGIL jobTask: AMBIL SEMUA BIT YANG MENUNGGU
+inline uint8_t jobBoardTakePersist(JobBoard &b) {
+  uint8_t mask = b.persistPending;
+  b.persistPending = 0;
+  return mask;
+}
+
+#endif
@@ -18,11 +18,33 @@
 #include "ESPAsyncWebServer.h"
 #include "TimeLib.h"
 #include "time.h"
-#include "HTTPClient.h"
 #include "esp_task_wdt.h"
 #include "esp_wifi.h"
+#include "esp_rom_crc.h"
+#include "lwip/sockets.h"
+#include "lwip/dns.h"
+#include "esp_netif.h"
 #include "DFRobotDFPlayerMini.h"
 
+#include "solar_math.h"
+#include "bulk_schedule.h"
+#include "route_table.h"
+#include "param_schema.h"
+#include "time_format.h"
+#include "touch_math.h"
+#include "state_document.h"
+#include "trace_format.h"
+#include "clock_trigger.h"
+#include "heap_trend.h"
+#include "clock_source.h"
+#include "rtc_calibration.h"
+#include "http_client.h"
+#include "schedule_hedge.h"
+#include "dfplayer_driver.h"
+#include "wifi_reconnect.h"
+#include "splash_rle.h"
+#include "job_queue.h"
+
 #include "src/ui.h"
 #include "src/screens.h"
 #include "src/fonts.h"
@@ -41,12 +63,13 @@
 
 //#define RTC_SDA    21
 //#define RTC_SCL    22
+#define RTC_SQW_PIN -1  // ISI GPIO JIKA SQW DS3231 DISAMBUNG (OPEN-DRAIN, PERLU PULL-UP), -1 = TIMER INTERNAL
 
 #define DFPLAYER_TX 25  // ESP32 TX → RX DFPLAYER
 #define DFPLAYER_RX 32  // ESP32 RX → TX DFPLAYER
+#define DFPLAYER_BUSY_PIN -1  // ISI GPIO JIKA PIN BUSY DISAMBUNG (LOW = MEMUTAR), -1 = HANYA UART
 
 #define BUZZER_PIN 26
-#define BUZZER_CHANNEL 1
 #define BUZZER_FREQ 2000
 #define BUZZER_RESOLUTION 8
 
@@ -72,29 +95,33 @@
 #define WIFI_TASK_STACK_SIZE 3072      // EVENT-DRIVEN + RECONNECT
 #define NTP_TASK_STACK_SIZE 4096       // HANYA SINKRONISASI NTP
 #define WEB_TASK_STACK_SIZE 4096       // ASYNC WEB SERVER
-#define PRAYER_TASK_STACK_SIZE 4096    // HTTP + PARSING JSON
+#define SCHEDULE_TASK_STACK_SIZE 8192  // HTTP + PARSING JSON JADWAL
 #define RTC_TASK_STACK_SIZE 2048       // KOMUNIKASI I2C
 #define CLOCK_TASK_STACK_SIZE 2048     // INCREMENT WAKTU
 #define AUDIO_TASK_STACK_SIZE 4096     // AUDIO ADZAN
+#define TOUCH_TASK_STACK_SIZE 3072     // BACA XPT2046 + AKSI SENTUH
+#define JOB_TASK_STACK_SIZE 6144       // SIMPAN LITTLEFS + I2C RTC DARI RUTE WEB
 
 #define UI_TASK_PRIORITY 3             // TERTINGGI - RESPONSIVITAS LAYAR
 #define WIFI_TASK_PRIORITY 2           // TINGGI - STABILITAS JARINGAN
 #define NTP_TASK_PRIORITY 2            // TINGGI - SINKRONISASI WAKTU
 #define WEB_TASK_PRIORITY 1            // RENDAH - WEB SERVER LATAR
-#define PRAYER_TASK_PRIORITY 1         // RENDAH - PEMBARUAN HARIAN
+#define SCHEDULE_TASK_PRIORITY 1       // RENDAH - PEMBARUAN HARIAN
 #define RTC_TASK_PRIORITY 1            // RENDAH - SINKRONISASI CADANGAN
 #define CLOCK_TASK_PRIORITY 2          // TINGGI - AKURASI WAKTU
 #define AUDIO_TASK_PRIORITY 0          // RENDAH - AUDIO ADZAN
+#define TOUCH_TASK_PRIORITY 4          // DI ATAS UI - DIBANGUNKAN ISR
+#define JOB_TASK_PRIORITY 1            // RENDAH - PEKERJAAN WEB TERTUNDA
 
 TaskHandle_t rtcTaskHandle = NULL;
 TaskHandle_t uiTaskHandle = NULL;
 TaskHandle_t wifiTaskHandle = NULL;
 TaskHandle_t ntpTaskHandle = NULL;
 TaskHandle_t webTaskHandle = NULL;
-TaskHandle_t httpTaskHandle = NULL;
-TaskHandle_t prayerTaskHandle = NULL;
+TaskHandle_t scheduleTaskHandle = NULL;
 TaskHandle_t clockTaskHandle = NULL;
-TaskHandle_t buzzerTestTaskHandle = NULL;
+TaskHandle_t touchTaskHandle = NULL;
+TaskHandle_t jobTaskHandle = NULL;
 
 // ================================
 // SEMAPHORES & MUTEXES
@@ -107,7 +134,195 @@ SemaphoreHandle_t spiMutex;
 SemaphoreHandle_t i2cMutex;
 
 QueueHandle_t displayQueue;
-QueueHandle_t httpQueue;
+QueueHandle_t jobQueue;
+
+// ================================
+// PROFIL BOOT & DEPENDENSI INISIALISASI
+// ================================
+#define BOOT_PHASE_MAX 16
+#define BOOT_WORKER_STACK_SIZE 4096    // RTC / DFPLAYER / WIFI PARALEL
+#define BOOT_WORKER_PRIORITY 2
+#define BOOT_RTC_WAIT_MS 300           // BATAS TUNGGU JAM SEBELUM FRAME PERTAMA
+#define DFPLAYER_POWERUP_MS 600        // DFPLAYER MENOLAK PERINTAH SEBELUM INI
+
+#define BOOT_FS_READY_BIT     BIT0
+#define BOOT_RTC_READY_BIT    BIT1
+#define BOOT_AUDIO_READY_BIT  BIT2
+#define BOOT_NET_READY_BIT    BIT3
+
+struct BootPhase {
+  const char *name;
+  uint32_t startUs;
+  uint32_t durationUs;
+  uint8_t core;
+};
+
+BootPhase bootPhases[BOOT_PHASE_MAX];
+uint8_t bootPhaseCount = 0;
+uint32_t bootFirstPixelUs = 0;
+uint32_t bootFirstFrameUs = 0;
+uint32_t bootSetupDoneUs = 0;
+portMUX_TYPE bootMux = portMUX_INITIALIZER_UNLOCKED;
+EventGroupHandle_t bootEventGroup;
+
+// ================================
+// PROFIL JALUR PANAS (/api/perf)
+// ================================
+#define PERF_PROFILE 1   // 0 = PERF_SCOPE DIKOMPILASI KOSONG
+
+enum PerfPath : uint8_t {
+  PERF_CHECK_PRAYER = 0,
+  PERF_CHECK_ALARM,
+  PERF_BLINK,
+  PERF_TOUCH,
+  PERF_LOAD_PRAYER,
+  PERF_LOAD_CITY,
+  PERF_API_DATA,
+  PERF_SOLAR_DAY,
+  PERF_SOLAR_BATCH,
+  PERF_PATH_COUNT
+};
+
+constexpr const char *PERF_PATH_NAMES[PERF_PATH_COUNT] = {
+  "checkPrayerTime", "checkAlarmTime", "handleBlinking", "handleTouchPress",
+  "loadPrayerTimes", "loadCitySelection", "apiData",
+  "solarDayCompute", "solarKernelBatch"
+};
+
+struct PerfStat {
+  uint32_t count;
+  uint64_t totalCycles;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+};
+
+PerfStat perfStats[PERF_PATH_COUNT];
+portMUX_TYPE perfMux = portMUX_INITIALIZER_UNLOCKED;
+
+void perfRecord(PerfPath path, uint32_t cycles) {
+  portENTER_CRITICAL(&perfMux);
+  PerfStat &st = perfStats[path];
+  if (st.count == 0 || cycles < st.minCycles) st.minCycles = cycles;
+  if (cycles > st.maxCycles) st.maxCycles = cycles;
+  st.totalCycles += cycles;
+  st.count++;
+  portEXIT_CRITICAL(&perfMux);
+}
+
+// SIKLUS CPU DARI KONSTRUKTOR SAMPAI AKHIR SCOPE
+struct PerfScope {
+  PerfPath path;
+  uint32_t start;
+  explicit PerfScope(PerfPath p) : path(p), start(ESP.getCycleCount()) {}
+  ~PerfScope() { perfRecord(path, ESP.getCycleCount() - start); }
+};
+
+#if PERF_PROFILE
+#define PERF_SCOPE(path) PerfScope perfScope_(path)
+#else
+#define PERF_SCOPE(path) do {} while (0)
+#endif
+
+// ================================
+// REKAMAN INPUT EKSTERNAL (/api/trace)
+// ================================
+// Ring buffer RAM berisi input yang dikonsumsi firmware (format & cakupan di
+// trace_format.h), diputar ulang di host oleh test/trace_replay.cpp.
+#define TRACE_ENABLED 1
+#define TRACE_CAPACITY 512              // 8 KB RAM
+#define TRACE_TICK_CHECKPOINT_S 600     // DETIK NORMAL (+1) DIREKAM TIAP 10 MENIT SAJA
+
+TraceRecord traceRing[TRACE_CAPACITY];
+uint16_t traceHead = 0;
+uint16_t traceCount = 0;
+uint32_t traceDropped = 0;
+portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+
+void traceRecord(TraceType type, uint8_t flags, uint16_t arg, int32_t value, uint32_t durUs = 0) {
+#if TRACE_ENABLED
+  uint32_t ms = millis();
+  portENTER_CRITICAL(&traceMux);
+  TraceRecord &r = traceRing[traceHead];
+  r.ms = ms;
+  r.type = type;
+  r.flags = flags;
+  r.arg = arg;
+  r.value = value;
+  r.durUs = durUs;
+  traceHead = (traceHead + 1) % TRACE_CAPACITY;
+  if (traceCount < TRACE_CAPACITY) traceCount++;
+  else traceDropped++;
+  portEXIT_CRITICAL(&traceMux);
+#endif
+}
+
+// DETIK BERURUTAN BISA DIREKONSTRUKSI REPLAYER; HANYA LOMPATAN & CHECKPOINT DISIMPAN
+void traceClockTick(time_t t) {
+  static time_t lastTick = 0;
+  static time_t lastCheckpoint = 0;
+  bool jump = (t != lastTick + 1);
+  if (jump || t - lastCheckpoint >= TRACE_TICK_CHECKPOINT_S) {
+    traceRecord(TRACE_TICK, jump ? TRACE_F_JUMP : 0, 0, (int32_t)t);
+    lastCheckpoint = t;
+  }
+  lastTick = t;
+}
+
+// ================================
+// TREN HEAP JANGKA PANJANG
+// ================================
+// SAMPEL PER JAM & ANALISIS DI heap_trend.h (DIUJI SETAHUN VIRTUAL OLEH test/heap_soak.cpp)
+HeapTrend heapTrend = {};
+portMUX_TYPE heapTrendMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ================================
+// SNAPSHOT LAYAR BOOT (RLE RGB565, FORMAT DI splash_rle.h)
+// ================================
+#define SPLASH_FILE "/splash.rle"
+#define SPLASH_TMP_FILE "/splash.tmp"
+#define SPLASH_IO_CHUNK 512
+#define SPLASH_RAM_CHUNK 2048          // HASIL ENCODE DI RAM, DIALOKASI PER BLOK
+#define SPLASH_RAM_CHUNKS (SPLASH_MAX_BYTES / SPLASH_RAM_CHUNK)
+
+SplashEncoder splashEncoder;
+// DIISI uiTask SAAT CAPTURE, DITULIS KE FLASH LALU DIBEBASKAN OLEH jobTask.
+// SELAMA splashWritePending, uiTask TIDAK MENYENTUH BLOK-BLOK INI.
+uint8_t *splashChunks[SPLASH_RAM_CHUNKS];
+volatile bool splashWritePending = false;
+volatile bool splashCaptureDue = false;
+
+// KELUARAN ENCODER: BLOK RAM splashChunks, DIALOKASI SAAT PERTAMA DIISI
+struct SplashChunkSink {
+  bool put(const uint8_t *data, size_t len, uint32_t offset) {
+    while (len > 0) {
+      uint32_t idx = offset / SPLASH_RAM_CHUNK;
+      uint32_t pos = offset % SPLASH_RAM_CHUNK;
+      if (splashChunks[idx] == NULL) {
+        splashChunks[idx] = (uint8_t *)malloc(SPLASH_RAM_CHUNK);
+        if (splashChunks[idx] == NULL) return false;
+      }
+
+      size_t n = min(len, (size_t)(SPLASH_RAM_CHUNK - pos));
+      memcpy(splashChunks[idx] + pos, data, n);
+      offset += n;
+      data += n;
+      len -= n;
+    }
+    return true;
+  }
+};
+
+bool backlightOn = false;
+
+// ================================
+// DOKUMEN STATE WEB (/api/v2/state)
+// ================================
+#define STATE_DOC_SIZE 2048
+
+volatile uint32_t stateVersion = 1;    // NAIK SETIAP KONFIGURASI DISIMPAN
+uint32_t stateBootId = 0;              // ETAG LAMA TIDAK BERLAKU SETELAH REBOOT
+uint32_t stateCacheVersion = 0;
+String stateCacheBody;
 
 // ================================
 // OBJEK GLOBAL
@@ -118,11 +333,30 @@ static uint8_t buf[SCREEN_WIDTH * 10];
 
 TFT_eSPI tft = TFT_eSPI();
 SPIClass touchSPI = SPIClass(VSPI);
-XPT2046_Touchscreen touch(TOUCH_CS, TOUCH_IRQ);
+XPT2046_Touchscreen touch(TOUCH_CS);  // IRQ DITANGANI touchISR(), BUKAN LIBRARY
 
 RTC_DS3231 rtc;
 bool rtcAvailable = false;
 
+// DETAK 1 Hz DARI SQW DS3231 (LIHAT RTC_SQW_PIN); TIMEOUT & BATAS TEPI HILANG DI clock_source.h
+#define RTC_SQW_DEBOUNCE_US 500000
+volatile bool rtcSqwActive = false;
+volatile uint32_t rtcSqwEdges = 0;
+uint32_t rtcSqwMissedTotal = 0;
+
+// KALIBRASI AGING DS3231 DARI SELISIH RTC VS NTP
+#define DS3231_ADDR              0x68
+#define DS3231_REG_SECONDS       0x00
+#define DS3231_REG_CONTROL       0x0E
+#define DS3231_REG_AGING         0x10
+#define DS3231_CONV_BIT          0x20
+#define RTC_AGING_FILE           "/rtc_aging.txt"
+#define RTC_OFFSET_POLL_MS       1200    // TEPI REGISTER DETIK PASTI DATANG DALAM WAKTU INI
+// KONSTANTA & ATURAN PENGENDALI AGING DI rtc_calibration.h
+
+RtcCalibration rtcCal = {0, 0.0f, false, 0, 0, 0};
+volatile uint32_t ntpSyncIntervalS = NTP_INTERVAL_MIN_S;
+
 // ================================
 // KONFIGURASI AP DEFAULT
 // ================================
@@ -198,6 +432,17 @@ struct MethodConfig {
   String methodName;
 };
 
+// SLOT POLA BUZZER: 7 WAKTU + ALARM
+#define BUZZER_SLOT_IMSAK   0
+#define BUZZER_SLOT_SUBUH   1
+#define BUZZER_SLOT_TERBIT  2
+#define BUZZER_SLOT_ZUHUR   3
+#define BUZZER_SLOT_ASHAR   4
+#define BUZZER_SLOT_MAGHRIB 5
+#define BUZZER_SLOT_ISYA    6
+#define BUZZER_SLOT_ALARM   7
+#define BUZZER_SLOT_COUNT   8
+
 struct BuzzerConfig {
   bool imsakEnabled;
   bool subuhEnabled;
@@ -207,8 +452,229 @@ struct BuzzerConfig {
   bool maghribEnabled;
   bool isyaEnabled;
   int volume;
+  uint8_t pattern[BUZZER_SLOT_COUNT];
+};
+
+// ================================
+// TABEL WAKTU SHALAT
+// ================================
+// URUTAN SAMA DENGAN BUZZER_SLOT_* DAN URUTAN LABEL DI LAYAR
+enum Prayer : uint8_t {
+  PRAYER_IMSAK = 0,
+  PRAYER_SUBUH,
+  PRAYER_TERBIT,
+  PRAYER_ZUHUR,
+  PRAYER_ASHAR,
+  PRAYER_MAGHRIB,
+  PRAYER_ISYA,
+  PRAYER_COUNT,
+  PRAYER_NONE = 0xFF
+};
+
+struct PrayerInfo {
+  const char *key;             // NAMA DI API WEB & FILE STATUS
+  const char *displayName;     // UNTUK LOG SERIAL
+  String PrayerConfig::*time;
+  bool BuzzerConfig::*enabled;
+  lv_obj_t *objects_t::*label;
+  uint8_t buzzerSlot;
+  uint8_t adzanTrack;          // 0 = TANPA ADZAN (BUZZER + KEDIP SAJA)
+};
+
+constexpr PrayerInfo PRAYER_INFO[PRAYER_COUNT] = {
+  {"imsak",   "IMSAK",   &PrayerConfig::imsakTime,   &BuzzerConfig::imsakEnabled,   &objects_t::imsak_time,   BUZZER_SLOT_IMSAK,   0},
+  {"subuh",   "SUBUH",   &PrayerConfig::subuhTime,   &BuzzerConfig::subuhEnabled,   &objects_t::subuh_time,   BUZZER_SLOT_SUBUH,   1},
+  {"terbit",  "TERBIT",  &PrayerConfig::terbitTime,  &BuzzerConfig::terbitEnabled,  &objects_t::terbit_time,  BUZZER_SLOT_TERBIT,  0},
+  {"zuhur",   "ZUHUR",   &PrayerConfig::zuhurTime,   &BuzzerConfig::zuhurEnabled,   &objects_t::zuhur_time,   BUZZER_SLOT_ZUHUR,   2},
+  {"ashar",   "ASHAR",   &PrayerConfig::asharTime,   &BuzzerConfig::asharEnabled,   &objects_t::ashar_time,   BUZZER_SLOT_ASHAR,   3},
+  {"maghrib", "MAGHRIB", &PrayerConfig::maghribTime, &BuzzerConfig::maghribEnabled, &objects_t::maghrib_time, BUZZER_SLOT_MAGHRIB, 4},
+  {"isya",    "ISYA",    &PrayerConfig::isyaTime,    &BuzzerConfig::isyaEnabled,    &objects_t::isya_time,    BUZZER_SLOT_ISYA,    5}
+};
+static_assert(PRAYER_TOUCH_ZONE_COUNT == PRAYER_COUNT, "PRAYER_TOUCH_ZONES HARUS SATU PER WAKTU SHALAT");
+static_assert(STATE_DOC_TIMES == PRAYER_COUNT && STATE_DOC_PATTERNS == BUZZER_SLOT_COUNT,
+              "StateDocFields HARUS MENGIKUTI Prayer DAN BUZZER_SLOT_*");
+
+constexpr bool prayerSlotsMatch(int i = 0) {
+  return i >= PRAYER_COUNT || (PRAYER_INFO[i].buzzerSlot == i && prayerSlotsMatch(i + 1));
+}
+static_assert(prayerSlotsMatch(), "URUTAN PRAYER_INFO HARUS SAMA DENGAN BUZZER_SLOT_*");
+static_assert(BUZZER_SLOT_ALARM == PRAYER_COUNT, "SLOT ALARM HARUS SETELAH SEMUA WAKTU SHALAT");
+
+inline bool isAdzanPrayer(Prayer prayer) {
+  return prayer < PRAYER_COUNT && PRAYER_INFO[prayer].adzanTrack != 0;
+}
+
+inline const char *prayerKey(Prayer prayer) {
+  return prayer < PRAYER_COUNT ? PRAYER_INFO[prayer].key : "";
+}
+
+// HANYA UNTUK INPUT WEB & FILE, BUKAN JALUR 1 Hz / 20 Hz
+Prayer prayerFromName(const char *name) {
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    if (strcasecmp(name, PRAYER_INFO[i].key) == 0) return (Prayer)i;
+  }
+  return PRAYER_NONE;
+}
+
+// parseMinuteOfDay(const char *) ADA DI time_format.h
+int parseMinuteOfDay(const String &hhmm) {
+  return parseMinuteOfDay(hhmm.c_str());
+}
+
+// ================================
+// JADWAL HARI INI / BESOK
+// ================================
+// prayerConfig.*Time = BUFFER HARI INI. BUFFER BESOK DIISI scheduleTask SETELAH
+// ISYA, LALU DITUKAR clockTickTask TEPAT SAAT HARI BERGANTI - TANPA JARINGAN.
+// HARI = HARI EPOCH LOKAL (currentTime / 86400).
+#define SCHEDULE_PREFETCH_AFTER_ISYA_MIN 30            // JAM SEPI SETELAH ISYA
+#define SCHEDULE_PREFETCH_DEFAULT_MIN    (20 * 60)     // BILA ISYA BELUM DIKETAHUI
+#define SCHEDULE_LOCAL_FALLBACK_MIN      (23 * 60 + 30) // HITUNG LOKAL BILA API BELUM BERHASIL
+#define SCHEDULE_RETRY_MIN_S             60
+#define SCHEDULE_RETRY_MAX_S             1800
+
+enum ScheduleSource : uint8_t {
+  SCHED_NONE = 0,
+  SCHED_API,
+  SCHED_LOCAL
+};
+
+struct DaySchedule {
+  int32_t day;
+  ScheduleSource source;
+  char times[PRAYER_COUNT][6];   // URUTAN ENUM Prayer, "JJ:MM"
+};
+
+DaySchedule tomorrowSchedule = { -1, SCHED_NONE, {} };
+portMUX_TYPE scheduleMux = portMUX_INITIALIZER_UNLOCKED;
+volatile int32_t scheduleDay = -1;   // HARI MILIK prayerConfig.*Time, -1 = TIDAK DIKETAHUI
+
+// SALINAN MENIT JADWAL AKTIF UNTUK checkPrayerTime (uiTask), DIJAGA scheduleMux.
+// String prayerConfig DITULIS TUGAS LAIN; uiTask TIDAK MEMBACANYA TANPA KUNCI.
+int16_t activeMinutes[PRAYER_COUNT] = { -1, -1, -1, -1, -1, -1, -1 };
+
+void schedulePublish(const char (*times)[6]) {
+  int16_t minutes[PRAYER_COUNT];
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) minutes[i] = (int16_t)parseMinuteOfDay(times[i]);
+
+  portENTER_CRITICAL(&scheduleMux);
+  memcpy(activeMinutes, minutes, sizeof(activeMinutes));
+  portEXIT_CRITICAL(&scheduleMux);
+
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) traceRecord(TRACE_SCHEDULE, 0, i, minutes[i]);
+}
+
+inline const char *scheduleSourceName(ScheduleSource source) {
+  switch (source) {
+    case SCHED_API:   return "api";
+    case SCHED_LOCAL: return "local";
+    default:          return "none";
+  }
+}
+
+// ================================
+// LAYANAN JADWAL: SATU TUGAS, SATU STATE MACHINE
+// ================================
+// PERMINTAAN MASUK LEWAT KOTAK SURAT SATU SLOT: PERMINTAAN BARU MENIMPA YANG
+// BELUM DIAMBIL DAN MENAIKKAN GENERASI, SEHINGGA HASIL HTTP GENERASI LAMA
+// DIBUANG SEBELUM MENYENTUH prayerConfig ATAU FLASH.
+#define SCHEDULE_FETCH_ATTEMPTS 3          // PER PERMINTAAN
+#define SCHEDULE_RETRY_BASE_MS 2000        // 2 S, 4 S, ... + JITTER
+#define SCHEDULE_RETRY_JITTER_MS 1000
+#define SCHEDULE_WAIT_TIME_MS 60000        // BATAS MENUNGGU WIFI + WAKTU VALID
+#define SCHEDULE_REQUEST_DEADLINE_MS 120000 // SELURUH PERMINTAAN TERMASUK MENUNGGU & RETRY
+#define SCHEDULE_API_HOST "api.aladhan.com" // BISA DIARAHKAN KE SERVER LOKAL UNTUK UKUR LATENSI
+#define SCHEDULE_API_PORT 80
+#define SCHEDULE_LOCAL_PROVIDER 1          // 0 = TANPA CADANGAN MESIN LOKAL
+
+enum ScheduleState : uint8_t {
+  SCHEDULE_IDLE = 0,
+  SCHEDULE_WAIT_TIME,
+  SCHEDULE_FETCHING,
+  SCHEDULE_PARSING,
+  SCHEDULE_PERSISTING,
+  SCHEDULE_STATE_COUNT
+};
+
+const char *const SCHEDULE_STATE_NAMES[SCHEDULE_STATE_COUNT] = {
+  "idle", "waiting_time", "fetching", "parsing", "persisting"
+};
+
+struct ScheduleRequest {
+  char lat[24];
+  char lon[24];
+  int32_t day;                // HARI EPOCH LOKAL, -1 = HARI INI SAAT DIAMBIL
+  uint32_t generation;
+};
+
+struct ScheduleStateStat {
+  uint32_t count;
+  uint32_t totalMs;
+  uint32_t maxMs;
+};
+
+struct ScheduleService {
+  ScheduleState state;
+  uint32_t stateSinceMs;
+  uint32_t generation;        // GENERASI PERMINTAAN TERBARU
+  bool pending;
+  ScheduleRequest mailbox;
+  ScheduleStateStat stats[SCHEDULE_STATE_COUNT];
+  uint32_t requests;
+  uint32_t coalesced;         // DITIMPA SEBELUM DIAMBIL
+  uint32_t stale;             // DIBUANG KARENA GENERASI BARU
+  uint32_t completed;
+  uint32_t failed;
+  uint32_t retries;
+  int16_t lastHttpCode;
+  ScheduleStateStat fetchCold;  // KONEKSI BARU (DNS + CONNECT)
+  ScheduleStateStat fetchWarm;  // KONEKSI KEEP-ALIVE DIPAKAI ULANG
+  bool lastWarm;
+  bool lastDnsCached;
+  uint16_t lastDnsMs;
+  uint16_t lastConnectMs;
+  uint16_t lastTtfbMs;
+  uint16_t lastTotalMs;
+};
+
+ScheduleService scheduleSvc = {};
+portMUX_TYPE scheduleSvcMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ================================
+// PENYEDIA JADWAL & HEDGING
+// ================================
+// PENYEDIA HTTP (ALADHAN + MIRROR SENDIRI BERFORMAT SAMA) DIURUTKAN DARI
+// HISTOGRAM LATENSI & GALAT MASING-MASING. PENYEDIA KEDUA DIBALAP BILA YANG
+// PERTAMA BELUM MENJAWAB DALAM p90-NYA. MESIN LOKAL (computeLocalSchedule)
+// HANYA DIPAKAI UNTUK JADWAL BESOK SETELAH SEMUA PENYEDIA HTTP GAGAL.
+// STATISTIK, URUTAN & LOOP BALAPAN ADA DI schedule_hedge.h (JUGA
+// SCHEDULE_HTTP_TIMEOUT_MS PER PERCOBAAN).
+#define SCHEDULE_MIRROR_FILE "/schedule_mirror.txt"
+#define SCHEDULE_PROVIDER_MIRROR 1         // INDEKS scheduleProviders
+
+struct ScheduleProvider {
+  const char *name;
+  char host[48];               // KOSONG = NONAKTIF
+  uint16_t port;
+  ProviderStats stats;
+};
+
+// DIJAGA scheduleSvcMux
+ScheduleProvider scheduleProviders[SCHEDULE_HTTP_PROVIDERS] = {
+  { "aladhan", SCHEDULE_API_HOST, SCHEDULE_API_PORT, {} },
+  { "mirror", "", 80, {} }
 };
 
+struct ScheduleHedgeStats {
+  uint32_t races;
+  uint32_t hedges;             // PENYEDIA KEDUA BENAR-BENAR DIMULAI
+  uint32_t hedgeWins;          // ... DAN MENJAWAB LEBIH DULU
+  uint32_t localFallbacks;
+  int8_t lastProvider;         // -1 = BELUM ADA / LOKAL
+};
+
+ScheduleHedgeStats scheduleHedge = { 0, 0, 0, 0, -1 };
+
 struct AlarmConfig {
   char alarmTime[6]; // FORMAT "JJ:MM"
   bool alarmEnabled;
@@ -219,6 +685,7 @@ struct AlarmConfig {
 // ================================
 struct AlarmState {
   bool isRinging;
+  volatile bool stopPending;   // DIHENTIKAN touchTask, LAYAR BELUM DIPULIHKAN uiTask
   unsigned long lastToggle;
   bool clockVisible;
   bool savedBlinkState;
@@ -227,6 +694,7 @@ struct AlarmState {
 
 AlarmState alarmState = {
   .isRinging = false,
+  .stopPending = false,
   .lastToggle = 0,
   .clockVisible = true,
   .savedBlinkState = false,
@@ -256,19 +724,28 @@ SemaphoreHandle_t countdownMutex = NULL;
 
 struct AdzanState {
   bool isPlaying;
-  String currentPrayer;
+  Prayer currentPrayer;
   time_t startTime;
   time_t deadlineTime;
   bool canTouch;
 };
 
-AdzanState adzanState = {false, "", 0, 0, false};
+AdzanState adzanState = {false, PRAYER_NONE, 0, 0, false};
 SemaphoreHandle_t audioMutex = NULL;
 TaskHandle_t audioTaskHandle = NULL;
 DFRobotDFPlayerMini dfPlayer;
 HardwareSerial dfSerial(2);
 bool dfPlayerAvailable = false;
 
+// ================================
+// DRIVER DFPLAYER - EVENT DRIVEN (FRAME & KEPUTUSAN DI dfplayer_driver.h)
+// ================================
+AudioPlayback audioPlayback = {false, false, false, {0, NULL}, 0, 0, 0};
+QueueHandle_t audioJobQueue = NULL;
+DfParser dfParser = {};                  // HANYA DIPAKAI dfOnReceive (TASK EVENT UART)
+volatile uint16_t dfErrorCode = 0;
+volatile uint8_t dfPlayStatus = 0;
+
 WiFiConfig wifiConfig;
 TimeConfig timeConfig;
 PrayerConfig prayerConfig;
@@ -277,7 +754,8 @@ int timezoneOffset = 7;
 
 BuzzerConfig buzzerConfig = {
   false, false, false, false, false, false, false,
-  50
+  50,
+  { 0, 0, 0, 0, 0, 0, 0, 3 }   // BEEP UNTUK SHALAT, ALARM UNTUK ALARM
 };
 
 AlarmConfig alarmConfig = {
@@ -285,9 +763,20 @@ AlarmConfig alarmConfig = {
   false
 };
 
-volatile bool needPrayerUpdate = false;
-String pendingPrayerLat = "";
-String pendingPrayerLon = "";
+// BIT i = BUZZER WAKTU SHALAT KE-i AKTIF (URUTAN PRAYER_INFO)
+uint8_t buzzerEnabledMask() {
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    if (buzzerConfig.*(PRAYER_INFO[i].enabled)) mask |= (1 << i);
+  }
+  return mask;
+}
+
+// KONFIGURASI YANG MENENTUKAN PEMICU 1 Hz, UNTUK PEMUTAR ULANG TRACE
+void traceConfig() {
+  uint16_t arg = buzzerEnabledMask() | (alarmConfig.alarmEnabled ? TRACE_CONFIG_ALARM : 0);
+  traceRecord(TRACE_CONFIG, 0, arg, parseMinuteOfDay(alarmConfig.alarmTime));
+}
 
 unsigned long lastWiFiCheck = 0;
 const unsigned long WIFI_CHECK_INTERVAL = 5000;
@@ -297,6 +786,20 @@ unsigned long wifiFailedTime = 0;
 int wifiRetryCount = 0;
 unsigned long wifiDisconnectedTime = 0;
 
+// ================================
+// CACHE LINK WIFI (FAST RECONNECT, TAHAP DI wifi_reconnect.h)
+// ================================
+// DITULIS EVENT GOT_IP (TASK EVENT WIFI), DIBACA wifiTask: AKSES LEWAT
+// getWiFiLinkSnapshot / publishWiFiLink DI BAWAH wifiLinkMux
+WiFiLinkInfo wifiLinkCache = {};
+volatile bool wifiLinkDirty = false;
+portMUX_TYPE wifiLinkMux = portMUX_INITIALIZER_UNLOCKED;
+WiFiLadder wifiLadder = { WIFI_STAGE_DIRECTED, WIFI_STAGE_FULL };
+
+WiFiReconnectStats wifiReconnectStats = {};
+unsigned long wifiReconnectStart = 0;
+portMUX_TYPE wifiStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
 bool fastReconnectMode = false;
 unsigned long lastFastScan = 0;
 const unsigned long FAST_SCAN_INTERVAL = 3000;
@@ -314,12 +817,10 @@ struct DisplayUpdate {
 };
 
 // ================================
-// STRUKTUR PERMINTAAN HTTP
+// ANTRIAN JOB WEB (TIPE & PAPAN STATUS DI job_queue.h)
 // ================================
-struct HTTPRequest {
-  String latitude;
-  String longitude;
-};
+JobBoard jobBoard = {};           // DIJAGA jobMux
+portMUX_TYPE jobMux = portMUX_INITIALIZER_UNLOCKED;
 
 // ================================
 // OBJEK JARINGAN
@@ -329,10 +830,65 @@ AsyncWebServer server(80);
 // ================================
 // VARIABEL SENTUHAN
 // ================================
+// SLOT TITIK SENTUH (FORMAT DI touch_math.h): DITULIS touchTask, DIBACA my_touchpad_read.
+#define TOUCH_TRACK_INTERVAL   20   // ms - INTERVAL BACA SELAMA JARI MENEMPEL
+#define TOUCH_MIN_PRESSURE     200
+#define TOUCH_SAMPLE_SPACING   4    // ms - JARAK SAMPEL SAAT JARI BARU MENEMPEL (LIBRARY CACHE 3 ms)
+#define TOUCH_CAL_TIMEOUT      20000
+#define TOUCH_CAL_TASK_STACK_SIZE 4096
+
+volatile uint32_t touchSlot = 0;
 bool touchPressed = false;
-int16_t lastX = 0;
-int16_t lastY = 0;
-unsigned long lastTouchTime = 0;
+
+// LATENSI SENTUH: ISR -> AKSI PERTAMA (STOP ALARM / ADZAN / LVGL)
+#define TOUCH_LATENCY_LOG 0   // 1 = CETAK LATENSI TIAP SENTUHAN KE SERIAL
+volatile uint32_t touchIrqMicros = 0;
+struct TouchStats {
+  uint32_t lastLatencyUs;
+  uint32_t maxLatencyUs;
+  uint32_t pressCount;
+};
+TouchStats touchStats = {0, 0, 0};
+portMUX_TYPE touchStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// MATRIKS AFFINE (touch_math.h); DEFAULT SETARA map() DENGAN TS_MIN/TS_MAX
+TouchCalibration touchCal = {
+  ((int32_t)SCREEN_WIDTH << 16) / (TS_MAX_X - TS_MIN_X), 0,
+  -(((int32_t)SCREEN_WIDTH << 16) / (TS_MAX_X - TS_MIN_X)) * TS_MIN_X,
+  0, ((int32_t)SCREEN_HEIGHT << 16) / (TS_MAX_Y - TS_MIN_Y),
+  -(((int32_t)SCREEN_HEIGHT << 16) / (TS_MAX_Y - TS_MIN_Y)) * TS_MIN_Y,
+  false
+};
+// DITULIS touchCalibrationTask / BOOT, DIBACA touchTask & WEB: ENAM WORD TIDAK
+// ATOMIK BERSAMA, JADI SELALU DISALIN UTUH DI BAWAH touchCalMux
+portMUX_TYPE touchCalMux = portMUX_INITIALIZER_UNLOCKED;
+
+TouchCalibration touchCalGet() {
+  portENTER_CRITICAL(&touchCalMux);
+  TouchCalibration cal = touchCal;
+  portEXIT_CRITICAL(&touchCalMux);
+  return cal;
+}
+
+void touchCalSet(const TouchCalibration &cal) {
+  portENTER_CRITICAL(&touchCalMux);
+  touchCal = cal;
+  portEXIT_CRITICAL(&touchCalMux);
+}
+
+// FILTER RAW MEDIAN-3 + IIR (touch_math.h), HANYA DIPAKAI touchTask
+TouchFilter touchFilter;
+
+// STATUS KALIBRASI (DIBACA /gettouchcalibration)
+struct TouchCalState {
+  volatile bool running;
+  volatile uint8_t point;
+  float errorPx;
+  const char *status;   // idle / running / done / failed
+};
+TouchCalState touchCalState = {false, 0, 0.0f, "idle"};
+TaskHandle_t touchCalTaskHandle = NULL;
+QueueHandle_t touchCalQueue = NULL;
 
 // ================================
 // VARIABEL STATUS
@@ -360,7 +916,7 @@ struct BlinkState {
   unsigned long blinkStartTime;
   unsigned long lastBlinkToggle;
   bool currentVisible;
-  String activePrayer;
+  Prayer activePrayer;
 };
 
 BlinkState blinkState = {
@@ -368,7 +924,7 @@ BlinkState blinkState = {
   .blinkStartTime = 0,
   .lastBlinkToggle = 0,
   .currentVisible = true,
-  .activePrayer = ""
+  .activePrayer = PRAYER_NONE
 };
 
 const unsigned long BLINK_DURATION = 60000;
@@ -379,6 +935,37 @@ const unsigned long BLINK_INTERVAL = 500;
 // ================================
 static int lastBlinkMinute = -1;
 
+// ================================
+// STATUS PANAS DI RTC SLOW MEMORY
+// ================================
+// BERTAHAN SAAT RESET LUNAK (WDT, PANIC, ESP.restart), HILANG SAAT LISTRIK
+// PADAM. LITTLEFS HANYA DIBACA SAAT BOOT DINGIN.
+#define HOT_STATE_MAGIC   0x544F484AUL   // "JHOT"
+#define HOT_STATE_VERSION 1
+
+struct HotState {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  uint8_t adzanPrayer;         // Prayer
+  uint8_t adzanCanTouch;
+  uint8_t alarmRinging;
+  uint8_t reserved;
+  int16_t lastBlinkMinute;
+  int16_t lastAlarmMinute;
+  int64_t adzanStart;
+  int64_t adzanDeadline;
+  int64_t timeAnchor;          // currentTime TERAKHIR DARI TUGAS JAM
+  uint32_t scheduleCrc;        // CRC JADWAL YANG TERAKHIR ADA DI FLASH
+  uint32_t crc;                // HARUS FIELD TERAKHIR
+};
+static_assert(sizeof(HotState) == 48, "HotState harus 48 byte");
+
+RTC_NOINIT_ATTR HotState hotState;
+portMUX_TYPE hotStateMux = portMUX_INITIALIZER_UNLOCKED;
+bool hotStateRestored = false;           // BOOT INI MELANJUTKAN RESET LUNAK
+volatile uint32_t hotStateFlashSkipped = 0;
+
 // ================================
 // PERLINDUNGAN RESTART WIFI
 // ================================
@@ -491,26 +1078,52 @@ void startCountdown(String reason, String message, int seconds);
 void stopCountdown();
 int getRemainingSeconds();
 
+bool initBuzzer();
+void buzzerPlay(uint8_t pattern, unsigned long maxDuration, int volume);
+void buzzerStop();
 void checkPrayerTime();
-void startBlinking(String prayerName);
+void startBlinking(Prayer prayer);
 void stopBlinking();
 void handleBlinking();
 
-void getPrayerTimesByCoordinates(String lat, String lon);
+bool scheduleRequest(const String &lat, const String &lon, int32_t day);
+void scheduleStoreTomorrow(const DaySchedule &next);
+void scheduleInvalidateTomorrow();
+bool scheduleSwapIn(int32_t today);
+void scheduleMaintain(time_t now_t);
+bool isValidCoordinate(const String &value, float limit);
+void requestPrayerUpdate(const String &lat, const String &lon);
+uint32_t enqueueJob(Job &job);
+void requestPersist(uint8_t mask);
+void queuePersist(uint8_t mask);
+void saveSplashSnapshot();
+void jobTask(void *parameter);
+void markStateChanged();
 void savePrayerTimes();
 void loadPrayerTimes();
 
 void saveWiFiCredentials();
 void loadWiFiCredentials();
+void saveWiFiLinkCache();
+void loadWiFiLinkCache();
 void saveAPCredentials();
 void setupWiFiEvents();
 
 void saveTimezoneConfig();
 void loadTimezoneConfig();
+void saveScheduleMirror();
+void loadScheduleMirror();
 void saveBuzzerConfig();
 void loadBuzzerConfig();
 void saveAdzanState();
 void loadAdzanState();
+bool hotStateInit();
+void hotStateSave();
+void hotStateSetTimeAnchor(time_t t);
+uint32_t hotStateScheduleCrc();
+void hotStateSetScheduleCrc(uint32_t crc);
+void schedulePublishConfig();
+uint32_t scheduleChecksum();
 int getAdzanRemainingSeconds();
 
 void saveAlarmConfig();
@@ -522,10 +1135,13 @@ void saveCitySelection();
 void loadCitySelection();
 void saveMethodSelection();
 void loadMethodSelection();
+void saveTouchCalibration();
+void loadTouchCalibration();
 
 bool initRTC();
 bool isRTCValid();
 bool isRTCTimeValid(DateTime dt);
+bool initRtcSqw();
 void saveTimeToRTC();
 
 void setupServerRoutes();
@@ -536,25 +1152,35 @@ void createDefaultConfigFiles();
 void printStackReport();
 
 void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+void captureSplashSnapshot();
+bool drawSplashSnapshot();
 void my_touchpad_read(lv_indev_t *indev_driver, lv_indev_data_t *data);
 
 void uiTask(void *parameter);
 void wifiTask(void *parameter);
 void ntpTask(void *parameter);
 void webTask(void *parameter);
-void prayerTask(void *parameter);
+void scheduleTask(void *parameter);
 void rtcSyncTask(void *parameter);
 void clockTickTask(void *parameter);
 void audioTask(void *parameter);
+void touchTask(void *parameter);
+void touchCalibrationTask(void *parameter);
 
 void restartWiFiTask(void *parameter);
 void restartAPTask(void *parameter);
 void internetCheckTask(void *parameter);
 
 bool initDFPlayer();
+void dfOnReceive();
+#if DFPLAYER_BUSY_PIN >= 0
+void dfBusyISR();
+#endif
 void setDFPlayerVolume(int vol);
-void playDFPlayerAdzan(String prayerName);
-bool isDFPlayerPlaying();
+bool audioPlay(uint16_t track, AudioDoneCallback onDone);
+bool audioQueue(uint16_t track, AudioDoneCallback onDone);
+void audioStop();
+void onAdzanAudioDone(uint16_t track, AudioResult result);
 
 // ============================================
 // FUNGSI LAYAR DAN ANTARMUKA
@@ -624,39 +1250,34 @@ void updateTimeDisplay() {
 }
 
 void updatePrayerDisplay() {
-  if (objects.imsak_time) lv_label_set_text(objects.imsak_time, prayerConfig.imsakTime.c_str());
-  if (objects.subuh_time) lv_label_set_text(objects.subuh_time, prayerConfig.subuhTime.c_str());
-  if (objects.terbit_time) lv_label_set_text(objects.terbit_time, prayerConfig.terbitTime.c_str());
-  if (objects.zuhur_time) lv_label_set_text(objects.zuhur_time, prayerConfig.zuhurTime.c_str());
-  if (objects.ashar_time) lv_label_set_text(objects.ashar_time, prayerConfig.asharTime.c_str());
-  if (objects.maghrib_time) lv_label_set_text(objects.maghrib_time, prayerConfig.maghribTime.c_str());
-  if (objects.isya_time) lv_label_set_text(objects.isya_time, prayerConfig.isyaTime.c_str());
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    lv_obj_t *label = objects.*(PRAYER_INFO[i].label);
+    if (label) lv_label_set_text(label, (prayerConfig.*(PRAYER_INFO[i].time)).c_str());
+  }
+}
+
+// DIPANGGIL DENGAN displayMutex DIPEGANG
+void setPrayerLabelsHidden(bool hidden) {
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    lv_obj_t *label = objects.*(PRAYER_INFO[i].label);
+    if (!label) continue;
+    if (hidden) lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
+  }
 }
 
 void hideAllUIElements() {
   if (objects.time_now) lv_obj_add_flag(objects.time_now, LV_OBJ_FLAG_HIDDEN);
   if (objects.date_now) lv_obj_add_flag(objects.date_now, LV_OBJ_FLAG_HIDDEN);
   if (objects.city_time) lv_obj_add_flag(objects.city_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.imsak_time) lv_obj_add_flag(objects.imsak_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.subuh_time) lv_obj_add_flag(objects.subuh_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.terbit_time) lv_obj_add_flag(objects.terbit_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.zuhur_time) lv_obj_add_flag(objects.zuhur_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.ashar_time) lv_obj_add_flag(objects.ashar_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.maghrib_time) lv_obj_add_flag(objects.maghrib_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.isya_time) lv_obj_add_flag(objects.isya_time, LV_OBJ_FLAG_HIDDEN);
+  setPrayerLabelsHidden(true);
 }
 
 void showAllUIElements() {
   if (objects.time_now) lv_obj_clear_flag(objects.time_now, LV_OBJ_FLAG_HIDDEN);
   if (objects.date_now) lv_obj_clear_flag(objects.date_now, LV_OBJ_FLAG_HIDDEN);
   if (objects.city_time) lv_obj_clear_flag(objects.city_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.imsak_time) lv_obj_clear_flag(objects.imsak_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.subuh_time) lv_obj_clear_flag(objects.subuh_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.terbit_time) lv_obj_clear_flag(objects.terbit_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.zuhur_time) lv_obj_clear_flag(objects.zuhur_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.ashar_time) lv_obj_clear_flag(objects.ashar_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.maghrib_time) lv_obj_clear_flag(objects.maghrib_time, LV_OBJ_FLAG_HIDDEN);
-  if (objects.isya_time) lv_obj_clear_flag(objects.isya_time, LV_OBJ_FLAG_HIDDEN);
+  setPrayerLabelsHidden(false);
 }
 
 // ============================================
@@ -709,91 +1330,236 @@ int getRemainingSeconds() {
   return remaining;
 }
 
+// ============================================
+// LAYANAN BUZZER - SEKUENSER POLA (esp_timer + LEDC FADE)
+// ============================================
+enum BuzzerStepType : uint8_t {
+  BZ_ON,          // NYALA PADA VOLUME
+  BZ_OFF,         // DIAM
+  BZ_RAMP_UP,     // FADE HARDWARE 0 -> VOLUME
+  BZ_RAMP_DOWN,   // FADE HARDWARE VOLUME -> 0
+  BZ_LOOP,        // ULANG DARI LANGKAH 0
+  BZ_END          // SELESAI
+};
+
+struct BuzzerStep {
+  BuzzerStepType type;
+  uint16_t durationMs;
+};
+
+#define BUZZER_MAX_STEPS     8
+#define BUZZER_PATTERN_COUNT 5
+#define BUZZER_RETRY_US      2000   // CALLBACK BERTEMU MUTEX TERPAKAI
+
+static const char *const BUZZER_PATTERN_NAMES[BUZZER_PATTERN_COUNT] = {
+  "beep", "double", "soft", "alarm", "single"
+};
+
+static const BuzzerStep BUZZER_PATTERNS[BUZZER_PATTERN_COUNT][BUZZER_MAX_STEPS] = {
+  // beep   : 500 ms NYALA / 500 ms DIAM
+  { {BZ_ON, 500}, {BZ_OFF, 500}, {BZ_LOOP, 0} },
+  // double : DUA BIP PENDEK
+  { {BZ_ON, 150}, {BZ_OFF, 100}, {BZ_ON, 150}, {BZ_OFF, 600}, {BZ_LOOP, 0} },
+  // soft   : NAIK-TURUN HALUS
+  { {BZ_RAMP_UP, 400}, {BZ_RAMP_DOWN, 400}, {BZ_OFF, 400}, {BZ_LOOP, 0} },
+  // alarm  : TIGA BIP CEPAT
+  { {BZ_ON, 100}, {BZ_OFF, 80}, {BZ_ON, 100}, {BZ_OFF, 80}, {BZ_ON, 100}, {BZ_OFF, 540}, {BZ_LOOP, 0} },
+  // single : SATU BIP PANJANG
+  { {BZ_ON, 1000}, {BZ_OFF, 0}, {BZ_END, 0} }
+};
+
+struct BuzzerState {
+  bool active;
+  uint8_t pattern;
+  uint8_t step;
+  uint32_t duty;
+  unsigned long startTime;
+  unsigned long maxDuration;   // 0 = SAMPAI buzzerStop()
+};
+
+BuzzerState buzzerState = {false, 0, 0, 0, 0, 0};
+esp_timer_handle_t buzzerTimer = NULL;
+SemaphoreHandle_t buzzerMutex = NULL;
+
+int buzzerSlotFor(const String &name) {
+  if (name == "alarm") return BUZZER_SLOT_ALARM;
+  Prayer prayer = prayerFromName(name.c_str());
+  return prayer != PRAYER_NONE ? PRAYER_INFO[prayer].buzzerSlot : -1;
+}
+
+int buzzerPatternFor(const String &name) {
+  for (int i = 0; i < BUZZER_PATTERN_COUNT; i++) {
+    if (name == BUZZER_PATTERN_NAMES[i]) return i;
+  }
+  return -1;
+}
+
+// DIPANGGIL DENGAN buzzerMutex DIPEGANG
+static void buzzerRunStep() {
+  while (buzzerState.active) {
+    if (buzzerState.maxDuration > 0 &&
+        millis() - buzzerState.startTime >= buzzerState.maxDuration) {
+      break;
+    }
+
+    const BuzzerStep &step = BUZZER_PATTERNS[buzzerState.pattern][buzzerState.step];
+
+    switch (step.type) {
+      case BZ_LOOP:
+        buzzerState.step = 0;
+        continue;
+      case BZ_END:
+        buzzerState.active = false;
+        continue;
+      case BZ_ON:
+        ledcWrite(BUZZER_PIN, buzzerState.duty);
+        break;
+      case BZ_OFF:
+        ledcWrite(BUZZER_PIN, 0);
+        break;
+      case BZ_RAMP_UP:
+        ledcFade(BUZZER_PIN, 0, buzzerState.duty, step.durationMs);
+        break;
+      case BZ_RAMP_DOWN:
+        ledcFade(BUZZER_PIN, buzzerState.duty, 0, step.durationMs);
+        break;
+    }
+
+    buzzerState.step++;
+    if (step.durationMs == 0) continue;
+
+    // TIMER BISA SUDAH DIPASANG ULANG OLEH CALLBACK YANG GAGAL MENGAMBIL MUTEX
+    if (esp_timer_start_once(buzzerTimer, (uint64_t)step.durationMs * 1000ULL) != ESP_OK) {
+      esp_timer_stop(buzzerTimer);
+      esp_timer_start_once(buzzerTimer, (uint64_t)step.durationMs * 1000ULL);
+    }
+    return;
+  }
+
+  buzzerState.active = false;
+  ledcWrite(BUZZER_PIN, 0);
+}
+
+// TUGAS esp_timer TIDAK BOLEH MENUNGGU. MUTEX SEDANG DIPEGANG buzzerPlay/Stop
+// (< 1 MS): PASANG ULANG SEBENTAR LAGI, LANGKAH TIDAK PERNAH DIBUANG.
+static void buzzerTimerCallback(void *arg) {
+  if (xSemaphoreTake(buzzerMutex, 0) != pdTRUE) {
+    esp_timer_start_once(buzzerTimer, BUZZER_RETRY_US);
+    return;
+  }
+  buzzerRunStep();
+  xSemaphoreGive(buzzerMutex);
+}
+
+bool initBuzzer() {
+  ledcAttach(BUZZER_PIN, BUZZER_FREQ, BUZZER_RESOLUTION);
+  ledcWrite(BUZZER_PIN, 0);
+
+  buzzerMutex = xSemaphoreCreateMutex();
+
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = buzzerTimerCallback;
+  timerArgs.dispatch_method = ESP_TIMER_TASK;
+  timerArgs.name = "buzzer";
+
+  return buzzerMutex != NULL && esp_timer_create(&timerArgs, &buzzerTimer) == ESP_OK;
+}
+
+void buzzerPlay(uint8_t pattern, unsigned long maxDuration, int volume) {
+  if (buzzerTimer == NULL || pattern >= BUZZER_PATTERN_COUNT) return;
+  if (xSemaphoreTake(buzzerMutex, pdMS_TO_TICKS(100)) != pdTRUE) return;
+
+  esp_timer_stop(buzzerTimer);
+
+  buzzerState.active = true;
+  buzzerState.pattern = pattern;
+  buzzerState.step = 0;
+  buzzerState.duty = map(constrain(volume, 0, 100), 0, 100, 0, 255);
+  buzzerState.startTime = millis();
+  buzzerState.maxDuration = maxDuration;
+
+  buzzerRunStep();
+  xSemaphoreGive(buzzerMutex);
+}
+
+void buzzerStop() {
+  if (buzzerTimer == NULL) return;
+  if (xSemaphoreTake(buzzerMutex, pdMS_TO_TICKS(100)) != pdTRUE) return;
+
+  esp_timer_stop(buzzerTimer);
+  buzzerState.active = false;
+  ledcWrite(BUZZER_PIN, 0);
+
+  xSemaphoreGive(buzzerMutex);
+}
+
 // ============================================
 // FUNGSI KEDIP WAKTU SHOLAT
 // ============================================
 void checkPrayerTime() {
+  PERF_SCOPE(PERF_CHECK_PRAYER);
   if (alarmState.isRinging) return;
 
-  if (prayerConfig.imsakTime   == "00:00" &&
-      prayerConfig.subuhTime   == "00:00" &&
-      prayerConfig.terbitTime  == "00:00" &&
-      prayerConfig.zuhurTime   == "00:00" &&
-      prayerConfig.asharTime   == "00:00" &&
-      prayerConfig.maghribTime == "00:00" &&
-      prayerConfig.isyaTime    == "00:00") {
-    return;
-  }
+  int16_t prayerMinutes[PRAYER_COUNT];
+  portENTER_CRITICAL(&scheduleMux);
+  memcpy(prayerMinutes, activeMinutes, sizeof(prayerMinutes));
+  portEXIT_CRITICAL(&scheduleMux);
 
   time_t now_t = timeConfig.currentTime;
   struct tm timeinfo;
   localtime_r(&now_t, &timeinfo);
 
-  char currentTime[6];
-  sprintf(currentTime, "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-
   int currentMinuteKey = timeinfo.tm_hour * 60 + timeinfo.tm_min;
 
-  if (timeinfo.tm_sec < 5
-      && currentMinuteKey != lastBlinkMinute
-      && !blinkState.isBlinking
-      && !adzanState.canTouch) {
-
-    String current = String(currentTime);
-    String prayerName = "";
+  if (!blinkState.isBlinking && !adzanState.canTouch) {
+    int due = prayerTriggerIndex(prayerMinutes, buzzerEnabledMask(), PRAYER_COUNT,
+                                 currentMinuteKey, timeinfo.tm_sec, lastBlinkMinute);
 
-    if (current == prayerConfig.imsakTime && buzzerConfig.imsakEnabled) prayerName = "imsak";
-    else if (current == prayerConfig.subuhTime && buzzerConfig.subuhEnabled) prayerName = "subuh";
-    else if (current == prayerConfig.terbitTime && buzzerConfig.terbitEnabled) prayerName = "terbit";
-    else if (current == prayerConfig.zuhurTime && buzzerConfig.zuhurEnabled) prayerName = "zuhur";
-    else if (current == prayerConfig.asharTime && buzzerConfig.asharEnabled) prayerName = "ashar";
-    else if (current == prayerConfig.maghribTime && buzzerConfig.maghribEnabled) prayerName = "maghrib";
-    else if (current == prayerConfig.isyaTime && buzzerConfig.isyaEnabled) prayerName = "isya";
-
-    if (prayerName.length() > 0) {
+    if (due >= 0) {
+      Prayer prayer = (Prayer)due;
       lastBlinkMinute = currentMinuteKey;
-      startBlinking(prayerName);
-
-      bool isAdzanPrayer = (prayerName != "imsak" && prayerName != "terbit");
+      startBlinking(prayer);
 
-      if (isAdzanPrayer && dfPlayerAvailable) {
+      if (isAdzanPrayer(prayer) && dfPlayerAvailable) {
         adzanState.canTouch = true;
-        adzanState.currentPrayer = prayerName;
+        adzanState.currentPrayer = prayer;
         adzanState.startTime = now_t;
         adzanState.deadlineTime = now_t + 600;
         saveAdzanState();
-        Serial.println("ADZAN AKTIF: " + prayerName + " - SENTUH LAYAR UNTUK PUTAR (10 MENIT)");
+        Serial.printf("ADZAN AKTIF: %s - SENTUH LAYAR UNTUK PUTAR (10 MENIT)\n", PRAYER_INFO[prayer].key);
       } else {
         adzanState.canTouch = false;
-        adzanState.currentPrayer = "";
-        Serial.println("NOTIFIKASI AKTIF: " + prayerName + " - BUZZER+KEDIP SAJA (TIDAK PERLU SENTUH)");
+        adzanState.currentPrayer = PRAYER_NONE;
+        hotStateSave();
+        Serial.printf("NOTIFIKASI AKTIF: %s - BUZZER+KEDIP SAJA (TIDAK PERLU SENTUH)\n", PRAYER_INFO[prayer].key);
       }
     }
   }
 
   if (adzanState.canTouch && getAdzanRemainingSeconds() <= 0) {
-    Serial.println("ADZAN KEDALUWARSA: " + adzanState.currentPrayer);
+    Serial.printf("ADZAN KEDALUWARSA: %s\n", prayerKey(adzanState.currentPrayer));
     adzanState.canTouch = false;
-    adzanState.currentPrayer = "";
+    adzanState.currentPrayer = PRAYER_NONE;
     adzanState.isPlaying = false;
-    saveAdzanState();
     lastBlinkMinute = -1;
+    saveAdzanState();
   }
 }
 
-void startBlinking(String prayerName) {
+void startBlinking(Prayer prayer) {
+  if (prayer >= PRAYER_COUNT) return;
+
   blinkState.isBlinking = true;
   blinkState.blinkStartTime = millis();
   blinkState.lastBlinkToggle = millis();
   blinkState.currentVisible = true;
-  blinkState.activePrayer = prayerName;
+  blinkState.activePrayer = prayer;
 
-  String upperName = prayerName;
-  upperName.toUpperCase();
+  buzzerPlay(buzzerConfig.pattern[PRAYER_INFO[prayer].buzzerSlot], BLINK_DURATION, buzzerConfig.volume);
 
   Serial.println("\n========================================");
   Serial.print("WAKTU SHALAT: ");
-  Serial.println(upperName);
+  Serial.println(PRAYER_INFO[prayer].displayName);
   Serial.println("========================================");
   Serial.println("MULAI BERKEDIP SELAMA 1 MENIT...");
   Serial.println("========================================\n");
@@ -802,18 +1568,12 @@ void startBlinking(String prayerName) {
 void stopBlinking() {
   if (blinkState.isBlinking) {
     blinkState.isBlinking = false;
-    blinkState.activePrayer = "";
+    blinkState.activePrayer = PRAYER_NONE;
 
-    ledcWrite(BUZZER_CHANNEL, 0);
+    buzzerStop();
 
     if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(200)) == pdTRUE) {
-      if (objects.imsak_time) lv_obj_clear_flag(objects.imsak_time, LV_OBJ_FLAG_HIDDEN);
-      if (objects.subuh_time) lv_obj_clear_flag(objects.subuh_time, LV_OBJ_FLAG_HIDDEN);
-      if (objects.terbit_time) lv_obj_clear_flag(objects.terbit_time, LV_OBJ_FLAG_HIDDEN);
-      if (objects.zuhur_time) lv_obj_clear_flag(objects.zuhur_time, LV_OBJ_FLAG_HIDDEN);
-      if (objects.ashar_time) lv_obj_clear_flag(objects.ashar_time, LV_OBJ_FLAG_HIDDEN);
-      if (objects.maghrib_time) lv_obj_clear_flag(objects.maghrib_time, LV_OBJ_FLAG_HIDDEN);
-      if (objects.isya_time) lv_obj_clear_flag(objects.isya_time, LV_OBJ_FLAG_HIDDEN);
+      setPrayerLabelsHidden(false);
       xSemaphoreGive(displayMutex);
     } else {
       Serial.println("[STOPBLINKING] PERINGATAN: TIMEOUT DISPLAYMUTEX - ELEMEN MUNGKIN MASIH TERSEMBUNYI");
@@ -824,6 +1584,7 @@ void stopBlinking() {
 }
 
 void handleBlinking() {
+  PERF_SCOPE(PERF_BLINK);
   if (!blinkState.isBlinking) return;
 
   unsigned long currentMillis = millis();
@@ -838,24 +1599,14 @@ void handleBlinking() {
     blinkState.currentVisible = !blinkState.currentVisible;
 
     if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(150)) == pdTRUE) {
-      lv_obj_t *targetLabel = NULL;
-
-      if (blinkState.activePrayer == "imsak") targetLabel = objects.imsak_time;
-      else if (blinkState.activePrayer == "subuh") targetLabel = objects.subuh_time;
-      else if (blinkState.activePrayer == "terbit") targetLabel = objects.terbit_time;
-      else if (blinkState.activePrayer == "zuhur") targetLabel = objects.zuhur_time;
-      else if (blinkState.activePrayer == "ashar") targetLabel = objects.ashar_time;
-      else if (blinkState.activePrayer == "maghrib") targetLabel = objects.maghrib_time;
-      else if (blinkState.activePrayer == "isya") targetLabel = objects.isya_time;
+      Prayer prayer = blinkState.activePrayer;
+      lv_obj_t *targetLabel = prayer < PRAYER_COUNT ? objects.*(PRAYER_INFO[prayer].label) : NULL;
 
       if (targetLabel) {
         if (blinkState.currentVisible) {
           lv_obj_clear_flag(targetLabel, LV_OBJ_FLAG_HIDDEN);
-          int pwmValue = map(buzzerConfig.volume, 0, 100, 0, 255);
-          ledcWrite(BUZZER_CHANNEL, pwmValue);
         } else {
           lv_obj_add_flag(targetLabel, LV_OBJ_FLAG_HIDDEN);
-          ledcWrite(BUZZER_CHANNEL, 0);
         }
       }
 
@@ -867,24 +1618,93 @@ void handleBlinking() {
 }
 
 // ============================================
-// PRAYER TIMES API FUNCTIONS
+// LAYANAN JADWAL - KOTAK SURAT PERMINTAAN
 // ============================================
-void getPrayerTimesByCoordinates(String lat, String lon) {
-  Serial.println("\n[TUGAS SHALAT] MENGIRIM PERMINTAAN HTTP KE ANTRIAN...");
+// AMAN DARI TUGAS MANA PUN. KOORDINAT SAMA YANG BELUM DIAMBIL DIGABUNG:
+// scheduleTask MEMBACA METODE & TUNE SAAT FETCH, JADI SUDAH TERCAKUP.
+bool scheduleRequest(const String &lat, const String &lon, int32_t day) {
+  if (lat.length() == 0 || lon.length() == 0 ||
+      lat.length() >= sizeof(ScheduleRequest::lat) ||
+      lon.length() >= sizeof(ScheduleRequest::lon)) {
+    return false;
+  }
 
-  HTTPRequest request;
-  request.latitude = lat;
-  request.longitude = lon;
+  portENTER_CRITICAL(&scheduleSvcMux);
+  ScheduleRequest &m = scheduleSvc.mailbox;
+  bool same = scheduleSvc.pending && m.day == day &&
+              strcmp(m.lat, lat.c_str()) == 0 && strcmp(m.lon, lon.c_str()) == 0;
+  scheduleSvc.requests++;
+  if (scheduleSvc.pending) scheduleSvc.coalesced++;
+  if (!same) {
+    strlcpy(m.lat, lat.c_str(), sizeof(m.lat));
+    strlcpy(m.lon, lon.c_str(), sizeof(m.lon));
+    m.day = day;
+    m.generation = ++scheduleSvc.generation;
+    scheduleSvc.pending = true;
+  }
+  uint32_t generation = m.generation;
+  portEXIT_CRITICAL(&scheduleSvcMux);
 
-  if (xQueueSend(httpQueue, &request, pdMS_TO_TICKS(100)) == pdTRUE) {
-    Serial.println("[TUGAS SHALAT] PERMINTAAN HTTP BERHASIL DIANTREKAN");
-  } else {
-    Serial.println("[TUGAS SHALAT] GAGAL MENGANTREKAN PERMINTAAN HTTP (ANTRIAN PENUH)");
+  Serial.printf("[JADWAL] PERMINTAAN #%lu %s: %s, %s\n",
+                (unsigned long)generation, same ? "DIGABUNG" : "DIANTREKAN",
+                lat.c_str(), lon.c_str());
+
+  if (scheduleTaskHandle != NULL) {
+    xTaskNotifyGive(scheduleTaskHandle);
+  }
+  return true;
+}
+
+// PEMBARUAN JADWAL HARI INI (KOTA / METODE / NTP BERHASIL)
+void requestPrayerUpdate(const String &lat, const String &lon) {
+  scheduleRequest(lat, lon, -1);
+}
+
+bool scheduleTakeRequest(ScheduleRequest &out) {
+  portENTER_CRITICAL(&scheduleSvcMux);
+  bool has = scheduleSvc.pending;
+  if (has) {
+    out = scheduleSvc.mailbox;
+    scheduleSvc.pending = false;
   }
+  portEXIT_CRITICAL(&scheduleSvcMux);
+  return has;
+}
+
+bool scheduleIsStale(uint32_t generation) {
+  portENTER_CRITICAL(&scheduleSvcMux);
+  bool stale = generation != scheduleSvc.generation;
+  if (stale) scheduleSvc.stale++;
+  portEXIT_CRITICAL(&scheduleSvcMux);
+  return stale;
+}
+
+void scheduleEnter(ScheduleState next) {
+  uint32_t now = millis();
+  portENTER_CRITICAL(&scheduleSvcMux);
+  ScheduleStateStat &st = scheduleSvc.stats[scheduleSvc.state];
+  uint32_t spent = now - scheduleSvc.stateSinceMs;
+  st.count++;
+  st.totalMs += spent;
+  if (spent > st.maxMs) st.maxMs = spent;
+  scheduleSvc.state = next;
+  scheduleSvc.stateSinceMs = now;
+  portEXIT_CRITICAL(&scheduleSvcMux);
 }
 
 void savePrayerTimes() {
+  markStateChanged();
+
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    // FETCH HARIAN SERING MENGHASILKAN JADWAL YANG SAMA - JANGAN AUS-KAN FLASH
+    uint32_t crc = scheduleChecksum();
+    if (crc == hotStateScheduleCrc() && LittleFS.exists("/prayer_times.txt")) {
+      hotStateFlashSkipped++;
+      Serial.println("JADWAL TIDAK BERUBAH - FLASH TIDAK DITULIS");
+      xSemaphoreGive(settingsMutex);
+      return;
+    }
+
     fs::File file = LittleFS.open("/prayer_times.txt", "w");
     if (file) {
       file.println(prayerConfig.subuhTime);
@@ -897,8 +1717,10 @@ void savePrayerTimes() {
 
       file.println(prayerConfig.selectedCity);
       file.println(prayerConfig.selectedCityName);
+      file.println((long)scheduleDay);
       file.flush();
       file.close();
+      hotStateSetScheduleCrc(crc);
       Serial.println("WAKTU SHALAT TERSIMPAN");
 
       vTaskDelay(pdMS_TO_TICKS(100));
@@ -913,6 +1735,7 @@ void savePrayerTimes() {
 }
 
 void loadPrayerTimes() {
+  PERF_SCOPE(PERF_LOAD_PRAYER);
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     if (LittleFS.exists("/prayer_times.txt")) {
       fs::File file = LittleFS.open("/prayer_times.txt", "r");
@@ -946,8 +1769,17 @@ void loadPrayerTimes() {
           prayerConfig.selectedCityName = file.readStringUntil('\n');
           prayerConfig.selectedCityName.trim();
         }
+        // FILE LAMA TANPA BARIS HARI: -1, scheduleTask MENGAMBIL ULANG SEKALI
+        scheduleDay = -1;
+        if (file.available()) {
+          String dayStr = file.readStringUntil('\n');
+          dayStr.trim();
+          if (dayStr.length() > 0) scheduleDay = dayStr.toInt();
+        }
 
         file.close();
+        schedulePublishConfig();
+        hotStateSetScheduleCrc(scheduleChecksum());
         Serial.println("WAKTU SHALAT DIMUAT");
         Serial.println("KOTA: " + prayerConfig.selectedCity);
       }
@@ -960,6 +1792,8 @@ void loadPrayerTimes() {
 // WIFI FUNCTIONS
 // ============================================
 void saveWiFiCredentials() {
+  markStateChanged();
+
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     fs::File file = LittleFS.open("/wifi_creds.txt", "w");
     if (file) {
@@ -1044,38 +1878,157 @@ void loadWiFiCredentials() {
   }
 }
 
-void saveAPCredentials() {
-  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
-    fs::File file = LittleFS.open("/ap_creds.txt", "w");
-    if (file) {
-      file.println(wifiConfig.apSSID);
-      file.println(wifiConfig.apPassword);
+WiFiLinkInfo getWiFiLinkSnapshot() {
+  portENTER_CRITICAL(&wifiLinkMux);
+  WiFiLinkInfo link = wifiLinkCache;
+  portEXIT_CRITICAL(&wifiLinkMux);
+  return link;
+}
 
-      file.println(wifiConfig.apIP.toString());
-      file.println(wifiConfig.apGateway.toString());
-      file.println(wifiConfig.apSubnet.toString());
+// true = ISI BERUBAH
+bool publishWiFiLink(const WiFiLinkInfo &fresh) {
+  portENTER_CRITICAL(&wifiLinkMux);
+  bool changed = wifiLinkUpdate(wifiLinkCache, fresh);
+  portEXIT_CRITICAL(&wifiLinkMux);
+  return changed;
+}
+
+void saveWiFiLinkCache() {
+  WiFiLinkInfo link = getWiFiLinkSnapshot();
+  if (!link.valid) return;
+
+  char bssidStr[18];
+  snprintf(bssidStr, sizeof(bssidStr), "%02X:%02X:%02X:%02X:%02X:%02X",
+           link.bssid[0], link.bssid[1], link.bssid[2],
+           link.bssid[3], link.bssid[4], link.bssid[5]);
 
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    fs::File file = LittleFS.open("/wifi_link.txt", "w");
+    if (file) {
+      file.println(link.ssid);
+      file.println(bssidStr);
+      file.println(link.channel);
       file.flush();
       file.close();
-      Serial.println("KREDENSIAL AP TERSIMPAN");
-      Serial.println("  SSID: " + String(wifiConfig.apSSID));
-      Serial.println("  IP: " + wifiConfig.apIP.toString());
-      Serial.println("  GATEWAY: " + wifiConfig.apGateway.toString());
-      Serial.println("  SUBNET: " + wifiConfig.apSubnet.toString());
-
-      vTaskDelay(pdMS_TO_TICKS(100));
-      if (LittleFS.exists("/ap_creds.txt")) {
-        Serial.println("FILE AP TERVERIFIKASI");
-      }
-    } else {
-      Serial.println("GAGAL MEMBUKA AP_CREDS.TXT UNTUK DITULIS");
+      Serial.printf("CACHE LINK WIFI TERSIMPAN: %s CH %ld\n", bssidStr, (long)link.channel);
     }
     xSemaphoreGive(settingsMutex);
   }
 }
 
-void setupWiFiEvents() {
-    wifiEventGroup = xEventGroupCreate();
+void loadWiFiLinkCache() {
+  WiFiLinkInfo link = {};
+
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    if (LittleFS.exists("/wifi_link.txt")) {
+      fs::File file = LittleFS.open("/wifi_link.txt", "r");
+      if (file) {
+        // FILE LAMA MEMUAT 5 BARIS LEASE IP SETELAH CHANNEL: DIABAIKAN
+        String lines[3];
+        int count = 0;
+        while (file.available() && count < 3) {
+          lines[count] = file.readStringUntil('\n');
+          lines[count].trim();
+          count++;
+        }
+        file.close();
+
+        unsigned int b[6];
+        if (count == 3 &&
+            sscanf(lines[1].c_str(), "%x:%x:%x:%x:%x:%x",
+                   &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) == 6) {
+          strlcpy(link.ssid, lines[0].c_str(), sizeof(link.ssid));
+          for (int i = 0; i < 6; i++) link.bssid[i] = b[i];
+          link.channel = lines[2].toInt();
+          link.valid = (link.channel >= 1 && link.channel <= 14);
+        }
+      }
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+
+  publishWiFiLink(link);
+  Serial.println(link.valid ?
+                 "CACHE LINK WIFI DIMUAT - FAST RECONNECT AKTIF" :
+                 "CACHE LINK WIFI TIDAK ADA - SCAN SAAT KONEK PERTAMA");
+}
+
+// DIPANGGIL DARI EVENT GOT_IP
+void recordWiFiConnected() {
+  if (wifiReconnectStart != 0) {
+    uint32_t elapsed = millis() - wifiReconnectStart;
+    wifiReconnectStart = 0;
+
+    uint8_t stage = wifiLadder.activeStage;
+    portENTER_CRITICAL(&wifiStatsMux);
+    wifiStatsRecord(wifiReconnectStats, elapsed, stage);
+    portEXIT_CRITICAL(&wifiStatsMux);
+
+    Serial.printf("[WIFI] TERHUBUNG DALAM %lu MS (TAHAP %d)\n",
+                  (unsigned long)elapsed, stage + 1);
+  }
+
+  // DISIMPAN KE FLASH OLEH wifiTask HANYA BILA AP / CHANNEL BERUBAH
+  uint8_t *bssid = WiFi.BSSID();
+  if (bssid != NULL) {
+    WiFiLinkInfo fresh = {};
+    memcpy(fresh.bssid, bssid, 6);
+    strlcpy(fresh.ssid, WiFi.SSID().c_str(), sizeof(fresh.ssid));
+    fresh.channel = WiFi.channel();
+    fresh.valid = true;
+    if (publishWiFiLink(fresh)) wifiLinkDirty = true;
+  }
+
+  wifiLadderConnected(wifiLadder);
+}
+
+// PERSENTIL NEAREST-RANK DARI SAMPEL TERAKHIR
+void getWiFiReconnectPercentiles(uint32_t &p50, uint32_t &p90, uint32_t &p99,
+                                 uint32_t &maxMs, uint8_t &count) {
+  uint32_t sorted[WIFI_RECONNECT_SAMPLES];
+
+  portENTER_CRITICAL(&wifiStatsMux);
+  count = wifiReconnectStats.count;
+  memcpy(sorted, wifiReconnectStats.samples, sizeof(sorted));
+  portEXIT_CRITICAL(&wifiStatsMux);
+
+  wifiReconnectPercentiles(sorted, count, p50, p90, p99, maxMs);
+}
+
+void saveAPCredentials() {
+  markStateChanged();
+
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    fs::File file = LittleFS.open("/ap_creds.txt", "w");
+    if (file) {
+      file.println(wifiConfig.apSSID);
+      file.println(wifiConfig.apPassword);
+
+      file.println(wifiConfig.apIP.toString());
+      file.println(wifiConfig.apGateway.toString());
+      file.println(wifiConfig.apSubnet.toString());
+
+      file.flush();
+      file.close();
+      Serial.println("KREDENSIAL AP TERSIMPAN");
+      Serial.println("  SSID: " + String(wifiConfig.apSSID));
+      Serial.println("  IP: " + wifiConfig.apIP.toString());
+      Serial.println("  GATEWAY: " + wifiConfig.apGateway.toString());
+      Serial.println("  SUBNET: " + wifiConfig.apSubnet.toString());
+
+      vTaskDelay(pdMS_TO_TICKS(100));
+      if (LittleFS.exists("/ap_creds.txt")) {
+        Serial.println("FILE AP TERVERIFIKASI");
+      }
+    } else {
+      Serial.println("GAGAL MEMBUKA AP_CREDS.TXT UNTUK DITULIS");
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+}
+
+void setupWiFiEvents() {
+    wifiEventGroup = xEventGroupCreate();
 
     WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
         // ============================================
@@ -1087,6 +2040,8 @@ void setupWiFiEvents() {
         }
 
         Serial.print(String("[WIFI-EVENT] ") + String(event));
+        traceRecord(TRACE_WIFI, 0, (uint16_t)event,
+                    event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED ? info.wifi_sta_disconnected.reason : 0);
 
         switch (event) {
             case ARDUINO_EVENT_WIFI_STA_CONNECTED:
@@ -1111,6 +2066,8 @@ void setupWiFiEvents() {
 
                 xEventGroupSetBits(wifiEventGroup, WIFI_GOT_IP_BIT);
 
+                recordWiFiConnected();
+
                 if (xSemaphoreTake(wifiMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
                     wifiConfig.isConnected = true;
                     wifiConfig.localIP = WiFi.localIP();
@@ -1199,6 +2156,8 @@ void setupWiFiEvents() {
 // FUNGSI PENGATURAN & KONFIGURASI
 // ============================================
 void saveTimezoneConfig() {
+  markStateChanged();
+
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     fs::File file = LittleFS.open("/timezone.txt", "w");
     if (file) {
@@ -1240,6 +2199,72 @@ void loadTimezoneConfig() {
   }
 }
 
+// ============================================
+// MIRROR JADWAL - SIMPAN / MUAT
+// ============================================
+bool isValidMirrorHost(const String &host) {
+  if (host.length() == 0 || host.length() >= sizeof(scheduleProviders[0].host)) return false;
+  for (size_t i = 0; i < host.length(); i++) {
+    char c = host[i];
+    if (!isalnum((unsigned char)c) && c != '.' && c != '-') return false;
+  }
+  return true;
+}
+
+void saveScheduleMirror() {
+  char host[sizeof(scheduleProviders[0].host)];
+  uint16_t port;
+  portENTER_CRITICAL(&scheduleSvcMux);
+  memcpy(host, scheduleProviders[SCHEDULE_PROVIDER_MIRROR].host, sizeof(host));
+  port = scheduleProviders[SCHEDULE_PROVIDER_MIRROR].port;
+  portEXIT_CRITICAL(&scheduleSvcMux);
+
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    if (host[0] == '\0') {
+      if (LittleFS.exists(SCHEDULE_MIRROR_FILE)) LittleFS.remove(SCHEDULE_MIRROR_FILE);
+      Serial.println("MIRROR JADWAL DINONAKTIFKAN");
+    } else {
+      fs::File file = LittleFS.open(SCHEDULE_MIRROR_FILE, "w");
+      if (file) {
+        file.println(host);
+        file.println(port);
+        file.flush();
+        file.close();
+        Serial.printf("MIRROR JADWAL TERSIMPAN: %s:%u\n", host, port);
+      } else {
+        Serial.println("GAGAL MENYIMPAN MIRROR JADWAL");
+      }
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+}
+
+void loadScheduleMirror() {
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    if (LittleFS.exists(SCHEDULE_MIRROR_FILE)) {
+      fs::File file = LittleFS.open(SCHEDULE_MIRROR_FILE, "r");
+      if (file) {
+        String host = file.readStringUntil('\n');
+        host.trim();
+        long port = file.readStringUntil('\n').toInt();
+        file.close();
+
+        if (isValidMirrorHost(host) && port > 0 && port <= 65535) {
+          portENTER_CRITICAL(&scheduleSvcMux);
+          strlcpy(scheduleProviders[SCHEDULE_PROVIDER_MIRROR].host, host.c_str(),
+                  sizeof(scheduleProviders[SCHEDULE_PROVIDER_MIRROR].host));
+          scheduleProviders[SCHEDULE_PROVIDER_MIRROR].port = (uint16_t)port;
+          portEXIT_CRITICAL(&scheduleSvcMux);
+          Serial.printf("MIRROR JADWAL DIMUAT: %s:%ld\n", host.c_str(), port);
+        } else {
+          Serial.println("MIRROR JADWAL DI FILE TIDAK VALID - DIABAIKAN");
+        }
+      }
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+}
+
 void loadBuzzerConfig() {
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     if (LittleFS.exists("/buzzer_config.txt")) {
@@ -1253,6 +2278,14 @@ void loadBuzzerConfig() {
         buzzerConfig.maghribEnabled = file.readStringUntil('\n').toInt() == 1;
         buzzerConfig.isyaEnabled = file.readStringUntil('\n').toInt() == 1;
         buzzerConfig.volume = file.readStringUntil('\n').toInt();
+
+        // POLA PER SLOT (FILE LAMA TIDAK PUNYA - TETAP DEFAULT)
+        for (int i = 0; i < BUZZER_SLOT_COUNT && file.available(); i++) {
+          int pattern = file.readStringUntil('\n').toInt();
+          if (pattern >= 0 && pattern < BUZZER_PATTERN_COUNT) {
+            buzzerConfig.pattern[i] = pattern;
+          }
+        }
         file.close();
         Serial.println("KONFIGURASI BUZZER DIMUAT");
       }
@@ -1265,6 +2298,8 @@ void loadBuzzerConfig() {
 // KONFIGURASI ALARM - SIMPAN / MUAT
 // ============================================
 void saveAlarmConfig() {
+  markStateChanged();
+
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     fs::File file = LittleFS.open("/alarm_config.txt", "w");
     if (file) {
@@ -1305,30 +2340,22 @@ void loadAlarmConfig() {
 // ============================================
 // ALARM - BERHENTI (DIPANGGIL SAAT LAYAR DISENTUH)
 // ============================================
+// DIPANGGIL touchTask: HANYA STATE RAM, BUZZER, DAN RTC MEMORY. LABEL JAM
+// DIPULIHKAN (DAN DICATAT) OLEH uiTask DI handleAlarmBlink().
 void stopAlarm() {
   if (!alarmState.isRinging) return;
 
-  Serial.println("\n========================================");
-  Serial.println("ALARM DIHENTIKAN (LAYAR DISENTUH)");
-  Serial.println("========================================");
-
   alarmState.isRinging = false;
-  ledcWrite(BUZZER_CHANNEL, 0);
-
-  if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(200)) == pdTRUE) {
-    if (objects.time_now) lv_obj_clear_flag(objects.time_now, LV_OBJ_FLAG_HIDDEN);
-    xSemaphoreGive(displayMutex);
-  }
-  alarmState.clockVisible = true;
-
-  Serial.println("NOTIFIKASI SHALAT DIKEMBALIKAN");
-  Serial.println("========================================\n");
+  buzzerStop();
+  hotStateSave();
+  alarmState.stopPending = true;
 }
 
 // ============================================
 // ALARM - CEK APAKAH WAKTUNYA BERBUNYI
 // ============================================
 void checkAlarmTime() {
+  PERF_SCOPE(PERF_CHECK_ALARM);
   if (!alarmConfig.alarmEnabled) return;
   if (alarmState.isRinging) return;
 
@@ -1337,13 +2364,9 @@ void checkAlarmTime() {
   localtime_r(&now_t, &timeinfo);
 
   int currentMinuteKey = timeinfo.tm_hour * 60 + timeinfo.tm_min;
-  if (currentMinuteKey == lastAlarmMinute) return;
-  if (timeinfo.tm_sec >= 5) return;
-
-  char currentTime[6];
-  sprintf(currentTime, "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
 
-  if (strcmp(currentTime, alarmConfig.alarmTime) == 0) {
+  if (alarmTriggered(parseMinuteOfDay(alarmConfig.alarmTime), currentMinuteKey,
+                     timeinfo.tm_sec, lastAlarmMinute)) {
     lastAlarmMinute = currentMinuteKey;
 
     Serial.println("\n========================================");
@@ -1358,15 +2381,9 @@ void checkAlarmTime() {
 
     if (blinkState.isBlinking) {
       blinkState.isBlinking = false;
-      blinkState.activePrayer = "";
+      blinkState.activePrayer = PRAYER_NONE;
       if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(200)) == pdTRUE) {
-        if (objects.imsak_time) lv_obj_clear_flag(objects.imsak_time, LV_OBJ_FLAG_HIDDEN);
-        if (objects.subuh_time) lv_obj_clear_flag(objects.subuh_time, LV_OBJ_FLAG_HIDDEN);
-        if (objects.terbit_time) lv_obj_clear_flag(objects.terbit_time, LV_OBJ_FLAG_HIDDEN);
-        if (objects.zuhur_time) lv_obj_clear_flag(objects.zuhur_time, LV_OBJ_FLAG_HIDDEN);
-        if (objects.ashar_time) lv_obj_clear_flag(objects.ashar_time, LV_OBJ_FLAG_HIDDEN);
-        if (objects.maghrib_time) lv_obj_clear_flag(objects.maghrib_time, LV_OBJ_FLAG_HIDDEN);
-        if (objects.isya_time) lv_obj_clear_flag(objects.isya_time, LV_OBJ_FLAG_HIDDEN);
+        setPrayerLabelsHidden(false);
         xSemaphoreGive(displayMutex);
       }
     }
@@ -1377,6 +2394,9 @@ void checkAlarmTime() {
     alarmState.isRinging = true;
     alarmState.lastToggle = millis();
     alarmState.clockVisible = true;
+    hotStateSave();
+
+    buzzerPlay(buzzerConfig.pattern[BUZZER_SLOT_ALARM], 0, buzzerConfig.volume);
   }
 }
 
@@ -1384,6 +2404,19 @@ void checkAlarmTime() {
 // ALARM - TANGANI KEDIP JAM DAN BUZZER
 // ============================================
 void handleAlarmBlink() {
+  if (alarmState.stopPending) {
+    if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(150)) != pdTRUE) return;
+    if (objects.time_now) lv_obj_clear_flag(objects.time_now, LV_OBJ_FLAG_HIDDEN);
+    xSemaphoreGive(displayMutex);
+    alarmState.clockVisible = true;
+    alarmState.stopPending = false;
+
+    Serial.println("\n========================================");
+    Serial.println("ALARM DIHENTIKAN (LAYAR DISENTUH)");
+    Serial.println("NOTIFIKASI SHALAT DIKEMBALIKAN");
+    Serial.println("========================================\n");
+  }
+
   if (!alarmState.isRinging) return;
 
   unsigned long currentMillis = millis();
@@ -1395,11 +2428,8 @@ void handleAlarmBlink() {
       if (objects.time_now) {
         if (alarmState.clockVisible) {
           lv_obj_clear_flag(objects.time_now, LV_OBJ_FLAG_HIDDEN);
-          int pwmValue = map(buzzerConfig.volume, 0, 100, 0, 255);
-          ledcWrite(BUZZER_CHANNEL, pwmValue);
         } else {
           lv_obj_add_flag(objects.time_now, LV_OBJ_FLAG_HIDDEN);
-          ledcWrite(BUZZER_CHANNEL, 0);
         }
       }
       xSemaphoreGive(displayMutex);
@@ -1408,6 +2438,8 @@ void handleAlarmBlink() {
 }
 
 void saveBuzzerConfig() {
+  markStateChanged();
+
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     fs::File file = LittleFS.open("/buzzer_config.txt", "w");
     if (file) {
@@ -1419,6 +2451,9 @@ void saveBuzzerConfig() {
       file.println(buzzerConfig.maghribEnabled ? "1" : "0");
       file.println(buzzerConfig.isyaEnabled ? "1" : "0");
       file.println(buzzerConfig.volume);
+      for (int i = 0; i < BUZZER_SLOT_COUNT; i++) {
+        file.println(buzzerConfig.pattern[i]);
+      }
       file.flush();
       file.close();
       Serial.println("KONFIGURASI BUZZER TERSIMPAN");
@@ -1427,14 +2462,171 @@ void saveBuzzerConfig() {
   }
 }
 
+// ============================================
+// STATUS PANAS - RTC SLOW MEMORY
+// ============================================
+static uint32_t hotStateChecksum() {
+  return esp_rom_crc32_le(0, (const uint8_t *)&hotState, offsetof(HotState, crc));
+}
+
+// DIPANGGIL SEKALI DI setup() SEBELUM WORKER BOOT DAN loadPrayerTimes()
+bool hotStateInit() {
+  esp_reset_reason_t reason = esp_reset_reason();
+  bool warm = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT;
+
+  if (warm &&
+      hotState.magic == HOT_STATE_MAGIC &&
+      hotState.version == HOT_STATE_VERSION &&
+      hotState.size == sizeof(HotState) &&
+      hotState.crc == hotStateChecksum()) {
+    lastBlinkMinute = hotState.lastBlinkMinute;
+    lastAlarmMinute = hotState.lastAlarmMinute;
+    hotStateRestored = true;
+    Serial.printf("STATUS PANAS DIPULIHKAN DARI RTC MEMORY (RESET: %d)\n", (int)reason);
+    return true;
+  }
+
+  memset(&hotState, 0, sizeof(hotState));
+  hotState.magic = HOT_STATE_MAGIC;
+  hotState.version = HOT_STATE_VERSION;
+  hotState.size = sizeof(HotState);
+  hotState.adzanPrayer = PRAYER_NONE;
+  hotState.lastBlinkMinute = -1;
+  hotState.lastAlarmMinute = -1;
+  hotState.crc = hotStateChecksum();
+  Serial.printf("BOOT DINGIN - STATUS DIMUAT DARI LITTLEFS (RESET: %d)\n", (int)reason);
+  return false;
+}
+
+void hotStateSave() {
+  portENTER_CRITICAL(&hotStateMux);
+  hotState.adzanPrayer = adzanState.currentPrayer;
+  hotState.adzanCanTouch = adzanState.canTouch ? 1 : 0;
+  hotState.alarmRinging = alarmState.isRinging ? 1 : 0;
+  hotState.lastBlinkMinute = (int16_t)lastBlinkMinute;
+  hotState.lastAlarmMinute = (int16_t)lastAlarmMinute;
+  hotState.adzanStart = adzanState.startTime;
+  hotState.adzanDeadline = adzanState.deadlineTime;
+  hotState.crc = hotStateChecksum();
+  portEXIT_CRITICAL(&hotStateMux);
+}
+
+void hotStateSetTimeAnchor(time_t t) {
+  portENTER_CRITICAL(&hotStateMux);
+  hotState.timeAnchor = t;
+  hotState.crc = hotStateChecksum();
+  portEXIT_CRITICAL(&hotStateMux);
+}
+
+uint32_t hotStateScheduleCrc() {
+  portENTER_CRITICAL(&hotStateMux);
+  uint32_t crc = hotState.scheduleCrc;
+  portEXIT_CRITICAL(&hotStateMux);
+  return crc;
+}
+
+void hotStateSetScheduleCrc(uint32_t crc) {
+  portENTER_CRITICAL(&hotStateMux);
+  hotState.scheduleCrc = crc;
+  hotState.crc = hotStateChecksum();
+  portEXIT_CRITICAL(&hotStateMux);
+}
+
+// PEMANGGIL MEMEGANG settingsMutex
+void schedulePublishConfig() {
+  char times[PRAYER_COUNT][6];
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    strlcpy(times[i], (prayerConfig.*(PRAYER_INFO[i].time)).c_str(), sizeof(times[i]));
+  }
+  schedulePublish(times);
+}
+
+// PEMANGGIL MEMEGANG settingsMutex. URUTAN SAMA DENGAN /prayer_times.txt
+uint32_t scheduleChecksum() {
+  const String *fields[] = {
+    &prayerConfig.subuhTime, &prayerConfig.terbitTime, &prayerConfig.zuhurTime,
+    &prayerConfig.asharTime, &prayerConfig.maghribTime, &prayerConfig.isyaTime,
+    &prayerConfig.imsakTime, &prayerConfig.selectedCity, &prayerConfig.selectedCityName
+  };
+  uint32_t crc = 0;
+  for (const String *f : fields) {
+    // TERMASUK NUL AGAR "1:23"+"4" BERBEDA DARI "1:2"+"34"
+    crc = esp_rom_crc32_le(crc, (const uint8_t *)f->c_str(), f->length() + 1);
+  }
+  int32_t day = scheduleDay;
+  return esp_rom_crc32_le(crc, (const uint8_t *)&day, sizeof(day));
+}
+
+// JENDELA ADZAN DARI RTC MEMORY; false = PAKAI /adzan_state.txt
+bool hotStateRestoreAdzan() {
+  if (!hotStateRestored) return false;
+
+  Prayer prayer = (Prayer)hotState.adzanPrayer;
+  adzanState.isPlaying = false;
+  adzanState.startTime = (time_t)hotState.adzanStart;
+  adzanState.deadlineTime = (time_t)hotState.adzanDeadline;
+  adzanState.canTouch = hotState.adzanCanTouch && isAdzanPrayer(prayer);
+  adzanState.currentPrayer = adzanState.canTouch ? prayer : PRAYER_NONE;
+
+  if (adzanState.canTouch) {
+    int remaining = getAdzanRemainingSeconds();
+    if (remaining > 0) {
+      Serial.printf("ADZAN DIPULIHKAN (RTC MEMORY): %s\n", prayerKey(prayer));
+      Serial.printf("SISA: %d DETIK (%d MENIT)\n", remaining, remaining/60);
+    } else {
+      adzanState.canTouch = false;
+      adzanState.currentPrayer = PRAYER_NONE;
+      Serial.println("ADZAN KEDALUWARSA");
+    }
+  }
+  return true;
+}
+
+// TANPA RTC: LANJUTKAN DARI JANGKAR TERAKHIR, BUKAN 01/01/2000.
+// DETIK SELAMA RESET HILANG - NTP MENGOREKSI SAAT TERHUBUNG
+bool hotStateRestoreTime() {
+  const time_t EPOCH_2000 = 946684800;
+  if (!hotStateRestored || hotState.timeAnchor <= EPOCH_2000) return false;
+
+  time_t anchor = (time_t)hotState.timeAnchor;
+  if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return false;
+  setTime(anchor);
+  timeConfig.currentTime = anchor;
+  xSemaphoreGive(timeMutex);
+  return true;
+}
+
+// ALARM YANG BERBUNYI SAAT RESET TETAP BERBUNYI SAMPAI LAYAR DISENTUH
+void hotStateRestoreAlarm() {
+  if (!hotStateRestored || !hotState.alarmRinging) return;
+
+  alarmState.isRinging = true;
+  alarmState.lastToggle = millis();
+  alarmState.clockVisible = true;
+  buzzerPlay(buzzerConfig.pattern[BUZZER_SLOT_ALARM], 0, buzzerConfig.volume);
+  Serial.println("ALARM DILANJUTKAN SETELAH RESET");
+}
+
 void saveAdzanState() {
-  fs::File file = LittleFS.open("/adzan_state.txt", "w");
-  if (file) {
-    file.println(adzanState.currentPrayer);
-    file.println(adzanState.canTouch ? "1" : "0");
-    file.println((unsigned long)adzanState.startTime);
-    file.println((unsigned long)adzanState.deadlineTime);
-    file.close();
+  hotStateSave();
+
+  // FLASH HANYA UNTUK BOOT DINGIN: TULIS SAAT JENDELA DIBUKA, HAPUS SAAT
+  // DITUTUP LEBIH AWAL. JENDELA KEDALUWARSA SUDAH DIBUANG loadAdzanState().
+  if (adzanState.canTouch) {
+    fs::File file = LittleFS.open("/adzan_state.txt", "w");
+    if (file) {
+      file.println(prayerKey(adzanState.currentPrayer));
+      file.println("1");
+      file.println((unsigned long)adzanState.startTime);
+      file.println((unsigned long)adzanState.deadlineTime);
+      file.close();
+    }
+  } else if (adzanState.deadlineTime > timeConfig.currentTime) {
+    if (LittleFS.exists("/adzan_state.txt")) {
+      LittleFS.remove("/adzan_state.txt");
+    }
+  } else {
+    hotStateFlashSkipped++;
   }
 }
 
@@ -1444,8 +2636,12 @@ void loadAdzanState() {
   fs::File file = LittleFS.open("/adzan_state.txt", "r");
   if (!file) return;
 
-  adzanState.currentPrayer = file.readStringUntil('\n');
-  adzanState.currentPrayer.trim();
+  // FILE MENYIMPAN NAMA ("subuh"), BUKAN INDEKS ENUM, AGAR TETAP KOMPATIBEL
+  // DENGAN FIRMWARE LAMA. NAMA TIDAK DIKENAL ATAU NON-ADZAN DIANGGAP KOSONG.
+  String prayerStr = file.readStringUntil('\n');
+  prayerStr.trim();
+  Prayer prayer = prayerFromName(prayerStr.c_str());
+  adzanState.currentPrayer = isAdzanPrayer(prayer) ? prayer : PRAYER_NONE;
 
   String touchStr = file.readStringUntil('\n');
   touchStr.trim();
@@ -1460,17 +2656,17 @@ void loadAdzanState() {
 
   file.close();
 
-  if (touchStr == "1" && adzanState.currentPrayer.length() > 0) {
+  if (touchStr == "1" && adzanState.currentPrayer != PRAYER_NONE) {
     time_t now = timeConfig.currentTime;
     int remaining = getAdzanRemainingSeconds();
 
     if (remaining > 0) {
       adzanState.canTouch = true;
-      Serial.println("ADZAN DIPULIHKAN: " + adzanState.currentPrayer);
+      Serial.printf("ADZAN DIPULIHKAN: %s\n", prayerKey(adzanState.currentPrayer));
       Serial.printf("SISA: %d DETIK (%d MENIT)\n", remaining, remaining/60);
     } else {
       adzanState.canTouch = false;
-      adzanState.currentPrayer = "";
+      adzanState.currentPrayer = PRAYER_NONE;
       Serial.println("ADZAN KEDALUWARSA");
     }
   }
@@ -1483,6 +2679,8 @@ int getAdzanRemainingSeconds() {
 }
 
 void saveCitySelection() {
+  markStateChanged();
+
     if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
         fs::File file = LittleFS.open("/city_selection.txt", "w");
         if (file) {
@@ -1515,6 +2713,7 @@ void saveCitySelection() {
 }
 
 void loadCitySelection() {
+  PERF_SCOPE(PERF_LOAD_CITY);
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     if (LittleFS.exists("/city_selection.txt")) {
       fs::File file = LittleFS.open("/city_selection.txt", "r");
@@ -1596,6 +2795,8 @@ void loadCitySelection() {
 }
 
 void saveMethodSelection() {
+  markStateChanged();
+
   if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
     fs::File file = LittleFS.open("/method_selection.txt", "w");
     if (file) {
@@ -1643,6 +2844,65 @@ void loadMethodSelection() {
   }
 }
 
+void saveTouchCalibration() {
+  TouchCalibration cal = touchCalGet();
+
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    fs::File file = LittleFS.open("/touch_calibration.txt", "w");
+    if (file) {
+      file.println(cal.a);
+      file.println(cal.b);
+      file.println(cal.c);
+      file.println(cal.d);
+      file.println(cal.e);
+      file.println(cal.f);
+      file.flush();
+      file.close();
+      Serial.println("KALIBRASI SENTUH TERSIMPAN");
+    } else {
+      Serial.println("GAGAL MENYIMPAN KALIBRASI SENTUH");
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+}
+
+void loadTouchCalibration() {
+  if (xSemaphoreTake(settingsMutex, portMAX_DELAY) == pdTRUE) {
+    if (LittleFS.exists("/touch_calibration.txt")) {
+      fs::File file = LittleFS.open("/touch_calibration.txt", "r");
+      if (file) {
+        int32_t coef[6];
+        int count = 0;
+
+        while (file.available() && count < 6) {
+          String line = file.readStringUntil('\n');
+          line.trim();
+          if (line.length() == 0) continue;
+          coef[count++] = line.toInt();
+        }
+        file.close();
+
+        bool inRange = (count == 6);
+        for (int i = 0; i < count && inRange; i++) {
+          bool isOffset = (i == 2 || i == 5);
+          int32_t limit = isOffset ? (1L << 27) : 65536;
+          if (coef[i] <= -limit || coef[i] >= limit) inRange = false;
+        }
+
+        if (inRange) {
+          touchCalSet({ coef[0], coef[1], coef[2], coef[3], coef[4], coef[5], true });
+          Serial.println("KALIBRASI SENTUH DIMUAT");
+        } else {
+          Serial.println("KALIBRASI SENTUH RUSAK - MENGGUNAKAN DEFAULT");
+        }
+      }
+    } else {
+      Serial.println("KALIBRASI SENTUH TIDAK DITEMUKAN - MENGGUNAKAN DEFAULT");
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+}
+
 // ============================================
 // FUNGSI RTC
 // ============================================
@@ -1751,6 +3011,80 @@ bool initRTC() {
     return true;
 }
 
+#if RTC_SQW_PIN >= 0
+void IRAM_ATTR rtcSqwISR() {
+  static uint32_t lastEdgeUs = 0;
+  uint32_t nowUs = micros();
+  if (rtcSqwEdges > 0 && nowUs - lastEdgeUs < RTC_SQW_DEBOUNCE_US) return;
+  lastEdgeUs = nowUs;
+  rtcSqwEdges++;
+
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  if (rtcSqwActive && clockTaskHandle != NULL) {
+    vTaskNotifyGiveFromISR(clockTaskHandle, &higherPriorityTaskWoken);
+  }
+  if (higherPriorityTaskWoken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+void rtcSqwDisable(const char *reason) {
+  detachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN));
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+    rtc.writeSqwPinMode(DS3231_OFF);
+    xSemaphoreGive(i2cMutex);
+  }
+  Serial.printf("SQW RTC: %s DI GPIO%d - MEMAKAI TIMER INTERNAL\n", reason, RTC_SQW_PIN);
+}
+#endif
+
+// DIPANGGIL SEKALI SAAT BOOT SETELAH initRTC() BERHASIL
+bool initRtcSqw() {
+#if RTC_SQW_PIN >= 0
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return false;
+  rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+  xSemaphoreGive(i2cMutex);
+
+  pinMode(RTC_SQW_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), rtcSqwISR, FALLING);
+
+  // PASTIKAN TEPI BENAR-BENAR DATANG SEBELUM MENYERAHKAN DETIK KE SQW
+  uint32_t startEdges = rtcSqwEdges;
+  for (int i = 0; i < 150 && rtcSqwEdges - startEdges < 2; i++) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+
+  if (rtcSqwEdges - startEdges < 2) {
+    rtcSqwDisable("TIDAK ADA TEPI");
+    return false;
+  }
+
+  // TEPI TURUN = REGISTER DETIK BERGANTI: BACA TEPAT SETELAHNYA AGAR currentTime SEJAJAR.
+  // SQW BISA BERHENTI DI ANTARA DUA PENGECEKAN (KABEL LEPAS) - JANGAN MENUNGGU SELAMANYA
+  startEdges = rtcSqwEdges;
+  if (!clockAwaitEdge(rtcSqwEdges, startEdges, RTC_SQW_TIMEOUT_MS,
+                      []() { return (uint32_t)millis(); }, []() { vTaskDelay(1); })) {
+    rtcSqwDisable("TEPI BERHENTI");
+    return false;
+  }
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    DateTime aligned = rtc.now();
+    xSemaphoreGive(i2cMutex);
+    if (isRTCTimeValid(aligned) && xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+      timeConfig.currentTime = aligned.unixtime();
+      setTime(timeConfig.currentTime);
+      xSemaphoreGive(timeMutex);
+    }
+  }
+
+  rtcSqwActive = true;
+  Serial.printf("SQW RTC: DETAK 1 Hz DARI GPIO%d AKTIF\n", RTC_SQW_PIN);
+  return true;
+#else
+  return false;
+#endif
+}
+
 bool isRTCTimeValid(DateTime dt) {
     return (
         dt.year() >= 2000 && dt.year() <= 2100 &&
@@ -1838,6 +3172,7 @@ void saveTimeToRTC() {
         DateTime dt(y, m, d, h, min, sec);
 
         rtc.adjust(dt);
+        rtcCal.baselineValid = false;   // FASE RTC BERUBAH, PENGUKURAN DRIFT MULAI ULANG
 
         delay(100);
 
@@ -1906,39 +3241,1366 @@ void saveTimeToRTC() {
     }
 }
 
-void sendJSONResponse(AsyncWebServerRequest *request, const String &json) {
-    AsyncWebServerResponse *resp = request->beginResponse(200, "application/json", json);
-    resp->addHeader("Content-Length", String(json.length()));
-    resp->addHeader("Connection", "keep-alive");
-    resp->addHeader("Cache-Control", "no-cache");
-    request->send(resp);
-}
-
 // ============================================
-// FUNGSI SERVER WEB
+// KALIBRASI AGING DS3231
 // ============================================
-void setupServerRoutes() {
-  server.on("/", HTTP_GET, [](AsyncWebServerRequest * request) {
-    if (!LittleFS.exists("/index.html")) {
-      request -> send(404, "text/plain", "index.html not found");
-      return;
-    }
-
-    AsyncWebServerResponse * response = request -> beginResponse(
-      LittleFS, "/index.html", "text/html");
+// Setiap sinkron NTP mengukur fase RTC terhadap jam SNTP dengan resolusi ~1 ms
+// (menunggu register detik berganti). Kemiringan selisih antar pengukuran
+// (minimal 6 jam) = galat kristal dalam ppm, dikoreksi lewat register aging.
+static int rtcReadReg(uint8_t reg) {
+  Wire.beginTransmission(DS3231_ADDR);
+  Wire.write(reg);
+  if (Wire.endTransmission() != 0) return -1;
+  if (Wire.requestFrom((uint8_t)DS3231_ADDR, (uint8_t)1) != 1) return -1;
+  return Wire.read();
+}
 
-    response -> addHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-    response -> addHeader("Pragma", "no-cache");
-    response -> addHeader("Expires", "0");
-    response -> addHeader("Content-Type", "text/html; charset=utf-8");
+static bool rtcWriteReg(uint8_t reg, uint8_t value) {
+  Wire.beginTransmission(DS3231_ADDR);
+  Wire.write(reg);
+  Wire.write(value);
+  return Wire.endTransmission() == 0;
+}
 
-    request -> send(response);
-  });
+// NILAI BARU BERLAKU SETELAH KONVERSI SUHU; PAKSA KONVERSI SEKARANG
+bool writeRtcAging(int8_t aging) {
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return false;
+  bool ok = rtcWriteReg(DS3231_REG_AGING, (uint8_t)aging);
+  int control = ok ? rtcReadReg(DS3231_REG_CONTROL) : -1;
+  if (control >= 0) {
+    ok = rtcWriteReg(DS3231_REG_CONTROL, (uint8_t)control | DS3231_CONV_BIT);
+  }
+  xSemaphoreGive(i2cMutex);
+  return ok;
+}
 
-  server.on("/css/foundation.min.css", HTTP_GET, [](AsyncWebServerRequest * request) {
-    if (!LittleFS.exists("/css/foundation.min.css")) {
-      request -> send(404, "text/plain", "CSS not found");
-      return;
+// offsetMs POSITIF = RTC LEBIH CEPAT DARI NTP. i2cMutex DIAMBIL SEKALI UNTUK SELURUH
+// POLLING (MAKS RTC_OFFSET_POLL_MS): PENGGUNA I2C LAIN HANYA RTC, DAN TAKE/GIVE PER
+// BACAAN (~1000x) MENAMBAH JITTER PADA TEPI YANG JUSTRU SEDANG DIUKUR
+bool measureRtcOffsetMs(int32_t &offsetMs, time_t &utcNow) {
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(200)) != pdTRUE) return false;
+
+  bool ok = false;
+  int first = rtcReadReg(DS3231_REG_SECONDS);
+  unsigned long start = millis();
+  while (first >= 0 && millis() - start < RTC_OFFSET_POLL_MS) {
+    int sec = rtcReadReg(DS3231_REG_SECONDS);
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    if (sec < 0 || sec == first) {
+      vTaskDelay(1);
+      continue;
+    }
+
+    DateTime rtcNow = rtc.now();
+    if (isRTCTimeValid(rtcNow)) {
+      offsetMs = rtcOffsetAtEdge(rtcNow.unixtime(), tv.tv_sec, tv.tv_usec, timezoneOffset);
+      utcNow = tv.tv_sec;
+      ok = true;
+    }
+    break;
+  }
+
+  xSemaphoreGive(i2cMutex);
+  return ok;
+}
+
+void saveRtcCalibration() {
+  fs::File file = LittleFS.open(RTC_AGING_FILE, "w");
+  if (file) {
+    file.println(rtcCal.aging);
+    file.println((long)lroundf(rtcCal.lastPpm * 1000));
+    file.println((unsigned long)ntpSyncIntervalS);
+    file.close();
+  }
+}
+
+// DIPANGGIL SETELAH LittleFS SIAP; REGISTER AGING DIKEMBALIKAN JIKA RTC DIGANTI/DIRESET
+void loadRtcCalibration() {
+  if (!rtcAvailable || !LittleFS.exists(RTC_AGING_FILE)) return;
+
+  fs::File file = LittleFS.open(RTC_AGING_FILE, "r");
+  if (!file) return;
+
+  int aging = file.readStringUntil('\n').toInt();
+  long ppmMilli = file.readStringUntil('\n').toInt();
+  long interval = file.readStringUntil('\n').toInt();
+  file.close();
+
+  rtcCal.aging = (int8_t)constrain(aging, -RTC_AGING_LIMIT, RTC_AGING_LIMIT);
+  rtcCal.lastPpm = ppmMilli / 1000.0f;
+  ntpSyncIntervalS = constrain(interval, (long)NTP_INTERVAL_MIN_S, (long)NTP_INTERVAL_MAX_S);
+
+  int current = -1;
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+    current = rtcReadReg(DS3231_REG_AGING);
+    xSemaphoreGive(i2cMutex);
+  }
+  if (current >= 0 && (int8_t)current != rtcCal.aging) {
+    writeRtcAging(rtcCal.aging);
+  }
+
+  Serial.printf("AGING RTC DIMUAT: %d (GALAT TERAKHIR %.2f PPM, INTERVAL NTP %lu DETIK)\n",
+                rtcCal.aging, rtcCal.lastPpm, (unsigned long)ntpSyncIntervalS);
+}
+
+// DIPANGGIL ntpTask SETELAH SINKRON BERHASIL. true = RTC PERLU DITULIS ULANG
+bool rtcCalibrateOnSync() {
+  int32_t offsetMs;
+  time_t utcNow;
+  if (!measureRtcOffsetMs(offsetMs, utcNow)) {
+    Serial.println("KALIBRASI RTC: FASE TIDAK TERUKUR");
+    rtcCal.baselineValid = false;
+    return true;
+  }
+
+  Serial.printf("KALIBRASI RTC: SELISIH %+ld MS TERHADAP NTP\n", (long)offsetMs);
+
+  RtcCalDecision d = rtcCalOnMeasurement(rtcCal, ntpSyncIntervalS, offsetMs, utcNow);
+  if (d.segmentClosed) {
+    if (d.aging != rtcCal.aging && writeRtcAging((int8_t)d.aging)) {
+      rtcCal.aging = (int8_t)d.aging;
+    }
+    ntpSyncIntervalS = d.intervalS;
+
+    Serial.printf("KALIBRASI RTC: %.2f PPM SELAMA %ld DETIK -> AGING %d, INTERVAL NTP %lu DETIK\n",
+                  d.ppm, (long)d.elapsedS, rtcCal.aging, (unsigned long)ntpSyncIntervalS);
+    saveRtcCalibration();
+  }
+
+  return d.rewriteRtc;
+}
+
+// MENULIS DETIK MENGULANG RANTAI PEMBAGI DS3231: TULIS TEPAT DI BATAS DETIK SNTP
+// AGAR FASE RTC IKUT SEJAJAR (saveTimeToRTC() MEMAKAI DETIK PERANGKAT LUNAK)
+bool saveTimeToRTCAligned() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  time_t target = tv.tv_sec + 1;
+
+  unsigned long start = millis();
+  do {
+    vTaskDelay(1);
+    gettimeofday(&tv, NULL);
+  } while (tv.tv_sec < target && millis() - start < 1500);
+
+  if (tv.tv_sec < target) return false;
+
+  DateTime local((uint32_t)(tv.tv_sec + timezoneOffset * 3600));
+  if (!isRTCTimeValid(local)) return false;
+
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(100)) != pdTRUE) return false;
+  rtc.adjust(local);
+  rtcCal.baselineValid = false;
+  xSemaphoreGive(i2cMutex);
+
+  Serial.printf("RTC DITULIS DI BATAS DETIK NTP (+%ld US)\n", (long)tv.tv_usec);
+  return true;
+}
+
+// SETELAH RTC DITULIS, FASE BERUBAH: SISA SELISIH MENJADI TITIK AWAL BARU
+void rtcCalibrationRebase() {
+  int32_t offsetMs;
+  time_t utcNow;
+  if (measureRtcOffsetMs(offsetMs, utcNow)) {
+    rtcCal.baselineValid = true;
+    rtcCal.baselineUtc = utcNow;
+    rtcCal.baselineOffsetMs = offsetMs;
+    rtcCal.lastOffsetMs = offsetMs;
+  } else {
+    rtcCal.baselineValid = false;
+  }
+}
+
+void sendJSONResponse(AsyncWebServerRequest *request, const String &json) {
+    AsyncWebServerResponse *resp = request->beginResponse(200, "application/json", json);
+    resp->addHeader("Content-Length", String(json.length()));
+    resp->addHeader("Connection", "keep-alive");
+    resp->addHeader("Cache-Control", "no-cache");
+    request->send(resp);
+}
+
+#define BULK_OUT_SIZE 3072             // BATCH YANG TIDAK MUAT DILANJUTKAN DI CHUNK BERIKUTNYA
+static_assert(BULK_OUT_SIZE >= BULK_RECORD_MAX, "BULK_OUT_SIZE HARUS MUAT 1 KOTA");
+
+// STATE STREAMING PER REQUEST - MEMORI TETAP BERAPAPUN JUMLAH KOTA
+struct BulkScheduleJob {
+  fs::File file;
+  bool csv;
+  bool started;
+  bool exhausted;
+  bool finished;
+  String province;
+  SolarDay sun;
+  PrayerAngles angles;
+  char date[11];
+  CityBatch batch;
+  char name[BULK_BATCH_SIZE][BULK_NAME_LEN];
+  char out[BULK_OUT_SIZE];
+  size_t outLen;
+  size_t outPos;
+  uint8_t renderPos;                   // KOTA BERIKUTNYA DI batch YANG BELUM DITULIS
+  uint16_t cityCount;
+  uint32_t kernelUs;
+  uint32_t kernelCycles;
+  uint32_t dayCycles;
+};
+
+bool loadBulkBatch(BulkScheduleJob &job) {
+  CityBatch &batch = job.batch;
+  batch.count = 0;
+
+  JsonDocument doc;
+  while (!job.exhausted && batch.count < BULK_BATCH_SIZE) {
+    DeserializationError error = deserializeJson(doc, job.file);
+    if (error) {
+      job.exhausted = true;
+      break;
+    }
+
+    const char *province = doc["province"] | "";
+    if (job.province.length() == 0 || job.province.equalsIgnoreCase(province)) {
+      uint8_t i = batch.count++;
+      bulkCopyName(job.name[i], doc["display"] | "", BULK_NAME_LEN);
+      batch.lat[i] = doc["lat"].as<float>();
+      batch.lon[i] = doc["lon"].as<float>();
+      batch.tz[i] = provinceTimezone(province);
+    }
+
+    if (!job.file.findUntil(",", "]")) {
+      job.exhausted = true;
+    }
+  }
+
+  return batch.count > 0;
+}
+
+// TULIS KOTA SAMPAI BUFFER PENUH; SISANYA DILANJUTKAN PADA PANGGILAN BERIKUTNYA
+void renderBulkBatch(BulkScheduleJob &job) {
+  CityBatch &batch = job.batch;
+  job.outLen = 0;
+  job.outPos = 0;
+
+  while (job.renderPos < batch.count) {
+    uint8_t i = job.renderPos;
+    size_t n = bulkRenderCity(job.out + job.outLen, sizeof(job.out) - job.outLen,
+                              job.csv, job.cityCount > 0, job.name[i], batch, i);
+    if (n == 0) break;                 // BUFFER KOSONG SELALU MUAT (static_assert)
+
+    job.outLen += n;
+    job.renderPos++;
+    job.cityCount++;
+  }
+}
+
+// DIPANGGIL BERULANG OLEH beginChunkedResponse SAMPAI MENGEMBALIKAN 0
+size_t fillBulkSchedule(BulkScheduleJob &job, uint8_t *buffer, size_t maxLen) {
+  while (job.outPos >= job.outLen) {
+    if (job.finished) return 0;
+
+    job.outLen = 0;
+    job.outPos = 0;
+
+    if (!job.started) {
+      job.started = true;
+      job.outLen = bulkRenderHeader(job.out, sizeof(job.out), job.csv, job.date);
+    } else if (job.renderPos < job.batch.count) {
+      renderBulkBatch(job);
+    } else if (loadBulkBatch(job)) {
+      uint32_t start = micros();
+      uint32_t cycles = ESP.getCycleCount();
+      {
+        PERF_SCOPE(PERF_SOLAR_BATCH);
+        solarKernelBatch(job.sun, job.angles, job.batch);
+      }
+      job.kernelCycles += ESP.getCycleCount() - cycles;
+      job.kernelUs += micros() - start;
+      job.renderPos = 0;
+      renderBulkBatch(job);
+    } else {
+      job.finished = true;
+      job.outLen = bulkRenderFooter(job.out, sizeof(job.out), job.csv, job.cityCount,
+                                    job.dayCycles, job.kernelCycles, job.kernelUs);
+    }
+  }
+
+  size_t n = min(maxLen, job.outLen - job.outPos);
+  memcpy(buffer, job.out + job.outPos, n);
+  job.outPos += n;
+  return n;
+}
+
+// ============================================
+// JADWAL HARI INI / BESOK: PREFETCH & PERGANTIAN HARI
+// ============================================
+static_assert((int)BULK_TIME_COUNT == (int)PRAYER_COUNT &&
+              (int)BULK_IMSAK == (int)PRAYER_IMSAK && (int)BULK_ISYA == (int)PRAYER_ISYA,
+              "URUTAN BulkTime HARUS SAMA DENGAN Prayer");
+
+DaySchedule scheduleTomorrowSnapshot() {
+  portENTER_CRITICAL(&scheduleMux);
+  DaySchedule next = tomorrowSchedule;
+  portEXIT_CRITICAL(&scheduleMux);
+  return next;
+}
+
+void scheduleStoreTomorrow(const DaySchedule &next) {
+  portENTER_CRITICAL(&scheduleMux);
+  tomorrowSchedule = next;
+  portEXIT_CRITICAL(&scheduleMux);
+}
+
+void scheduleInvalidateTomorrow() {
+  portENTER_CRITICAL(&scheduleMux);
+  tomorrowSchedule.day = -1;
+  tomorrowSchedule.source = SCHED_NONE;
+  portEXIT_CRITICAL(&scheduleMux);
+}
+
+// CADANGAN TANPA JARINGAN: KERNEL MATAHARI YANG SAMA DENGAN /api/schedules,
+// DENGAN TUNE PENGGUNA. HANYA DIPANGGIL DARI scheduleTask.
+bool computeLocalSchedule(int32_t dayIndex, DaySchedule &out) {
+  if (!isValidCoordinate(prayerConfig.latitude, 90.0f) ||
+      !isValidCoordinate(prayerConfig.longitude, 180.0f)) {
+    return false;
+  }
+
+  static CityBatch batch;
+  batch.count = 1;
+  batch.lat[0] = prayerConfig.latitude.toFloat();
+  batch.lon[0] = prayerConfig.longitude.toFloat();
+  batch.tz[0] = (float)timezoneOffset;
+
+  time_t t = (time_t)dayIndex * 86400;
+  SolarDay sun;
+  {
+    PERF_SCOPE(PERF_SOLAR_DAY);
+    solarDayCompute(year(t), month(t), day(t), sun);
+  }
+  {
+    PERF_SCOPE(PERF_SOLAR_BATCH);
+    solarKernelBatch(sun, prayerAnglesFor(methodConfig.methodId), batch);
+  }
+
+  const int tune[PRAYER_COUNT] = {
+    prayerConfig.tuneImsak, prayerConfig.tuneSubuh, prayerConfig.tuneTerbit,
+    prayerConfig.tuneZuhur, prayerConfig.tuneAshar, prayerConfig.tuneMaghrib,
+    prayerConfig.tuneIsya
+  };
+
+  out.day = dayIndex;
+  out.source = SCHED_LOCAL;
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    formatBulkTime(batch.times[i][0] + tune[i] / 60.0f, out.times[i]);
+  }
+  return true;
+}
+
+// DIPANGGIL clockTickTask SETIAP DETIK SELAMA HARI JADWAL != HARI INI.
+// TANPA JARINGAN, TANPA FLASH, TANPA MENUNGGU: GAGAL = COBA LAGI DETIK BERIKUTNYA.
+bool scheduleSwapIn(int32_t today) {
+  portENTER_CRITICAL(&scheduleMux);
+  bool ready = (tomorrowSchedule.day == today);
+  DaySchedule next;
+  if (ready) next = tomorrowSchedule;
+  portEXIT_CRITICAL(&scheduleMux);
+
+  if (!ready) return false;
+  if (xSemaphoreTake(settingsMutex, 0) != pdTRUE) return false;
+
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    prayerConfig.*(PRAYER_INFO[i].time) = next.times[i];
+  }
+  scheduleDay = today;
+  xSemaphoreGive(settingsMutex);
+  schedulePublish(next.times);
+
+  portENTER_CRITICAL(&scheduleMux);
+  if (tomorrowSchedule.day == today) {
+    tomorrowSchedule.day = -1;
+    tomorrowSchedule.source = SCHED_NONE;
+  }
+  portEXIT_CRITICAL(&scheduleMux);
+
+  DisplayUpdate update;
+  update.type = DisplayUpdate::PRAYER_UPDATE;
+  xQueueSend(displayQueue, &update, 0);
+
+  // FLASH DITULIS jobTask, BUKAN TUGAS JAM
+  requestPersist(PERSIST_PRAYER);
+
+  Serial.printf("\n[JADWAL] HARI BERGANTI - JADWAL BESOK DIPASANG (SUMBER: %s)\n",
+                scheduleSourceName(next.source));
+  return true;
+}
+
+// DIPANGGIL scheduleTask SAAT IDLE DENGAN WAKTU VALID: HARI INI BILA JADWAL
+// AKTIF MILIK HARI LAIN, BESOK SETELAH ISYA. BACKOFF DI SINI MENGATUR JARAK
+// ANTAR PERMINTAAN; RETRY CEPAT PER PERMINTAAN ADA DI STATE MACHINE.
+void scheduleMaintain(time_t now_t) {
+  static int32_t lastTarget = -1;
+  static uint32_t nextAttemptMs = 0;
+  static uint32_t backoffS = SCHEDULE_RETRY_MIN_S;
+
+  int32_t today = (int32_t)(now_t / 86400);
+  int minuteOfDay = (int)((now_t % 86400) / 60);
+  int32_t target;
+
+  if (scheduleDay != today) {
+    target = today;
+  } else {
+    int isya = parseMinuteOfDay(prayerConfig.isyaTime);
+    int quietFrom = (isya > 0 ? isya : SCHEDULE_PREFETCH_DEFAULT_MIN) + SCHEDULE_PREFETCH_AFTER_ISYA_MIN;
+    if (minuteOfDay < min(quietFrom, SCHEDULE_LOCAL_FALLBACK_MIN)) return;
+
+    DaySchedule next = scheduleTomorrowSnapshot();
+    if (next.day == today + 1 && next.source == SCHED_API) return;
+
+    if (next.day != today + 1 && minuteOfDay >= SCHEDULE_LOCAL_FALLBACK_MIN) {
+      DaySchedule local;
+      if (computeLocalSchedule(today + 1, local)) {
+        scheduleStoreTomorrow(local);
+        Serial.printf("[JADWAL] API BESOK BELUM BERHASIL - DIHITUNG LOKAL (SUBUH %s, MAGHRIB %s)\n",
+                      local.times[PRAYER_SUBUH], local.times[PRAYER_MAGHRIB]);
+      }
+    }
+    target = today + 1;
+  }
+
+  if (target != lastTarget) {
+    lastTarget = target;
+    backoffS = SCHEDULE_RETRY_MIN_S;
+    nextAttemptMs = millis();
+  }
+
+  if (!wifiConfig.isConnected || (int32_t)(millis() - nextAttemptMs) < 0) return;
+
+  Serial.printf("\n[JADWAL] MENGAMBIL JADWAL %s - COBA LAGI DALAM %lu DETIK BILA GAGAL\n",
+                target == today ? "HARI INI" : "BESOK", (unsigned long)backoffS);
+  scheduleRequest(prayerConfig.latitude, prayerConfig.longitude, target);
+
+  nextAttemptMs = millis() + backoffS * 1000;
+  backoffS = min(backoffS * 2, (uint32_t)SCHEDULE_RETRY_MAX_S);
+}
+
+// ============================================
+// CACHE JADWAL: LRU RAM + SLOT LITTLEFS
+// ============================================
+// KUNCI = (LAT/LON FIXED-POINT 1e-4 DERAJAT, METODE, 7 TUNE, HARI). RAM
+// MENYIMPAN SCHEDULE_CACHE_RAM_SLOTS RECORD DENGAN LRU PENUH. FILE MENYIMPAN
+// SCHEDULE_CACHE_FILE_SLOTS RECORD BERUKURAN TETAP YANG DITULIS PER SLOT
+// (SEEK + WRITE); PENGGANTIAN DI FLASH MENGIKUTI WAKTU SIMPAN AGAR HIT TIDAK
+// PERNAH MENULIS FLASH. HANYA HASIL API YANG DISIMPAN. HANYA DIAKSES scheduleTask.
+#define SCHEDULE_CACHE_RAM_SLOTS 8
+#define SCHEDULE_CACHE_FILE_SLOTS 32
+#define SCHEDULE_CACHE_FILE "/schedule_cache.bin"
+#define SCHEDULE_CACHE_MAGIC 0x3143534A  // "JSC1"
+
+struct ScheduleCacheKey {
+  int32_t latE4;
+  int32_t lonE4;
+  int32_t day;                // HARI EPOCH LOKAL
+  uint8_t methodId;
+  int8_t tune[PRAYER_COUNT];
+};
+
+static_assert(sizeof(ScheduleCacheKey) == 20, "ScheduleCacheKey dibandingkan dengan memcmp - tanpa padding");
+
+struct ScheduleCacheRecord {
+  ScheduleCacheKey key;
+  uint32_t stamp;             // 0 = SLOT KOSONG
+  uint16_t minutes[PRAYER_COUNT];
+  uint16_t reserved;
+  uint32_t crc;
+};
+
+static_assert(sizeof(ScheduleCacheRecord) == 44, "format /schedule_cache.bin berubah");
+
+struct ScheduleCacheFileHeader {
+  uint32_t magic;
+  uint16_t recordSize;
+  uint16_t slots;
+};
+
+struct ScheduleCacheStats {
+  uint32_t ramHits;
+  uint32_t flashHits;
+  uint32_t misses;
+  uint32_t stores;
+  uint32_t evictions;         // RECORD RAM VALID YANG DIGESER
+  uint32_t flashErrors;
+  uint32_t lastLookupUs;
+  uint32_t maxLookupUs;
+};
+
+ScheduleCacheRecord scheduleCacheRam[SCHEDULE_CACHE_RAM_SLOTS] = {};
+uint32_t scheduleCacheClock = 0;
+bool scheduleCacheFileReady = false;
+ScheduleCacheStats scheduleCacheStats = {};
+portMUX_TYPE scheduleCacheMux = portMUX_INITIALIZER_UNLOCKED;
+
+int32_t scheduleCacheFixed(const char *deg) {
+  return (int32_t)lround(strtod(deg, NULL) * 10000.0);
+}
+
+// PARAMETER YANG SAMA DENGAN YANG DIKIRIM KE API - URL DIBANGUN DARI KUNCI INI
+void scheduleCacheKeyFor(const ScheduleRequest &req, ScheduleCacheKey &key) {
+  memset(&key, 0, sizeof(key));
+  key.latE4 = scheduleCacheFixed(req.lat);
+  key.lonE4 = scheduleCacheFixed(req.lon);
+  key.day = req.day;
+  key.methodId = (uint8_t)methodConfig.methodId;
+
+  const int tune[PRAYER_COUNT] = {
+    prayerConfig.tuneImsak, prayerConfig.tuneSubuh, prayerConfig.tuneTerbit,
+    prayerConfig.tuneZuhur, prayerConfig.tuneAshar, prayerConfig.tuneMaghrib,
+    prayerConfig.tuneIsya
+  };
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    key.tune[i] = (int8_t)constrain(tune[i], -99, 99);
+  }
+}
+
+uint32_t scheduleCacheCrc(const ScheduleCacheRecord &r) {
+  return esp_rom_crc32_le(0, (const uint8_t *)&r, offsetof(ScheduleCacheRecord, crc));
+}
+
+bool scheduleCacheRecordValid(const ScheduleCacheRecord &r) {
+  return r.stamp != 0 && r.crc == scheduleCacheCrc(r);
+}
+
+void scheduleCacheToDay(const ScheduleCacheRecord &r, DaySchedule &out) {
+  out.day = r.key.day;
+  out.source = SCHED_API;
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    snprintf(out.times[i], sizeof(out.times[i]), "%02u:%02u",
+             r.minutes[i] / 60, r.minutes[i] % 60);
+  }
+}
+
+void scheduleCacheStat(uint32_t ScheduleCacheStats::*counter) {
+  portENTER_CRITICAL(&scheduleCacheMux);
+  scheduleCacheStats.*counter += 1;
+  portEXIT_CRITICAL(&scheduleCacheMux);
+}
+
+// FILE DIBUAT SEKALI DENGAN SEMUA SLOT KOSONG; FORMAT LAIN DIBUANG.
+// SEKALIGUS MELANJUTKAN scheduleCacheClock DARI STAMP TERBESAR DI FILE.
+bool scheduleCacheEnsureFile() {
+  if (scheduleCacheFileReady) return true;
+
+  if (LittleFS.exists(SCHEDULE_CACHE_FILE)) {
+    fs::File file = LittleFS.open(SCHEDULE_CACHE_FILE, "r");
+    ScheduleCacheFileHeader header = {};
+    bool ok = file &&
+              file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == SCHEDULE_CACHE_MAGIC &&
+              header.recordSize == sizeof(ScheduleCacheRecord) &&
+              header.slots == SCHEDULE_CACHE_FILE_SLOTS &&
+              file.size() == sizeof(header) + SCHEDULE_CACHE_FILE_SLOTS * sizeof(ScheduleCacheRecord);
+
+    if (ok) {
+      ScheduleCacheRecord r;
+      for (uint16_t i = 0; i < SCHEDULE_CACHE_FILE_SLOTS; i++) {
+        if (file.read((uint8_t *)&r, sizeof(r)) != sizeof(r)) break;
+        if (scheduleCacheRecordValid(r) && r.stamp > scheduleCacheClock) scheduleCacheClock = r.stamp;
+      }
+    }
+    if (file) file.close();
+
+    if (ok) {
+      scheduleCacheFileReady = true;
+      return true;
+    }
+    Serial.println("[CACHE] FORMAT FILE CACHE JADWAL BERBEDA - DIBUAT ULANG");
+  }
+
+  fs::File file = LittleFS.open(SCHEDULE_CACHE_FILE, "w");
+  if (!file) {
+    scheduleCacheStat(&ScheduleCacheStats::flashErrors);
+    return false;
+  }
+
+  ScheduleCacheFileHeader header = {
+    SCHEDULE_CACHE_MAGIC, (uint16_t)sizeof(ScheduleCacheRecord), SCHEDULE_CACHE_FILE_SLOTS
+  };
+  ScheduleCacheRecord empty = {};
+  bool ok = file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header);
+  for (uint16_t i = 0; ok && i < SCHEDULE_CACHE_FILE_SLOTS; i++) {
+    ok = file.write((const uint8_t *)&empty, sizeof(empty)) == sizeof(empty);
+  }
+  file.close();
+
+  if (!ok) {
+    scheduleCacheStat(&ScheduleCacheStats::flashErrors);
+    LittleFS.remove(SCHEDULE_CACHE_FILE);
+    return false;
+  }
+  scheduleCacheFileReady = true;
+  return true;
+}
+
+bool scheduleCacheFlashFind(const ScheduleCacheKey &key, ScheduleCacheRecord &out) {
+  if (!scheduleCacheEnsureFile()) return false;
+
+  fs::File file = LittleFS.open(SCHEDULE_CACHE_FILE, "r");
+  if (!file) return false;
+  file.seek(sizeof(ScheduleCacheFileHeader));
+
+  bool found = false;
+  ScheduleCacheRecord r;
+  for (uint16_t i = 0; i < SCHEDULE_CACHE_FILE_SLOTS; i++) {
+    if (file.read((uint8_t *)&r, sizeof(r)) != sizeof(r)) break;
+    if (scheduleCacheRecordValid(r) && memcmp(&r.key, &key, sizeof(key)) == 0) {
+      out = r;
+      found = true;
+      break;
+    }
+  }
+  file.close();
+  return found;
+}
+
+// SLOT DENGAN KUNCI SAMA, SLOT KOSONG / RUSAK, ATAU STAMP TERKECIL
+void scheduleCacheFlashPut(const ScheduleCacheRecord &rec) {
+  if (!scheduleCacheEnsureFile()) return;
+
+  fs::File file = LittleFS.open(SCHEDULE_CACHE_FILE, "r+");
+  if (!file) {
+    scheduleCacheStat(&ScheduleCacheStats::flashErrors);
+    return;
+  }
+  file.seek(sizeof(ScheduleCacheFileHeader));
+
+  int16_t slot = -1;
+  uint32_t oldest = UINT32_MAX;
+  ScheduleCacheRecord r;
+  for (uint16_t i = 0; i < SCHEDULE_CACHE_FILE_SLOTS; i++) {
+    if (file.read((uint8_t *)&r, sizeof(r)) != sizeof(r)) break;
+    if (!scheduleCacheRecordValid(r)) {
+      if (oldest != 0) {
+        slot = i;
+        oldest = 0;
+      }
+      continue;
+    }
+    if (memcmp(&r.key, &rec.key, sizeof(rec.key)) == 0) {
+      slot = i;
+      break;
+    }
+    if (r.stamp < oldest) {
+      slot = i;
+      oldest = r.stamp;
+    }
+  }
+
+  bool ok = slot >= 0 &&
+            file.seek(sizeof(ScheduleCacheFileHeader) + slot * sizeof(ScheduleCacheRecord)) &&
+            file.write((const uint8_t *)&rec, sizeof(rec)) == sizeof(rec);
+  file.close();
+  if (!ok) scheduleCacheStat(&ScheduleCacheStats::flashErrors);
+}
+
+void scheduleCacheRamPut(const ScheduleCacheRecord &rec) {
+  uint8_t victim = 0;
+  for (uint8_t i = 0; i < SCHEDULE_CACHE_RAM_SLOTS; i++) {
+    ScheduleCacheRecord &r = scheduleCacheRam[i];
+    if (r.stamp != 0 && memcmp(&r.key, &rec.key, sizeof(rec.key)) == 0) {
+      victim = i;
+      break;
+    }
+    if (r.stamp < scheduleCacheRam[victim].stamp) victim = i;
+  }
+
+  ScheduleCacheRecord &slot = scheduleCacheRam[victim];
+  if (slot.stamp != 0 && memcmp(&slot.key, &rec.key, sizeof(rec.key)) != 0) {
+    scheduleCacheStat(&ScheduleCacheStats::evictions);
+  }
+  slot = rec;
+}
+
+bool scheduleCacheLookup(const ScheduleCacheKey &key, DaySchedule &out) {
+  uint32_t t0 = micros();
+  bool hit = false;
+
+  for (uint8_t i = 0; i < SCHEDULE_CACHE_RAM_SLOTS; i++) {
+    ScheduleCacheRecord &r = scheduleCacheRam[i];
+    if (r.stamp != 0 && memcmp(&r.key, &key, sizeof(key)) == 0) {
+      r.stamp = ++scheduleCacheClock;
+      scheduleCacheToDay(r, out);
+      scheduleCacheStat(&ScheduleCacheStats::ramHits);
+      hit = true;
+      break;
+    }
+  }
+
+  if (!hit) {
+    ScheduleCacheRecord r;
+    if (scheduleCacheFlashFind(key, r)) {
+      // CRC SUDAH DIHITUNG DENGAN STAMP LAMA - RECORD RAM TIDAK DIPERIKSA CRC
+      r.stamp = ++scheduleCacheClock;
+      scheduleCacheRamPut(r);
+      scheduleCacheToDay(r, out);
+      scheduleCacheStat(&ScheduleCacheStats::flashHits);
+      hit = true;
+    } else {
+      scheduleCacheStat(&ScheduleCacheStats::misses);
+    }
+  }
+
+  uint32_t us = micros() - t0;
+  portENTER_CRITICAL(&scheduleCacheMux);
+  scheduleCacheStats.lastLookupUs = us;
+  if (us > scheduleCacheStats.maxLookupUs) scheduleCacheStats.maxLookupUs = us;
+  portEXIT_CRITICAL(&scheduleCacheMux);
+  return hit;
+}
+
+void scheduleCacheStore(const ScheduleCacheKey &key, const DaySchedule &day) {
+  ScheduleCacheRecord rec = {};
+  rec.key = key;
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    int m = parseMinuteOfDay(String(day.times[i]));
+    if (m < 0) return;
+    rec.minutes[i] = (uint16_t)m;
+  }
+  rec.stamp = ++scheduleCacheClock;
+  rec.crc = scheduleCacheCrc(rec);
+
+  scheduleCacheRamPut(rec);
+  scheduleCacheFlashPut(rec);
+  scheduleCacheStat(&ScheduleCacheStats::stores);
+}
+
+// ============================================
+// DOKUMEN STATE TERGABUNG: SATU SNAPSHOT, DI-CACHE SAMPAI ADA PERUBAHAN
+// ============================================
+void markStateChanged() {
+  stateVersion++;
+}
+
+bool isClientOnLocalAP(AsyncWebServerRequest *request) {
+  IPAddress clientIP = request -> client() -> remoteIP();
+  IPAddress apIP = WiFi.softAPIP();
+  IPAddress apSubnet = WiFi.softAPSubnetMask();
+
+  for (int i = 0; i < 4; i++) {
+    if ((apIP[i] & apSubnet[i]) != (clientIP[i] & apSubnet[i])) return false;
+  }
+  return true;
+}
+
+bool isValidCoordinate(const String &value, float limit) {
+  if (value.length() == 0 || value.length() > 20) return false;
+
+  char *end = NULL;
+  float v = strtof(value.c_str(), &end);
+  if (end == value.c_str() || *end != '\0') return false;
+
+  return v >= -limit && v <= limit;
+}
+
+// DIPANGGIL DENGAN settingsMutex DIPEGANG
+void buildStateDocument(uint32_t version) {
+  char routerSSID[64] = "";
+  char routerPassword[64] = "";
+
+  if (xSemaphoreTake(wifiMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    strncpy(routerSSID,     wifiConfig.routerSSID.c_str(),     sizeof(routerSSID) - 1);
+    strncpy(routerPassword, wifiConfig.routerPassword.c_str(), sizeof(routerPassword) - 1);
+    xSemaphoreGive(wifiMutex);
+  }
+
+  String apSSID = WiFi.softAPSSID();
+  if (apSSID.length() == 0 || apSSID == "null") apSSID = String(wifiConfig.apSSID);
+  if (apSSID.length() == 0) apSSID = DEFAULT_AP_SSID;
+
+  String apPassword = String(wifiConfig.apPassword);
+  if (apPassword.length() == 0) apPassword = DEFAULT_AP_PASSWORD;
+
+  String apIP = wifiConfig.apIP.toString();
+  String apGateway = wifiConfig.apGateway.toString();
+  String apSubnet = wifiConfig.apSubnet.toString();
+
+  StateDocFields s;
+  s.version = version;
+  s.routerSSID = routerSSID;
+  s.routerPassword = routerPassword;
+  s.apSSID = apSSID.c_str();
+  s.apPassword = apPassword.c_str();
+  s.apIP = apIP.c_str();
+  s.apGateway = apGateway.c_str();
+  s.apSubnet = apSubnet.c_str();
+  s.timezoneOffset = timezoneOffset;
+  s.methodId = methodConfig.methodId;
+  s.methodName = methodConfig.methodName.c_str();
+  s.selectedCity = prayerConfig.selectedCity.c_str();
+  s.latitude = prayerConfig.latitude.c_str();
+  s.longitude = prayerConfig.longitude.c_str();
+  s.alarmEnabled = alarmConfig.alarmEnabled;
+  s.alarmTime = alarmConfig.alarmTime;
+  s.volume = buzzerConfig.volume;
+
+  const int tunes[PRAYER_COUNT] = {
+    prayerConfig.tuneImsak, prayerConfig.tuneSubuh, prayerConfig.tuneTerbit, prayerConfig.tuneZuhur,
+    prayerConfig.tuneAshar, prayerConfig.tuneMaghrib, prayerConfig.tuneIsya
+  };
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    const PrayerInfo &info = PRAYER_INFO[i];
+    s.tune[i] = tunes[i];
+    s.times[i] = (prayerConfig.*info.time).c_str();
+    s.buzzer[i] = buzzerConfig.*info.enabled;
+  }
+  for (uint8_t i = 0; i < STATE_DOC_PATTERNS; i++) {
+    s.patterns[i] = BUZZER_PATTERN_NAMES[buzzerConfig.pattern[i]];
+  }
+
+  char *buf = (char *)malloc(STATE_DOC_SIZE);
+  if (buf == NULL) return;
+
+  int len = formatStateDocument(buf, STATE_DOC_SIZE, s);
+
+  if (len > 0 && len < STATE_DOC_SIZE) {
+    stateCacheBody = buf;
+    stateCacheVersion = version;
+  } else {
+    Serial.println("DOKUMEN STATE TERPOTONG - BUFFER KURANG");
+  }
+
+  free(buf);
+}
+
+// ============================================
+// ANTRIAN JOB: PEKERJAAN BLOKING DARI RUTE WEB
+// ============================================
+const char *jobTypeName(JobType type) {
+  switch (type) {
+    case JOB_APPLY_SETTINGS: return "settings";
+    case JOB_SYNC_TIME:      return "synctime";
+    case JOB_PERSIST:        return "persist";
+  }
+  return "unknown";
+}
+
+const char *jobStateName(JobState state) {
+  switch (state) {
+    case JOB_QUEUED:  return "queued";
+    case JOB_RUNNING: return "running";
+    case JOB_DONE:    return "done";
+    case JOB_FAILED:  return "failed";
+  }
+  return "unknown";
+}
+
+uint32_t enqueueJob(Job &job) {
+  if (jobQueue == NULL) return 0;
+
+  portENTER_CRITICAL(&jobMux);
+  jobBoardOpen(jobBoard, job, millis());
+  portEXIT_CRITICAL(&jobMux);
+
+  job.queuedAt = millis();
+
+  if (xQueueSend(jobQueue, &job, 0) != pdTRUE) {
+    portENTER_CRITICAL(&jobMux);
+    jobBoardDrop(jobBoard, job.id);
+    portEXIT_CRITICAL(&jobMux);
+    Serial.println("[JOB] ANTRIAN PENUH - DITOLAK");
+    return 0;
+  }
+
+  return job.id;
+}
+
+void updateJobStatus(uint32_t id, JobState state, uint32_t waitMs, uint32_t runMs, const char *result) {
+  portENTER_CRITICAL(&jobMux);
+  jobBoardUpdate(jobBoard, id, state, waitMs, runMs, result);
+  portEXIT_CRITICAL(&jobMux);
+}
+
+// JOB YANG SUDAH ANTRE MENYIMPAN NILAI TERBARU DI RAM (jobBoardAddPersist).
+// TIDAK PERNAH MENULIS FLASH DI SINI: PEMANGGIL BISA clockTickTask ATAU
+// async_tcp. ANTRIAN PENUH = BIT TETAP MENUNGGU, jobTask MENGURASNYA SETELAH
+// JOB BERIKUTNYA ATAU SAAT TIMEOUT ANTRIAN.
+void requestPersist(uint8_t mask) {
+  markStateChanged();   // RAM SUDAH BERUBAH, CACHE /api/v2/state TIDAK MENUNGGU FLASH
+  queuePersist(mask);
+}
+
+// TANPA markStateChanged: UNTUK DATA YANG TIDAK MASUK /api/v2/state (SPLASH)
+void queuePersist(uint8_t mask) {
+  portENTER_CRITICAL(&jobMux);
+  bool first = jobBoardAddPersist(jobBoard, mask);
+  portEXIT_CRITICAL(&jobMux);
+
+  if (!first) return;
+
+  Job job = {};
+  job.type = JOB_PERSIST;
+  if (enqueueJob(job) == 0) {
+    Serial.println("[JOB] PERSIST MENUNGGU - DIKURAS jobTask");
+  }
+}
+
+// DIPANGGIL HANYA DARI jobTask. MENGEMBALIKAN MASK YANG DITULIS.
+uint8_t drainPersist() {
+  portENTER_CRITICAL(&jobMux);
+  uint8_t mask = jobBoardTakePersist(jobBoard);
+  portEXIT_CRITICAL(&jobMux);
+
+  if (mask & PERSIST_BUZZER) saveBuzzerConfig();
+  if (mask & PERSIST_ALARM) saveAlarmConfig();
+  if (mask & (PERSIST_BUZZER | PERSIST_ALARM)) traceConfig();
+  if (mask & PERSIST_PRAYER) savePrayerTimes();
+  if (mask & PERSIST_MIRROR) saveScheduleMirror();
+  if (mask & PERSIST_ADZAN) saveAdzanState();
+  if (mask & PERSIST_SPLASH) saveSplashSnapshot();
+  return mask;
+}
+
+void sendJobQueueFull(AsyncWebServerRequest *request) {
+  AsyncWebServerResponse *response = request->beginResponse(503, "application/json",
+    "{\"error\":\"Job queue full\"}");
+  response->addHeader("Retry-After", "1");
+  request->send(response);
+}
+
+// JOB BARU DIANTREKAN, BELUM DIJALANKAN: HASIL SEBENARNYA HANYA DI /api/jobs
+void sendJobAccepted(AsyncWebServerRequest *request, uint32_t jobId) {
+  char body[112];
+  snprintf(body, sizeof(body),
+    "{\"success\":true,\"queued\":true,\"jobId\":%lu,\"status\":\"/api/jobs?id=%lu\"}",
+    (unsigned long)jobId, (unsigned long)jobId);
+  AsyncWebServerResponse *response = request->beginResponse(202, "application/json", body);
+  response->addHeader("X-Job-Id", String(jobId));
+  request->send(response);
+}
+
+// DIJALANKAN OLEH jobTask. RUTE LAMA MEMAKAI force AGAR PERILAKU TETAP:
+// SELALU MENYIMPAN DAN MEMICU PEMBARUAN WALAU NILAINYA SAMA.
+bool applySettingsPatch(const SettingsPatch &p, char *result, size_t resultLen) {
+  bool anyTune = false;
+  for (int i = 0; i < 7; i++) anyTune |= p.hasTune[i];
+
+  bool cityChanged = p.force && (p.hasCity || p.hasCoords || anyTune);
+  bool methodChanged = p.force && p.hasMethod;
+  bool timezoneChanged = p.force && p.hasTimezone;
+  String curLat, curLon;
+
+  if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(5000)) != pdTRUE) {
+    snprintf(result, resultLen, "\"Settings busy\"");
+    return false;
+  }
+
+  if (p.hasCity) {
+    cityChanged |= (prayerConfig.selectedCity != p.cityApi ||
+                    prayerConfig.selectedCityName != p.cityName);
+    prayerConfig.selectedCity = p.cityApi;
+    prayerConfig.selectedCityName = p.cityName;
+  }
+
+  if (p.hasCoords) {
+    cityChanged |= (prayerConfig.latitude != p.lat || prayerConfig.longitude != p.lon);
+    prayerConfig.latitude = p.lat;
+    prayerConfig.longitude = p.lon;
+  }
+
+  int *tuneFields[7] = {
+    &prayerConfig.tuneImsak, &prayerConfig.tuneSubuh, &prayerConfig.tuneTerbit,
+    &prayerConfig.tuneZuhur, &prayerConfig.tuneAshar, &prayerConfig.tuneMaghrib,
+    &prayerConfig.tuneIsya
+  };
+  for (int i = 0; i < 7; i++) {
+    if (p.hasTune[i] && *tuneFields[i] != p.tune[i]) {
+      *tuneFields[i] = p.tune[i];
+      cityChanged = true;
+    }
+  }
+
+  if (p.hasMethod) {
+    methodChanged |= (methodConfig.methodId != p.methodId ||
+                      methodConfig.methodName != p.methodName);
+    methodConfig.methodId = p.methodId;
+    methodConfig.methodName = p.methodName;
+  }
+
+  if (p.hasTimezone) {
+    timezoneChanged |= (timezoneOffset != p.offset);
+    timezoneOffset = p.offset;
+  }
+
+  curLat = prayerConfig.latitude;
+  curLon = prayerConfig.longitude;
+  xSemaphoreGive(settingsMutex);
+
+  // TIAP FILE YANG TERSENTUH DITULIS SATU KALI
+  if (cityChanged) saveCitySelection();
+  if (methodChanged) saveMethodSelection();
+  if (timezoneChanged) saveTimezoneConfig();
+
+  // PALING BANYAK SATU KALI HITUNG ULANG
+  bool hasLocation = curLat.length() > 0 && curLon.length() > 0;
+  bool ntpTriggered = false;
+  bool prayerUpdating = false;
+
+  if (timezoneChanged && wifiConfig.isConnected && ntpTaskHandle != NULL) {
+    // NTP YANG BERHASIL SUDAH MEMICU PEMBARUAN SHALAT DENGAN TANGGAL BARU
+    if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+      timeConfig.ntpSynced = false;
+      xSemaphoreGive(timeMutex);
+    }
+    xTaskNotifyGive(ntpTaskHandle);
+    ntpTriggered = true;
+    prayerUpdating = hasLocation;
+  } else if ((cityChanged || methodChanged) && hasLocation && WiFi.status() == WL_CONNECTED) {
+    requestPrayerUpdate(curLat, curLon);
+    prayerUpdating = true;
+  }
+
+  // BUFFER BESOK DIAMBIL/DIHITUNG ULANG SETELAH ISYA
+  if (cityChanged || methodChanged || timezoneChanged) {
+    scheduleInvalidateTomorrow();
+  }
+
+  Serial.printf("[JOB] PENGATURAN: KOTA=%s METODE=%s TIMEZONE=%s NTP=%s SHALAT=%s\n",
+                cityChanged ? "YA" : "TIDAK",
+                methodChanged ? "YA" : "TIDAK",
+                timezoneChanged ? "YA" : "TIDAK",
+                ntpTriggered ? "YA" : "TIDAK",
+                prayerUpdating ? "YA" : "TIDAK");
+
+  snprintf(result, resultLen,
+    "{\"changed\":{\"city\":%s,\"method\":%s,\"timezone\":%s},"
+    "\"ntpTriggered\":%s,\"prayerTimesUpdating\":%s}",
+    cityChanged ? "true" : "false",
+    methodChanged ? "true" : "false",
+    timezoneChanged ? "true" : "false",
+    ntpTriggered ? "true" : "false",
+    prayerUpdating ? "true" : "false"
+  );
+  return true;
+}
+
+bool runTimeSyncJob(const TimeSyncJob &t, unsigned long queuedAt, char *result, size_t resultLen) {
+  Serial.println("\n========================================");
+  Serial.println("SINKRONISASI WAKTU BROWSER");
+  Serial.println("========================================");
+  Serial.printf("DITERIMA: %02d:%02d:%02d %02d/%02d/%04d\n", t.h, t.i, t.s, t.d, t.m, t.y);
+
+  if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+    snprintf(result, resultLen, "\"Time busy\"");
+    return false;
+  }
+
+  setTime(t.h, t.i, t.s, t.d, t.m, t.y);
+  adjustTime((millis() - queuedAt) / 1000);   // KOMPENSASI WAKTU TUNGGU ANTREAN
+  timeConfig.currentTime = now();
+  timeConfig.ntpSynced = true;
+
+  DisplayUpdate update;
+  update.type = DisplayUpdate::TIME_UPDATE;
+  xQueueSend(displayQueue, & update, 0);
+
+  xSemaphoreGive(timeMutex);
+
+  if (!rtcAvailable) {
+    Serial.println("\nRTC TIDAK TERSEDIA - WAKTU AKAN DIRESET SAAT RESTART");
+    Serial.println("========================================\n");
+    snprintf(result, resultLen, "{\"rtcSaved\":false}");
+    return true;
+  }
+
+  Serial.println("\nMENYIMPAN WAKTU KE HARDWARE RTC...");
+
+  saveTimeToRTC();
+
+  vTaskDelay(pdMS_TO_TICKS(500));
+
+  DateTime rtcNow;
+  bool rtcRead = false;
+  if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+    rtcNow = rtc.now();
+    rtcRead = true;
+    xSemaphoreGive(i2cMutex);
+  }
+
+  Serial.println("VERIFIKASI RTC:");
+  Serial.printf("   RTC: %02d:%02d:%02d %02d/%02d/%04d",
+    rtcNow.hour(), rtcNow.minute(), rtcNow.second(),
+    rtcNow.day(), rtcNow.month(), rtcNow.year());
+
+  bool rtcValid = rtcRead && (
+    rtcNow.year() >= 2000 && rtcNow.year() <= 2100 &&
+    rtcNow.month() >= 1 && rtcNow.month() <= 12 &&
+    rtcNow.day() >= 1 && rtcNow.day() <= 31
+  );
+
+  if (rtcValid) {
+    Serial.println("RTC BERHASIL DISIMPAN");
+    Serial.println("WAKTU AKAN BERTAHAN SAAT RESTART");
+  } else {
+    Serial.println("SIMPAN RTC GAGAL - WAKTU TIDAK VALID");
+    Serial.println("PERIKSA BATERAI RTC ATAU KONEKSI I2C");
+  }
+  Serial.println("========================================\n");
+
+  snprintf(result, resultLen, "{\"rtcSaved\":%s}", rtcValid ? "true" : "false");
+  return true;
+}
+
+void jobTask(void *parameter) {
+  esp_task_wdt_add(NULL);
+
+  Serial.println("[JOB] TUGAS JOB DIMULAI");
+
+  Job job;
+  char result[JOB_RESULT_LEN];
+
+  while (true) {
+    esp_task_wdt_reset();
+
+    if (xQueueReceive(jobQueue, &job, pdMS_TO_TICKS(JOB_PERSIST_DRAIN_MS)) != pdTRUE) {
+      // BIT PERSIST YANG TERTINGGAL SAAT ANTRIAN PENUH
+      uint8_t mask = drainPersist();
+      if (mask) Serial.printf("[JOB] PERSIST TERTUNDA DISIMPAN (MASK 0x%02X)\n", mask);
+      continue;
+    }
+
+    unsigned long startedAt = millis();
+    uint32_t waitMs = startedAt - job.queuedAt;
+    updateJobStatus(job.id, JOB_RUNNING, waitMs, 0, NULL);
+
+    result[0] = '\0';
+    bool ok = false;
+
+    switch (job.type) {
+      case JOB_APPLY_SETTINGS:
+        ok = applySettingsPatch(job.settings, result, sizeof(result));
+        break;
+      case JOB_SYNC_TIME:
+        ok = runTimeSyncJob(job.time, job.queuedAt, result, sizeof(result));
+        break;
+      case JOB_PERSIST: {
+        uint8_t mask = drainPersist();
+
+        snprintf(result, sizeof(result),
+                 "{\"buzzer\":%s,\"alarm\":%s,\"prayer\":%s,\"mirror\":%s,\"adzan\":%s,\"splash\":%s}",
+                 (mask & PERSIST_BUZZER) ? "true" : "false",
+                 (mask & PERSIST_ALARM) ? "true" : "false",
+                 (mask & PERSIST_PRAYER) ? "true" : "false",
+                 (mask & PERSIST_MIRROR) ? "true" : "false",
+                 (mask & PERSIST_ADZAN) ? "true" : "false",
+                 (mask & PERSIST_SPLASH) ? "true" : "false");
+        ok = true;
+        break;
+      }
+    }
+
+    uint32_t runMs = millis() - startedAt;
+    updateJobStatus(job.id, ok ? JOB_DONE : JOB_FAILED, waitMs, runMs, result);
+
+    Serial.printf("[JOB] #%lu %s %s (ANTRE %lu MS, JALAN %lu MS)\n",
+                  (unsigned long)job.id, jobTypeName(job.type),
+                  ok ? "SELESAI" : "GAGAL",
+                  (unsigned long)waitMs, (unsigned long)runMs);
+  }
+}
+
+void appendJobStatusJSON(String &out, const JobStatus &st) {
+  char buf[96 + JOB_RESULT_LEN];
+  snprintf(buf, sizeof(buf),
+    "{\"id\":%lu,\"type\":\"%s\",\"state\":\"%s\",\"waitMs\":%lu,\"runMs\":%lu,\"result\":%s}",
+    (unsigned long)st.id,
+    jobTypeName(st.type),
+    jobStateName(st.state),
+    (unsigned long)st.waitMs,
+    (unsigned long)st.runMs,
+    st.result[0] ? st.result : "null"
+  );
+  out += buf;
+}
+
+// ============================================
+// TABEL RUTE: LIHAT route_table.h
+// ============================================
+struct RouteHandler {
+  WebRequestMethodComposite method;
+  ArRequestHandlerFunction fn;
+};
+
+RouteHandler routeHandlers[ROUTE_COUNT];
+
+void routeOn(const char *path, WebRequestMethodComposite method, ArRequestHandlerFunction fn) {
+  int idx = routeLookup(path);
+  if (idx < 0) {
+    // LUPA DITAMBAHKAN KE ROUTE_PATHS: TETAP JALAN LEWAT PENCOCOKAN LINEAR
+    Serial.printf("[RUTE] %s TIDAK ADA DI ROUTE_PATHS - FALLBACK server.on()\n", path);
+    server.on(path, method, fn);
+    return;
+  }
+
+  routeHandlers[idx].method = method;
+  routeHandlers[idx].fn = fn;
+}
+
+// DIPANGGIL DARI onNotFound. FALSE = BUKAN RUTE TABEL (LANJUT KE 404)
+bool dispatchRoute(AsyncWebServerRequest *request) {
+  int idx = routeLookup(request->url().c_str());
+  if (idx < 0 || !routeHandlers[idx].fn) return false;
+
+  if (!(routeHandlers[idx].method & request->method())) {
+    request->send(405, "text/plain", "Method Not Allowed");
+    return true;
+  }
+
+  uint32_t digest = TRACE_DIGEST_SEED;
+#if TRACE_ENABLED
+  size_t count = request->params();
+  for (size_t i = 0; i < count; i++) {
+    const AsyncWebParameter *p = request->getParam(i);
+    const String &name = p->name();
+    const String &value = p->value();
+    digest = traceDigest(digest, name.c_str(), name.length());
+    digest = traceDigest(digest, "=", 1);
+    // PASSWORD HANYA PANJANGNYA: DIGEST TIDAK BOLEH BISA DITEBAK ULANG
+    if (name.indexOf("assword") >= 0) {
+      uint32_t len = value.length();
+      digest = traceDigest(digest, (const char *)&len, sizeof(len));
+    } else {
+      digest = traceDigest(digest, value.c_str(), value.length());
+    }
+    digest = traceDigest(digest, "&", 1);
+  }
+#endif
+
+  uint32_t startUs = micros();
+  routeHandlers[idx].fn(request);
+  traceRecord(TRACE_HTTP_REQ, (uint8_t)request->method(), (uint16_t)idx, (int32_t)digest, micros() - startUs);
+  return true;
+}
+
+// ============================================
+// SKEMA PARAMETER FORM: SATU PASS KE STRUCT BERTIPE
+// ============================================
+// hasParam()/getParam(name) memindai seluruh daftar parameter per panggilan.
+// Skema deklaratif (param_schema.h) membaca setiap parameter POST tepat sekali.
+template <typename T, size_t N>
+ParamResult parseParams(AsyncWebServerRequest *request, const ParamSpec (&schema)[N], T &out) {
+  return parseParamList(schema, out, request->params(),
+    [request](size_t i, const char *&name, const char *&value, size_t &len) {
+      const AsyncWebParameter *p = request->getParam(i);
+      if (!p->isPost() || p->isFile()) return false;
+      name = p->name().c_str();
+      value = p->value().c_str();
+      len = p->value().length();
+      return true;
+    });
+}
+
+template <size_t N>
+String paramFieldList(const ParamSpec (&schema)[N], uint32_t mask) {
+  String out;
+  for (size_t k = 0; k < N; k++) {
+    if (!(mask & (1UL << k))) continue;
+    if (out.length() > 0) out += ",";
+    out += "\"";
+    out += schema[k].name;
+    out += "\"";
+  }
+  return out;
+}
+
+// ---- SKEMA PER RUTE ----
+// URUTAN FIELD = NOMOR BIT DI ParamResult; ENUM *_P_* HARUS IKUT URUTAN INI.
+enum CityParam {
+  CITY_P_CITY, CITY_P_NAME, CITY_P_LAT, CITY_P_LON,
+  CITY_P_TUNE0   // tuneImsak..tuneIsya = CITY_P_TUNE0 + 0..6
+};
+
+const ParamSpec CITY_SCHEMA[] = {
+  { "city",        PARAM_STR, PARAM_REQUIRED | PARAM_CLIP, 0, 100, PARAM_FIELD(SettingsPatch, cityApi) },
+  { "cityName",    PARAM_STR, PARAM_CLIP, 0, 100, PARAM_FIELD(SettingsPatch, cityName) },
+  { "lat",         PARAM_STR, PARAM_CLIP, 0, 20,  PARAM_FIELD(SettingsPatch, lat) },
+  { "lon",         PARAM_STR, PARAM_CLIP, 0, 20,  PARAM_FIELD(SettingsPatch, lon) },
+  { "tuneImsak",   PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[0]) },
+  { "tuneSubuh",   PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[1]) },
+  { "tuneTerbit",  PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[2]) },
+  { "tuneZuhur",   PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[3]) },
+  { "tuneAshar",   PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[4]) },
+  { "tuneMaghrib", PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[5]) },
+  { "tuneIsya",    PARAM_INT, 0, -99, 99, PARAM_FIELD(SettingsPatch, tune[6]) }
+};
+
+enum MethodParam {
+  METHOD_P_ID, METHOD_P_NAME
+};
+
+const ParamSpec METHOD_SCHEMA[] = {
+  { "methodId",   PARAM_INT, PARAM_REQUIRED, 0, 20,  PARAM_FIELD(SettingsPatch, methodId) },
+  { "methodName", PARAM_STR, PARAM_REQUIRED, 1, 100, PARAM_FIELD(SettingsPatch, methodName) }
+};
+
+const ParamSpec TIMEZONE_SCHEMA[] = {
+  { "offset", PARAM_INT, PARAM_REQUIRED, -12, 14, PARAM_FIELD(SettingsPatch, offset) }
+};
+
+enum SettingsParam {
+  SET_P_CITY, SET_P_NAME, SET_P_LAT, SET_P_LON,
+  SET_P_METHOD_ID, SET_P_METHOD_NAME, SET_P_TIMEZONE,
+  SET_P_TUNE0    // tuneImsak..tuneIsya = SET_P_TUNE0 + 0..6
+};
+
+const ParamSpec SETTINGS_SCHEMA[] = {
+  { "city",        PARAM_STR, 0, 1, 100,   PARAM_FIELD(SettingsPatch, cityApi) },
+  { "cityName",    PARAM_STR, 0, 0, 100,   PARAM_FIELD(SettingsPatch, cityName) },
+  { "lat",         PARAM_STR, 0, 1, 20,    PARAM_FIELD(SettingsPatch, lat) },
+  { "lon",         PARAM_STR, 0, 1, 20,    PARAM_FIELD(SettingsPatch, lon) },
+  { "methodId",    PARAM_INT, 0, 0, 20,    PARAM_FIELD(SettingsPatch, methodId) },
+  { "methodName",  PARAM_STR, 0, 1, 100,   PARAM_FIELD(SettingsPatch, methodName) },
+  { "timezone",    PARAM_INT, 0, -12, 14,  PARAM_FIELD(SettingsPatch, offset) },
+  { "tuneImsak",   PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[0]) },
+  { "tuneSubuh",   PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[1]) },
+  { "tuneTerbit",  PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[2]) },
+  { "tuneZuhur",   PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[3]) },
+  { "tuneAshar",   PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[4]) },
+  { "tuneMaghrib", PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[5]) },
+  { "tuneIsya",    PARAM_INT, 0, -99, 99,  PARAM_FIELD(SettingsPatch, tune[6]) }
+};
+
+const ParamSpec SYNCTIME_SCHEMA[] = {
+  { "y", PARAM_INT, PARAM_REQUIRED, 2000, 2099, PARAM_FIELD(TimeSyncJob, y) },
+  { "m", PARAM_INT, PARAM_REQUIRED, 1, 12,      PARAM_FIELD(TimeSyncJob, m) },
+  { "d", PARAM_INT, PARAM_REQUIRED, 1, 31,      PARAM_FIELD(TimeSyncJob, d) },
+  { "h", PARAM_INT, PARAM_REQUIRED, 0, 23,      PARAM_FIELD(TimeSyncJob, h) },
+  { "i", PARAM_INT, PARAM_REQUIRED, 0, 59,      PARAM_FIELD(TimeSyncJob, i) },
+  { "s", PARAM_INT, PARAM_REQUIRED, 0, 59,      PARAM_FIELD(TimeSyncJob, s) }
+};
+
+// ============================================
+// FUNGSI SERVER WEB
+// ============================================
+void setupServerRoutes() {
+  routeOn("/", HTTP_GET, [](AsyncWebServerRequest * request) {
+    if (!LittleFS.exists("/index.html")) {
+      request -> send(404, "text/plain", "index.html not found");
+      return;
+    }
+
+    AsyncWebServerResponse * response = request -> beginResponse(
+      LittleFS, "/index.html", "text/html");
+
+    response -> addHeader("Cache-Control", "no-cache, no-store, must-revalidate");
+    response -> addHeader("Pragma", "no-cache");
+    response -> addHeader("Expires", "0");
+    response -> addHeader("Content-Type", "text/html; charset=utf-8");
+
+    request -> send(response);
+  });
+
+  routeOn("/css/foundation.min.css", HTTP_GET, [](AsyncWebServerRequest * request) {
+    if (!LittleFS.exists("/css/foundation.min.css")) {
+      request -> send(404, "text/plain", "CSS not found");
+      return;
     }
 
     AsyncWebServerResponse * response = request -> beginResponse(
@@ -1952,7 +4614,7 @@ void setupServerRoutes() {
     request -> send(response);
   });
 
-  server.on("/devicestatus", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/devicestatus", HTTP_GET, [](AsyncWebServerRequest * request) {
     char timeStr[20];
     char dateStr[20];
 
@@ -1993,7 +4655,13 @@ void setupServerRoutes() {
       default:              wifiStateStr = "unknown"; break;
     }
 
-    char jsonBuffer[768];
+    uint32_t p50, p90, p99, maxMs;
+    uint8_t reconnectSamples;
+    getWiFiReconnectPercentiles(p50, p90, p99, maxMs, reconnectSamples);
+
+    DaySchedule tomorrow = scheduleTomorrowSnapshot();
+
+    char jsonBuffer[1024];
     snprintf(jsonBuffer, sizeof(jsonBuffer),
       "{"
       "\"connected\":%s,"
@@ -2006,7 +4674,24 @@ void setupServerRoutes() {
       "\"currentTime\":\"%s\","
       "\"currentDate\":\"%s\","
       "\"uptime\":%lu,"
-      "\"freeHeap\":\"%d\""
+      "\"freeHeap\":\"%d\","
+      "\"touchLatencyUs\":%lu,"
+      "\"touchLatencyMaxUs\":%lu,"
+      "\"touchCount\":%lu,"
+      "\"clockSource\":\"%s\","
+      "\"sqwMissed\":%lu,"
+      "\"rtcAging\":%d,"
+      "\"rtcPpm\":%.2f,"
+      "\"rtcOffsetMs\":%ld,"
+      "\"ntpIntervalS\":%lu,"
+      "\"hotState\":\"%s\","
+      "\"flashWritesSkipped\":%lu,"
+      "\"scheduleToday\":%s,"
+      "\"tomorrowSource\":\"%s\","
+      "\"wifiReconnect\":{"
+        "\"samples\":%d,\"p50\":%lu,\"p90\":%lu,\"p99\":%lu,\"max\":%lu,"
+        "\"directed\":%lu,\"targeted\":%lu,\"fullScan\":%lu"
+      "}"
       "}",
       isWiFiConnected ? "true" : "false",
       wifiStateStr.c_str(),
@@ -2018,13 +4703,31 @@ void setupServerRoutes() {
       timeStr,
       dateStr,
       millis() / 1000,
-      ESP.getFreeHeap()
+      ESP.getFreeHeap(),
+      (unsigned long)touchStats.lastLatencyUs,
+      (unsigned long)touchStats.maxLatencyUs,
+      (unsigned long)touchStats.pressCount,
+      rtcSqwActive ? "rtc_sqw" : "timer",
+      (unsigned long)rtcSqwMissedTotal,
+      rtcCal.aging,
+      rtcCal.lastPpm,
+      (long)rtcCal.lastOffsetMs,
+      (unsigned long)ntpSyncIntervalS,
+      hotStateRestored ? "restored" : "cold",
+      (unsigned long)hotStateFlashSkipped,
+      scheduleDay == (int32_t)(now_t / 86400) ? "true" : "false",
+      scheduleSourceName(tomorrow.day == (int32_t)(now_t / 86400) + 1 ? tomorrow.source : SCHED_NONE),
+      reconnectSamples,
+      (unsigned long)p50, (unsigned long)p90, (unsigned long)p99, (unsigned long)maxMs,
+      (unsigned long)wifiReconnectStats.stageWins[WIFI_STAGE_DIRECTED],
+      (unsigned long)wifiReconnectStats.stageWins[WIFI_STAGE_TARGETED],
+      (unsigned long)wifiReconnectStats.stageWins[WIFI_STAGE_FULL]
     );
 
     sendJSONResponse(request, String(jsonBuffer));
   });
 
-  server.on("/restart", HTTP_POST, [](AsyncWebServerRequest *request) {
+  routeOn("/restart", HTTP_POST, [](AsyncWebServerRequest *request) {
       if (restartTaskHandle != NULL) {
           vTaskDelete(restartTaskHandle);
           restartTaskHandle = NULL;
@@ -2074,16 +4777,13 @@ void setupServerRoutes() {
                           esp_task_wdt_delete(ntpTaskHandle);
                           vTaskSuspend(ntpTaskHandle);
                       }
-                      if (prayerTaskHandle != NULL) {
-                          esp_task_wdt_delete(prayerTaskHandle);
-                          vTaskSuspend(prayerTaskHandle);
+                      if (scheduleTaskHandle != NULL) {
+                          esp_task_wdt_delete(scheduleTaskHandle);
+                          vTaskSuspend(scheduleTaskHandle);
                       }
                       if (webTaskHandle != NULL) {
                           esp_task_wdt_delete(webTaskHandle);
                       }
-                      if (httpTaskHandle != NULL) {
-                          esp_task_wdt_delete(httpTaskHandle);
-                      }
 
                       WiFi.mode(WIFI_OFF);
                       vTaskDelay(pdMS_TO_TICKS(500));
@@ -2117,7 +4817,7 @@ void setupServerRoutes() {
       );
   });
 
-  server.on("/getwificonfig", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/getwificonfig", HTTP_GET, [](AsyncWebServerRequest * request) {
     char buf[512];
     char routerSSID[64] = "";
     char routerPassword[64] = "";
@@ -2157,7 +4857,7 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/setwifi", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/setwifi", HTTP_POST, [](AsyncWebServerRequest * request) {
     unsigned long now = millis();
     if (now - lastWiFiRestartRequest < RESTART_DEBOUNCE_MS) {
       unsigned long waitTime = RESTART_DEBOUNCE_MS - (now - lastWiFiRestartRequest);
@@ -2214,7 +4914,7 @@ void setupServerRoutes() {
     }
   });
 
-  server.on("/setap", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/setap", HTTP_POST, [](AsyncWebServerRequest * request) {
       unsigned long now = millis();
       if (now - lastAPRestartRequest < RESTART_DEBOUNCE_MS) {
           unsigned long waitTime = RESTART_DEBOUNCE_MS - (now - lastAPRestartRequest);
@@ -2376,111 +5076,191 @@ void setupServerRoutes() {
       xTaskCreate(restartAPTask, "APRestart", 5120, NULL, 1, NULL);
   });
 
-  server.on("/api/connection-type", HTTP_GET, [](AsyncWebServerRequest * request) {
-    IPAddress clientIP = request -> client() -> remoteIP();
-    IPAddress apIP = WiFi.softAPIP();
-    IPAddress apSubnet = WiFi.softAPSubnetMask();
+  routeOn("/api/v2/state", HTTP_GET, [](AsyncWebServerRequest *request) {
+    bool isLocalAP = isClientOnLocalAP(request);
+    String body;
+    uint32_t version;
 
-    IPAddress apNetwork(
-      apIP[0] & apSubnet[0],
-      apIP[1] & apSubnet[1],
-      apIP[2] & apSubnet[2],
-      apIP[3] & apSubnet[3]
-    );
+    if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(200)) != pdTRUE) {
+      AsyncWebServerResponse *busy = request->beginResponse(503, "application/json", "{\"error\":\"Busy\"}");
+      busy->addHeader("Retry-After", "1");
+      request->send(busy);
+      return;
+    }
 
-    IPAddress clientNetwork(
-      clientIP[0] & apSubnet[0],
-      clientIP[1] & apSubnet[1],
-      clientIP[2] & apSubnet[2],
-      clientIP[3] & apSubnet[3]
-    );
+    version = stateVersion;
+    if (stateCacheVersion != version) {
+      buildStateDocument(version);
+    }
+    version = stateCacheVersion;
+    body = stateCacheBody;
+    xSemaphoreGive(settingsMutex);
 
-    bool isLocalAP = (apNetwork == clientNetwork);
+    if (body.length() == 0) {
+      request->send(500, "application/json", "{\"error\":\"State unavailable\"}");
+      return;
+    }
 
-    char buf[192];
-    snprintf(buf, sizeof(buf),
-      "{\"isLocalAP\":%s,\"clientIP\":\"%s\",\"apIP\":\"%s\",\"apSubnet\":\"%s\"}",
-      isLocalAP ? "true" : "false",
-      clientIP.toString().c_str(),
-      apIP.toString().c_str(),
-      apSubnet.toString().c_str()
-    );
-    sendJSONResponse(request, String(buf));
+    char etag[32];
+    snprintf(etag, sizeof(etag), "\"%08lx-%lu-%c\"",
+             (unsigned long)stateBootId, (unsigned long)version, isLocalAP ? 'a' : 's');
+
+    if (request->hasHeader("If-None-Match") &&
+        request->getHeader("If-None-Match")->value() == etag) {
+      AsyncWebServerResponse *notModified = request->beginResponse(304);
+      notModified->addHeader("ETag", etag);
+      notModified->addHeader("Cache-Control", "no-cache");
+      request->send(notModified);
+      return;
+    }
+
+    body += isLocalAP ? ",\"isLocalAP\":true}" : ",\"isLocalAP\":false}";
+
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", body);
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
   });
 
-  server.on("/synctime", HTTP_POST, [](AsyncWebServerRequest * request) {
-    if (request -> hasParam("y", true) &&
-      request -> hasParam("m", true) &&
-      request -> hasParam("d", true) &&
-      request -> hasParam("h", true) &&
-      request -> hasParam("i", true) &&
-      request -> hasParam("s", true)) {
-
-      int y = request -> getParam("y", true) -> value().toInt();
-      int m = request -> getParam("m", true) -> value().toInt();
-      int d = request -> getParam("d", true) -> value().toInt();
-      int h = request -> getParam("h", true) -> value().toInt();
-      int i = request -> getParam("i", true) -> value().toInt();
-      int s = request -> getParam("s", true) -> value().toInt();
+  // ========================================
+  // PATCH PENGATURAN: VALIDASI SEMUA, TERAPKAN SEKALIGUS, SATU KALI HITUNG ULANG
+  // ========================================
+  routeOn("/api/v2/settings", HTTP_POST, [](AsyncWebServerRequest *request) {
+    Serial.println("\n========================================");
+    Serial.println("PATCH PENGATURAN (V2)");
+    Serial.println("========================================");
 
-      Serial.println("\n========================================");
-      Serial.println("SINKRONISASI WAKTU BROWSER");
-      Serial.println("========================================");
-      Serial.printf("DITERIMA: %02d:%02d:%02d %02d/%02d/%04d\n", h, i, s, d, m, y);
+    Job job = {};
+    job.type = JOB_APPLY_SETTINGS;
+    SettingsPatch &patch = job.settings;
 
-      if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        setTime(h, i, s, d, m, y);
-        timeConfig.currentTime = now();
-        timeConfig.ntpSynced = true;
+    ParamResult params = parseParams(request, SETTINGS_SCHEMA, patch);
+    auto has = [&params](int field) { return (params.present & (1UL << field)) != 0; };
 
-        DisplayUpdate update;
-        update.type = DisplayUpdate::TIME_UPDATE;
-        xQueueSend(displayQueue, & update, 0);
+    patch.hasCity = has(SET_P_CITY);
+    patch.hasCoords = has(SET_P_LAT) || has(SET_P_LON);
+    patch.hasMethod = has(SET_P_METHOD_ID);
+    patch.hasTimezone = has(SET_P_TIMEZONE);
 
-        xSemaphoreGive(timeMutex);
+    bool anyTune = false;
+    for (int i = 0; i < 7; i++) {
+      patch.hasTune[i] = has(SET_P_TUNE0 + i);
+      anyTune |= patch.hasTune[i];
+    }
+
+    // ATURAN ANTAR-FIELD DI ATAS VALIDASI RENTANG SKEMA
+    uint32_t invalid = params.invalid;
+    if (patch.hasCity && !patch.hasCoords) invalid |= (1UL << SET_P_LAT);
+    if (patch.hasCoords && !isValidCoordinate(patch.lat, 90.0f)) invalid |= (1UL << SET_P_LAT);
+    if (patch.hasCoords && !isValidCoordinate(patch.lon, 180.0f)) invalid |= (1UL << SET_P_LON);
+    if (has(SET_P_METHOD_ID) != has(SET_P_METHOD_NAME)) {
+      invalid |= (1UL << SET_P_METHOD_ID) | (1UL << SET_P_METHOD_NAME);
+    }
+
+    if (invalid) {
+      String errors = paramFieldList(SETTINGS_SCHEMA, invalid);
+      Serial.println("DITOLAK - FIELD TIDAK VALID: " + errors);
+      request->send(400, "application/json",
+        "{\"error\":\"Invalid settings\",\"fields\":[" + errors + "]}");
+      return;
+    }
+
+    if (!patch.hasCity && !patch.hasCoords && !patch.hasMethod && !patch.hasTimezone && !anyTune) {
+      request->send(400, "application/json", "{\"error\":\"Empty patch\"}");
+      return;
+    }
+
+    if (patch.hasCity && !has(SET_P_NAME)) {
+      strlcpy(patch.cityName, patch.cityApi, sizeof(patch.cityName));
+    }
+
+    // ---- DITERAPKAN & DISIMPAN OLEH jobTask ----
+    uint32_t jobId = enqueueJob(job);
+    if (jobId == 0) {
+      sendJobQueueFull(request);
+      return;
+    }
+
+    Serial.printf("DIANTREKAN SEBAGAI JOB #%lu\n", (unsigned long)jobId);
+    Serial.println("========================================\n");
+
+    sendJobAccepted(request, jobId);
+  });
+
+  routeOn("/api/jobs", HTTP_GET, [](AsyncWebServerRequest *request) {
+    JobStatus snapshot[JOB_STATUS_SLOTS];
+
+    portENTER_CRITICAL(&jobMux);
+    memcpy(snapshot, jobBoard.status, sizeof(snapshot));
+    portEXIT_CRITICAL(&jobMux);
+
+    if (request->hasParam("id")) {
+      uint32_t id = strtoul(request->getParam("id")->value().c_str(), NULL, 10);
+      const JobStatus *st = jobBoardFind(snapshot, id);
+
+      if (st == NULL) {
+        request->send(404, "application/json", "{\"error\":\"Unknown or expired job\"}");
+        return;
       }
 
-      if (rtcAvailable) {
-        Serial.println("\nMENYIMPAN WAKTU KE HARDWARE RTC...");
+      String out;
+      appendJobStatusJSON(out, *st);
+      sendJSONResponse(request, out);
+      return;
+    }
 
-        saveTimeToRTC();
+    String out = "{\"pending\":";
+    out += String(jobQueue != NULL ? uxQueueMessagesWaiting(jobQueue) : 0);
+    out += ",\"jobs\":[";
+    bool first = true;
+    for (int i = 0; i < JOB_STATUS_SLOTS; i++) {
+      if (snapshot[i].id == 0) continue;
+      if (!first) out += ",";
+      appendJobStatusJSON(out, snapshot[i]);
+      first = false;
+    }
+    out += "]}";
+    sendJSONResponse(request, out);
+  });
 
-        delay(500);
+  routeOn("/api/connection-type", HTTP_GET, [](AsyncWebServerRequest * request) {
+    IPAddress clientIP = request -> client() -> remoteIP();
+    IPAddress apIP = WiFi.softAPIP();
+    IPAddress apSubnet = WiFi.softAPSubnetMask();
+    bool isLocalAP = isClientOnLocalAP(request);
 
-        DateTime rtcNow = rtc.now();
-        Serial.println("VERIFIKASI RTC:");
-        Serial.printf("   RTC: %02d:%02d:%02d %02d/%02d/%04d",
-          rtcNow.hour(), rtcNow.minute(), rtcNow.second(),
-          rtcNow.day(), rtcNow.month(), rtcNow.year());
-
-        bool rtcValid = (
-          rtcNow.year() >= 2000 && rtcNow.year() <= 2100 &&
-          rtcNow.month() >= 1 && rtcNow.month() <= 12 &&
-          rtcNow.day() >= 1 && rtcNow.day() <= 31
-        );
+    char buf[192];
+    snprintf(buf, sizeof(buf),
+      "{\"isLocalAP\":%s,\"clientIP\":\"%s\",\"apIP\":\"%s\",\"apSubnet\":\"%s\"}",
+      isLocalAP ? "true" : "false",
+      clientIP.toString().c_str(),
+      apIP.toString().c_str(),
+      apSubnet.toString().c_str()
+    );
+    sendJSONResponse(request, String(buf));
+  });
 
-        if (rtcValid) {
-          Serial.println("RTC BERHASIL DISIMPAN");
-          Serial.println("WAKTU AKAN BERTAHAN SAAT RESTART");
-        } else {
-          Serial.println("SIMPAN RTC GAGAL - WAKTU TIDAK VALID");
-          Serial.println("PERIKSA BATERAI RTC ATAU KONEKSI I2C");
-        }
-      } else {
-        Serial.println("\nRTC TIDAK TERSEDIA - WAKTU AKAN DIRESET SAAT RESTART");
-      }
+  routeOn("/synctime", HTTP_POST, [](AsyncWebServerRequest * request) {
+    Job job = {};
+    job.type = JOB_SYNC_TIME;
 
-      Serial.println("========================================\n");
+    ParamResult params = parseParams(request, SYNCTIME_SCHEMA, job.time);
 
-      AsyncWebServerResponse * resp = request -> beginResponse(200, "text/plain", "Waktu berhasil di-sync!");
-      request -> send(resp);
+    if (params.invalid) {
+      request -> send(400, "text/plain", "Data waktu tidak lengkap atau tidak valid");
+      return;
+    }
 
-    } else {
-      request -> send(400, "text/plain", "Data waktu tidak lengkap");
+    uint32_t jobId = enqueueJob(job);
+    if (jobId == 0) {
+      sendJobQueueFull(request);
+      return;
     }
+
+    sendJobAccepted(request, jobId);
   });
 
-  server.on("/gettimezone", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/gettimezone", HTTP_GET, [](AsyncWebServerRequest * request) {
     char buf[32];
 
     if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -2493,104 +5273,89 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/settimezone", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/settimezone", HTTP_POST, [](AsyncWebServerRequest * request) {
       Serial.println("\n========================================");
       Serial.println("SIMPAN TIMEZONE");
       Serial.println("========================================");
 
-      if (!request -> hasParam("offset", true)) {
+      Job job = {};
+      job.type = JOB_APPLY_SETTINGS;
+
+      ParamResult params = parseParams(request, TIMEZONE_SCHEMA, job.settings);
+
+      if (!params.present) {
         Serial.println("ERROR: PARAMETER OFFSET TIDAK ADA");
         request -> send(400, "application/json",
           "{\"error\":\"Missing offset parameter\"}");
         return;
       }
 
-      String offsetStr = request -> getParam("offset", true) -> value();
-      offsetStr.trim();
-
-      int offset = offsetStr.toInt();
-
-      Serial.println("OFFSET DITERIMA: " + String(offset));
-
-      if (offset < -12 || offset > 14) {
+      if (params.invalid) {
         Serial.println("ERROR: OFFSET TIMEZONE TIDAK VALID");
         request -> send(400, "application/json",
           "{\"error\":\"Invalid timezone offset (must be -12 to +14)\"}");
         return;
       }
 
-      Serial.println("MENYIMPAN KE MEMORI DAN FILE...");
+      int offset = job.settings.offset;
+      Serial.println("OFFSET DITERIMA: " + String(offset));
 
-      if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        timezoneOffset = offset;
-        xSemaphoreGive(settingsMutex);
-        Serial.println("MEMORI DIPERBARUI");
-      }
+      job.settings.force = true;
+      job.settings.hasTimezone = true;
 
-      bool ntpTriggered = false;
-      bool prayerWillUpdate = false;
+      uint32_t jobId = enqueueJob(job);
+      if (jobId == 0) {
+        sendJobQueueFull(request);
+        return;
+      }
 
-      if (wifiConfig.isConnected && ntpTaskHandle != NULL) {
-        Serial.println("\n========================================");
-        Serial.println("MEMICU ULANG SINKRONISASI NTP OTOMATIS");
-        Serial.println("========================================");
-        Serial.println("ALASAN: TIMEZONE DIUBAH KE UTC" + String(offset >= 0 ? "+" : "") + String(offset));
-
-        if (prayerConfig.latitude.length() > 0 && prayerConfig.longitude.length() > 0) {
-          Serial.println("KOTA: " + prayerConfig.selectedCity);
-          Serial.println("KOORDINAT: " + prayerConfig.latitude + ", " + prayerConfig.longitude);
-          Serial.println("");
-          Serial.println("TUGAS NTP AKAN OTOMATIS:");
-          Serial.println("  1. SINKRONISASI WAKTU DENGAN TIMEZONE BARU");
-          Serial.println("  2. PERBARUI WAKTU SHALAT DENGAN TANGGAL YANG BENAR");
-          prayerWillUpdate = true;
-        } else {
-          Serial.println("CATATAN: TIDAK ADA KOORDINAT KOTA");
-          Serial.println("HANYA WAKTU YANG AKAN DISINKRONKAN (TANPA PEMBARUAN WAKTU SHALAT)");
-        }
+      Serial.printf("TIMEZONE UTC%s%d DIANTREKAN SEBAGAI JOB #%lu\n",
+                    offset >= 0 ? "+" : "", offset, (unsigned long)jobId);
+      Serial.println("========================================\n");
 
-        if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-          timeConfig.ntpSynced = false;
-          xSemaphoreGive(timeMutex);
-        }
+      // ntpTriggered / prayerTimesUpdating DILAPORKAN JOB, BUKAN DITEBAK DI SINI
+      sendJobAccepted(request, jobId);
+  });
 
-        xTaskNotifyGive(ntpTaskHandle);
-        ntpTriggered = true;
+  // MIRROR ALADHAN SENDIRI SEBAGAI PENYEDIA KEDUA; host KOSONG = NONAKTIF
+  routeOn("/setmirror", HTTP_POST, [](AsyncWebServerRequest * request) {
+    if (!request -> hasParam("host", true)) {
+      request -> send(400, "application/json", "{\"error\":\"Missing host parameter\"}");
+      return;
+    }
 
-        Serial.println("SINKRONISASI ULANG NTP BERHASIL DIPICU");
-        Serial.println("========================================\n");
+    String host = request -> getParam("host", true) -> value();
+    host.trim();
+    long port = 80;
+    if (request -> hasParam("port", true)) {
+      port = request -> getParam("port", true) -> value().toInt();
+    }
 
-      } else {
-        Serial.println("\nTIDAK DAPAT MEMICU SINKRONISASI NTP:");
-        if (!wifiConfig.isConnected) {
-          Serial.println("ALASAN: WIFI TIDAK TERHUBUNG");
-        }
-        if (ntpTaskHandle == NULL) {
-          Serial.println("ALASAN: TUGAS NTP TIDAK BERJALAN");
-        }
-        Serial.println("TIMEZONE AKAN DITERAPKAN SAAT KONEKSI BERIKUTNYA\n");
-      }
+    if (host.length() > 0 && (!isValidMirrorHost(host) || port <= 0 || port > 65535)) {
+      request -> send(400, "application/json", "{\"error\":\"Invalid mirror host or port\"}");
+      return;
+    }
 
-      char respBuf[128];
-      snprintf(respBuf, sizeof(respBuf),
-        "{\"success\":true,\"offset\":%d,\"ntpTriggered\":%s,\"prayerTimesWillUpdate\":%s}",
-        offset,
-        ntpTriggered ? "true" : "false",
-        prayerWillUpdate ? "true" : "false"
-      );
-      request -> send(200, "application/json", respBuf);
+    // SERVER BARU: HISTOGRAM LAMA TIDAK BERLAKU
+    portENTER_CRITICAL(&scheduleSvcMux);
+    ScheduleProvider &mirror = scheduleProviders[SCHEDULE_PROVIDER_MIRROR];
+    strlcpy(mirror.host, host.c_str(), sizeof(mirror.host));
+    mirror.port = (uint16_t)port;
+    memset(&mirror.stats, 0, sizeof(mirror.stats));
+    portEXIT_CRITICAL(&scheduleSvcMux);
 
-      vTaskDelay(pdMS_TO_TICKS(50));
+    requestPersist(PERSIST_MIRROR);
 
-      saveTimezoneConfig();
+    Serial.printf("MIRROR JADWAL: %s\n", host.length() > 0 ? host.c_str() : "NONAKTIF");
 
-      Serial.println("========================================");
-      Serial.println("BERHASIL: TIMEZONE TERSIMPAN");
-      Serial.println("OFFSET: UTC" + String(offset >= 0 ? "+" : "") + String(offset));
-      Serial.println("========================================\n");
+    char respBuf[128];
+    snprintf(respBuf, sizeof(respBuf),
+      "{\"success\":true,\"enabled\":%s,\"host\":\"%s\",\"port\":%ld}",
+      host.length() > 0 ? "true" : "false", host.c_str(), port);
+    request -> send(200, "application/json", respBuf);
   });
 
-  server.on("/getcities", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/getcities", HTTP_GET, [](AsyncWebServerRequest * request) {
     if (!LittleFS.exists("/cities.json")) {
       Serial.println("CITIES.JSON TIDAK DITEMUKAN");
       request -> send(404, "application/json", "[]");
@@ -2614,7 +5379,69 @@ void setupServerRoutes() {
     request -> send(response);
   });
 
-  server.on("/getcityinfo", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/api/schedule/bulk", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (!LittleFS.exists("/cities.json")) {
+      request->send(404, "application/json", "{\"error\":\"cities.json not found\"}");
+      return;
+    }
+
+    int y, m, d;
+    if (request->hasParam("date")) {
+      String date = request->getParam("date")->value();
+      if (sscanf(date.c_str(), "%d-%d-%d", &y, &m, &d) != 3 ||
+          m < 1 || m > 12 || d < 1 || d > 31 || y < 2000 || y > 2100) {
+        request->send(400, "application/json", "{\"error\":\"Invalid date, use YYYY-MM-DD\"}");
+        return;
+      }
+    } else {
+      time_t now_t = timeConfig.currentTime;
+      y = year(now_t);
+      m = month(now_t);
+      d = day(now_t);
+    }
+
+    std::shared_ptr<BulkScheduleJob> job(new (std::nothrow) BulkScheduleJob());
+    if (!job) {
+      request->send(503, "application/json", "{\"error\":\"Out of memory\"}");
+      return;
+    }
+
+    job->file = LittleFS.open("/cities.json", "r");
+    if (!job->file || !job->file.find("[")) {
+      request->send(500, "application/json", "{\"error\":\"Cannot read cities.json\"}");
+      return;
+    }
+
+    job->csv = request->hasParam("format") && request->getParam("format")->value() == "csv";
+    if (request->hasParam("province")) {
+      job->province = request->getParam("province")->value();
+    }
+
+    int methodId = methodConfig.methodId;
+    if (request->hasParam("method")) {
+      methodId = request->getParam("method")->value().toInt();
+    }
+
+    snprintf(job->date, sizeof(job->date), "%04d-%02d-%02d", y, m, d);
+    job->angles = prayerAnglesFor(methodId);
+    uint32_t cycles = ESP.getCycleCount();
+    {
+      PERF_SCOPE(PERF_SOLAR_DAY);
+      solarDayCompute(y, m, d, job->sun);
+    }
+    job->dayCycles = ESP.getCycleCount() - cycles;
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse(
+      job->csv ? "text/csv" : "application/json",
+      [job](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        return fillBulkSchedule(*job, buffer, maxLen);
+      });
+
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    request->send(response);
+  });
+
+  routeOn("/getcityinfo", HTTP_GET, [](AsyncWebServerRequest * request) {
     char buf[512];
 
     if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -2652,104 +5479,48 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/setcity", HTTP_POST, [](AsyncWebServerRequest * request) {
-      if (!request->hasParam("city", true)) {
+  routeOn("/setcity", HTTP_POST, [](AsyncWebServerRequest * request) {
+      Job job = {};
+      job.type = JOB_APPLY_SETTINGS;
+      SettingsPatch &patch = job.settings;
+
+      ParamResult params = parseParams(request, CITY_SCHEMA, patch);
+
+      if (params.invalid & (1UL << CITY_P_CITY)) {
           request->send(400, "application/json", "{\"error\":\"Missing city parameter\"}");
           return;
       }
-
-      String cityApi = request->getParam("city", true)->value();
-      String cityName = request->hasParam("cityName", true)
-          ? request->getParam("cityName", true)->value()
-          : cityApi;
-      String lat = request->hasParam("lat", true)
-          ? request->getParam("lat", true)->value()
-          : "";
-      String lon = request->hasParam("lon", true)
-          ? request->getParam("lon", true)->value()
-          : "";
-
-      int tuneImsak = request->hasParam("tuneImsak", true)
-          ? request->getParam("tuneImsak", true)->value().toInt()
-          : 0;
-      int tuneSubuh = request->hasParam("tuneSubuh", true)
-          ? request->getParam("tuneSubuh", true)->value().toInt()
-          : 0;
-      int tuneTerbit = request->hasParam("tuneTerbit", true)
-          ? request->getParam("tuneTerbit", true)->value().toInt()
-          : 0;
-      int tuneZuhur = request->hasParam("tuneZuhur", true)
-          ? request->getParam("tuneZuhur", true)->value().toInt()
-          : 0;
-      int tuneAshar = request->hasParam("tuneAshar", true)
-          ? request->getParam("tuneAshar", true)->value().toInt()
-          : 0;
-      int tuneMaghrib = request->hasParam("tuneMaghrib", true)
-          ? request->getParam("tuneMaghrib", true)->value().toInt()
-          : 0;
-      int tuneIsya = request->hasParam("tuneIsya", true)
-          ? request->getParam("tuneIsya", true)->value().toInt()
-          : 0;
-
-      if (cityApi.length() > 100) cityApi = cityApi.substring(0, 100);
-      if (cityName.length() > 100) cityName = cityName.substring(0, 100);
-      if (lat.length() > 20) lat = lat.substring(0, 20);
-      if (lon.length() > 20) lon = lon.substring(0, 20);
-
-      bool willUpdate = (WiFi.status() == WL_CONNECTED && lat.length() > 0 && lon.length() > 0);
-
-      char response[256];
-      snprintf(response, sizeof(response),
-          "{\"success\":true,\"city\":\"%s\",\"updating\":%s}",
-          cityName.c_str(),
-          willUpdate ? "true" : "false"
-      );
-
-      request->send(200, "application/json", response);
-
-      vTaskDelay(pdMS_TO_TICKS(50));
-
-      if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-          prayerConfig.selectedCity = cityApi;
-          prayerConfig.selectedCityName = cityName;
-          prayerConfig.latitude = lat;
-          prayerConfig.longitude = lon;
-          xSemaphoreGive(settingsMutex);
+      if (params.invalid) {
+          request->send(400, "application/json",
+              "{\"error\":\"Invalid parameter\",\"fields\":[" + paramFieldList(CITY_SCHEMA, params.invalid) + "]}");
+          return;
       }
 
-      if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-          prayerConfig.selectedCity = cityApi;
-          prayerConfig.selectedCityName = cityName;
-          prayerConfig.latitude = lat;
-          prayerConfig.longitude = lon;
-
-          prayerConfig.tuneImsak = tuneImsak;
-          prayerConfig.tuneSubuh = tuneSubuh;
-          prayerConfig.tuneTerbit = tuneTerbit;
-          prayerConfig.tuneZuhur = tuneZuhur;
-          prayerConfig.tuneAshar = tuneAshar;
-          prayerConfig.tuneMaghrib = tuneMaghrib;
-          prayerConfig.tuneIsya = tuneIsya;
-
-          xSemaphoreGive(settingsMutex);
+      if (!(params.present & (1UL << CITY_P_NAME))) {
+          strlcpy(patch.cityName, patch.cityApi, sizeof(patch.cityName));
       }
 
-      saveCitySelection();
+      // RUTE LAMA: TUNE YANG TIDAK DIKIRIM = 0, KOORDINAT BOLEH KOSONG
+      patch.force = true;
+      patch.hasCity = true;
+      patch.hasCoords = true;
+      for (int i = 0; i < 7; i++) patch.hasTune[i] = true;
 
-      if (willUpdate) {
-          vTaskDelay(pdMS_TO_TICKS(100));
+      uint32_t jobId = enqueueJob(job);
+      if (jobId == 0) {
+          sendJobQueueFull(request);
+          return;
+      }
 
-          if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-              needPrayerUpdate = true;
-              pendingPrayerLat = lat;
-              pendingPrayerLon = lon;
-              xSemaphoreGive(settingsMutex);
+      // PEMBARUAN JADWAL DILAPORKAN JOB (/api/jobs), BUKAN DITEBAK DI SINI
+      char response[288];
+      snprintf(response, sizeof(response),
+          "{\"success\":true,\"city\":\"%s\",\"queued\":true,\"jobId\":%lu}",
+          patch.cityName,
+          (unsigned long)jobId
+      );
 
-              if (prayerTaskHandle != NULL) {
-                  xTaskNotifyGive(prayerTaskHandle);
-              }
-          }
-      }
+      request->send(200, "application/json", response);
   });
 
   server.on(
@@ -2873,7 +5644,7 @@ void setupServerRoutes() {
     }
   );
 
-  server.on("/getmethod", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/getmethod", HTTP_GET, [](AsyncWebServerRequest * request) {
     char buf[256];
 
     if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -2892,134 +5663,66 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/setmethod", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/setmethod", HTTP_POST, [](AsyncWebServerRequest * request) {
       Serial.println("\n========================================");
       Serial.println("SIMPAN METODE PERHITUNGAN");
       Serial.print("IP KLIEN: ");
       Serial.println(request -> client() -> remoteIP().toString());
       Serial.println("========================================");
 
-      if (!request -> hasParam("methodId", true) || !request -> hasParam("methodName", true)) {
-        Serial.println("ERROR: PARAMETER TIDAK ADA");
+      Job job = {};
+      job.type = JOB_APPLY_SETTINGS;
 
-        int params = request -> params();
-        Serial.printf("PARAMETER DITERIMA (%d):", params);
-        for (int i = 0; i < params; i++) {
-          const AsyncWebParameter * p = request -> getParam(i);
-          Serial.printf("  %s = %s\n", p -> name().c_str(), p -> value().c_str());
-        }
+      ParamResult params = parseParams(request, METHOD_SCHEMA, job.settings);
 
+      const uint32_t required = (1UL << METHOD_P_ID) | (1UL << METHOD_P_NAME);
+      if ((params.present & required) != required) {
+        Serial.println("ERROR: PARAMETER TIDAK ADA");
         request -> send(400, "application/json",
           "{\"error\":\"Missing methodId or methodName parameter\"}");
         return;
       }
 
-      String methodIdStr = request -> getParam("methodId", true) -> value();
-      String methodName = request -> getParam("methodName", true) -> value();
-
-      methodIdStr.trim();
-      methodName.trim();
-
-      int methodId = methodIdStr.toInt();
-
-      Serial.println("DATA DITERIMA:");
-      Serial.println("ID METODE: " + String(methodId));
-      Serial.println("NAMA METODE: " + methodName);
-
-      if (methodId < 0 || methodId > 20) {
-        Serial.println("ERROR: ID METODE TIDAK VALID");
-        request -> send(400, "application/json",
-          "{\"error\":\"Invalid method ID\"}");
-        return;
-      }
-
-      if (methodName.length() == 0) {
-        Serial.println("ERROR: NAMA METODE KOSONG");
+      if (params.invalid) {
+        Serial.println("ERROR: PARAMETER TIDAK VALID: " + paramFieldList(METHOD_SCHEMA, params.invalid));
         request -> send(400, "application/json",
-          "{\"error\":\"Method name cannot be empty\"}");
+          "{\"error\":\"Invalid method ID or name (id 0-20, name 1-100 chars)\"}");
         return;
       }
 
-      if (methodName.length() > 100) {
-        Serial.println("ERROR: NAMA METODE TERLALU PANJANG");
-        request -> send(400, "application/json",
-          "{\"error\":\"Method name too long (max 100 chars)\"}");
-        return;
-      }
+      int methodId = job.settings.methodId;
+      const char *methodName = job.settings.methodName;
 
-      Serial.println("MENYIMPAN KE MEMORI...");
+      Serial.println("DATA DITERIMA:");
+      Serial.println("ID METODE: " + String(methodId));
+      Serial.println("NAMA METODE: " + String(methodName));
 
-      if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        methodConfig.methodId = methodId;
-        methodConfig.methodName = methodName;
+      job.settings.force = true;
+      job.settings.hasMethod = true;
 
-        xSemaphoreGive(settingsMutex);
-        Serial.println("MEMORI DIPERBARUI");
-        Serial.println("ID METODE: " + String(methodConfig.methodId));
-        Serial.println("NAMA METODE: " + methodConfig.methodName);
+      uint32_t jobId = enqueueJob(job);
+      if (jobId == 0) {
+        sendJobQueueFull(request);
+        return;
       }
 
-      bool willFetchPrayerTimes = false;
-
-      if (WiFi.status() == WL_CONNECTED) {
-          if (prayerConfig.latitude.length() > 0 && prayerConfig.longitude.length() > 0) {
-              Serial.println("MEMICU PEMBARUAN WAKTU SHALAT DENGAN METODE BARU...");
-              Serial.println("KOTA: " + prayerConfig.selectedCity);
-              Serial.println("METODE: " + methodName);
-
-              willFetchPrayerTimes = true;
-          } else {
-              Serial.println("TIDAK ADA KOORDINAT TERSEDIA");
-          }
-      } else {
-          Serial.println("WIFI TIDAK TERHUBUNG");
-      }
+      Serial.printf("METODE DIANTREKAN SEBAGAI JOB #%lu\n", (unsigned long)jobId);
+      Serial.println("========================================\n");
 
-      char respBuf[128];
+      char respBuf[192];
       snprintf(respBuf, sizeof(respBuf),
-        "{\"success\":true,\"methodId\":%d,\"methodName\":\"%s\",\"prayerTimesUpdating\":%s}",
+        "{\"success\":true,\"methodId\":%d,\"methodName\":\"%s\",\"queued\":true,\"jobId\":%lu}",
         methodId,
-        methodName.c_str(),
-        willFetchPrayerTimes ? "true" : "false"
+        methodName,
+        (unsigned long)jobId
       );
       request -> send(200, "application/json", respBuf);
-
-      vTaskDelay(pdMS_TO_TICKS(50));
-
-      Serial.println("MENULIS KE LITTLEFS...");
-      saveMethodSelection();
-
-      if (willFetchPrayerTimes) {
-          vTaskDelay(pdMS_TO_TICKS(100));
-
-          if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-              needPrayerUpdate = true;
-              pendingPrayerLat = prayerConfig.latitude;
-              pendingPrayerLon = prayerConfig.longitude;
-              xSemaphoreGive(settingsMutex);
-
-              if (prayerTaskHandle != NULL) {
-                  xTaskNotifyGive(prayerTaskHandle);
-                  Serial.println("TUGAS SHALAT DIPICU UNTUK PERUBAHAN METODE");
-              }
-          }
-
-          Serial.println("PEMBARUAN WAKTU SHALAT DIMULAI");
-      }
-
-      Serial.println("========================================");
-      Serial.println("BERHASIL: METODE TERSIMPAN");
-      Serial.println("METODE: " + methodName);
-      if (willFetchPrayerTimes) {
-        Serial.println("WAKTU SHALAT AKAN DIPERBARUI SEBENTAR LAGI...");
-      }
-      Serial.println("========================================\n");
   });
 
   // ========================================
   // TAB JADWAL - WAKTU SHALAT DAN BUZZER
   // ========================================
-  server.on("/getprayertimes", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/getprayertimes", HTTP_GET, [](AsyncWebServerRequest * request) {
     char buf[256];
     snprintf(buf, sizeof(buf),
       "{\"imsak\":\"%s\",\"subuh\":\"%s\",\"terbit\":\"%s\","
@@ -3035,12 +5738,15 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/getbuzzerconfig", HTTP_GET, [](AsyncWebServerRequest * request) {
-    char buf[256];
+  routeOn("/getbuzzerconfig", HTTP_GET, [](AsyncWebServerRequest * request) {
+    const uint8_t *pt = buzzerConfig.pattern;
+    char buf[512];
     snprintf(buf, sizeof(buf),
       "{\"imsak\":%s,\"subuh\":%s,\"terbit\":%s,\"zuhur\":%s,"
       "\"ashar\":%s,\"maghrib\":%s,\"isya\":%s,"
-      "\"alarm\":%s,\"alarmTime\":\"%s\",\"volume\":%d}",
+      "\"alarm\":%s,\"alarmTime\":\"%s\",\"volume\":%d,"
+      "\"patterns\":{\"imsak\":\"%s\",\"subuh\":\"%s\",\"terbit\":\"%s\",\"zuhur\":\"%s\","
+      "\"ashar\":\"%s\",\"maghrib\":\"%s\",\"isya\":\"%s\",\"alarm\":\"%s\"}}",
       buzzerConfig.imsakEnabled   ? "true" : "false",
       buzzerConfig.subuhEnabled   ? "true" : "false",
       buzzerConfig.terbitEnabled  ? "true" : "false",
@@ -3050,12 +5756,40 @@ void setupServerRoutes() {
       buzzerConfig.isyaEnabled    ? "true" : "false",
       alarmConfig.alarmEnabled    ? "true" : "false",
       alarmConfig.alarmTime,
-      buzzerConfig.volume
+      buzzerConfig.volume,
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_IMSAK]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_SUBUH]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_TERBIT]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_ZUHUR]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_ASHAR]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_MAGHRIB]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_ISYA]],
+      BUZZER_PATTERN_NAMES[pt[BUZZER_SLOT_ALARM]]
     );
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/setbuzzertoggle", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/setbuzzerpattern", HTTP_POST, [](AsyncWebServerRequest * request) {
+    if (!request -> hasParam("prayer", true) || !request -> hasParam("pattern", true)) {
+      request -> send(400, "text/plain", "Missing parameters");
+      return;
+    }
+
+    int slot = buzzerSlotFor(request -> getParam("prayer", true) -> value());
+    int pattern = buzzerPatternFor(request -> getParam("pattern", true) -> value());
+
+    if (slot < 0 || pattern < 0) {
+      request -> send(400, "text/plain", "Invalid prayer or pattern");
+      return;
+    }
+
+    buzzerConfig.pattern[slot] = pattern;
+    requestPersist(PERSIST_BUZZER);
+
+    request -> send(200, "text/plain", "OK");
+  });
+
+  routeOn("/setbuzzertoggle", HTTP_POST, [](AsyncWebServerRequest * request) {
     if (!request -> hasParam("prayer", true) || !request -> hasParam("enabled", true)) {
       request -> send(400, "text/plain", "Missing parameters");
       return;
@@ -3064,26 +5798,27 @@ void setupServerRoutes() {
     String prayer = request -> getParam("prayer", true) -> value();
     bool enabled = request -> getParam("enabled", true) -> value() == "true";
 
-    if (prayer == "imsak") buzzerConfig.imsakEnabled = enabled;
-    else if (prayer == "subuh") buzzerConfig.subuhEnabled = enabled;
-    else if (prayer == "terbit") buzzerConfig.terbitEnabled = enabled;
-    else if (prayer == "zuhur") buzzerConfig.zuhurEnabled = enabled;
-    else if (prayer == "ashar") buzzerConfig.asharEnabled = enabled;
-    else if (prayer == "maghrib") buzzerConfig.maghribEnabled = enabled;
-    else if (prayer == "isya") buzzerConfig.isyaEnabled = enabled;
-    else if (prayer == "alarm") {
+    if (prayer == "alarm") {
       alarmConfig.alarmEnabled = enabled;
       lastAlarmMinute = -1;
-      saveAlarmConfig();
+      hotStateSave();
+      requestPersist(PERSIST_ALARM);
       request->send(200, "text/plain", "OK");
       return;
     }
 
-    saveBuzzerConfig();
+    Prayer slot = prayerFromName(prayer.c_str());
+    if (slot == PRAYER_NONE) {
+      request -> send(400, "text/plain", "Invalid prayer");
+      return;
+    }
+
+    buzzerConfig.*(PRAYER_INFO[slot].enabled) = enabled;
+    requestPersist(PERSIST_BUZZER);
     request -> send(200, "text/plain", "OK");
   });
 
-  server.on("/setbuzzervolume", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/setbuzzervolume", HTTP_POST, [](AsyncWebServerRequest * request) {
     if (!request -> hasParam("volume", true)) {
       request -> send(400, "text/plain", "Missing volume");
       return;
@@ -3094,12 +5829,12 @@ void setupServerRoutes() {
     if (volume > 100) volume = 100;
 
     buzzerConfig.volume = volume;
-    saveBuzzerConfig();
+    requestPersist(PERSIST_BUZZER);
 
     request -> send(200, "text/plain", "OK");
   });
 
-  server.on("/testbuzzer", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/testbuzzer", HTTP_POST, [](AsyncWebServerRequest * request) {
       if (!request->hasParam("volume", true)) {
           request->send(400, "text/plain", "Missing volume");
           return;
@@ -3112,69 +5847,29 @@ void setupServerRoutes() {
       Serial.println("\n========================================");
       Serial.println("UJI BUZZER DIMULAI");
       Serial.println("========================================");
-      Serial.printf("VOLUME: %d%%", volume);
+      Serial.printf("VOLUME: %d%%\n", volume);
       Serial.println("DURASI: BERHENTI MANUAL ATAU TIMEOUT 30 DETIK");
       Serial.println("========================================\n");
 
-      if (buzzerTestTaskHandle != NULL) {
-          vTaskDelete(buzzerTestTaskHandle);
-          buzzerTestTaskHandle = NULL;
-          ledcWrite(BUZZER_CHANNEL, 0);
-          vTaskDelay(pdMS_TO_TICKS(100));
+      int pattern = 0;
+      if (request->hasParam("pattern", true)) {
+          pattern = buzzerPatternFor(request->getParam("pattern", true)->value());
+          if (pattern < 0) {
+              request->send(400, "text/plain", "Invalid pattern");
+              return;
+          }
       }
 
+      buzzerPlay(pattern, 30000, volume);
       request->send(200, "text/plain", "OK");
-
-      xTaskCreate(
-          [](void* param) {
-              int vol = *((int*)param);
-              int pwmValue = map(vol, 0, 100, 0, 255);
-
-              unsigned long startTime = millis();
-              const unsigned long maxDuration = 30000;
-
-              Serial.printf("LOOP UJI BUZZER DIMULAI (PWM: %d)", pwmValue);
-
-              while ((millis() - startTime) < maxDuration) {
-                  if (buzzerTestTaskHandle == NULL) {
-                      Serial.println("UJI BUZZER DIHENTIKAN OLEH PENGGUNA");
-                      break;
-                  }
-
-                  ledcWrite(BUZZER_CHANNEL, pwmValue);
-                  vTaskDelay(pdMS_TO_TICKS(500));
-
-                  ledcWrite(BUZZER_CHANNEL, 0);
-                  vTaskDelay(pdMS_TO_TICKS(500));
-              }
-
-              ledcWrite(BUZZER_CHANNEL, 0);
-              Serial.println("UJI BUZZER SELESAI");
-
-              buzzerTestTaskHandle = NULL;
-              delete (int*)param;
-              vTaskDelete(NULL);
-          },
-          "BuzzerTest",
-          2048,
-          new int(volume),
-          1,
-          &buzzerTestTaskHandle
-      );
   });
 
-  server.on("/stopbuzzer", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/stopbuzzer", HTTP_POST, [](AsyncWebServerRequest * request) {
       Serial.println("\n========================================");
       Serial.println("PERMINTAAN BERHENTI BUZZER");
       Serial.println("========================================\n");
 
-      ledcWrite(BUZZER_CHANNEL, 0);
-
-      if (buzzerTestTaskHandle != NULL) {
-          vTaskDelete(buzzerTestTaskHandle);
-          buzzerTestTaskHandle = NULL;
-          Serial.println("TUGAS UJI BUZZER DIHAPUS");
-      }
+      buzzerStop();
 
       request->send(200, "text/plain", "OK");
       Serial.println("BUZZER BERHASIL DIHENTIKAN\n");
@@ -3183,7 +5878,52 @@ void setupServerRoutes() {
   // ========================================
   // RUTE KONFIGURASI ALARM
   // ========================================
-  server.on("/getalarmconfig", HTTP_GET, [](AsyncWebServerRequest *request) {
+  routeOn("/touchcalibrate", HTTP_POST, [](AsyncWebServerRequest *request) {
+    if (touchCalTaskHandle != NULL) {
+      request->send(409, "application/json", "{\"error\":\"Calibration already running\"}");
+      return;
+    }
+
+    touchCalState.point = 0;
+    touchCalState.errorPx = 0;
+    touchCalState.status = "running";
+
+    if (xTaskCreate(touchCalibrationTask, "TouchCal", TOUCH_CAL_TASK_STACK_SIZE,
+                    NULL, 1, &touchCalTaskHandle) != pdPASS) {
+      touchCalTaskHandle = NULL;
+      touchCalState.status = "failed";
+      request->send(500, "application/json", "{\"error\":\"Failed to start calibration\"}");
+      return;
+    }
+
+    request->send(200, "application/json", "{\"success\":true}");
+  });
+
+  routeOn("/gettouchcalibration", HTTP_GET, [](AsyncWebServerRequest *request) {
+    TouchCalibration cal = touchCalGet();
+    char json[256];
+    snprintf(json, sizeof(json),
+      "{"
+      "\"calibrated\":%s,"
+      "\"status\":\"%s\","
+      "\"point\":%d,"
+      "\"total\":%d,"
+      "\"errorPx\":%.1f,"
+      "\"matrix\":[%ld,%ld,%ld,%ld,%ld,%ld]"
+      "}",
+      cal.calibrated ? "true" : "false",
+      touchCalState.status,
+      touchCalState.point + 1,
+      TOUCH_CAL_POINTS,
+      touchCalState.errorPx,
+      (long)cal.a, (long)cal.b, (long)cal.c,
+      (long)cal.d, (long)cal.e, (long)cal.f
+    );
+
+    sendJSONResponse(request, String(json));
+  });
+
+  routeOn("/getalarmconfig", HTTP_GET, [](AsyncWebServerRequest *request) {
     char buf[64];
     snprintf(buf, sizeof(buf),
       "{\"alarmTime\":\"%s\",\"alarmEnabled\":%s}",
@@ -3193,7 +5933,7 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(buf));
   });
 
-  server.on("/setalarmconfig", HTTP_POST, [](AsyncWebServerRequest *request) {
+  routeOn("/setalarmconfig", HTTP_POST, [](AsyncWebServerRequest *request) {
     bool changed = false;
 
     if (request->hasParam("alarmTime", true)) {
@@ -3213,16 +5953,17 @@ void setupServerRoutes() {
       changed = true;
       Serial.println("ALARM DIAKTIFKAN: " + String(alarmConfig.alarmEnabled ? "ON" : "OFF"));
       lastAlarmMinute = -1;
+      hotStateSave();
     }
 
-    if (changed) saveAlarmConfig();
+    if (changed) requestPersist(PERSIST_ALARM);
     request->send(200, "application/json", "{\"success\":true}");
   });
 
   // ========================================
   // TAB RESET - RESET PABRIK
   // ========================================
-  server.on("/reset", HTTP_POST, [](AsyncWebServerRequest * request) {
+  routeOn("/reset", HTTP_POST, [](AsyncWebServerRequest * request) {
       if (resetTaskHandle != NULL) {
           vTaskDelete(resetTaskHandle);
           resetTaskHandle = NULL;
@@ -3232,6 +5973,7 @@ void setupServerRoutes() {
       Serial.println("RESET PABRIK DIMULAI");
 
       if (LittleFS.exists("/wifi_creds.txt"))       LittleFS.remove("/wifi_creds.txt");
+      if (LittleFS.exists("/wifi_link.txt"))        LittleFS.remove("/wifi_link.txt");
       if (LittleFS.exists("/prayer_times.txt"))     LittleFS.remove("/prayer_times.txt");
       if (LittleFS.exists("/ap_creds.txt"))         LittleFS.remove("/ap_creds.txt");
       if (LittleFS.exists("/city_selection.txt"))   LittleFS.remove("/city_selection.txt");
@@ -3240,6 +5982,10 @@ void setupServerRoutes() {
       if (LittleFS.exists("/buzzer_config.txt"))    LittleFS.remove("/buzzer_config.txt");
       if (LittleFS.exists("/adzan_state.txt"))      LittleFS.remove("/adzan_state.txt");
       if (LittleFS.exists("/alarm_config.txt"))     LittleFS.remove("/alarm_config.txt");
+      if (LittleFS.exists("/touch_calibration.txt")) LittleFS.remove("/touch_calibration.txt");
+      if (LittleFS.exists(SCHEDULE_MIRROR_FILE))    LittleFS.remove(SCHEDULE_MIRROR_FILE);
+      if (LittleFS.exists(SCHEDULE_CACHE_FILE))     LittleFS.remove(SCHEDULE_CACHE_FILE);
+      if (LittleFS.exists(SPLASH_FILE))             LittleFS.remove(SPLASH_FILE);
 
       if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
           methodConfig.methodId = 5;
@@ -3256,6 +6002,7 @@ void setupServerRoutes() {
           prayerConfig.asharTime = "00:00";
           prayerConfig.maghribTime = "00:00";
           prayerConfig.isyaTime = "00:00";
+          schedulePublishConfig();
           prayerConfig.selectedCity = "";
           prayerConfig.selectedCityName = "";
           prayerConfig.latitude = "";
@@ -3283,9 +6030,11 @@ void setupServerRoutes() {
       alarmConfig.alarmEnabled = false;
       alarmState.isRinging = false;
       lastAlarmMinute = -1;
-      ledcWrite(BUZZER_CHANNEL, 0);
+      buzzerStop();
+      hotStateSave();
 
       timezoneOffset = 7;
+      markStateChanged();
 
       if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
           const time_t EPOCH_2000 = 946684800;
@@ -3355,16 +6104,13 @@ void setupServerRoutes() {
                           esp_task_wdt_delete(ntpTaskHandle);
                           vTaskSuspend(ntpTaskHandle);
                       }
-                      if (prayerTaskHandle != NULL) {
-                          esp_task_wdt_delete(prayerTaskHandle);
-                          vTaskSuspend(prayerTaskHandle);
+                      if (scheduleTaskHandle != NULL) {
+                          esp_task_wdt_delete(scheduleTaskHandle);
+                          vTaskSuspend(scheduleTaskHandle);
                       }
                       if (webTaskHandle != NULL) {
                           esp_task_wdt_delete(webTaskHandle);
                       }
-                      if (httpTaskHandle != NULL) {
-                          esp_task_wdt_delete(httpTaskHandle);
-                      }
 
                       WiFi.disconnect(true);
                       vTaskDelay(pdMS_TO_TICKS(500));
@@ -3395,7 +6141,8 @@ void setupServerRoutes() {
       );
   });
 
-  server.on("/api/data", HTTP_GET, [](AsyncWebServerRequest * request) {
+  routeOn("/api/data", HTTP_GET, [](AsyncWebServerRequest * request) {
+    PERF_SCOPE(PERF_API_DATA);
     char timeStr[20], dateStr[20], dayStr[15];
 
     time_t now_t;
@@ -3503,34 +6250,344 @@ void setupServerRoutes() {
     sendJSONResponse(request, String(jsonBuffer));
   });
 
-  server.on("/api/countdown", HTTP_GET, [](AsyncWebServerRequest * request) {
-      char buf[256];
+  routeOn("/api/countdown", HTTP_GET, [](AsyncWebServerRequest * request) {
+      char buf[256];
+
+      if (countdownMutex != NULL && xSemaphoreTake(countdownMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        int remaining = getRemainingSeconds();
+        snprintf(buf, sizeof(buf),
+          "{\"active\":%s,\"remaining\":%d,\"total\":%d,"
+          "\"message\":\"%s\",\"reason\":\"%s\",\"serverTime\":%lu}",
+          countdownState.isActive ? "true" : "false",
+          remaining,
+          countdownState.totalSeconds,
+          countdownState.message.c_str(),
+          countdownState.reason.c_str(),
+          millis()
+        );
+        xSemaphoreGive(countdownMutex);
+      } else {
+        snprintf(buf, sizeof(buf),
+          "{\"active\":false,\"remaining\":0,\"total\":0,"
+          "\"message\":\"\",\"reason\":\"\",\"serverTime\":%lu}",
+          millis()
+        );
+      }
+
+      sendJSONResponse(request, String(buf));
+    });
+
+  routeOn("/api/boot", HTTP_GET, [](AsyncWebServerRequest *request) {
+      BootPhase phases[BOOT_PHASE_MAX];
+      uint8_t count;
+
+      portENTER_CRITICAL(&bootMux);
+      count = bootPhaseCount;
+      memcpy(phases, bootPhases, sizeof(BootPhase) * count);
+      portEXIT_CRITICAL(&bootMux);
+
+      char buf[1536];
+      int len = snprintf(buf, sizeof(buf),
+        "{\"firstPixelUs\":%lu,\"firstFrameUs\":%lu,\"setupDoneUs\":%lu,\"ready\":{"
+        "\"fs\":%s,\"rtc\":%s,\"audio\":%s,\"net\":%s},\"phases\":[",
+        (unsigned long)bootFirstPixelUs,
+        (unsigned long)bootFirstFrameUs,
+        (unsigned long)bootSetupDoneUs,
+        (xEventGroupGetBits(bootEventGroup) & BOOT_FS_READY_BIT) ? "true" : "false",
+        (xEventGroupGetBits(bootEventGroup) & BOOT_RTC_READY_BIT) ? "true" : "false",
+        (xEventGroupGetBits(bootEventGroup) & BOOT_AUDIO_READY_BIT) ? "true" : "false",
+        (xEventGroupGetBits(bootEventGroup) & BOOT_NET_READY_BIT) ? "true" : "false"
+      );
+
+      for (int i = 0; i < count && len < (int)sizeof(buf); i++) {
+        len += snprintf(buf + len, sizeof(buf) - len,
+          "%s{\"name\":\"%s\",\"startUs\":%lu,\"durationUs\":%lu,\"core\":%d}",
+          i > 0 ? "," : "",
+          phases[i].name,
+          (unsigned long)phases[i].startUs,
+          (unsigned long)phases[i].durationUs,
+          phases[i].core
+        );
+      }
+
+      if (len < (int)sizeof(buf)) {
+        snprintf(buf + len, sizeof(buf) - len, "]}");
+      }
+
+      sendJSONResponse(request, String(buf));
+    });
+
+    // ?reset=1 MENGOSONGKAN STATISTIK SETELAH SNAPSHOT DIKIRIM
+    routeOn("/api/perf", HTTP_GET, [](AsyncWebServerRequest *request) {
+      PerfStat stats[PERF_PATH_COUNT];
+
+      portENTER_CRITICAL(&perfMux);
+      memcpy(stats, perfStats, sizeof(stats));
+      if (request->hasParam("reset")) {
+        memset(perfStats, 0, sizeof(perfStats));
+      }
+      portEXIT_CRITICAL(&perfMux);
+
+      uint32_t mhz = getCpuFrequencyMhz();
+      char buf[1536];
+      int len = snprintf(buf, sizeof(buf),
+        "{\"profile\":%s,\"cpuMhz\":%lu,\"fastMath\":%s,\"uptime\":%lu,\"paths\":[",
+        PERF_PROFILE ? "true" : "false",
+        (unsigned long)mhz,
+        SOLAR_FAST_MATH ? "true" : "false",
+        millis() / 1000
+      );
+
+      for (int i = 0; i < PERF_PATH_COUNT && len < (int)sizeof(buf); i++) {
+        uint32_t avg = stats[i].count ? (uint32_t)(stats[i].totalCycles / stats[i].count) : 0;
+        len += snprintf(buf + len, sizeof(buf) - len,
+          "%s{\"name\":\"%s\",\"count\":%lu,\"avgCycles\":%lu,\"minCycles\":%lu,"
+          "\"maxCycles\":%lu,\"avgUs\":%lu,\"maxUs\":%lu}",
+          i > 0 ? "," : "",
+          PERF_PATH_NAMES[i],
+          (unsigned long)stats[i].count,
+          (unsigned long)avg,
+          (unsigned long)stats[i].minCycles,
+          (unsigned long)stats[i].maxCycles,
+          (unsigned long)(avg / mhz),
+          (unsigned long)(stats[i].maxCycles / mhz)
+        );
+      }
+
+      if (len < (int)sizeof(buf)) {
+        snprintf(buf + len, sizeof(buf) - len, "]}");
+      }
+
+      sendJSONResponse(request, String(buf));
+    });
+
+    routeOn("/api/heap", HTTP_GET, [](AsyncWebServerRequest *request) {
+      HeapTrend t;
+      portENTER_CRITICAL(&heapTrendMux);
+      memcpy(&t, &heapTrend, sizeof(t));
+      portEXIT_CRITICAL(&heapTrendMux);
+
+      char buf[2048];
+      int len = snprintf(buf, sizeof(buf),
+        "{\"freeHeap\":%lu,\"minFreeHeap\":%lu,\"largestBlock\":%lu,\"heapSize\":%lu,"
+        "\"hours\":%lu,\"freeSlopeBph\":%ld,\"fragSlopePmph\":%ld,"
+        "\"leakSuspected\":%s,\"fragSuspected\":%s,\"samples\":[",
+        (unsigned long)ESP.getFreeHeap(),
+        (unsigned long)ESP.getMinFreeHeap(),
+        (unsigned long)ESP.getMaxAllocHeap(),
+        (unsigned long)ESP.getHeapSize(),
+        (unsigned long)t.hours,
+        (long)t.freeSlopeBph,
+        (long)t.fragSlopePmph,
+        t.leakSuspected ? "true" : "false",
+        t.fragSuspected ? "true" : "false"
+      );
+
+      for (int i = 0; i < t.count && len < (int)sizeof(buf); i++) {
+        const HeapSample &h = heapTrendAt(t, i);
+        len += snprintf(buf + len, sizeof(buf) - len,
+          "%s[%lu,%lu,%lu,%lu]",
+          i > 0 ? "," : "",
+          (unsigned long)h.hour,
+          (unsigned long)h.minFree,
+          (unsigned long)h.minLargest,
+          (unsigned long)h.minFragPermil
+        );
+      }
+
+      if (len < (int)sizeof(buf)) {
+        snprintf(buf + len, sizeof(buf) - len, "]}");
+      }
+
+      sendJSONResponse(request, String(buf));
+    });
+
+    routeOn("/api/schedule", HTTP_GET, [](AsyncWebServerRequest *request) {
+      ScheduleService svc;
+      portENTER_CRITICAL(&scheduleSvcMux);
+      memcpy(&svc, &scheduleSvc, sizeof(svc));
+      portEXIT_CRITICAL(&scheduleSvcMux);
+
+      DaySchedule tomorrow = scheduleTomorrowSnapshot();
+
+      char buf[1536];
+      int len = snprintf(buf, sizeof(buf),
+        "{\"state\":\"%s\",\"stateMs\":%lu,\"generation\":%lu,\"pending\":%s,"
+        "\"requests\":%lu,\"coalesced\":%lu,\"stale\":%lu,\"completed\":%lu,"
+        "\"failed\":%lu,\"retries\":%lu,\"lastHttpCode\":%d,"
+        "\"scheduleDay\":%ld,\"tomorrowDay\":%ld,\"tomorrowSource\":\"%s\","
+        "\"fetch\":{\"lastWarm\":%s,\"lastDnsCached\":%s,\"dnsMs\":%u,"
+        "\"connectMs\":%u,\"ttfbMs\":%u,\"totalMs\":%u,"
+        "\"cold\":{\"count\":%lu,\"totalMs\":%lu,\"maxMs\":%lu},"
+        "\"warm\":{\"count\":%lu,\"totalMs\":%lu,\"maxMs\":%lu}},\"states\":{",
+        SCHEDULE_STATE_NAMES[svc.state],
+        (unsigned long)(millis() - svc.stateSinceMs),
+        (unsigned long)svc.generation,
+        svc.pending ? "true" : "false",
+        (unsigned long)svc.requests,
+        (unsigned long)svc.coalesced,
+        (unsigned long)svc.stale,
+        (unsigned long)svc.completed,
+        (unsigned long)svc.failed,
+        (unsigned long)svc.retries,
+        svc.lastHttpCode,
+        (long)scheduleDay,
+        (long)tomorrow.day,
+        scheduleSourceName(tomorrow.source),
+        svc.lastWarm ? "true" : "false",
+        svc.lastDnsCached ? "true" : "false",
+        svc.lastDnsMs,
+        svc.lastConnectMs,
+        svc.lastTtfbMs,
+        svc.lastTotalMs,
+        (unsigned long)svc.fetchCold.count,
+        (unsigned long)svc.fetchCold.totalMs,
+        (unsigned long)svc.fetchCold.maxMs,
+        (unsigned long)svc.fetchWarm.count,
+        (unsigned long)svc.fetchWarm.totalMs,
+        (unsigned long)svc.fetchWarm.maxMs
+      );
 
-      if (countdownMutex != NULL && xSemaphoreTake(countdownMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        int remaining = getRemainingSeconds();
-        snprintf(buf, sizeof(buf),
-          "{\"active\":%s,\"remaining\":%d,\"total\":%d,"
-          "\"message\":\"%s\",\"reason\":\"%s\",\"serverTime\":%lu}",
-          countdownState.isActive ? "true" : "false",
-          remaining,
-          countdownState.totalSeconds,
-          countdownState.message.c_str(),
-          countdownState.reason.c_str(),
-          millis()
+      for (int i = 0; i < SCHEDULE_STATE_COUNT && len < (int)sizeof(buf); i++) {
+        const ScheduleStateStat &st = svc.stats[i];
+        len += snprintf(buf + len, sizeof(buf) - len,
+          "%s\"%s\":{\"count\":%lu,\"totalMs\":%lu,\"maxMs\":%lu}",
+          i > 0 ? "," : "",
+          SCHEDULE_STATE_NAMES[i],
+          (unsigned long)st.count,
+          (unsigned long)st.totalMs,
+          (unsigned long)st.maxMs
         );
-        xSemaphoreGive(countdownMutex);
-      } else {
-        snprintf(buf, sizeof(buf),
-          "{\"active\":false,\"remaining\":0,\"total\":0,"
-          "\"message\":\"\",\"reason\":\"\",\"serverTime\":%lu}",
-          millis()
+      }
+
+      if (len < (int)sizeof(buf)) {
+        snprintf(buf + len, sizeof(buf) - len, "},");
+      }
+
+      ScheduleProvider providers[SCHEDULE_HTTP_PROVIDERS];
+      ScheduleHedgeStats hedge;
+      portENTER_CRITICAL(&scheduleSvcMux);
+      memcpy(providers, scheduleProviders, sizeof(providers));
+      hedge = scheduleHedge;
+      portEXIT_CRITICAL(&scheduleSvcMux);
+
+      ScheduleCacheStats cache;
+      portENTER_CRITICAL(&scheduleCacheMux);
+      cache = scheduleCacheStats;
+      portEXIT_CRITICAL(&scheduleCacheMux);
+
+      String out(buf);
+      snprintf(buf, sizeof(buf),
+        "\"cache\":{\"ramHits\":%lu,\"flashHits\":%lu,\"misses\":%lu,\"stores\":%lu,"
+        "\"evictions\":%lu,\"flashErrors\":%lu,\"lastLookupUs\":%lu,\"maxLookupUs\":%lu,"
+        "\"ramSlots\":%d,\"fileSlots\":%d},",
+        (unsigned long)cache.ramHits,
+        (unsigned long)cache.flashHits,
+        (unsigned long)cache.misses,
+        (unsigned long)cache.stores,
+        (unsigned long)cache.evictions,
+        (unsigned long)cache.flashErrors,
+        (unsigned long)cache.lastLookupUs,
+        (unsigned long)cache.maxLookupUs,
+        SCHEDULE_CACHE_RAM_SLOTS,
+        SCHEDULE_CACHE_FILE_SLOTS
+      );
+      out += buf;
+
+      snprintf(buf, sizeof(buf),
+        "\"hedge\":{\"races\":%lu,\"hedges\":%lu,\"hedgeWins\":%lu,\"localFallbacks\":%lu,"
+        "\"lastProvider\":\"%s\"},\"providers\":[",
+        (unsigned long)hedge.races,
+        (unsigned long)hedge.hedges,
+        (unsigned long)hedge.hedgeWins,
+        (unsigned long)hedge.localFallbacks,
+        hedge.lastProvider >= 0 ? providers[hedge.lastProvider].name : (hedge.localFallbacks > 0 ? "local" : "none")
+      );
+      out += buf;
+
+      for (uint8_t i = 0; i < SCHEDULE_HTTP_PROVIDERS; i++) {
+        const ScheduleProvider &p = providers[i];
+        const ProviderStats &st = p.stats;
+        len = snprintf(buf, sizeof(buf),
+          "%s{\"name\":\"%s\",\"host\":\"%s\",\"port\":%u,\"enabled\":%s,"
+          "\"score\":%lu,\"p50Ms\":%lu,\"p90Ms\":%lu,\"ok\":%u,\"lastCode\":%d,"
+          "\"launched\":%lu,\"hedged\":%lu,\"wins\":%lu,\"lost\":%lu,\"errors\":{",
+          i > 0 ? "," : "",
+          p.name, p.host, p.port,
+          p.host[0] != '\0' ? "true" : "false",
+          (unsigned long)providerScore(st),
+          (unsigned long)providerQuantileMs(st, 50),
+          (unsigned long)providerQuantileMs(st, 90),
+          st.ok, st.lastCode,
+          (unsigned long)st.launched,
+          (unsigned long)st.hedged,
+          (unsigned long)st.wins,
+          (unsigned long)st.lost
         );
+        for (uint8_t e = 0; e < PROVIDER_ERR_COUNT && len < (int)sizeof(buf); e++) {
+          len += snprintf(buf + len, sizeof(buf) - len, "%s\"%s\":%u",
+                          e > 0 ? "," : "", PROVIDER_ERROR_NAMES[e], st.errors[e]);
+        }
+        // BATAS ATAS BUCKET (ms); BUCKET TERAKHIR = LEBIH DARI 16000
+        if (len < (int)sizeof(buf)) len += snprintf(buf + len, sizeof(buf) - len, "},\"latency\":[");
+        for (uint8_t b = 0; b < PROVIDER_LATENCY_BUCKETS && len < (int)sizeof(buf); b++) {
+          len += snprintf(buf + len, sizeof(buf) - len, "%s%u", b > 0 ? "," : "", st.latency[b]);
+        }
+        if (len < (int)sizeof(buf)) snprintf(buf + len, sizeof(buf) - len, "]}");
+        out += buf;
       }
+      out += "]}";
 
-      sendJSONResponse(request, String(buf));
+      sendJSONResponse(request, out);
+    });
+
+    // BINER: TraceHeader + RECORD TERLAMA -> TERBARU; ?clear=1 MENGOSONGKAN SETELAH SNAPSHOT
+    routeOn("/api/trace", HTTP_GET, [](AsyncWebServerRequest *request) {
+      struct TraceSnapshot {
+        TraceHeader header;
+        TraceRecord records[TRACE_CAPACITY];
+      };
+
+      std::shared_ptr<TraceSnapshot> snap(new (std::nothrow) TraceSnapshot());
+      if (!snap) {
+        request->send(503, "application/json", "{\"error\":\"Out of memory\"}");
+        return;
+      }
+
+      portENTER_CRITICAL(&traceMux);
+      uint16_t count = traceCount;
+      uint16_t first = (traceHead + TRACE_CAPACITY - count) % TRACE_CAPACITY;
+      for (uint16_t i = 0; i < count; i++) {
+        snap->records[i] = traceRing[(first + i) % TRACE_CAPACITY];
+      }
+      snap->header.dropped = traceDropped;
+      if (request->hasParam("clear")) {
+        traceHead = 0;
+        traceCount = 0;
+        traceDropped = 0;
+      }
+      portEXIT_CRITICAL(&traceMux);
+
+      memcpy(snap->header.magic, "JWST", 4);
+      snap->header.version = TRACE_FORMAT_VERSION;
+      snap->header.recordSize = sizeof(TraceRecord);
+      snap->header.count = count;
+      snap->header.bootId = stateBootId;
+
+      size_t total = sizeof(TraceHeader) + count * sizeof(TraceRecord);
+      AsyncWebServerResponse *response = request->beginResponse(
+        "application/octet-stream", total,
+        [snap, total](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+          size_t n = min(maxLen, total - index);
+          memcpy(buffer, (const uint8_t *)snap.get() + index, n);
+          return n;
+        });
+      response->addHeader("Content-Disposition", "attachment; filename=\"jws-trace.bin\"");
+      response->addHeader("Cache-Control", "no-store");
+      request->send(response);
     });
 
-    server.on("/notfound", HTTP_GET, [](AsyncWebServerRequest * request) {
+    routeOn("/notfound", HTTP_GET, [](AsyncWebServerRequest * request) {
     request->send(404, "text/html",
       "<!DOCTYPE html><html><head>"
       "<meta charset='UTF-8'>"
@@ -3559,7 +6616,10 @@ void setupServerRoutes() {
     );
     });
 
+    // SEMUA RUTE routeOn() MASUK LEWAT CATCH-ALL INI (LIHAT TABEL RUTE)
     server.onNotFound([](AsyncWebServerRequest * request) {
+      if (dispatchRoute(request)) return;
+
       String url = request -> url();
       IPAddress clientIP = request -> client() -> remoteIP();
 
@@ -3691,221 +6751,600 @@ void createDefaultConfigFiles() {
     Serial.println("[ADA]   /METHOD_SELECTION.TXT - DILEWATI");
   }
 
-  Serial.println("========================================\n");
-}
+  Serial.println("========================================\n");
+}
+
+void printStackReport() {
+  Serial.println("\n========================================");
+  Serial.println("ANALISIS PENGGUNAAN STACK");
+  Serial.println("========================================");
+
+  struct TaskInfo {
+    TaskHandle_t handle;
+    const char *name;
+    uint32_t size;
+  };
+
+  TaskInfo tasks[] = {
+    { uiTaskHandle, "UI", UI_TASK_STACK_SIZE },
+    { webTaskHandle, "Web", WEB_TASK_STACK_SIZE },
+    { wifiTaskHandle, "WiFi", WIFI_TASK_STACK_SIZE },
+    { ntpTaskHandle, "NTP", NTP_TASK_STACK_SIZE },
+    { scheduleTaskHandle, "Schedule", SCHEDULE_TASK_STACK_SIZE },
+    { rtcTaskHandle, "RTC", RTC_TASK_STACK_SIZE },
+    { touchTaskHandle, "Touch", TOUCH_TASK_STACK_SIZE },
+    { jobTaskHandle, "Job", JOB_TASK_STACK_SIZE }
+  };
+  const int taskCount = sizeof(tasks) / sizeof(tasks[0]);
+
+  uint32_t totalAllocated = 0;
+  uint32_t totalUsed = 0;
+  uint32_t totalFree = 0;
+
+  for (int i = 0; i < taskCount; i++) {
+    if (tasks[i].handle) {
+      UBaseType_t hwm = uxTaskGetStackHighWaterMark(tasks[i].handle);
+
+      uint32_t free = hwm * sizeof(StackType_t);
+      uint32_t used = tasks[i].size - free;
+      float percent = (used * 100.0) / tasks[i].size;
+
+      totalAllocated += tasks[i].size;
+      totalUsed += used;
+      totalFree += free;
+
+      Serial.printf("%-10s: %5d/%5d (%5.1f%%) [SISA: %5d] ",
+                    tasks[i].name, used, tasks[i].size, percent, free);
+
+      if (percent < 40) Serial.println("BOROS - DAPAT DIKURANGI");
+      else if (percent < 60) Serial.println("OPTIMAL");
+      else if (percent < 75) Serial.println("SESUAI");
+      else if (percent < 90) Serial.println("TINGGI - PANTAU TERUS");
+      else if (percent < 95) Serial.println("BERBAHAYA - HARUS DITAMBAH");
+      else Serial.println("KRITIS - TAMBAH SEGERA");
+    } else {
+      Serial.printf("%-10s: TUGAS TIDAK BERJALAN", tasks[i].name);
+    }
+  }
+
+  Serial.println("========================================");
+  Serial.printf("TOTAL DIALOKASIKAN: %d BYTE (%.1F KB)",
+                totalAllocated, totalAllocated / 1024.0);
+  Serial.printf("TOTAL DIGUNAKAN:    %d BYTE (%.1F KB)",
+                totalUsed, totalUsed / 1024.0);
+  Serial.printf("TOTAL TERSISA:      %d BYTE (%.1F KB)",
+                totalFree, totalFree / 1024.0);
+  Serial.printf("EFISIENSI:      %.1f%%\n",
+                (totalUsed * 100.0) / totalAllocated);
+
+  bool hasCritical = false;
+  for (int i = 0; i < taskCount; i++) {
+    if (tasks[i].handle) {
+      UBaseType_t hwm = uxTaskGetStackHighWaterMark(tasks[i].handle);
+      uint32_t free = hwm * sizeof(StackType_t);
+      uint32_t used = tasks[i].size - free;
+      float percent = (used * 100.0) / tasks[i].size;
+
+      if (percent >= 90) {
+        if (!hasCritical) {
+          Serial.println("========================================");
+          Serial.println("TUGAS KRITIS:");
+          hasCritical = true;
+        }
+        Serial.printf("   %s: %.1f%% (TERSISA: %d BYTE)",
+                      tasks[i].name, percent, free);
+      }
+    }
+  }
+
+  if (hasCritical) {
+    Serial.println("   TINDAKAN: TAMBAH UKURAN STACK SEGERA");
+  }
+
+  Serial.println("========================================\n");
+}
+
+// ============================================
+// FUNGSI CALLBACK LVGL
+// ============================================
+void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+  uint16_t *color_p = (uint16_t *)px_map;
+
+  if (splashEncoder.active) {
+    // RENDER CAPTURE (TANPA JAM) HANYA KE ENCODER, BUKAN KE LAYAR
+    SplashChunkSink sink;
+    splashEncodeArea(splashEncoder, sink, area->x1, area->y1, area->x2, area->y2, color_p);
+  } else if (spiMutex != NULL && xSemaphoreTake(spiMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    uint32_t w = area->x2 - area->x1 + 1;
+    uint32_t h = area->y2 - area->y1 + 1;
+
+    tft.startWrite();
+    tft.setAddrWindow(area->x1, area->y1, w, h);
+    tft.pushColors(color_p, w * h);
+    tft.endWrite();
+
+    xSemaphoreGive(spiMutex);
+  }
+  lv_display_flush_ready(disp);
+}
+
+// ============================================
+// SNAPSHOT LAYAR: ENCODE SAAT FLUSH, DECODE LANGSUNG KE TFT SAAT BOOT
+// ============================================
+void splashFreeChunks() {
+  for (int i = 0; i < SPLASH_RAM_CHUNKS; i++) {
+    free(splashChunks[i]);
+    splashChunks[i] = NULL;
+  }
+}
+
+// DIPANGGIL DARI uiTask DENGAN displayMutex SUDAH DIPEGANG. HANYA RENDER +
+// ENCODE KE RAM; FLASH DITULIS jobTask LEWAT saveSplashSnapshot().
+void captureSplashSnapshot() {
+  if (splashWritePending) {
+    splashCaptureDue = true;   // HASIL SEBELUMNYA BELUM DITULIS
+    return;
+  }
+
+  unsigned long start = millis();
+
+  SplashChunkSink sink;
+  splashEncodeBegin(splashEncoder, sink, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+  // SPLASH DITAMPILKAN SAAT BOOT BERIKUTNYA: JAM & TANGGAL SAAT CAPTURE SUDAH
+  // BASI, JADI DIKOSONGKAN. FLUSH TIDAK MENGIRIM KE TFT SELAMA CAPTURE, LAYAR
+  // TETAP MENAMPILKAN FRAME TERAKHIR LENGKAP DENGAN JAM.
+  lv_obj_t *clockLabels[] = { objects.time_now, objects.date_now };
+  bool hidden[2] = { false, false };
+  for (int i = 0; i < 2; i++) {
+    if (clockLabels[i] && !lv_obj_has_flag(clockLabels[i], LV_OBJ_FLAG_HIDDEN)) {
+      lv_obj_add_flag(clockLabels[i], LV_OBJ_FLAG_HIDDEN);
+      hidden[i] = true;
+    }
+  }
+
+  splashEncoder.active = true;
+  lv_obj_invalidate(lv_screen_active());
+  lv_refr_now(display);
+  splashEncoder.active = false;
+
+  for (int i = 0; i < 2; i++) {
+    if (hidden[i]) lv_obj_clear_flag(clockLabels[i], LV_OBJ_FLAG_HIDDEN);
+  }
+
+  bool complete = splashEncodeEnd(splashEncoder, sink);
+
+  if (!complete) {
+    splashFreeChunks();
+    Serial.println("SNAPSHOT LAYAR DIBATALKAN (TERLALU BESAR / AREA TIDAK LENGKAP)");
+    return;
+  }
+
+  Serial.printf("SNAPSHOT LAYAR DI-ENCODE: %lu BYTE (%.1f%% DARI RAW) DALAM %lu MS\n",
+                (unsigned long)splashEncoder.bytes,
+                splashEncoder.bytes * 100.0 / (SCREEN_WIDTH * SCREEN_HEIGHT * 2),
+                millis() - start);
+
+  splashWritePending = true;
+  queuePersist(PERSIST_SPLASH);
+}
+
+// DIPANGGIL jobTask: TULIS BLOK RAM KE FILE SEMENTARA, LALU GANTI NAMA
+void saveSplashSnapshot() {
+  if (!splashWritePending) return;
+
+  unsigned long start = millis();
+  uint32_t total = splashEncoder.bytes;
+  bool ok = false;
+
+  if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(5000)) == pdTRUE) {
+    fs::File file = LittleFS.open(SPLASH_TMP_FILE, "w");
+    if (file) {
+      ok = true;
+      for (uint32_t off = 0; off < total && ok; off += SPLASH_RAM_CHUNK) {
+        size_t n = min((uint32_t)SPLASH_RAM_CHUNK, total - off);
+        ok = file.write(splashChunks[off / SPLASH_RAM_CHUNK], n) == n;
+      }
+      file.close();
+
+      if (ok) {
+        LittleFS.remove(SPLASH_FILE);
+        LittleFS.rename(SPLASH_TMP_FILE, SPLASH_FILE);
+      } else {
+        LittleFS.remove(SPLASH_TMP_FILE);
+      }
+    }
+    xSemaphoreGive(settingsMutex);
+  }
+
+  splashFreeChunks();
+  splashWritePending = false;
+
+  if (ok) {
+    Serial.printf("SNAPSHOT LAYAR DISIMPAN: %lu BYTE DALAM %lu MS\n",
+                  (unsigned long)total, millis() - start);
+  } else {
+    Serial.println("SNAPSHOT LAYAR GAGAL DITULIS");
+  }
+}
+
+struct SplashReader {
+  fs::File *file;
+  uint8_t buf[SPLASH_IO_CHUNK];
+  size_t len;
+  size_t pos;
+
+  bool read(uint8_t *dst, size_t n) {
+    while (n > 0) {
+      if (pos >= len) {
+        len = file->read(buf, sizeof(buf));
+        pos = 0;
+        if (len == 0) return false;
+      }
+      size_t chunk = min(n, len - pos);
+      memcpy(dst, buf + pos, chunk);
+      pos += chunk;
+      dst += chunk;
+      n -= chunk;
+    }
+    return true;
+  }
+};
+
+struct SplashTftPixels {
+  void push(const uint16_t *pixels, uint16_t count) {
+    tft.pushColors((uint16_t *)pixels, count);
+  }
+};
+
+// TANPA LVGL: STREAM LANGSUNG KE ILI9341, DIPANGGIL SEBELUM INIT LAIN
+bool drawSplashSnapshot() {
+  fs::File f = LittleFS.open(SPLASH_FILE, "r");
+  if (!f) return false;
+
+  SplashReader reader;
+  reader.file = &f;
+  reader.len = 0;
+  reader.pos = 0;
+
+  if (!splashReadHeader(reader, SCREEN_WIDTH, SCREEN_HEIGHT)) {
+    f.close();
+    Serial.println("SNAPSHOT LAYAR TIDAK VALID - DIABAIKAN");
+    return false;
+  }
+
+  const uint32_t total = (uint32_t)SCREEN_WIDTH * SCREEN_HEIGHT;
+  SplashTftPixels out;
+
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+  uint32_t drawn = splashDecodePixels(reader, total, out);
+  tft.endWrite();
+  f.close();
+
+  if (drawn != total) {
+    Serial.printf("SNAPSHOT LAYAR RUSAK (%lu/%lu PIKSEL) - DIHAPUS\n",
+                  (unsigned long)drawn, (unsigned long)total);
+    tft.fillScreen(TFT_BLACK);
+    LittleFS.remove(SPLASH_FILE);
+    return false;
+  }
+
+  return true;
+}
+
+void turnOnBacklight() {
+  if (backlightOn) return;
+
+  ledcAttach(TFT_BL, TFT_BL_FREQ, TFT_BL_RESOLUTION);
+  ledcWrite(TFT_BL, TFT_BL_BRIGHTNESS);
+  backlightOn = true;
+}
+
+// ============================================
+// INPUT SENTUH - ISR + TOUCH TASK
+// ============================================
+void IRAM_ATTR touchISR() {
+  if (touchIrqMicros == 0) {
+    touchIrqMicros = micros();
+  }
+
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  if (touchTaskHandle != NULL) {
+    vTaskNotifyGiveFromISR(touchTaskHandle, &higherPriorityTaskWoken);
+  }
+  if (higherPriorityTaskWoken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+// DICATAT SEKALI PER SENTUHAN OLEH KONSUMEN PERTAMA
+void recordTouchLatency() {
+  uint32_t irqAt = touchIrqMicros;
+  if (irqAt == 0) return;
+
+  uint32_t latency = micros() - irqAt;
+  bool recorded = false;
+
+  portENTER_CRITICAL(&touchStatsMux);
+  if (touchIrqMicros == irqAt) {
+    touchIrqMicros = 0;
+    touchStats.lastLatencyUs = latency;
+    if (latency > touchStats.maxLatencyUs) {
+      touchStats.maxLatencyUs = latency;
+    }
+    touchStats.pressCount++;
+    recorded = true;
+  }
+  portEXIT_CRITICAL(&touchStatsMux);
+
+#if TOUCH_LATENCY_LOG
+  if (recorded) {
+    Serial.printf("LATENSI SENTUH: %lu us (MAKS %lu us)\n",
+                  (unsigned long)latency,
+                  (unsigned long)touchStats.maxLatencyUs);
+  }
+#else
+  (void)recorded;
+#endif
+}
+
+void publishTouch(bool pressed, int16_t x, int16_t y) {
+  touchSlot = touchSlotPack(touchSlot, pressed, x, y);
+}
+
+bool sampleTouchRaw(int16_t &rx, int16_t &ry) {
+  bool validTouch = false;
+
+  if (spiMutex != NULL && xSemaphoreTake(spiMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
+    TS_Point p = touch.getPoint();
+    xSemaphoreGive(spiMutex);
+
+    if (p.z > TOUCH_MIN_PRESSURE) {
+      rx = p.x;
+      ry = p.y;
+      validTouch = true;
+    }
+  }
+
+  return validTouch;
+}
+
+// JARI BARU MENEMPEL : 3 SAMPEL -> MEDIAN, FILTER DIISI ULANG
+// JARI DITAHAN      : 1 SAMPEL -> MEDIAN 3 TERAKHIR -> IIR
+bool readTouchRaw(int16_t &rx, int16_t &ry, bool penDown) {
+  TouchFilter &f = touchFilter;
+
+  if (penDown) {
+    for (int i = 0; i < 3; i++) {
+      if (i > 0) vTaskDelay(pdMS_TO_TICKS(TOUCH_SAMPLE_SPACING));
+      if (!sampleTouchRaw(f.rawX[i], f.rawY[i])) return false;
+    }
+    touchFilterStart(f);
+  } else {
+    int16_t sx, sy;
+    if (!sampleTouchRaw(sx, sy)) return false;
+    touchFilterTrack(f, sx, sy);
+  }
+
+  touchFilterOutput(f, rx, ry);
+  return true;
+}
+
+void applyTouchCalibration(int16_t rx, int16_t ry, int16_t &x, int16_t &y) {
+  touchCalibrationApply(touchCalGet(), rx, ry, SCREEN_WIDTH, SCREEN_HEIGHT, x, y);
+}
+
+void handleTouchPress(int16_t x, int16_t y) {
+  PERF_SCOPE(PERF_TOUCH);
+
+  // ======================================
+  // PRIORITAS 1: MATIKAN ALARM DENGAN SENTUHAN LAYAR
+  // ======================================
+  if (alarmState.isRinging) {
+    recordTouchLatency();
+    stopAlarm();
+    return;
+  }
+
+  if (!adzanState.canTouch) return;
 
-void printStackReport() {
-  Serial.println("\n========================================");
-  Serial.println("ANALISIS PENGGUNAAN STACK");
-  Serial.println("========================================");
+  Prayer prayer = adzanState.currentPrayer;
+  if (!isAdzanPrayer(prayer)) return;
 
-  struct TaskInfo {
-    TaskHandle_t handle;
-    const char *name;
-    uint32_t size;
-  };
+  if (!touchZoneHit(PRAYER_TOUCH_ZONES[prayer], x, y)) return;
 
-  TaskInfo tasks[] = {
-    { uiTaskHandle, "UI", UI_TASK_STACK_SIZE },
-    { webTaskHandle, "Web", WEB_TASK_STACK_SIZE },
-    { wifiTaskHandle, "WiFi", WIFI_TASK_STACK_SIZE },
-    { ntpTaskHandle, "NTP", NTP_TASK_STACK_SIZE },
-    { prayerTaskHandle, "Prayer", PRAYER_TASK_STACK_SIZE },
-    { httpTaskHandle, "HTTP", 8192 },
-    { rtcTaskHandle, "RTC", RTC_TASK_STACK_SIZE }
-  };
+  const PrayerInfo &info = PRAYER_INFO[prayer];
 
-  uint32_t totalAllocated = 0;
-  uint32_t totalUsed = 0;
-  uint32_t totalFree = 0;
+  recordTouchLatency();
+  Serial.printf("SENTUH ADZAN: %s\n", info.key);
 
-  for (int i = 0; i < 6; i++) {
-    if (tasks[i].handle) {
-      UBaseType_t hwm = uxTaskGetStackHighWaterMark(tasks[i].handle);
+  if (audioTaskHandle != NULL) {
+    Serial.println("SISTEM AUDIO TERSEDIA - MEMULAI PEMUTARAN");
 
-      uint32_t free = hwm * sizeof(StackType_t);
-      uint32_t used = tasks[i].size - free;
-      float percent = (used * 100.0) / tasks[i].size;
+    adzanState.isPlaying = true;
+    adzanState.canTouch = false;
 
-      totalAllocated += tasks[i].size;
-      totalUsed += used;
-      totalFree += free;
+    audioPlay(info.adzanTrack, onAdzanAudioDone);
 
-      Serial.printf("%-10s: %5d/%5d (%5.1f%%) [SISA: %5d] ",
-                    tasks[i].name, used, tasks[i].size, percent, free);
+  } else {
+    adzanState.isPlaying = false;
+    adzanState.canTouch = false;
+    adzanState.currentPrayer = PRAYER_NONE;
 
-      if (percent < 40) Serial.println("BOROS - DAPAT DIKURANGI");
-      else if (percent < 60) Serial.println("OPTIMAL");
-      else if (percent < 75) Serial.println("SESUAI");
-      else if (percent < 90) Serial.println("TINGGI - PANTAU TERUS");
-      else if (percent < 95) Serial.println("BERBAHAYA - HARUS DITAMBAH");
-      else Serial.println("KRITIS - TAMBAH SEGERA");
+    // /adzan_state.txt DITULIS jobTask, BUKAN DI JALUR SENTUH
+    requestPersist(PERSIST_ADZAN);
+
+    Serial.println("AUDIO TIDAK TERSEDIA - STATUS ADZAN DIKOSONGKAN");
+  }
+}
+
+void touchTask(void *parameter) {
+  bool pressed = false;
+  int16_t rx = 0;
+  int16_t ry = 0;
+  int16_t x = 0;
+  int16_t y = 0;
+
+  while (true) {
+    if (pressed || digitalRead(TOUCH_IRQ) == LOW) {
+      // JARI MASIH MENEMPEL: LACAK POSISI
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TOUCH_TRACK_INTERVAL));
     } else {
-      Serial.printf("%-10s: TUGAS TIDAK BERJALAN", tasks[i].name);
+      // DIAM SAMPAI ISR MEMBANGUNKAN - TANPA POLLING SPI
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
-  }
 
-  Serial.println("========================================");
-  Serial.printf("TOTAL DIALOKASIKAN: %d BYTE (%.1F KB)",
-                totalAllocated, totalAllocated / 1024.0);
-  Serial.printf("TOTAL DIGUNAKAN:    %d BYTE (%.1F KB)",
-                totalUsed, totalUsed / 1024.0);
-  Serial.printf("TOTAL TERSISA:      %d BYTE (%.1F KB)",
-                totalFree, totalFree / 1024.0);
-  Serial.printf("EFISIENSI:      %.1f%%\n",
-                (totalUsed * 100.0) / totalAllocated);
+    if (readTouchRaw(rx, ry, !pressed)) {
+      bool firstContact = !pressed;
+      pressed = true;
 
-  bool hasCritical = false;
-  for (int i = 0; i < 6; i++) {
-    if (tasks[i].handle) {
-      UBaseType_t hwm = uxTaskGetStackHighWaterMark(tasks[i].handle);
-      uint32_t free = hwm * sizeof(StackType_t);
-      uint32_t used = tasks[i].size - free;
-      float percent = (used * 100.0) / tasks[i].size;
+      // SAAT KALIBRASI: RAW DITAHAN SAMPAI JARI DILEPAS
+      if (touchCalState.running) continue;
 
-      if (percent >= 90) {
-        if (!hasCritical) {
-          Serial.println("========================================");
-          Serial.println("TUGAS KRITIS:");
-          hasCritical = true;
+      applyTouchCalibration(rx, ry, x, y);
+      publishTouch(true, x, y);
+
+      if (firstContact) {
+        uint32_t startUs = micros();
+        handleTouchPress(x, y);
+        traceRecord(TRACE_TOUCH, TRACE_F_PRESS, 0,
+                    ((int32_t)x << 16) | (uint16_t)y, micros() - startUs);
+      }
+    } else if (digitalRead(TOUCH_IRQ) == HIGH) {
+      if (pressed) {
+        pressed = false;
+        publishTouch(false, x, y);
+        traceRecord(TRACE_TOUCH, 0, 0, ((int32_t)x << 16) | (uint16_t)y);
+
+        if (touchCalState.running && touchCalQueue != NULL) {
+          uint32_t raw = ((uint32_t)(uint16_t)rx << 16) | (uint16_t)ry;
+          xQueueOverwrite(touchCalQueue, &raw);
         }
-        Serial.printf("   %s: %.1f%% (TERSISA: %d BYTE)",
-                      tasks[i].name, percent, free);
       }
+      touchIrqMicros = 0;
     }
   }
-
-  if (hasCritical) {
-    Serial.println("   TINDAKAN: TAMBAH UKURAN STACK SEGERA");
-  }
-
-  Serial.println("========================================\n");
 }
 
 // ============================================
-// FUNGSI CALLBACK LVGL
+// KALIBRASI LAYAR SENTUH
 // ============================================
-void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
-  if (spiMutex != NULL && xSemaphoreTake(spiMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-    uint32_t w = area->x2 - area->x1 + 1;
-    uint32_t h = area->y2 - area->y1 + 1;
-    uint16_t *color_p = (uint16_t *)px_map;
+void drawTouchCalTarget(int16_t x, int16_t y, uint8_t index) {
+  if (xSemaphoreTake(spiMutex, pdMS_TO_TICKS(200)) != pdTRUE) return;
 
-    tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors(color_p, w * h);
-    tft.endWrite();
+  char label[32];
+  snprintf(label, sizeof(label), "SENTUH TITIK %d/%d", index + 1, TOUCH_CAL_POINTS);
 
-    xSemaphoreGive(spiMutex);
-  }
-  lv_display_flush_ready(disp);
+  tft.fillScreen(TFT_BLACK);
+  tft.drawFastHLine(x - 10, y, 21, TFT_WHITE);
+  tft.drawFastVLine(x, y - 10, 21, TFT_WHITE);
+  tft.drawCircle(x, y, 6, TFT_WHITE);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.setTextDatum(MC_DATUM);
+  tft.drawString(label, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 40, 2);
+
+  xSemaphoreGive(spiMutex);
 }
 
-void my_touchpad_read(lv_indev_t *indev_driver, lv_indev_data_t *data) {
-  static unsigned long lastTouchRead = 0;
-  unsigned long now = millis();
+void touchCalibrationTask(void *parameter) {
+  int16_t rawX[TOUCH_CAL_POINTS];
+  int16_t rawY[TOUCH_CAL_POINTS];
 
-  if (now - lastTouchRead < 50) {
-    data->state = touchPressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
-    if (touchPressed) {
-      data->point.x = lastX;
-      data->point.y = lastY;
-    }
+  Serial.println("\n========================================");
+  Serial.println("KALIBRASI LAYAR SENTUH DIMULAI");
+  Serial.println("========================================");
+
+  if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+    Serial.println("KALIBRASI GAGAL: LAYAR SIBUK");
+    touchCalState.status = "failed";
+    touchCalTaskHandle = NULL;
+    vTaskDelete(NULL);
     return;
   }
 
-  lastTouchRead = now;
-
-  bool irqActive = (digitalRead(TOUCH_IRQ) == LOW);
-  if (irqActive) {
-    delayMicroseconds(100);
-
-    bool validTouch = false;
-
-    if (spiMutex != NULL && xSemaphoreTake(spiMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-      if (touch.touched()) {
-        TS_Point p = touch.getPoint();
-        if (p.z > 200) {
-          lastX = map(p.x, TS_MIN_X, TS_MAX_X, 0, SCREEN_WIDTH);
-          lastY = map(p.y, TS_MIN_Y, TS_MAX_Y, 0, SCREEN_HEIGHT);
-          lastX = constrain(lastX, 0, SCREEN_WIDTH - 1);
-          lastY = constrain(lastY, 0, SCREEN_HEIGHT - 1);
+  touchCalState.running = true;
+  bool ok = true;
 
-          data->point.x = lastX;
-          data->point.y = lastY;
-          validTouch = true;
-        }
-      }
-      xSemaphoreGive(spiMutex);
-    }
+  for (int i = 0; i < TOUCH_CAL_POINTS; i++) {
+    touchCalState.point = i;
+    drawTouchCalTarget(TOUCH_CAL_TARGET_X[i], TOUCH_CAL_TARGET_Y[i], i);
+    xQueueReset(touchCalQueue);
 
-    if (validTouch && !touchPressed) {
-      // ======================================
-      // PRIORITAS 1: MATIKAN ALARM DENGAN SENTUHAN LAYAR
-      // ======================================
-      if (alarmState.isRinging) {
-        stopAlarm();
-        data->state = LV_INDEV_STATE_PR;
-        touchPressed = true;
-        return;
-      }
+    uint32_t raw;
+    if (xQueueReceive(touchCalQueue, &raw, pdMS_TO_TICKS(TOUCH_CAL_TIMEOUT)) != pdTRUE) {
+      Serial.printf("KALIBRASI DIBATALKAN: TITIK %d TIDAK DISENTUH\n", i + 1);
+      ok = false;
+      break;
     }
 
-    if (validTouch && adzanState.canTouch && !touchPressed) {
-      struct {String name; int x1,y1,x2,y2;} areas[] = {
-        {"subuh",   200, 70,  310, 95},
-        {"zuhur",   200, 130, 310, 155},
-        {"ashar",   200, 160, 310, 185},
-        {"maghrib", 200, 190, 310, 215},
-        {"isya",    200, 220, 310, 240}
-      };
-
-      for (int i = 0; i < 5; i++) {
-        if (areas[i].name == adzanState.currentPrayer &&
-            lastX >= areas[i].x1 && lastX <= areas[i].x2 &&
-            lastY >= areas[i].y1 && lastY <= areas[i].y2) {
+    rawX[i] = (int16_t)(raw >> 16);
+    rawY[i] = (int16_t)(raw & 0xFFFF);
+    Serial.printf("TITIK %d: LAYAR (%d,%d) RAW (%d,%d)\n",
+                  i + 1, TOUCH_CAL_TARGET_X[i], TOUCH_CAL_TARGET_Y[i], rawX[i], rawY[i]);
+  }
 
-          Serial.println("SENTUH ADZAN: " + areas[i].name);
+  TouchCalibration result;
+  float errorPx = 0;
+  if (ok) {
+    TouchCalFit fit = solveTouchCalibration(rawX, rawY, TOUCH_CAL_TARGET_X, TOUCH_CAL_TARGET_Y,
+                                            TOUCH_CAL_POINTS, result, errorPx);
+    if (fit == TOUCH_FIT_DEGENERATE) {
+      Serial.println("KALIBRASI GAGAL: TITIK SEGARIS / RAW TIDAK BERUBAH");
+    } else if (fit == TOUCH_FIT_RANGE) {
+      Serial.println("KALIBRASI GAGAL: KOEFISIEN DI LUAR BATAS");
+    } else if (fit == TOUCH_FIT_ERROR) {
+      Serial.printf("KALIBRASI GAGAL: GALAT %.1f px > %d px\n", errorPx, TOUCH_CAL_MAX_ERROR);
+    }
+    ok = (fit == TOUCH_FIT_OK);
+  }
 
-          if (audioTaskHandle != NULL) {
-            Serial.println("SISTEM AUDIO TERSEDIA - MEMULAI PEMUTARAN");
+  if (ok) {
+    touchCalSet(result);
+  }
 
-            adzanState.isPlaying = true;
-            adzanState.canTouch = false;
+  touchCalState.errorPx = errorPx;
+  touchCalState.status = ok ? "done" : "failed";
+  touchCalState.running = false;
 
-            xTaskNotifyGive(audioTaskHandle);
+  if (xSemaphoreTake(spiMutex, pdMS_TO_TICKS(200)) == pdTRUE) {
+    tft.fillScreen(TFT_BLACK);
+    xSemaphoreGive(spiMutex);
+  }
+  lv_obj_invalidate(lv_screen_active());
+  xSemaphoreGive(displayMutex);
 
-          } else {
-            Serial.println("========================================");
-            Serial.println("PERINGATAN: SISTEM AUDIO TIDAK TERSEDIA");
-            Serial.println("========================================");
-            Serial.println("ALASAN: SD CARD TIDAK TERDETEKSI ATAU AUDIO DINONAKTIFKAN");
-            Serial.println("AKSI: MENGHAPUS STATUS ADZAN SEGERA");
-            Serial.println("========================================");
+  if (ok) {
+    Serial.printf("KALIBRASI BERHASIL - GALAT RMS: %.1f px\n", errorPx);
+    saveTouchCalibration();
+  } else {
+    Serial.println("KALIBRASI LAMA TETAP DIGUNAKAN");
+  }
+  Serial.println("========================================\n");
 
-            adzanState.isPlaying = false;
-            adzanState.canTouch = false;
-            adzanState.currentPrayer = "";
+  touchCalTaskHandle = NULL;
+  vTaskDelete(NULL);
+}
 
-            saveAdzanState();
+void my_touchpad_read(lv_indev_t *indev_driver, lv_indev_data_t *data) {
+  uint32_t slot = touchSlot;
+  bool pressed = (slot & TOUCH_SLOT_PRESSED) != 0;
 
-            Serial.println("STATUS ADZAN DIKOSONGKAN - SIAP UNTUK WAKTU SHALAT BERIKUTNYA");
-          }
+  // SAAT LEPAS SLOT TETAP MEMBAWA TITIK TERAKHIR
+  data->point.x = TOUCH_SLOT_X(slot);
+  data->point.y = TOUCH_SLOT_Y(slot);
 
-          break;
-        }
-      }
-    }
+  if (pressed) {
+    data->state = LV_INDEV_STATE_PR;
 
-    if (validTouch) {
-      data->state = LV_INDEV_STATE_PR;
-      touchPressed = true;
-      return;
+    if (!touchPressed) {
+      recordTouchLatency();
     }
+  } else {
+    data->state = LV_INDEV_STATE_REL;
   }
 
-  data->state = LV_INDEV_STATE_REL;
-  touchPressed = false;
+  touchPressed = pressed;
 }
 
 // ============================================
@@ -3915,28 +7354,15 @@ void uiTask(void *parameter) {
   TickType_t xLastWakeTime = xTaskGetTickCount();
   const TickType_t xFrequency = pdMS_TO_TICKS(50);
 
-  static bool initialDisplayDone = false;
-  static bool uiShown = false;
-
+  // FRAME PERTAMA (JADWAL TERSIMPAN) SUDAH DIGAMBAR DI setup()
   while (true) {
     if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(20)) == pdTRUE) {
       lv_timer_handler();
 
-      if (!initialDisplayDone && objects.subuh_time != NULL) {
-        initialDisplayDone = true;
-
-        updateCityDisplay();
-
-        if (prayerConfig.subuhTime.length() > 0) {
-          updatePrayerDisplay();
-          Serial.println("WAKTU SHALAT AWAL DITAMPILKAN");
-        }
-
-        if (!uiShown) {
-          showAllUIElements();
-          uiShown = true;
-          Serial.println("ELEMEN UI DITAMPILKAN");
-        }
+      // JANGAN SIMPAN LAYAR SAAT LABEL SEDANG BERKEDIP
+      if (splashCaptureDue && !blinkState.isBlinking && !alarmState.isRinging) {
+        splashCaptureDue = false;
+        captureSplashSnapshot();
       }
 
       xSemaphoreGive(displayMutex);
@@ -3952,6 +7378,7 @@ void uiTask(void *parameter) {
           case DisplayUpdate::PRAYER_UPDATE:
             updatePrayerDisplay();
             updateCityDisplay();
+            splashCaptureDue = true;
             break;
           default:
             break;
@@ -3975,11 +7402,12 @@ void uiTask(void *parameter) {
 
 // ============================================
 // HELPER: ASYNC SCAN - TIDAK BLOCKING, AMAN WDT
+// ssid != NULL -> SCAN TERARAH (PROBE SSID SAJA)
 // ============================================
-int asyncScanNetworks() {
+int asyncScanNetworks(const char *ssid, uint32_t dwellMs) {
     esp_task_wdt_reset();
 
-    WiFi.scanNetworks(true, false);
+    WiFi.scanNetworks(true, false, false, dwellMs, 0, ssid);
 
     unsigned long scanStart = millis();
     const unsigned long SCAN_TIMEOUT = 8000;
@@ -3992,68 +7420,81 @@ int asyncScanNetworks() {
             return -1;
         }
         esp_task_wdt_reset();
-        vTaskDelay(pdMS_TO_TICKS(200));
+        vTaskDelay(pdMS_TO_TICKS(50));
         result = WiFi.scanComplete();
     }
 
+    Serial.printf("[WIFI] SCAN SELESAI DALAM %lu MS\n", millis() - scanStart);
     return result;
 }
 
 // ============================================
-// KONEKSI KE AP TERKUAT (ASYNC SCAN + BSSID)
-// Dipanggil hanya saat: pertama nyala, koneksi terputus, percobaan ulang
+// KONEKSI ULANG BERTAHAP (wifi_reconnect.h)
+// 1. LANGSUNG KE BSSID/CHANNEL TERAKHIR. ALAMAT IP SELALU LEWAT DHCP: IP
+//    STATIS DARI LEASE LAMA BENTROK BILA ROUTER SUDAH MEMBERIKANNYA KE LAIN
+// 2. SCAN TERARAH SSID
+// 3. SCAN PENUH SEMUA CHANNEL
+// Tahap naik setiap kali dipanggil ulang, kembali ke 1 setelah GOT_IP
 // ============================================
-void connectToBestAP() {
-    Serial.println("\n[WIFI] MEMINDAI AP TERKUAT (ASYNC)...");
+struct ArduinoWiFiDriver {
+    int32_t bestRssi;
 
-    int found = asyncScanNetworks();
-    if (found <= 0) {
-        Serial.println("[WIFI] TIDAK ADA JARINGAN DITEMUKAN, KONEK LANGSUNG...");
-        esp_netif_set_hostname(esp_netif_get_handle_from_ifkey("WIFI_STA_DEF"), hostname.c_str());
-        WiFi.begin(wifiConfig.routerSSID.c_str(), wifiConfig.routerPassword.c_str());
-        return;
+    void beginDirect(uint8_t stage, int32_t channel, const uint8_t *bssid) {
+        if (stage == WIFI_STAGE_DIRECTED) {
+            Serial.printf("\n[WIFI] TAHAP 1: KONEK LANGSUNG %02X:%02X:%02X:%02X:%02X:%02X CH %ld\n",
+                bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], (long)channel);
+        } else {
+            Serial.printf("[WIFI] AP TERPILIH: %02X:%02X:%02X:%02X:%02X:%02X | RSSI: %ld dBm | CH: %ld\n",
+                bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], (long)bestRssi, (long)channel);
+        }
+        WiFi.begin(wifiConfig.routerSSID.c_str(), wifiConfig.routerPassword.c_str(), channel, bssid);
     }
 
-    int bestIndex = -1;
-    int bestRSSI  = -999;
+    void beginAny(const char *reason) {
+        Serial.printf("[WIFI] %s, KONEK NORMAL...\n", reason);
+        WiFi.begin(wifiConfig.routerSSID.c_str(), wifiConfig.routerPassword.c_str());
+    }
 
-    for (int i = 0; i < found; i++) {
-        if (WiFi.SSID(i) == wifiConfig.routerSSID) {
-            Serial.printf("  [%d] BSSID: %s | RSSI: %d dBm | CH: %d\n",
-                i, WiFi.BSSIDstr(i).c_str(), WiFi.RSSI(i), WiFi.channel(i));
-            if (WiFi.RSSI(i) > bestRSSI) {
-                bestRSSI  = WiFi.RSSI(i);
-                bestIndex = i;
-            }
+    int scan(const char *ssid, uint32_t dwellMs) {
+        bestRssi = -999;
+        if (ssid != NULL) {
+            Serial.printf("\n[WIFI] TAHAP 2: SCAN TERARAH SSID %s\n", ssid);
+        } else {
+            Serial.println("\n[WIFI] TAHAP 3: SCAN PENUH SEMUA CHANNEL");
         }
+        return asyncScanNetworks(ssid, dwellMs);
     }
 
-    uint8_t bestBSSID[6];
-    bool hasBSSID = false;
-    if (bestIndex >= 0) {
-        memcpy(bestBSSID, WiFi.BSSID(bestIndex), 6);
-        hasBSSID = true;
+    bool scanEntry(int i, const char *ssid, int32_t &rssi, int32_t &channel, uint8_t *bssid) {
+        if (WiFi.SSID(i) != ssid) return false;
+        rssi = WiFi.RSSI(i);
+        channel = WiFi.channel(i);
+        memcpy(bssid, WiFi.BSSID(i), 6);
+        Serial.printf("  [%d] BSSID: %s | RSSI: %ld dBm | CH: %ld\n",
+            i, WiFi.BSSIDstr(i).c_str(), (long)rssi, (long)channel);
+        if (rssi > bestRssi) bestRssi = rssi;
+        return true;
     }
 
-    WiFi.scanDelete();
+    void scanDone() {
+        WiFi.scanDelete();
+    }
+};
 
+void connectToBestAP() {
     esp_netif_set_hostname(esp_netif_get_handle_from_ifkey("WIFI_STA_DEF"), hostname.c_str());
 
-    if (hasBSSID) {
-        Serial.printf("[WIFI] AP TERPILIH: %02X:%02X:%02X:%02X:%02X:%02X | RSSI: %d dBm\n",
-            bestBSSID[0], bestBSSID[1], bestBSSID[2],
-            bestBSSID[3], bestBSSID[4], bestBSSID[5], bestRSSI);
-        WiFi.begin(wifiConfig.routerSSID.c_str(),
-                   wifiConfig.routerPassword.c_str(),
-                   0,
-                   bestBSSID);
-    } else {
-        Serial.println("[WIFI] SSID TIDAK DITEMUKAN DI SCAN, KONEK NORMAL...");
-        WiFi.begin(wifiConfig.routerSSID.c_str(), wifiConfig.routerPassword.c_str());
+    if (wifiReconnectStart == 0) {
+        wifiReconnectStart = millis();
     }
+
+    WiFiLinkInfo link = getWiFiLinkSnapshot();
+    ArduinoWiFiDriver driver = { -999 };
+    wifiConnectStep(wifiLadder, link, wifiConfig.routerSSID.c_str(), driver);
 }
 
 void wifiTask(void *parameter) {
+    xEventGroupWaitBits(bootEventGroup, BOOT_NET_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
     esp_task_wdt_add(NULL);
 
     Serial.println("\n========================================");
@@ -4066,6 +7507,11 @@ void wifiTask(void *parameter) {
     while (true) {
         esp_task_wdt_reset();
 
+        if (wifiLinkDirty) {
+            wifiLinkDirty = false;
+            saveWiFiLinkCache();
+        }
+
         // ========================================
         // TUNGGU EVENT WIFI (EVENT-DRIVEN)
         // ========================================
@@ -4127,6 +7573,9 @@ void wifiTask(void *parameter) {
             ntpSyncCompleted = false;
 
             wifiDisconnectedTime = millis();
+            if (wifiReconnectStart == 0) {
+                wifiReconnectStart = wifiDisconnectedTime;
+            }
 
             if (xSemaphoreTake(wifiMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
                 wifiConfig.isConnected = false;
@@ -4258,20 +7707,8 @@ void wifiTask(void *parameter) {
                             Serial.println("KOORDINAT: " + prayerConfig.latitude + ", " + prayerConfig.longitude);
                             Serial.println("");
 
-                            if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                                needPrayerUpdate = true;
-                                pendingPrayerLat = prayerConfig.latitude;
-                                pendingPrayerLon = prayerConfig.longitude;
-                                xSemaphoreGive(settingsMutex);
-
-                                if (prayerTaskHandle != NULL) {
-                                    xTaskNotifyGive(prayerTaskHandle);
-                                    Serial.println("TUGAS SHALAT DIPICU");
-                                    Serial.println("STATUS: PEMBARUAN DI LATAR BELAKANG");
-                                } else {
-                                    Serial.println("ERROR: HANDLE TUGAS SHALAT NULL");
-                                }
-                            }
+                            requestPrayerUpdate(prayerConfig.latitude, prayerConfig.longitude);
+                            Serial.println("STATUS: PEMBARUAN DI LATAR BELAKANG");
                         } else {
                             Serial.println("ERROR: WAKTU MASIH TIDAK VALID (TAHUN < 2000)");
                             Serial.println("MELEWATI PEMBARUAN WAKTU SHALAT");
@@ -4393,6 +7830,7 @@ void ntpTask(void *parameter) {
         esp_task_wdt_reset();
 
         syncSuccess = (timeinfo.tm_year >= (2000 - 1900));
+        traceRecord(TRACE_NTP, 0, retry, syncSuccess ? (int32_t)now : 0);
 
         if (syncSuccess) {
             ntpTime = now;
@@ -4492,32 +7930,40 @@ void ntpTask(void *parameter) {
             Serial.println("========================================");
 
             if (isRTCValid()) {
-                Serial.println("STATUS RTC: VALID - SIAP DISIMPAN");
-                Serial.println("MENYIMPAN WAKTU NTP KE RTC...");
+                Serial.println("STATUS RTC: VALID");
 
-                saveTimeToRTC();
+                if (!rtcCalibrateOnSync()) {
+                    Serial.println("SELISIH RTC DALAM TARGET - RTC TIDAK DITULIS ULANG");
+                } else {
+                    Serial.println("MENYIMPAN WAKTU NTP KE RTC...");
 
-                vTaskDelay(pdMS_TO_TICKS(500));
+                    if (!saveTimeToRTCAligned()) {
+                        saveTimeToRTC();
+                    }
+                    rtcCalibrationRebase();
 
-                if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                    DateTime rtcNow = rtc.now();
-                    xSemaphoreGive(i2cMutex);
+                    vTaskDelay(pdMS_TO_TICKS(500));
 
-                    Serial.println("");
-                    Serial.println("VERIFIKASI RTC:");
-                    Serial.printf("   WAKTU RTC: %02d:%02d:%02d %02d/%02d/%04d\n",
-                                rtcNow.hour(), rtcNow.minute(), rtcNow.second(),
-                                rtcNow.day(), rtcNow.month(), rtcNow.year());
+                    if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+                        DateTime rtcNow = rtc.now();
+                        xSemaphoreGive(i2cMutex);
 
-                    if (isRTCTimeValid(rtcNow)) {
-                        Serial.println("   STATUS: RTC BERHASIL DISIMPAN");
-                        Serial.println("   WAKTU AKAN BERTAHAN SAAT RESTART");
+                        Serial.println("");
+                        Serial.println("VERIFIKASI RTC:");
+                        Serial.printf("   WAKTU RTC: %02d:%02d:%02d %02d/%02d/%04d\n",
+                                    rtcNow.hour(), rtcNow.minute(), rtcNow.second(),
+                                    rtcNow.day(), rtcNow.month(), rtcNow.year());
+
+                        if (isRTCTimeValid(rtcNow)) {
+                            Serial.println("   STATUS: RTC BERHASIL DISIMPAN");
+                            Serial.println("   WAKTU AKAN BERTAHAN SAAT RESTART");
+                        } else {
+                            Serial.println("   STATUS: SIMPAN RTC GAGAL");
+                            Serial.println("   HARDWARE RTC MUNGKIN RUSAK");
+                        }
                     } else {
-                        Serial.println("   STATUS: SIMPAN RTC GAGAL");
-                        Serial.println("   HARDWARE RTC MUNGKIN RUSAK");
+                        Serial.println("   STATUS: TIDAK DAPAT DIVERIFIKASI (I2C SIBUK)");
                     }
-                } else {
-                    Serial.println("   STATUS: TIDAK DAPAT DIVERIFIKASI (I2C SIBUK)");
                 }
             } else {
                 Serial.println("STATUS RTC: TIDAK VALID - TIDAK DAPAT DISIMPAN");
@@ -4557,21 +8003,8 @@ void ntpTask(void *parameter) {
                 Serial.println("   BUJUR: " + prayerConfig.longitude);
                 Serial.println("");
 
-                if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                    needPrayerUpdate = true;
-                    pendingPrayerLat = prayerConfig.latitude;
-                    pendingPrayerLon = prayerConfig.longitude;
-                    xSemaphoreGive(settingsMutex);
-
-                    Serial.println("MEMICU TUGAS SHALAT UNTUK PEMBARUAN...");
-
-                    if (prayerTaskHandle != NULL) {
-                        xTaskNotifyGive(prayerTaskHandle);
-                        Serial.println("TUGAS SHALAT DIBERI TAHU - AKAN DIPERBARUI DI LATAR BELAKANG");
-                    } else {
-                        Serial.println("ERROR: HANDLE TUGAS SHALAT NULL");
-                    }
-                }
+                requestPrayerUpdate(prayerConfig.latitude, prayerConfig.longitude);
+                Serial.println("LAYANAN JADWAL DIBERI TAHU - AKAN DIPERBARUI DI LATAR BELAKANG");
 
                 Serial.println("========================================");
 
@@ -4608,7 +8041,50 @@ void ntpTask(void *parameter) {
     }
 }
 
+// ============================================
+// TREN HEAP JANGKA PANJANG (/api/heap)
+// ============================================
+// Sampel per jam & aturan deteksi di heap_trend.h; di sini hanya penguncian
+// heapTrendMux dan log Serial.
+
+void heapTrendAnalyze() {
+  HeapTrend t;
+  portENTER_CRITICAL(&heapTrendMux);
+  memcpy(&t, &heapTrend, sizeof(t));
+  portEXIT_CRITICAL(&heapTrendMux);
+
+  HeapTrendVerdict v = heapTrendEvaluate(t);
+  if (v.n < 3) return;
+
+  portENTER_CRITICAL(&heapTrendMux);
+  heapTrend.freeSlopeBph = (int32_t)v.freeSlope;
+  heapTrend.fragSlopePmph = (int32_t)v.fragSlope;
+  heapTrend.leakSuspected = v.leak;
+  heapTrend.fragSuspected = v.frag;
+  portEXIT_CRITICAL(&heapTrendMux);
+
+  Serial.printf("TREN HEAP %d JAM: %+ld BYTE/JAM, RASIO BLOK %+ld PERMIL/JAM\n",
+                v.n, (long)v.freeSlope, (long)v.fragSlope);
+  if (v.leak) {
+    Serial.printf("KEBOCORAN: HEAP MINIMUM TURUN %d/%d JAM (%ld BYTE/JAM)\n",
+                  v.freeDown, v.n - 1, (long)v.freeSlope);
+  }
+  if (v.frag) {
+    Serial.println("FRAGMENTASI: BLOK TERBESAR MENYUSUT RELATIF TERHADAP HEAP BEBAS");
+  }
+}
+
+// DIPANGGIL OLEH webTask SETIAP PENGECEKAN MEMORI (30 DETIK)
+void heapTrendSample(uint32_t freeHeap, uint32_t largest, unsigned long now) {
+  portENTER_CRITICAL(&heapTrendMux);
+  bool hourClosed = heapTrendAdd(heapTrend, freeHeap, largest, (uint32_t)now);
+  portEXIT_CRITICAL(&heapTrendMux);
+
+  if (hourClosed) heapTrendAnalyze();
+}
+
 void webTask(void *parameter) {
+  xEventGroupWaitBits(bootEventGroup, BOOT_NET_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
   esp_task_wdt_add(NULL);
 
   setupServerRoutes();
@@ -4693,13 +8169,10 @@ void webTask(void *parameter) {
         xSemaphoreGive(countdownMutex);
       }
 
+      // SATU PENURUNAN lowestHeap BIASANYA HANYA PUNCAK SESAAT (TLS, JSON);
+      // KEBOCORAN DINILAI DARI TREN MINIMUM PER JAM DI heapTrendAnalyze()
       if (!isCountdownActive) {
-        static size_t prevLowest = lowestHeap;
-        if (prevLowest > lowestHeap && (prevLowest - lowestHeap) > 1000) {
-          int32_t leaked = prevLowest - lowestHeap;
-          Serial.printf("KEBOCORAN: %d BYTE HILANG SEJAK PENGECEKAN TERAKHIR\n", leaked);
-        }
-        prevLowest = lowestHeap;
+        heapTrendSample(currentHeap, ESP.getMaxAllocHeap(), now);
       }
 
       Serial.println();
@@ -4748,240 +8221,658 @@ void webTask(void *parameter) {
   }
 }
 
-void prayerTask(void *parameter) {
-    esp_task_wdt_add(NULL);
+// ============================================
+// KLIEN HTTP NON-BLOCKING - HOOK FIRMWARE
+// ============================================
+// KLIENNYA ADA DI http_client.h. DI SINI: millis() DAN DNS ASINKRON LWIP.
+// dns_gethostbyname HARUS DIPANGGIL DI THREAD TCPIP (esp_netif_tcpip_exec HANYA
+// MENUNGGU PANGGILAN ITU, BUKAN JAWABAN DNS); JAWABANNYA DATANG LEWAT dnsFoundCb
+// DAN DIAMBIL httpPoll() TIAP HTTPC_DNS_POLL_MS. getaddrinfo TIDAK DIPAKAI KARENA
+// MENAHAN scheduleTask SAMPAI SERVER DNS MENJAWAB - HEDGE KE PENYEDIA LAIN IKUT TERTAHAN.
+enum DnsPendingState : uint8_t {
+  DNS_SLOT_FREE = 0,
+  DNS_SLOT_WAITING,
+  DNS_SLOT_DONE,
+  DNS_SLOT_FAILED
+};
+
+struct DnsPending {
+  DnsPendingState state;
+  uint32_t seq;                        // CALLBACK DENGAN seq LAMA (SUDAH DIBATALKAN) DIBUANG
+  uint32_t addr;                       // URUTAN BYTE JARINGAN
+  char host[48];
+};
+
+// SATU LOOKUP PER FETCH YANG DIBALAP
+DnsPending dnsPending[HTTPC_CONN_SLOTS] = {};
+portMUX_TYPE dnsPendingMux = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t httpcNowMs() {
+  return millis();
+}
+
+void httpcIdle(uint32_t ms) {
+  vTaskDelay(pdMS_TO_TICKS(ms) > 0 ? pdMS_TO_TICKS(ms) : 1);
+}
+
+// THREAD TCPIP
+void dnsFoundCb(const char *name, const ip_addr_t *ip, void *arg) {
+  uint32_t tag = (uint32_t)(uintptr_t)arg;
+  DnsPending &p = dnsPending[tag % HTTPC_CONN_SLOTS];
+
+  portENTER_CRITICAL(&dnsPendingMux);
+  if (p.state == DNS_SLOT_WAITING && p.seq == tag / HTTPC_CONN_SLOTS) {
+    if (ip != NULL && IP_IS_V4(ip)) {
+      p.addr = ip4_addr_get_u32(ip_2_ip4(ip));
+      p.state = DNS_SLOT_DONE;
+    } else {
+      p.state = DNS_SLOT_FAILED;
+    }
+  }
+  portEXIT_CRITICAL(&dnsPendingMux);
+}
+
+// THREAD TCPIP; ctx = INDEKS SLOT. JAWABAN DARI TABEL DNS LWIP LANGSUNG SELESAI
+esp_err_t dnsStartTcpip(void *ctx) {
+  uint8_t slot = (uint8_t)(uintptr_t)ctx;
+  DnsPending &p = dnsPending[slot];
+  uint32_t tag = p.seq * HTTPC_CONN_SLOTS + slot;
+  ip_addr_t ip;
+
+  err_t err = dns_gethostbyname_addrtype(p.host, &ip, dnsFoundCb, (void *)(uintptr_t)tag,
+                                         LWIP_DNS_ADDRTYPE_IPV4);
+  portENTER_CRITICAL(&dnsPendingMux);
+  if (err == ERR_OK) {
+    p.addr = ip4_addr_get_u32(ip_2_ip4(&ip));
+    p.state = DNS_SLOT_DONE;
+  } else if (err != ERR_INPROGRESS) {
+    p.state = DNS_SLOT_FAILED;
+  }
+  portEXIT_CRITICAL(&dnsPendingMux);
+  return ESP_OK;
+}
+
+int httpcDnsStart(const char *host, uint32_t &addr) {
+  int slot = -1;
+  portENTER_CRITICAL(&dnsPendingMux);
+  for (int i = 0; i < HTTPC_CONN_SLOTS; i++) {
+    if (dnsPending[i].state == DNS_SLOT_FREE) {
+      slot = i;
+      dnsPending[i].state = DNS_SLOT_WAITING;
+      dnsPending[i].seq++;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&dnsPendingMux);
+  if (slot < 0) return HTTPC_DNS_FAIL;
+
+  strlcpy(dnsPending[slot].host, host, sizeof(dnsPending[slot].host));
+  if (esp_netif_tcpip_exec(dnsStartTcpip, (void *)(uintptr_t)slot) != ESP_OK) {
+    httpcDnsCancel(slot);
+    return HTTPC_DNS_FAIL;
+  }
+
+  int r = httpcDnsPoll(slot, addr);
+  return r == HTTPC_DNS_PENDING ? slot : r;
+}
+
+int httpcDnsPoll(int ticket, uint32_t &addr) {
+  DnsPending &p = dnsPending[ticket];
+  portENTER_CRITICAL(&dnsPendingMux);
+  DnsPendingState state = p.state;
+  addr = p.addr;
+  if (state != DNS_SLOT_WAITING) p.state = DNS_SLOT_FREE;
+  portEXIT_CRITICAL(&dnsPendingMux);
+
+  if (state == DNS_SLOT_WAITING) return HTTPC_DNS_PENDING;
+  return state == DNS_SLOT_DONE ? HTTPC_DNS_DONE : HTTPC_DNS_FAIL;
+}
+
+void httpcDnsCancel(int ticket) {
+  portENTER_CRITICAL(&dnsPendingMux);
+  dnsPending[ticket].state = DNS_SLOT_FREE;
+  portEXIT_CRITICAL(&dnsPendingMux);
+}
+
+// ============================================
+// LAYANAN JADWAL - STATE MACHINE
+// ============================================
+// IDLE -> WAIT_TIME -> FETCHING -> PARSING -> PERSISTING -> IDLE.
+// GAGAL DI FETCHING/PARSING KEMBALI KE WAIT_TIME DENGAN JEDA + JITTER SAMPAI
+// SCHEDULE_FETCH_ATTEMPTS, LALU IDLE. GENERASI DIPERIKSA DI SETIAP BATAS STATE.
+
+// true = DICOBA LAGI LEWAT WAIT_TIME, false = PERCOBAAN / TENGGAT HABIS
+bool scheduleRetry(uint8_t &attempt, uint32_t &retryAtMs, uint32_t deadlineMs) {
+  attempt++;
+  uint32_t delayMs = (SCHEDULE_RETRY_BASE_MS << (attempt - 1)) + esp_random() % SCHEDULE_RETRY_JITTER_MS;
+
+  if (attempt >= SCHEDULE_FETCH_ATTEMPTS || (int32_t)(deadlineMs - (millis() + delayMs)) <= 0) {
+    return false;
+  }
+
+  retryAtMs = millis() + delayMs;
+
+  portENTER_CRITICAL(&scheduleSvcMux);
+  scheduleSvc.retries++;
+  portEXIT_CRITICAL(&scheduleSvcMux);
+  Serial.printf("[JADWAL] PERCOBAAN %u/%u DALAM %lu MS\n",
+                attempt + 1, SCHEDULE_FETCH_ATTEMPTS, (unsigned long)delayMs);
+  scheduleEnter(SCHEDULE_WAIT_TIME);
+  return true;
+}
+
+// SEMUA PENYEDIA HTTP GAGAL. JADWAL BESOK MASIH BISA DIISI MESIN LOKAL;
+// scheduleMaintain TETAP MENCOBA API KARENA SUMBERNYA BUKAN SCHED_API.
+void scheduleGiveUp(const ScheduleRequest &req, uint8_t attempt, int32_t today) {
+  portENTER_CRITICAL(&scheduleSvcMux);
+  scheduleSvc.failed++;
+  portEXIT_CRITICAL(&scheduleSvcMux);
+  Serial.printf("[JADWAL] PERMINTAAN #%lu GAGAL SETELAH %u PERCOBAAN\n",
+                (unsigned long)req.generation, attempt);
+
+#if SCHEDULE_LOCAL_PROVIDER
+  DaySchedule local;
+  if (req.day == today + 1 &&
+      prayerConfig.latitude == req.lat && prayerConfig.longitude == req.lon &&
+      scheduleTomorrowSnapshot().day != req.day &&
+      computeLocalSchedule(req.day, local)) {
+    scheduleStoreTomorrow(local);
+    portENTER_CRITICAL(&scheduleSvcMux);
+    scheduleHedge.localFallbacks++;
+    scheduleHedge.lastProvider = -1;
+    portEXIT_CRITICAL(&scheduleSvcMux);
+    Serial.printf("[JADWAL] JADWAL BESOK DARI MESIN LOKAL (SUBUH %s, MAGHRIB %s)\n",
+                  local.times[PRAYER_SUBUH], local.times[PRAYER_MAGHRIB]);
+  }
+#endif
+
+  scheduleEnter(SCHEDULE_IDLE);
+}
+
+// PEMINDAI JSON INKREMENTAL: HANYA MENANGKAP NILAI STRING UNTUK KUNCI WAKTU
+// ALADHAN. BODY TIDAK PERNAH DIKUMPULKAN UTUH DI HEAP. NILAI NUMERIK DENGAN
+// NAMA KUNCI SAMA (meta.offset, params) DIABAIKAN.
+struct TimingsScanner {
+  DaySchedule *out;
+  uint8_t found;              // BIT PER Prayer
+  bool inString;
+  bool escape;
+  bool expectValue;
+  bool valueString;
+  int8_t keyPrayer;
+  int8_t valuePrayer;
+  uint8_t tokenLen;
+  char token[12];
+};
+
+struct ScheduleFetchCtx {
+  TimingsScanner scan;
+  uint32_t generation;
+};
+
+// NAMA FIELD ALADHAN, URUTAN ENUM Prayer
+const char *const ALADHAN_FIELDS[PRAYER_COUNT] = {
+  "Imsak", "Fajr", "Sunrise", "Dhuhr", "Asr", "Maghrib", "Isha"
+};
+
+void timingsScanFeed(TimingsScanner &s, const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    char c = (char)data[i];
+
+    if (s.inString) {
+      if (s.escape) {
+        s.escape = false;
+      } else if (c == '\\') {
+        s.escape = true;
+        continue;
+      } else if (c == '"') {
+        s.inString = false;
+        s.token[s.tokenLen] = '\0';
+        if (s.valueString) {
+          if (s.valuePrayer >= 0 && s.tokenLen >= 5) {
+            // "04:35 (WIB)" -> "04:35"
+            strlcpy(s.out->times[s.valuePrayer], s.token, sizeof(s.out->times[0]));
+            s.found |= (uint8_t)(1 << s.valuePrayer);
+          }
+          s.valuePrayer = -1;
+        } else {
+          s.keyPrayer = -1;
+          for (uint8_t k = 0; k < PRAYER_COUNT; k++) {
+            if (strcmp(s.token, ALADHAN_FIELDS[k]) == 0) {
+              s.keyPrayer = (int8_t)k;
+              break;
+            }
+          }
+        }
+        continue;
+      }
+      if (s.tokenLen < sizeof(s.token) - 1) s.token[s.tokenLen++] = c;
+      continue;
+    }
+
+    if (c == '"') {
+      s.inString = true;
+      s.tokenLen = 0;
+      s.valueString = s.expectValue;
+      s.expectValue = false;
+    } else if (c == ':') {
+      s.expectValue = true;
+      s.valuePrayer = s.keyPrayer;
+      s.keyPrayer = -1;
+    } else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+      // ANGKA, OBJEK, ARRAY, ATAU PEMISAH
+      s.expectValue = false;
+      s.valuePrayer = -1;
+      s.keyPrayer = -1;
+    }
+  }
+}
+
+bool scheduleFetchBody(const uint8_t *data, size_t len, void *ctx) {
+  timingsScanFeed(((ScheduleFetchCtx *)ctx)->scan, data, len);
+  return true;
+}
+
+// TIDAK MENAMBAH scheduleSvc.stale - ITU DILAKUKAN LOOP UTAMA SEKALI
+bool scheduleSuperseded(uint32_t generation) {
+  portENTER_CRITICAL(&scheduleSvcMux);
+  bool superseded = (generation != scheduleSvc.generation);
+  portEXIT_CRITICAL(&scheduleSvcMux);
+  return superseded;
+}
+
+bool scheduleFetchCancelled(void *ctx) {
+  return scheduleSuperseded(((ScheduleFetchCtx *)ctx)->generation);
+}
+
+bool scheduleValidateTimings(const TimingsScanner &scan, DaySchedule &out) {
+  for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+    if (!(scan.found & (1 << i)) || parseMinuteOfDay(String(out.times[i])) < 0) {
+      Serial.printf("DATA WAKTU SHALAT TIDAK VALID: %s = \"%s\"\n",
+                    ALADHAN_FIELDS[i], (scan.found & (1 << i)) ? out.times[i] : "");
+      return false;
+    }
+  }
+  out.source = SCHED_API;
+  return true;
+}
+
+void scheduleRecordFetch(const HttpFetch &f) {
+  portENTER_CRITICAL(&scheduleSvcMux);
+  ScheduleStateStat &st = f.reused ? scheduleSvc.fetchWarm : scheduleSvc.fetchCold;
+  st.count++;
+  st.totalMs += f.totalMs;
+  if (f.totalMs > st.maxMs) st.maxMs = f.totalMs;
+  scheduleSvc.lastWarm = f.reused;
+  scheduleSvc.lastDnsCached = f.dnsCached;
+  scheduleSvc.lastDnsMs = (uint16_t)min(f.dnsMs, (uint32_t)UINT16_MAX);
+  scheduleSvc.lastConnectMs = (uint16_t)min(f.connectMs, (uint32_t)UINT16_MAX);
+  scheduleSvc.lastTtfbMs = (uint16_t)min(f.ttfbMs, (uint32_t)UINT16_MAX);
+  scheduleSvc.lastTotalMs = (uint16_t)min(f.totalMs, (uint32_t)UINT16_MAX);
+  portEXIT_CRITICAL(&scheduleSvcMux);
+}
 
-    Serial.println("\n========================================");
-    Serial.println("TUGAS SHALAT DIMULAI");
-    Serial.println("========================================");
-    Serial.println("UKURAN STACK: 12288 BYTE");
-    Serial.println("MENUNGGU PEMICU...");
-    Serial.println("========================================\n");
+void providerRecord(uint8_t idx, int code, bool valid, bool lost, uint32_t ms) {
+  portENTER_CRITICAL(&scheduleSvcMux);
+  providerAccount(scheduleProviders[idx].stats, code, valid, lost, ms);
+  portEXIT_CRITICAL(&scheduleSvcMux);
+}
 
-    vTaskDelay(pdMS_TO_TICKS(5000));
+// PENYEDIA AKTIF, URUT DARI SKOR. host/port DISALIN AGAR /setmirror DI TENGAH
+// BALAPAN TIDAK MENGUBAH STRING YANG SEDANG DIPAKAI FETCH
+uint8_t scheduleProviderOrder(uint8_t *order, char (*hosts)[48], uint16_t *ports, uint32_t &hedgeMs) {
+  ProviderStats stats[SCHEDULE_HTTP_PROVIDERS];
+  const ProviderStats *active[SCHEDULE_HTTP_PROVIDERS] = {};
+
+  portENTER_CRITICAL(&scheduleSvcMux);
+  for (uint8_t i = 0; i < SCHEDULE_HTTP_PROVIDERS; i++) {
+    const ScheduleProvider &p = scheduleProviders[i];
+    if (p.host[0] == '\0') continue;
+    memcpy(hosts[i], p.host, sizeof(p.host));
+    ports[i] = p.port;
+    stats[i] = p.stats;
+    active[i] = &stats[i];
+  }
+  portEXIT_CRITICAL(&scheduleSvcMux);
 
-    static bool hasUpdatedToday = false;
-    static int lastDay = -1;
-    static bool waitingForMidnightNTP = false;
-    static unsigned long midnightNTPStartTime = 0;
+  return providerOrder(active, order, hedgeMs);
+}
 
-    while (true) {
-        esp_task_wdt_reset();
+// EFEK SAMPING FIRMWARE UNTUK hedgeRace (schedule_hedge.h)
+struct ScheduleRaceHooks {
+  const ScheduleRequest &req;
+  const char *path;
+  uint32_t deadlineMs;
+  char (*hosts)[48];
+  const uint16_t *ports;
+  ScheduleFetchCtx *ctx;
+  DaySchedule *results;
+
+  void tick() {
+    esp_task_wdt_reset();
+  }
 
-        static unsigned long lastStackReport = 0;
+  bool superseded() {
+    return scheduleSuperseded(req.generation);
+  }
 
-        if (millis() - lastStackReport > 60000) {
-            lastStackReport = millis();
-            UBaseType_t stackRemaining = uxTaskGetStackHighWaterMark(NULL);
-            Serial.printf("[TUGAS SHALAT] STACK TERSISA: %d BYTE\n", stackRemaining * 4);
+  void launch(HttpFetch &f, uint8_t slot, uint8_t idx, bool hedge) {
+    memset(&ctx[slot], 0, sizeof(ctx[slot]));
+    memset(&results[slot], 0, sizeof(results[slot]));
+    ctx[slot].scan.out = &results[slot];
+    ctx[slot].scan.keyPrayer = -1;
+    ctx[slot].scan.valuePrayer = -1;
+    ctx[slot].generation = req.generation;
+
+    f.host = hosts[idx];
+    f.port = ports[idx];
+    f.path = path;
+    f.onBody = scheduleFetchBody;
+    f.cancelled = scheduleFetchCancelled;
+    f.ctx = &ctx[slot];
+
+    // TENGGAT PERCOBAAN TIDAK BOLEH MELEWATI TENGGAT PERMINTAAN
+    f.deadlineMs = millis() + SCHEDULE_HTTP_TIMEOUT_MS;
+    if ((int32_t)(f.deadlineMs - deadlineMs) > 0) f.deadlineMs = deadlineMs;
+
+    portENTER_CRITICAL(&scheduleSvcMux);
+    scheduleProviders[idx].stats.launched++;
+    if (hedge) {
+      scheduleProviders[idx].stats.hedged++;
+      scheduleHedge.hedges++;
+    }
+    portEXIT_CRITICAL(&scheduleSvcMux);
 
-            if (stackRemaining < 1000) {
-                Serial.println("PERINGATAN: STACK TUGAS SHALAT SANGAT RENDAH!");
-            }
-        }
+    Serial.printf("[JADWAL] %s %s: http://%s:%u%s\n",
+                  hedge ? "HEDGE KE" : "MENGAMBIL DARI",
+                  scheduleProviders[idx].name, f.host, f.port, path);
+  }
 
-        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+  bool finished(const HttpFetch &f, uint8_t slot, uint8_t idx, bool hedged) {
+    int code = f.result;
+    traceRecord(TRACE_HTTP_API,
+                (uint8_t)((f.reused ? TRACE_F_WARM : 0) | (hedged ? TRACE_F_HEDGE : 0) | (idx << 4)),
+                (uint16_t)(int16_t)code, f.bodyBytes, f.totalMs * 1000);
+    if (code == FETCH_ERR_CANCELLED) return false;
+
+    if (f.status > 0) scheduleRecordFetch(f);
+
+    bool valid = (code == 200) && scheduleValidateTimings(ctx[slot].scan, results[slot]);
+    providerRecord(idx, code, valid, false, f.totalMs);
+
+    Serial.printf("[JADWAL] %s: KODE %d (%s, DNS %s %lu MS, CONNECT %lu MS, TTFB %lu MS, TOTAL %lu MS, %lu BYTE)\n",
+                  scheduleProviders[idx].name, code,
+                  f.reused ? "KEEP-ALIVE" : "KONEKSI BARU",
+                  f.dnsCached ? "CACHE" : "LOOKUP",
+                  (unsigned long)f.dnsMs,
+                  (unsigned long)f.connectMs,
+                  (unsigned long)f.ttfbMs,
+                  (unsigned long)f.totalMs,
+                  (unsigned long)f.bodyBytes);
+    if (!valid && code != 200) {
+      Serial.printf("PERMINTAAN HTTP GAGAL: %d (%s)\n", code, httpFetchErrorName(code));
+    }
+    return valid;
+  }
 
-        if (needPrayerUpdate && pendingPrayerLat.length() > 0 && pendingPrayerLon.length() > 0) {
-            esp_task_wdt_reset();
+  void lost(const HttpFetch &f, uint8_t idx) {
+    providerRecord(idx, FETCH_ERR_CANCELLED, false, true, f.totalMs);
+  }
 
-            if (WiFi.status() != WL_CONNECTED) {
-                Serial.println("TUGAS SHALAT: DILEWATI - WIFI TIDAK TERHUBUNG");
+  void won(uint8_t slot, uint8_t idx, bool hedged) {
+    portENTER_CRITICAL(&scheduleSvcMux);
+    scheduleHedge.lastProvider = (int8_t)idx;
+    if (hedged) scheduleHedge.hedgeWins++;
+    portEXIT_CRITICAL(&scheduleSvcMux);
+  }
+};
 
-                if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                    needPrayerUpdate = false;
-                    xSemaphoreGive(settingsMutex);
-                }
-                continue;
-            }
+// BALAPAN PENYEDIA LEWAT hedgeRace. MENGEMBALIKAN 200 + out BILA MENANG,
+// SELAIN ITU KODE TERAKHIR (FETCH_ERR_CANCELLED BILA GENERASI DIGANTIKAN).
+int scheduleRace(const ScheduleRequest &req, const char *path, uint32_t deadlineMs, DaySchedule &out) {
+  static HttpFetch fetches[SCHEDULE_HTTP_PROVIDERS];
+  static ScheduleFetchCtx ctx[SCHEDULE_HTTP_PROVIDERS];
+  static DaySchedule results[SCHEDULE_HTTP_PROVIDERS];
+  static char hosts[SCHEDULE_HTTP_PROVIDERS][48];
+  uint16_t ports[SCHEDULE_HTTP_PROVIDERS];
+  uint8_t order[SCHEDULE_HTTP_PROVIDERS];
+
+  uint32_t hedgeMs;
+  uint8_t count = scheduleProviderOrder(order, hosts, ports, hedgeMs);
+  if (count == 0) {
+    Serial.println("[JADWAL] TIDAK ADA PENYEDIA HTTP AKTIF");
+    return FETCH_ERR_CONNECT;
+  }
 
-            time_t now_t;
-            if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                now_t = timeConfig.currentTime;
-                xSemaphoreGive(timeMutex);
-            } else {
-                now_t = time(nullptr);
-            }
+  portENTER_CRITICAL(&scheduleSvcMux);
+  scheduleHedge.races++;
+  portEXIT_CRITICAL(&scheduleSvcMux);
 
-            if (now_t < 946684800) {
-                Serial.println("TUGAS SHALAT: DILEWATI - WAKTU SISTEM TIDAK VALID");
-                Serial.printf("TIMESTAMP SAAT INI: %ld (SEBELUM 01/01/2000)\n", now_t);
+  ScheduleRaceHooks hooks = { req, path, deadlineMs, hosts, ports, ctx, results };
+  int8_t winner;
+  int code = hedgeRace(fetches, order, count, hedgeMs, hooks, winner);
+  if (code == 200) out = results[winner];
+  return code;
+}
 
-                if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                    needPrayerUpdate = false;
-                    xSemaphoreGive(settingsMutex);
-                }
-                continue;
-            }
+void scheduleTask(void *parameter) {
+  esp_task_wdt_add(NULL);
 
-            Serial.println("\n========================================");
-            Serial.println("TUGAS SHALAT: MEMPROSES PEMBARUAN");
-            Serial.println("========================================");
-            Serial.printf("STACK SEBELUM HTTP: %d BYTE TERSISA\n", uxTaskGetStackHighWaterMark(NULL) * 4);
-            Serial.println("KOORDINAT: " + pendingPrayerLat + ", " + pendingPrayerLon);
+  Serial.println("\n========================================");
+  Serial.println("LAYANAN JADWAL DIMULAI");
+  Serial.println("========================================");
+  Serial.printf("UKURAN STACK: %d BYTE\n", SCHEDULE_TASK_STACK_SIZE);
+  Serial.println("TUJUAN: AMBIL, PARSE, DAN SIMPAN WAKTU SHALAT");
+  Serial.println("========================================\n");
 
-            esp_task_wdt_reset();
+  portENTER_CRITICAL(&scheduleSvcMux);
+  scheduleSvc.state = SCHEDULE_IDLE;
+  scheduleSvc.stateSinceMs = millis();
+  portEXIT_CRITICAL(&scheduleSvcMux);
 
-            String tempLat = pendingPrayerLat;
-            String tempLon = pendingPrayerLon;
+  ScheduleRequest req = {};
+  DaySchedule result = {};
+  uint8_t attempt = 0;
+  uint32_t retryAtMs = 0;
+  uint32_t deadlineMs = 0;
+  bool cacheChecked = false;
+  ScheduleCacheKey cacheKey = {};
+  uint32_t lastStackReport = 0;
 
-            if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                needPrayerUpdate = false;
-                pendingPrayerLat = "";
-                pendingPrayerLon = "";
-                xSemaphoreGive(settingsMutex);
-            }
+  while (true) {
+    esp_task_wdt_reset();
 
-            getPrayerTimesByCoordinates(tempLat, tempLon);
+    if (millis() - lastStackReport > 60000) {
+      lastStackReport = millis();
+      UBaseType_t stackRemaining = uxTaskGetStackHighWaterMark(NULL);
+      Serial.printf("[TUGAS JADWAL] STACK TERSISA: %d BYTE\n", stackRemaining * 4);
+      if (stackRemaining < 1000) {
+        Serial.println("PERINGATAN: STACK TUGAS JADWAL SANGAT RENDAH!");
+      }
+    }
 
-            esp_task_wdt_reset();
+    // PERMINTAAN YANG LEBIH BARU MENGGANTIKAN YANG SEDANG BERJALAN
+    if (scheduleSvc.state != SCHEDULE_IDLE && scheduleIsStale(req.generation)) {
+      Serial.printf("[JADWAL] PERMINTAAN #%lu DIBATALKAN - ADA YANG LEBIH BARU\n",
+                    (unsigned long)req.generation);
+      scheduleEnter(SCHEDULE_IDLE);
+    }
 
-            Serial.printf("STACK SETELAH HTTP: %d BYTE TERSISA\n", uxTaskGetStackHighWaterMark(NULL) * 4);
-            Serial.println("TUGAS SHALAT: PEMBARUAN SELESAI");
-            Serial.println("========================================\n");
+    time_t now_t = 0;
+    if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+      now_t = timeConfig.currentTime;
+      xSemaphoreGive(timeMutex);
+    }
+    // TANGGAL HANYA DIPERCAYA SETELAH NTP ATAU DARI RTC
+    bool timeValid = (timeConfig.ntpSynced || rtcAvailable) && now_t > 946684800;
+
+    switch (scheduleSvc.state) {
+      case SCHEDULE_IDLE: {
+        if (scheduleTakeRequest(req)) {
+          attempt = 0;
+          retryAtMs = millis();
+          deadlineMs = retryAtMs + SCHEDULE_REQUEST_DEADLINE_MS;
+          cacheChecked = false;
+          Serial.printf("\n[JADWAL] MEMPROSES PERMINTAAN #%lu: %s, %s\n",
+                        (unsigned long)req.generation, req.lat, req.lon);
+          scheduleEnter(SCHEDULE_WAIT_TIME);
+          break;
         }
 
-        if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            int currentHour = hour(timeConfig.currentTime);
-            int currentMinute = minute(timeConfig.currentTime);
-            int currentDay = day(timeConfig.currentTime);
-            int currentYear = year(timeConfig.currentTime);
-            time_t currentTimestamp = timeConfig.currentTime;
-            bool ntpSynced = timeConfig.ntpSynced;
-
-            xSemaphoreGive(timeMutex);
-
-            if (currentDay != lastDay) {
-                hasUpdatedToday = false;
-                lastDay = currentDay;
-                waitingForMidnightNTP = false;
-            }
-
-            if (currentHour == 0 && currentMinute < 5 &&
-                !hasUpdatedToday &&
-                !waitingForMidnightNTP &&
-                wifiConfig.isConnected) {
-
-                Serial.println("\n========================================");
-                Serial.println("TENGAH MALAM TERDETEKSI - MEMULAI URUTAN");
-                Serial.println("========================================");
-                Serial.printf("WAKTU: %02d:%02d:%02d\n", currentHour, currentMinute, second(timeConfig.currentTime));
-                Serial.printf("TANGGAL: %02d/%02d/%04d\n", currentDay, month(timeConfig.currentTime), currentYear);
-                Serial.println("");
+        if (timeValid &&
+            prayerConfig.latitude.length() > 0 &&
+            prayerConfig.longitude.length() > 0) {
+          scheduleMaintain(now_t);
+        }
 
-                Serial.println("MEMICU SINKRONISASI NTP...");
-                Serial.println("ALASAN: MEMASTIKAN WAKTU AKURAT SEBELUM MEMPERBARUI");
+        httpConnReap();
 
-                if (ntpTaskHandle != NULL) {
-                    ntpSyncInProgress = false;
-                    ntpSyncCompleted = false;
+        if (!scheduleSvc.pending) {
+          ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+        }
+        break;
+      }
 
-                    xTaskNotifyGive(ntpTaskHandle);
+      case SCHEDULE_WAIT_TIME: {
+        // CACHE DULU, SEKALI PER PERMINTAAN: HIT TIDAK BUTUH WIFI
+        if (timeValid && !cacheChecked) {
+          cacheChecked = true;
+          int32_t today = (int32_t)(now_t / 86400);
+          if (req.day < 0) req.day = today;
+          if (req.day == today || req.day == today + 1) {
+            scheduleCacheKeyFor(req, cacheKey);
+            if (scheduleCacheLookup(cacheKey, result)) {
+              Serial.printf("[JADWAL] CACHE HIT %s (%lu US) - TANPA JARINGAN\n",
+                            req.day == today ? "HARI INI" : "BESOK",
+                            (unsigned long)scheduleCacheStats.lastLookupUs);
+              scheduleEnter(SCHEDULE_PERSISTING);
+              break;
+            }
+          }
+        }
 
-                    waitingForMidnightNTP = true;
-                    midnightNTPStartTime = millis();
+        uint32_t waited = millis() - scheduleSvc.stateSinceMs;
+        bool ready = timeValid && WiFi.status() == WL_CONNECTED;
 
-                    Serial.println("SINKRONISASI NTP BERHASIL DIPICU");
-                    Serial.println("MENUNGGU SINKRONISASI NTP SELESAI...");
-                    Serial.println("========================================\n");
-                } else {
-                    Serial.println("ERROR: HANDLE TUGAS NTP NULL");
-                    Serial.println("MELEWATI PEMBARUAN TENGAH MALAM");
-                    Serial.println("========================================\n");
-                    hasUpdatedToday = true;
-                }
-            }
+        if (!ready && (waited > SCHEDULE_WAIT_TIME_MS || (int32_t)(millis() - deadlineMs) >= 0)) {
+          Serial.println("[JADWAL] WIFI / WAKTU TIDAK SIAP - PERMINTAAN DILEWATI");
+          portENTER_CRITICAL(&scheduleSvcMux);
+          scheduleSvc.failed++;
+          portEXIT_CRITICAL(&scheduleSvcMux);
+          scheduleEnter(SCHEDULE_IDLE);
+          break;
+        }
 
-            if (waitingForMidnightNTP) {
-                unsigned long waitTime = millis() - midnightNTPStartTime;
-                const unsigned long MAX_WAIT_TIME = 30000;
+        if (!ready || (int32_t)(millis() - retryAtMs) < 0) {
+          ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(500));
+          break;
+        }
 
-                if (waitTime % 5000 < 1000) {
-                    esp_task_wdt_reset();
-                }
+        int32_t today = (int32_t)(now_t / 86400);
+        if (req.day < 0) req.day = today;
+        if (req.day != today && req.day != today + 1) {
+          Serial.println("[JADWAL] PERMINTAAN UNTUK HARI LAIN SUDAH KEDALUWARSA - DILEWATI");
+          scheduleEnter(SCHEDULE_IDLE);
+          break;
+        }
+        scheduleEnter(SCHEDULE_FETCHING);
+        break;
+      }
 
-                if (ntpSyncCompleted) {
-                    Serial.println("\n========================================");
-                    Serial.println("SINKRONISASI NTP SELESAI");
-                    Serial.println("========================================");
+      case SCHEDULE_FETCHING: {
+        time_t target_t = (time_t)req.day * 86400;
+
+        // URL DIBANGUN DARI KUNCI CACHE AGAR HASILNYA DISIMPAN DENGAN PARAMETER YANG BENAR
+        scheduleCacheKeyFor(req, cacheKey);
+        char path[192];
+        int pathLen = snprintf(path, sizeof(path),
+          "/v1/timings/%02d-%02d-%04d?latitude=%s&longitude=%s&method=%u&tune=%d,%d,%d,%d,%d,%d,0,%d,0",
+          day(target_t), month(target_t), year(target_t),
+          req.lat, req.lon, cacheKey.methodId,
+          cacheKey.tune[PRAYER_IMSAK], cacheKey.tune[PRAYER_SUBUH], cacheKey.tune[PRAYER_TERBIT],
+          cacheKey.tune[PRAYER_ZUHUR], cacheKey.tune[PRAYER_ASHAR], cacheKey.tune[PRAYER_MAGHRIB],
+          cacheKey.tune[PRAYER_ISYA]);
+        if (pathLen >= (int)sizeof(path)) {
+          Serial.println("[JADWAL] URL TERLALU PANJANG - PERMINTAAN DILEWATI");
+          scheduleEnter(SCHEDULE_IDLE);
+          break;
+        }
 
-                    if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                        currentTimestamp = timeConfig.currentTime;
-                        currentYear = year(timeConfig.currentTime);
-                        currentDay = day(timeConfig.currentTime);
-                        int currentMonth = month(timeConfig.currentTime);
-                        currentHour = hour(timeConfig.currentTime);
-                        currentMinute = minute(timeConfig.currentTime);
-                        int currentSecond = second(timeConfig.currentTime);
-                        xSemaphoreGive(timeMutex);
-
-                        Serial.printf("WAKTU BARU: %02d:%02d:%02d\n", currentHour, currentMinute, currentSecond);
-                        Serial.printf("TANGGAL BARU: %02d/%02d/%04d\n", currentDay, currentMonth, currentYear);
-                        Serial.printf("TIMESTAMP: %ld\n", currentTimestamp);
-                        Serial.println("");
-                    }
+        int httpResponseCode = scheduleRace(req, path, deadlineMs, result);
 
-                    if (prayerConfig.latitude.length() > 0 &&
-                        prayerConfig.longitude.length() > 0) {
+        esp_task_wdt_reset();
 
-                        if (currentYear >= 2000 && currentTimestamp >= 946684800) {
-                            Serial.println("MEMPERBARUI WAKTU SHALAT...");
-                            Serial.println("STATUS WAKTU: VALID");
-                            Serial.println("KOTA: " + prayerConfig.selectedCity);
-                            Serial.println("KOORDINAT: " + prayerConfig.latitude + ", " + prayerConfig.longitude);
-                            Serial.println("");
+        if (httpResponseCode == FETCH_ERR_CANCELLED) {
+          // LOOP BERIKUTNYA MENCATAT stale DAN KEMBALI KE IDLE
+          break;
+        }
 
-                            esp_task_wdt_reset();
-                            getPrayerTimesByCoordinates(
-                                prayerConfig.latitude,
-                                prayerConfig.longitude
-                            );
-                            esp_task_wdt_reset();
+        scheduleSvc.lastHttpCode = (int16_t)httpResponseCode;
 
-                            Serial.println("\nURUTAN PEMBARUAN TENGAH MALAM SELESAI");
-                        } else {
-                            Serial.println("PERINGATAN: WAKTU MASIH TIDAK VALID SETELAH NTP");
-                            Serial.printf("   TAHUN: %d (MIN: 2000)\n", currentYear);
-                            Serial.printf("   TIMESTAMP: %ld (MIN: 946684800)\n", currentTimestamp);
-                            Serial.println("   MENGGUNAKAN WAKTU SHALAT YANG ADA");
-                        }
-                    } else {
-                        Serial.println("PERINGATAN: TIDAK ADA KOORDINAT KOTA");
-                        Serial.println("   MENGGUNAKAN WAKTU SHALAT YANG ADA");
-                    }
+        if (httpResponseCode == 200) {
+          scheduleEnter(SCHEDULE_PARSING);
+        } else if (!scheduleRetry(attempt, retryAtMs, deadlineMs)) {
+          scheduleGiveUp(req, attempt, (int32_t)(now_t / 86400));
+        }
+        break;
+      }
 
-                    Serial.println("========================================\n");
+      case SCHEDULE_PARSING: {
+        // BODY SUDAH DIPINDAI & DIVALIDASI SAAT BALAPAN - PEMENANG SAJA YANG SAMPAI SINI
+        result.day = req.day;
+        Serial.printf("[JADWAL] JADWAL DARI %s (SUBUH %s, MAGHRIB %s)\n",
+                      scheduleHedge.lastProvider >= 0 ? scheduleProviders[scheduleHedge.lastProvider].name : "?",
+                      result.times[PRAYER_SUBUH], result.times[PRAYER_MAGHRIB]);
+        scheduleCacheStore(cacheKey, result);
+        scheduleEnter(SCHEDULE_PERSISTING);
+        break;
+      }
 
-                    waitingForMidnightNTP = false;
-                    hasUpdatedToday = true;
+      case SCHEDULE_PERSISTING: {
+        int32_t today = (int32_t)(now_t / 86400);
 
-                } else if (waitTime > MAX_WAIT_TIME) {
-                    Serial.println("\n========================================");
-                    Serial.println("TIMEOUT SINKRONISASI NTP");
-                    Serial.println("========================================");
-                    Serial.printf("WAKTU TUNGGU: %lu MS (MAKS: %lu MS)\n", waitTime, MAX_WAIT_TIME);
-                    Serial.println("STATUS NTP:");
-                    Serial.printf("   NTPSYNCINPROGRESS: %s\n", ntpSyncInProgress ? "true" : "false");
-                    Serial.printf("   NTPSYNCCOMPLETED: %s\n", ntpSyncCompleted ? "false" : "false");
-                    Serial.println("");
-                    Serial.println("KEPUTUSAN: GUNAKAN WAKTU SHALAT YANG ADA");
-                    Serial.println("JANGAN PERBARUI (WAKTU MUNGKIN TIDAK AKURAT)");
-                    Serial.println("========================================\n");
+        if (result.day != today) {
+          // BUFFER BESOK: DIPASANG clockTickTask SAAT HARI BERGANTI
+          if (prayerConfig.latitude == req.lat && prayerConfig.longitude == req.lon) {
+            scheduleStoreTomorrow(result);
+            Serial.printf("[JADWAL] JADWAL BESOK SIAP (SUBUH %s, MAGHRIB %s)\n",
+                          result.times[PRAYER_SUBUH], result.times[PRAYER_MAGHRIB]);
+          } else {
+            Serial.println("[JADWAL] KOORDINAT BERUBAH - JADWAL BESOK DIBUANG");
+          }
+        } else if (xSemaphoreTake(settingsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+          for (uint8_t i = 0; i < PRAYER_COUNT; i++) {
+            prayerConfig.*(PRAYER_INFO[i].time) = result.times[i];
+          }
+          scheduleDay = result.day;
+          xSemaphoreGive(settingsMutex);
+          schedulePublish(result.times);
 
-                    waitingForMidnightNTP = false;
-                    hasUpdatedToday = true;
+          Serial.println("WAKTU SHALAT BERHASIL DIPERBARUI");
+          savePrayerTimes();
 
-                } else {
-                    if (waitTime % 5000 < 1000) {
-                        Serial.printf("MENUNGGU SINKRONISASI NTP... (%lu/%lu MS)\n",
-                                     waitTime, MAX_WAIT_TIME);
-                    }
-                }
-            }
+          DisplayUpdate update;
+          update.type = DisplayUpdate::PRAYER_UPDATE;
+          xQueueSend(displayQueue, &update, pdMS_TO_TICKS(100));
+        } else {
+          // MUTEX SIBUK: COBA LAGI PUTARAN BERIKUTNYA TANPA FETCH ULANG
+          vTaskDelay(pdMS_TO_TICKS(100));
+          break;
         }
 
-        vTaskDelay(pdMS_TO_TICKS(500));
+        portENTER_CRITICAL(&scheduleSvcMux);
+        scheduleSvc.completed++;
+        portEXIT_CRITICAL(&scheduleSvcMux);
+        Serial.printf("[JADWAL] PERMINTAAN #%lu SELESAI\n", (unsigned long)req.generation);
+        scheduleEnter(SCHEDULE_IDLE);
+        break;
+      }
+
+      default:
+        scheduleEnter(SCHEDULE_IDLE);
+        break;
     }
+  }
 }
 
 void rtcSyncTask(void *parameter) {
@@ -4997,6 +8888,12 @@ void rtcSyncTask(void *parameter) {
     Serial.println("========================================\n");
 
     while (true) {
+        // DETIK SUDAH BERASAL DARI RTC LEWAT SQW - TIDAK PERLU POLLING I2C
+        if (rtcSqwActive) {
+            vTaskDelayUntil(&xLastWakeTime, xFrequency);
+            continue;
+        }
+
         if (rtcAvailable) {
             if (!isRTCValid()) {
                 Serial.println("\n[SINKRONISASI RTC] DILEWATI - RTC TIDAK VALID");
@@ -5008,6 +8905,7 @@ void rtcSyncTask(void *parameter) {
             if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
                 rtcTime = rtc.now();
                 xSemaphoreGive(i2cMutex);
+                traceRecord(TRACE_RTC, 0, isRTCTimeValid(rtcTime) ? 1 : 0, (int32_t)rtcTime.unixtime());
             } else {
                 Serial.println("\n[SINKRONISASI RTC] DILEWATI - TIDAK DAPAT MENDAPATKAN MUTEX I2C");
                 vTaskDelayUntil(&xLastWakeTime, xFrequency);
@@ -5126,16 +9024,33 @@ void internetCheckTask(void *parameter) {
   }
 }
 
+// SUMBER DETIK: TEPI SQW DS3231 JIKA AKTIF, SELAIN ITU vTaskDelayUntil 1 DETIK.
+// DETIK YANG TERTUNDA (MUTEX SIBUK / NOTIFIKASI TERGABUNG) DITAMBAHKAN SEKALIGUS.
 void clockTickTask(void *parameter) {
     TickType_t xLastWakeTime = xTaskGetTickCount();
     const TickType_t xFrequency = pdMS_TO_TICKS(1000);
 
-    static int autoSyncCounter = 0;
+    ClockTickState tick = {};
+    int32_t tickDay = -1;
 
     const time_t EPOCH_2000 = 946684800;
 
     while (true) {
+        uint32_t edges = rtcSqwActive ? ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RTC_SQW_TIMEOUT_MS)) : 0;
+        ClockWake wake = clockTickWake(tick, rtcSqwActive, edges);
+        if (wake == CLOCK_WAKE_MISSED || wake == CLOCK_WAKE_SQW_LOST) {
+            rtcSqwMissedTotal++;
+        }
+        if (wake == CLOCK_WAKE_SQW_LOST) {
+            rtcSqwActive = false;
+            xLastWakeTime = xTaskGetTickCount();
+            Serial.println("\nSQW RTC HILANG - KEMBALI KE TIMER INTERNAL");
+        }
+
+        uint32_t applied = 0;
+
         if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
+            uint32_t ticks = clockTickTake(tick);
             if (timeConfig.currentTime < EPOCH_2000) {
                 Serial.println("\nPERINGATAN TUGAS JAM:");
                 Serial.printf("  TIMESTAMP TIDAK VALID: %ld\n", timeConfig.currentTime);
@@ -5153,28 +9068,37 @@ void clockTickTask(void *parameter) {
                 Serial.printf("WAKTU DIKOREKSI KE: %ld (01/01/2000 00:00:00)\n",
                              timeConfig.currentTime);
             } else {
-                timeConfig.currentTime++;
+                timeConfig.currentTime += ticks;
+                applied = ticks;
             }
+            tickDay = (int32_t)(timeConfig.currentTime / 86400);
 
+            traceClockTick(timeConfig.currentTime);
+            hotStateSetTimeAnchor(timeConfig.currentTime);
             xSemaphoreGive(timeMutex);
 
+            // PERGANTIAN HARI: BUFFER BESOK SUDAH DI RAM
+            if (tickDay != scheduleDay) {
+                scheduleSwapIn(tickDay);
+            }
+
             DisplayUpdate update;
             update.type = DisplayUpdate::TIME_UPDATE;
             xQueueSend(displayQueue, &update, pdMS_TO_TICKS(100));
         }
 
-        if (wifiConfig.isConnected) {
-            autoSyncCounter++;
-            if (autoSyncCounter >= 3600) {
-                autoSyncCounter = 0;
-                if (ntpTaskHandle != NULL) {
-                    Serial.println("\nSINKRONISASI NTP OTOMATIS (PER JAM)");
-                    xTaskNotifyGive(ntpTaskHandle);
-                }
+        // DIHITUNG DALAM DETIK YANG DITERAPKAN: TEPI SQW TERGABUNG / MUTEX SIBUK TIDAK MEMPERLAMBAT
+        if (wifiConfig.isConnected && clockSyncDue(tick, applied, ntpSyncIntervalS)) {
+            if (ntpTaskHandle != NULL) {
+                Serial.printf("\nSINKRONISASI NTP OTOMATIS (INTERVAL %lu DETIK)\n",
+                              (unsigned long)ntpSyncIntervalS);
+                xTaskNotifyGive(ntpTaskHandle);
             }
         }
 
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        if (!rtcSqwActive) {
+            vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        }
     }
 }
 
@@ -5528,7 +9452,12 @@ bool initDFPlayer() {
   Serial.println("UART2: TX=GPIO25, RX=GPIO32");
 
   dfSerial.begin(9600, SERIAL_8N1, DFPLAYER_RX, DFPLAYER_TX);
-  delay(500);
+
+  // MODUL BARU SIAP ~0.5 DETIK SETELAH DAYA MASUK, BUKAN SETELAH UART DIBUKA
+  uint32_t sinceBoot = millis();
+  if (sinceBoot < DFPLAYER_POWERUP_MS) {
+    vTaskDelay(pdMS_TO_TICKS(DFPLAYER_POWERUP_MS - sinceBoot));
+  }
 
   if (!dfPlayer.begin(dfSerial, true, true)) {
     Serial.println("KONEKSI DFPLAYER GAGAL!");
@@ -5542,17 +9471,24 @@ bool initDFPlayer() {
     return false;
   }
 
-  delay(200);
-
+  // MODE ACK: SETIAP PERINTAH MENUNGGU BALASAN, TIDAK PERLU JEDA TETAP
   dfPlayer.setTimeOut(500);
   dfPlayer.volume(15);
   dfPlayer.EQ(DFPLAYER_EQ_NORMAL);
   dfPlayer.outputDevice(DFPLAYER_DEVICE_SD);
 
-  delay(200);
-
   int fileCount = dfPlayer.readFileCounts();
 
+  // SETELAH INI UART DIKELOLA DRIVER SENDIRI, LIBRARY TIDAK DIPAKAI LAGI
+  while (dfSerial.available()) dfSerial.read();
+  dfSerial.onReceive(dfOnReceive);
+
+#if DFPLAYER_BUSY_PIN >= 0
+  pinMode(DFPLAYER_BUSY_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(DFPLAYER_BUSY_PIN), dfBusyISR, RISING);
+  Serial.printf("PIN BUSY: GPIO%d\n", DFPLAYER_BUSY_PIN);
+#endif
+
   Serial.println("DFPLAYER BERHASIL DIINISIALISASI!");
   Serial.println("UART2: TX=GPIO25, RX=GPIO32");
   Serial.println("VOLUME: 15/30");
@@ -5562,75 +9498,156 @@ bool initDFPlayer() {
   return true;
 }
 
+// ============================================
+// DRIVER DFPLAYER: KIRIM TANPA ACK, TERIMA FRAME ASINKRON
+// ============================================
+void dfSendCommand(uint8_t cmd, uint16_t param) {
+  uint8_t frame[DF_FRAME_SIZE];
+  dfBuildFrame(cmd, param, frame);
+
+  if (xSemaphoreTake(audioMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    dfSerial.write(frame, DF_FRAME_SIZE);
+    xSemaphoreGive(audioMutex);
+  }
+}
+
+void dfHandleFrame(const uint8_t *frame) {
+  uint32_t events = dfFrameEvents(frame, audioPlayback.playingTrack);
+  if (events & AUDIO_EVT_ERROR) dfErrorCode = dfFrameParam(frame);
+  if (events & AUDIO_EVT_STATUS) dfPlayStatus = dfFrameParam(frame) & 0xFF;
+
+  if (events != 0 && audioTaskHandle != NULL) {
+    xTaskNotify(audioTaskHandle, events, eSetBits);
+  }
+}
+
+// DIPANGGIL TASK EVENT UART SAAT ADA DATA MASUK; FRAME BOLEH TERPOTONG ANTAR PANGGILAN
+void dfOnReceive() {
+  while (dfSerial.available()) {
+    if (dfParserFeed(dfParser, dfSerial.read())) {
+      dfHandleFrame(dfParser.frame);
+    }
+  }
+}
+
+#if DFPLAYER_BUSY_PIN >= 0
+void IRAM_ATTR dfBusyISR() {
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  if (audioTaskHandle != NULL) {
+    xTaskNotifyFromISR(audioTaskHandle, AUDIO_EVT_FINISHED, eSetBits, &higherPriorityTaskWoken);
+  }
+  if (higherPriorityTaskWoken) {
+    portYIELD_FROM_ISR();
+  }
+}
+#endif
+
 void setDFPlayerVolume(int vol) {
   if (!dfPlayerAvailable) return;
 
   int dfVol = map(vol, 0, 100, 0, 30);
-  dfPlayer.volume(dfVol);
+  dfSendCommand(DF_CMD_VOLUME, dfVol);
   Serial.println("VOLUME DFPLAYER: " + String(dfVol) + "/30");
 }
 
-void playDFPlayerAdzan(String prayerName) {
-  if (!dfPlayerAvailable) {
-    Serial.println("DFPLAYER TIDAK TERSEDIA");
-    return;
+// ============================================
+// API AUDIO: PLAY / QUEUE / STOP + CALLBACK SELESAI
+// CALLBACK DIJALANKAN DI KONTEKS audioTask
+// ============================================
+bool audioQueue(uint16_t track, AudioDoneCallback onDone) {
+  if (!dfPlayerAvailable || audioTaskHandle == NULL || track == 0) return false;
+
+  AudioJob job = { track, onDone };
+  if (xQueueSend(audioJobQueue, &job, 0) != pdTRUE) {
+    Serial.println("ANTRIAN AUDIO PENUH");
+    return false;
   }
 
-  int trackNumber = 0;
+  xTaskNotify(audioTaskHandle, AUDIO_EVT_QUEUE, eSetBits);
+  return true;
+}
+
+bool audioPlay(uint16_t track, AudioDoneCallback onDone) {
+  if (!dfPlayerAvailable || audioTaskHandle == NULL || track == 0) return false;
 
-  if (prayerName == "subuh") trackNumber = 1;
-  else if (prayerName == "zuhur") trackNumber = 2;
-  else if (prayerName == "ashar") trackNumber = 3;
-  else if (prayerName == "maghrib") trackNumber = 4;
-  else if (prayerName == "isya") trackNumber = 5;
+  // JOB YANG DIGANTI TIDAK MENERIMA AUDIO_STOPPED: CALLBACK ADZAN LAMA AKAN
+  // MEMBERSIHKAN adzanState YANG BARU SAJA DIISI PEMANGGIL
+  xQueueReset(audioJobQueue);
+  xTaskNotify(audioTaskHandle, AUDIO_EVT_REPLACE, eSetBits);
+  return audioQueue(track, onDone);
+}
 
-  if (trackNumber == 0) {
-    Serial.println("NAMA SHALAT TIDAK VALID: " + prayerName);
-    return;
-  }
+void audioStop() {
+  if (audioTaskHandle == NULL) return;
 
-  Serial.println("\n========================================");
-  Serial.println("MEMUTAR ADZAN: " + prayerName);
-  Serial.println("========================================");
-  Serial.println("TRACK: " + String(trackNumber));
-  Serial.println("FILE: /000" + String(trackNumber) + ".mp3");
-  Serial.println("========================================\n");
+  xQueueReset(audioJobQueue);
+  xTaskNotify(audioTaskHandle, AUDIO_EVT_STOP, eSetBits);
+}
+
+void onAdzanAudioDone(uint16_t track, AudioResult result) {
+  static const char *resultNames[] = {
+    "SELESAI", "DIHENTIKAN", "SD CARD DICABUT", "ERROR DFPLAYER", "TIMEOUT"
+  };
+
+  Serial.printf("PEMUTARAN ADZAN TRACK %d: %s\n", track, resultNames[result]);
 
-  dfPlayer.play(trackNumber);
+  adzanState.isPlaying = false;
+  adzanState.canTouch = false;
+  adzanState.currentPrayer = PRAYER_NONE;
+  saveAdzanState();
+
+  Serial.println("STATUS ADZAN DIBERSIHKAN");
 }
 
-bool isDFPlayerPlaying() {
-  if (!dfPlayerAvailable) return false;
+void audioStart(const AudioJob &job) {
+  Serial.println("\n========================================");
+  Serial.println("MEMUTAR AUDIO");
+  Serial.println("========================================");
+  Serial.println("TRACK: " + String(job.track));
+  Serial.printf("FILE: /%04d.mp3\n", job.track);
+  Serial.println("========================================\n");
 
-  int state = dfPlayer.readState();
-  return (state == 1);
+  audioPlaybackStart(audioPlayback, job, millis());
+  dfSendCommand(DF_CMD_PLAY_TRACK, job.track);
 }
 
+// TIDUR PADA NOTIFIKASI - TANPA TRAFIK UART SELAMA MEMUTAR
 void audioTask(void *parameter) {
   while (true) {
-    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t waitMs = audioPlaybackWaitMs(audioPlayback, millis());
+    TickType_t wait = (waitMs == AUDIO_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(waitMs);
 
-    if (adzanState.isPlaying && adzanState.currentPrayer.length() > 0) {
-      Serial.println("TUGAS AUDIO DIPICU UNTUK: " + adzanState.currentPrayer);
+    uint32_t events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &events, wait);
 
-      playDFPlayerAdzan(adzanState.currentPrayer);
+    if (events & AUDIO_EVT_REMOVED) {
+      Serial.println("DFPLAYER: SD CARD DICABUT");
+    }
 
-      unsigned long startTime = millis();
-      const unsigned long maxDuration = 600000;
+    if (audioPlayback.active) {
+#if DFPLAYER_BUSY_PIN >= 0
+      int busyLevel = digitalRead(DFPLAYER_BUSY_PIN) == HIGH ? 1 : 0;
+#else
+      int busyLevel = -1;
+#endif
+      AudioAction act = audioPlaybackStep(audioPlayback, events, millis(), dfPlayStatus, busyLevel);
 
-      while (isDFPlayerPlaying() && (millis() - startTime < maxDuration)) {
-        vTaskDelay(pdMS_TO_TICKS(500));
-        esp_task_wdt_reset();
+      if (act.sendQuery) dfSendCommand(DF_CMD_QUERY_STATUS, 0);
+      if (act.sendStop) dfSendCommand(DF_CMD_STOP, 0);
+      if (act.done && act.result == AUDIO_ERROR) {
+        Serial.printf("DFPLAYER ERROR: KODE %d\n", dfErrorCode);
       }
+      // REPLACE: TANPA onDone, LIHAT audioPlay()
+      if (act.done && act.job.onDone != NULL) {
+        act.job.onDone(act.job.track, act.result);
+      }
+    }
 
-      Serial.println("PEMUTARAN ADZAN SELESAI");
-
-      adzanState.isPlaying = false;
-      adzanState.canTouch = false;
-      adzanState.currentPrayer = "";
-      saveAdzanState();
-
-      Serial.println("STATUS ADZAN DIBERSIHKAN");
+    if (!audioPlayback.active) {
+      AudioJob job;
+      if (xQueueReceive(audioJobQueue, &job, 0) == pdTRUE) {
+        audioStart(job);
+      }
     }
   }
 }
@@ -5638,160 +9655,199 @@ void audioTask(void *parameter) {
 // ============================================
 // TASK HTTP - KHUSUS PERMINTAAN API
 // ============================================
-void httpTask(void *parameter) {
-  esp_task_wdt_add(NULL);
+// ================================
+// INISIALISASI - ESP32 CORE 3.X
+// ================================
+// ============================================
+// PROFIL BOOT: FASE BERNAMA + WORKER PARALEL
+// ============================================
+int bootPhaseBegin(const char *name) {
+  int idx = -1;
+
+  portENTER_CRITICAL(&bootMux);
+  if (bootPhaseCount < BOOT_PHASE_MAX) {
+    idx = bootPhaseCount++;
+    bootPhases[idx].name = name;
+    bootPhases[idx].startUs = (uint32_t)esp_timer_get_time();
+    bootPhases[idx].durationUs = 0;
+    bootPhases[idx].core = xPortGetCoreID();
+  }
+  portEXIT_CRITICAL(&bootMux);
 
-  Serial.println("\n========================================");
-  Serial.println("TUGAS HTTP DIMULAI");
-  Serial.println("========================================");
-  Serial.println("UKURAN STACK: 8192 BYTE");
-  Serial.println("TUJUAN: MENANGANI PERMINTAAN API WAKTU SHALAT");
-  Serial.println("========================================\n");
+  return idx;
+}
 
-  HTTPRequest request;
+void bootPhaseEnd(int idx) {
+  if (idx < 0) return;
 
-  while (true) {
-    esp_task_wdt_reset();
+  uint32_t nowUs = (uint32_t)esp_timer_get_time();
 
-    if (xQueueReceive(httpQueue, &request, pdMS_TO_TICKS(10000)) == pdTRUE) {
-      esp_task_wdt_reset();
+  portENTER_CRITICAL(&bootMux);
+  bootPhases[idx].durationUs = nowUs - bootPhases[idx].startUs;
+  portEXIT_CRITICAL(&bootMux);
 
-      if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("TUGAS HTTP: WIFI TIDAK TERHUBUNG - MELEWATI PERMINTAAN");
-        vTaskDelay(pdMS_TO_TICKS(1000));
-        continue;
-      }
+  Serial.printf("[BOOT] %-12s SELESAI @%lu MS (%lu MS, CORE %d)\n",
+                bootPhases[idx].name,
+                (unsigned long)(nowUs / 1000),
+                (unsigned long)(bootPhases[idx].durationUs / 1000),
+                bootPhases[idx].core);
+}
 
-      Serial.println("\n========================================");
-      Serial.println("TUGAS HTTP: MEMPROSES WAKTU SHALAT");
-      Serial.println("========================================");
-      Serial.println("KOORDINAT: " + request.latitude + ", " + request.longitude);
+void bootRTCWorker(void *parameter) {
+  int phase = bootPhaseBegin("rtc");
 
-      time_t now_t;
-      if (xSemaphoreTake(timeMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        now_t = timeConfig.currentTime;
-        xSemaphoreGive(timeMutex);
-      } else {
-        now_t = time(nullptr);
-      }
+  Wire.begin(/*RTC_SDA, RTC_SCL*/);
+  rtcAvailable = initRTC();
+
+  if (rtcAvailable) {
+    Serial.println("\nRTC TERSEDIA");
+    Serial.println("WAKTU BERHASIL DIMUAT DARI RTC");
+    Serial.println("WAKTU AKAN BERTAHAN SAAT RESTART");
+    initRtcSqw();
+  } else {
+    // initRTC() SUDAH MENGATUR WAKTU KE 01/01/2000
+    Serial.println("\nRTC TIDAK TERSEDIA - WAKTU AKAN DIRESET SAAT RESTART");
+    if (hotStateRestoreTime()) {
+      Serial.println("WAKTU DILANJUTKAN DARI RTC MEMORY (RESET LUNAK)");
+    }
+  }
+
+  bootPhaseEnd(phase);
+  xEventGroupSetBits(bootEventGroup, BOOT_RTC_READY_BIT);
+
+  // FILE KALIBRASI ADA DI LITTLEFS
+  if (rtcAvailable) {
+    xEventGroupWaitBits(bootEventGroup, BOOT_FS_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+    loadRtcCalibration();
+  }
+  vTaskDelete(NULL);
+}
+
+void bootAudioWorker(void *parameter) {
+  int phase = bootPhaseBegin("dfplayer");
+  bool available = initDFPlayer();
+  bootPhaseEnd(phase);
+
+  // STATUS ADZAN ADA DI RTC MEMORY ATAU LITTLEFS; SISA JENDELA BUTUH JAM
+  xEventGroupWaitBits(bootEventGroup, BOOT_FS_READY_BIT | BOOT_RTC_READY_BIT,
+                      pdFALSE, pdTRUE, portMAX_DELAY);
+
+  if (available) {
+    if (!hotStateRestoreAdzan()) {
+      loadAdzanState();
+    }
+    hotStateSave();
 
-      if (now_t < 946684800) {
-        Serial.println("WAKTU SISTEM TIDAK VALID - DILEWATI");
-        continue;
-      }
+    xTaskCreatePinnedToCore(
+      audioTask,
+      "Audio",
+      AUDIO_TASK_STACK_SIZE,
+      NULL,
+      AUDIO_TASK_PRIORITY,
+      &audioTaskHandle,
+      1
+    );
+    dfPlayerAvailable = true;
+    Serial.println("TUGAS AUDIO OK");
+  } else {
+    Serial.println("DFPLAYER DINONAKTIFKAN - TIDAK ADA PEMUTARAN AUDIO");
+    Serial.println("MENGHAPUS STATUS ADZAN YANG TERTUNDA...");
 
-      char dateStr[12];
-      sprintf(dateStr, "%02d-%02d-%04d", day(now_t), month(now_t), year(now_t));
+    adzanState.isPlaying = false;
+    adzanState.canTouch = false;
+    adzanState.currentPrayer = PRAYER_NONE;
 
-      int currentMethod = methodConfig.methodId;
-      String tuneParam = String(prayerConfig.tuneImsak) + "," +
-                        String(prayerConfig.tuneSubuh) + "," +
-                        String(prayerConfig.tuneTerbit) + "," +
-                        String(prayerConfig.tuneZuhur) + "," +
-                        String(prayerConfig.tuneAshar) + "," +
-                        String(prayerConfig.tuneMaghrib) + "," +
-                        "0," +
-                        String(prayerConfig.tuneIsya) + "," +
-                        "0";
+    if (LittleFS.exists("/adzan_state.txt")) {
+      LittleFS.remove("/adzan_state.txt");
+      Serial.println("FILE STATUS ADZAN DIHAPUS (TIDAK ADA SISTEM AUDIO)");
+    }
+    hotStateSave();
 
-      String url = "http://api.aladhan.com/v1/timings/" + String(dateStr) +
-                  "?latitude=" + request.latitude +
-                  "&longitude=" + request.longitude +
-                  "&method=" + String(currentMethod) +
-                  "&tune=" + tuneParam;
+    Serial.println("STATUS ADZAN DIBERSIHKAN - MODE HANYA BUZZER AKTIF");
+  }
 
-      Serial.println("URL: " + url);
+  xEventGroupSetBits(bootEventGroup, BOOT_AUDIO_READY_BIT);
+  vTaskDelete(NULL);
+}
 
-      HTTPClient http;
-      WiFiClient client;
+void bootNetWorker(void *parameter) {
+  int phase = bootPhaseBegin("wifi");
 
-      http.begin(client, url);
-      http.setTimeout(20000);
+  Serial.println("\n========================================");
+  Serial.println("KONFIGURASI WIFI");
+  Serial.println("========================================");
 
-      esp_task_wdt_reset();
+  setupWiFiEvents();
 
-      int httpResponseCode = http.GET();
+  // WiFi.mode() SINKRON: KEMBALI SETELAH DRIVER BERHENTI/MULAI
+  WiFi.mode(WIFI_OFF);
 
-      esp_task_wdt_reset();
+  esp_netif_t *sta_netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+  if (sta_netif != NULL) {
+    esp_netif_set_hostname(sta_netif, hostname.c_str());
+    Serial.print("HOSTNAME DIATUR VIA ESP-IDF: ");
+    Serial.println(hostname.c_str());
+  } else {
+    Serial.println("PERINGATAN: TIDAK DAPAT MENDAPATKAN HANDLE STA NETIF");
+  }
 
-      Serial.println("KODE RESPONS: " + String(httpResponseCode));
+  WiFi.mode(WIFI_AP_STA);
 
-      if (httpResponseCode == 200) {
-        String payload = http.getString();
+  Serial.println("MENERAPKAN OPTIMASI WIFI UNTUK AKSES ROUTER...");
 
-        esp_task_wdt_reset();
+  esp_wifi_set_protocol(WIFI_IF_STA, WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N);
+  esp_wifi_set_bandwidth(WIFI_IF_STA, WIFI_BW_HT40);
+  WiFi.setTxPower(WIFI_POWER_19_5dBm);
 
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, payload);
+  Serial.println("  PROTOKOL: 802.11 B/G/N");
+  Serial.println("  BANDWIDTH: 40MHZ (HT40)");
+  Serial.println("  DAYA TX: 19.5DBM (MAKSIMUM)");
 
-        esp_task_wdt_reset();
+  WiFi.setSleep(WIFI_PS_NONE);
+  esp_wifi_set_ps(WIFI_PS_NONE);
 
-        if (!error) {
-          JsonObject timings = doc["data"]["timings"];
-
-          String tempSubuh = timings["Fajr"].as<String>().substring(0, 5);
-          String tempTerbit = timings["Sunrise"].as<String>().substring(0, 5);
-          String tempZuhur = timings["Dhuhr"].as<String>().substring(0, 5);
-          String tempAshar = timings["Asr"].as<String>().substring(0, 5);
-          String tempMaghrib = timings["Maghrib"].as<String>().substring(0, 5);
-          String tempIsya = timings["Isha"].as<String>().substring(0, 5);
-          String tempImsak = timings["Imsak"].as<String>().substring(0, 5);
-
-          bool allValid = true;
-          if (tempSubuh.length() != 5 || tempSubuh.indexOf(':') != 2) allValid = false;
-          if (tempTerbit.length() != 5 || tempTerbit.indexOf(':') != 2) allValid = false;
-          if (tempZuhur.length() != 5 || tempZuhur.indexOf(':') != 2) allValid = false;
-          if (tempAshar.length() != 5 || tempAshar.indexOf(':') != 2) allValid = false;
-          if (tempMaghrib.length() != 5 || tempMaghrib.indexOf(':') != 2) allValid = false;
-          if (tempIsya.length() != 5 || tempIsya.indexOf(':') != 2) allValid = false;
-          if (tempImsak.length() != 5 || tempImsak.indexOf(':') != 2) allValid = false;
-
-          if (allValid) {
-            prayerConfig.subuhTime = tempSubuh;
-            prayerConfig.terbitTime = tempTerbit;
-            prayerConfig.zuhurTime = tempZuhur;
-            prayerConfig.asharTime = tempAshar;
-            prayerConfig.maghribTime = tempMaghrib;
-            prayerConfig.isyaTime = tempIsya;
-            prayerConfig.imsakTime = tempImsak;
-
-            Serial.println("WAKTU SHALAT BERHASIL DIPERBARUI");
-            savePrayerTimes();
+  esp_wifi_set_max_tx_power(78);
 
-            DisplayUpdate update;
-            update.type = DisplayUpdate::PRAYER_UPDATE;
-            xQueueSend(displayQueue, &update, pdMS_TO_TICKS(100));
-          } else {
-            Serial.println("DATA WAKTU SHALAT TIDAK VALID");
-          }
-        } else {
-          Serial.println("ERROR PARSE JSON: " + String(error.c_str()));
-        }
-      } else {
-        Serial.println("PERMINTAAN HTTP GAGAL: " + String(httpResponseCode));
-      }
+  WiFi.setAutoReconnect(false);
+  WiFi.persistent(false);
+  WiFi.setSortMethod(WIFI_CONNECT_AP_BY_SIGNAL);
+  WiFi.setScanMethod(WIFI_ALL_CHANNEL_SCAN);
 
-      http.end();
-      client.stop();
+  Serial.println("MODE WIFI: AP + STA");
+  Serial.println("SLEEP WIFI: GANDA DINONAKTIFKAN");
+  Serial.println("  ARDUINO: WIFI_PS_NONE");
+  Serial.println("  ESP-IDF: WIFI_PS_NONE");
+  Serial.println("DAYA WIFI: MAKSIMUM (19.5DBM)");
+  Serial.println("AUTO RECONNECT: DIAKTIFKAN");
+  Serial.println("PERSISTENT: DINONAKTIFKAN");
+  Serial.println("========================================\n");
 
-      Serial.println("TUGAS HTTP: PERMINTAAN SELESAI");
-      Serial.println("========================================\n");
+  // KONFIGURASI AP DIBACA DARI LITTLEFS
+  xEventGroupWaitBits(bootEventGroup, BOOT_FS_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
 
-      esp_task_wdt_reset();
-    }
+  WiFi.softAPConfig(wifiConfig.apIP, wifiConfig.apGateway, wifiConfig.apSubnet);
+  WiFi.softAP(wifiConfig.apSSID, wifiConfig.apPassword);
 
-    esp_task_wdt_reset();
-    vTaskDelay(pdMS_TO_TICKS(100));
-  }
+  Serial.printf("AP DIMULAI: %s\n", wifiConfig.apSSID);
+  Serial.printf("PASSWORD: %s\n", wifiConfig.apPassword);
+  Serial.print("IP AP: ");
+  Serial.println(WiFi.softAPIP());
+  Serial.printf("MAC AP: %s\n", WiFi.softAPmacAddress().c_str());
+
+  bootPhaseEnd(phase);
+  xEventGroupSetBits(bootEventGroup, BOOT_NET_READY_BIT);
+  vTaskDelete(NULL);
 }
 
-// ================================
-// INISIALISASI - ESP32 CORE 3.X
-// ================================
+// ============================================
+// SETUP
+// Urutan: TFT -> worker paralel (RTC, DFPLAYER, WIFI) -> LittleFS
+// -> LVGL -> frame pertama dengan jadwal tersimpan -> tugas FreeRTOS.
+// Tidak ada jeda tetap; setiap ketergantungan ditunggu lewat bootEventGroup.
+// ============================================
 void setup() {
 #if !PRODUCTION
   Serial.begin(115200);
-  delay(1000);
 #endif
 
   Serial.println("\n\n");
@@ -5802,6 +9858,8 @@ void setup() {
   Serial.println("VERSI 2.3 - TUGAS HTTP DIPISAHKAN");
   Serial.println("========================================\n");
 
+  int phase = bootPhaseBegin("tft");
+
   pinMode(TFT_BL, OUTPUT);
   digitalWrite(TFT_BL, LOW);
   Serial.println("LAMPU LATAR: MATI");
@@ -5818,9 +9876,24 @@ void setup() {
 
   tft.begin();
   tft.setRotation(1);
-  tft.fillScreen(TFT_BLACK);
 
   Serial.println("TFT DIINISIALISASI");
+  bootPhaseEnd(phase);
+
+  // ================================
+  // SNAPSHOT TERAKHIR SEBELUM INIT LAIN
+  // ================================
+  phase = bootPhaseBegin("splash");
+  init_littlefs();
+  if (drawSplashSnapshot()) {
+    turnOnBacklight();
+    bootFirstPixelUs = (uint32_t)esp_timer_get_time();
+    Serial.printf("SNAPSHOT LAYAR DITAMPILKAN @%lu MS\n", (unsigned long)(bootFirstPixelUs / 1000));
+  } else {
+    tft.fillScreen(TFT_BLACK);
+    Serial.println("TIDAK ADA SNAPSHOT LAYAR - MENUNGGU FRAME LVGL");
+  }
+  bootPhaseEnd(phase);
 
   displayMutex = xSemaphoreCreateMutex();
   timeMutex = xSemaphoreCreateMutex();
@@ -5830,97 +9903,64 @@ void setup() {
   i2cMutex = xSemaphoreCreateMutex();
   audioMutex = xSemaphoreCreateMutex();
   alarmMutex = xSemaphoreCreateMutex();
+  bootEventGroup = xEventGroupCreate();
+  stateBootId = esp_random();
+  hotStateInit();
 
   displayQueue = xQueueCreate(20, sizeof(DisplayUpdate));
-  httpQueue = xQueueCreate(5, sizeof(HTTPRequest));
+  jobQueue = xQueueCreate(JOB_QUEUE_LENGTH, sizeof(Job));
+  touchCalQueue = xQueueCreate(1, sizeof(uint32_t));
+  audioJobQueue = xQueueCreate(AUDIO_QUEUE_LENGTH, sizeof(AudioJob));
 
   Serial.println("SEMAPHORE & ANTRIAN DIBUAT");
 
-  dfPlayerAvailable = initDFPlayer();
-
-  if (dfPlayerAvailable) {
-    loadAdzanState();
-
-    xTaskCreatePinnedToCore(
-      audioTask,
-      "Audio",
-      AUDIO_TASK_STACK_SIZE,
-      NULL,
-      AUDIO_TASK_PRIORITY,
-      &audioTaskHandle,
-      1
-    );
-    Serial.println("TUGAS AUDIO OK");
-  } else {
-    Serial.println("DFPLAYER DINONAKTIFKAN - TIDAK ADA PEMUTARAN AUDIO");
-    Serial.println("MENGHAPUS STATUS ADZAN YANG TERTUNDA...");
-
-    adzanState.isPlaying = false;
-    adzanState.canTouch = false;
-    adzanState.currentPrayer = "";
-
-    if (LittleFS.exists("/adzan_state.txt")) {
-      LittleFS.remove("/adzan_state.txt");
-      Serial.println("FILE STATUS ADZAN DIHAPUS (TIDAK ADA SISTEM AUDIO)");
-    }
-
-    Serial.println("STATUS ADZAN DIBERSIHKAN - MODE HANYA BUZZER AKTIF");
-  }
-
   if (wifiConfig.apIP == IPAddress(0, 0, 0, 0)) {
     wifiConfig.apIP = IPAddress(192, 168, 4, 1);
     wifiConfig.apGateway = IPAddress(192, 168, 4, 1);
     wifiConfig.apSubnet = IPAddress(255, 255, 255, 0);
   }
 
-  init_littlefs();
+  // ================================
+  // WORKER BOOT PARALEL (CORE 0)
+  // ================================
+  xTaskCreatePinnedToCore(bootRTCWorker, "BootRTC", BOOT_WORKER_STACK_SIZE,
+                          NULL, BOOT_WORKER_PRIORITY, NULL, 0);
+  xTaskCreatePinnedToCore(bootAudioWorker, "BootAudio", BOOT_WORKER_STACK_SIZE,
+                          NULL, BOOT_WORKER_PRIORITY, NULL, 0);
+  xTaskCreatePinnedToCore(bootNetWorker, "BootNet", BOOT_WORKER_STACK_SIZE,
+                          NULL, BOOT_WORKER_PRIORITY, NULL, 0);
+
+  phase = bootPhaseBegin("config");
   createDefaultConfigFiles();
   loadWiFiCredentials();
+  loadWiFiLinkCache();
   loadPrayerTimes();
   loadCitySelection();
   loadMethodSelection();
+  loadTouchCalibration();
   loadTimezoneConfig();
+  loadScheduleMirror();
   loadBuzzerConfig();
   loadAlarmConfig();
+  bootPhaseEnd(phase);
+  xEventGroupSetBits(bootEventGroup, BOOT_FS_READY_BIT);
 
-  Wire.begin(/*RTC_SDA, RTC_SCL*/);
-  delay(500);
-
-  Wire.beginTransmission(0x68);
-  Wire.endTransmission();
-
-  rtcAvailable = initRTC();
-
-  if (rtcAvailable) {
-      Serial.println("\nRTC TERSEDIA");
-      Serial.println("WAKTU BERHASIL DIMUAT DARI RTC");
-      Serial.println("WAKTU AKAN BERTAHAN SAAT RESTART");
-  } else {
-      Serial.println("\nRTC TIDAK TERSEDIA - WAKTU AKAN DIRESET SAAT RESTART");
-
-      if (xSemaphoreTake(timeMutex, portMAX_DELAY) == pdTRUE) {
-          const time_t EPOCH_2000 = 946684800;
-          setTime(0, 0, 0, 1, 1, 2000);
-          timeConfig.currentTime = EPOCH_2000;
-
-          if (timeConfig.currentTime < EPOCH_2000) {
-              timeConfig.currentTime = EPOCH_2000;
-          }
-
-          xSemaphoreGive(timeMutex);
-          Serial.printf("WAKTU AWAL DIATUR: %ld (01/01/2000 00:00:00 UTC)\n", EPOCH_2000);
-      }
-  }
-
+  phase = bootPhaseBegin("input");
   touchSPI.begin(TOUCH_CLK, TOUCH_MISO, TOUCH_MOSI, TOUCH_CS);
   touch.begin(touchSPI);
   touch.setRotation(1);
-  Serial.println("LAYAR SENTUH DIINISIALISASI");
+  attachInterrupt(digitalPinToInterrupt(TOUCH_IRQ), touchISR, FALLING);
+  Serial.println("LAYAR SENTUH DIINISIALISASI (IRQ GPIO36)");
 
-  ledcAttach(BUZZER_PIN, BUZZER_FREQ, BUZZER_RESOLUTION);
-  ledcWrite(BUZZER_CHANNEL, 0);
-  Serial.println("BUZZER DIINISIALISASI (GPIO26)");
+  if (initBuzzer()) {
+    Serial.println("BUZZER DIINISIALISASI (GPIO26)");
+    hotStateRestoreAlarm();
+  } else {
+    Serial.println("GAGAL MEMBUAT TIMER BUZZER");
+  }
+  bootPhaseEnd(phase);
 
+  phase = bootPhaseBegin("lvgl");
   lv_init();
   lv_tick_set_cb([]() {
     return (uint32_t)millis();
@@ -5939,85 +9979,36 @@ void setup() {
 
   ui_init();
   Serial.println("EEZ UI DIINISIALISASI");
+  bootPhaseEnd(phase);
 
-  hideAllUIElements();
-  Serial.println("ELEMEN UI DISEMBUNYIKAN");
-
-  delay(100);
-  lv_timer_handler();
-  delay(100);
-  lv_timer_handler();
-  delay(100);
-
-  tft.fillScreen(TFT_BLACK);
-
-  Serial.println("UI DIRENDER (LAYAR HITAM)");
-
-  Serial.println("MEMULAI LAMPU LATAR...");
-
-  ledcAttach(TFT_BL, TFT_BL_FREQ, TFT_BL_RESOLUTION);
-  ledcWrite(TFT_BL, TFT_BL_BRIGHTNESS);
-  Serial.printf("LAMPU LATAR MENYALA: %d/255\n", TFT_BL_BRIGHTNESS);
-
-  Serial.println("\n========================================");
-  Serial.println("KONFIGURASI WIFI");
-  Serial.println("========================================");
-
-  setupWiFiEvents();
-
-  WiFi.mode(WIFI_OFF);
-  delay(500);
-
-  esp_netif_t *sta_netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
-  if (sta_netif != NULL) {
-    esp_netif_set_hostname(sta_netif, hostname.c_str());
-    Serial.print("HOSTNAME DIATUR VIA ESP-IDF: ");
-    Serial.println(hostname.c_str());
-  } else {
-    Serial.println("PERINGATAN: TIDAK DAPAT MENDAPATKAN HANDLE STA NETIF");
+  // ================================
+  // FRAME PERTAMA: JADWAL TERAKHIR + JAM RTC
+  // ================================
+  phase = bootPhaseBegin("wait_rtc");
+  xEventGroupWaitBits(bootEventGroup, BOOT_RTC_READY_BIT, pdFALSE, pdTRUE,
+                      pdMS_TO_TICKS(BOOT_RTC_WAIT_MS));
+  bootPhaseEnd(phase);
+
+  phase = bootPhaseBegin("first_frame");
+  updateCityDisplay();
+  if (prayerConfig.subuhTime.length() > 0) {
+    updatePrayerDisplay();
   }
+  updateTimeDisplay();
+  showAllUIElements();
+  lv_refr_now(display);
 
-  WiFi.mode(WIFI_AP_STA);
-  delay(100);
-
-  Serial.println("MENERAPKAN OPTIMASI WIFI UNTUK AKSES ROUTER...");
-
-  esp_wifi_set_protocol(WIFI_IF_STA, WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N);
-  esp_wifi_set_bandwidth(WIFI_IF_STA, WIFI_BW_HT40);
-  WiFi.setTxPower(WIFI_POWER_19_5dBm);
-
-  Serial.println("  PROTOKOL: 802.11 B/G/N");
-  Serial.println("  BANDWIDTH: 40MHZ (HT40)");
-  Serial.println("  DAYA TX: 19.5DBM (MAKSIMUM)");
-
-  WiFi.setSleep(WIFI_PS_NONE);
-  esp_wifi_set_ps(WIFI_PS_NONE);
-
-  esp_wifi_set_max_tx_power(78);
-
-  WiFi.setAutoReconnect(false);
-  WiFi.persistent(false);
-  WiFi.setSortMethod(WIFI_CONNECT_AP_BY_SIGNAL);
-  WiFi.setScanMethod(WIFI_ALL_CHANNEL_SCAN);
-
-  Serial.println("MODE WIFI: AP + STA");
-  Serial.println("SLEEP WIFI: GANDA DINONAKTIFKAN");
-  Serial.println("  ARDUINO: WIFI_PS_NONE");
-  Serial.println("  ESP-IDF: WIFI_PS_NONE");
-  Serial.println("DAYA WIFI: MAKSIMUM (19.5DBM)");
-  Serial.println("AUTO RECONNECT: DIAKTIFKAN");
-  Serial.println("PERSISTENT: DINONAKTIFKAN");
-  Serial.println("========================================\n");
+  turnOnBacklight();
+  bootFirstFrameUs = (uint32_t)esp_timer_get_time();
+  if (bootFirstPixelUs == 0) bootFirstPixelUs = bootFirstFrameUs;
+  bootPhaseEnd(phase);
 
-  WiFi.softAPConfig(wifiConfig.apIP, wifiConfig.apGateway, wifiConfig.apSubnet);
-  WiFi.softAP(wifiConfig.apSSID, wifiConfig.apPassword);
-  delay(100);
+  if (prayerConfig.subuhTime.length() > 0 && !LittleFS.exists(SPLASH_FILE)) {
+    splashCaptureDue = true;
+  }
 
-  Serial.printf("AP DIMULAI: %s\n", wifiConfig.apSSID);
-  Serial.printf("PASSWORD: %s\n", wifiConfig.apPassword);
-  Serial.print("IP AP: ");
-  Serial.println(WiFi.softAPIP());
-  Serial.printf("MAC AP: %s\n", WiFi.softAPmacAddress().c_str());
+  Serial.printf("LAMPU LATAR MENYALA: %d/255 - FRAME PERTAMA @%lu MS\n",
+                TFT_BL_BRIGHTNESS, (unsigned long)(bootFirstFrameUs / 1000));
 
   timeConfig.ntpServer = "pool.ntp.org";
   timeConfig.ntpSynced = false;
@@ -6033,15 +10024,16 @@ void setup() {
     Serial.println("ASHAR: " + prayerConfig.asharTime);
     Serial.println("MAGHRIB: " + prayerConfig.maghribTime);
     Serial.println("ISYA: " + prayerConfig.isyaTime);
-
-    DisplayUpdate update;
-    update.type = DisplayUpdate::PRAYER_UPDATE;
-    xQueueSend(displayQueue, &update, pdMS_TO_TICKS(100));
   } else {
     Serial.println("\nTIDAK ADA KOTA DIPILIH");
     Serial.println("SILAKAN PILIH KOTA MELALUI ANTARMUKA WEB");
   }
 
+  // TUGAS JAM & SINKRONISASI RTC BUTUH HASIL PROBE RTC
+  phase = bootPhaseBegin("rtc_join");
+  xEventGroupWaitBits(bootEventGroup, BOOT_RTC_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+  bootPhaseEnd(phase);
+
   Serial.println("\nMENGKONFIGURASI WATCHDOG...");
 
   esp_task_wdt_deinit();
@@ -6063,6 +10055,8 @@ void setup() {
   Serial.println("MEMULAI TUGAS FREERTOS");
   Serial.println("========================================");
 
+  phase = bootPhaseBegin("tasks");
+
   xTaskCreatePinnedToCore(
     uiTask,
     "UI",
@@ -6074,6 +10068,17 @@ void setup() {
   );
   Serial.printf("TUGAS UI (CORE 1) - STACK: %d BYTE\n", UI_TASK_STACK_SIZE);
 
+  xTaskCreatePinnedToCore(
+    touchTask,
+    "Touch",
+    TOUCH_TASK_STACK_SIZE,
+    NULL,
+    TOUCH_TASK_PRIORITY,
+    &touchTaskHandle,
+    1
+  );
+  Serial.printf("TUGAS TOUCH (CORE 1) - STACK: %d BYTE\n", TOUCH_TASK_STACK_SIZE);
+
   // ================================
   // WIFI TASK
   // ================================
@@ -6117,42 +10122,37 @@ void setup() {
   Serial.printf("TUGAS WEB (CORE 0) - STACK: %d BYTE\n", WEB_TASK_STACK_SIZE);
 
   // ================================
-  // HTTP TASK
+  // SCHEDULE TASK (JADWAL: HTTP + PARSING + SIMPAN)
   // ================================
   xTaskCreatePinnedToCore(
-    httpTask,
-    "HTTP",
-    8192,
+    scheduleTask,
+    "Schedule",
+    SCHEDULE_TASK_STACK_SIZE,
     NULL,
-    0,
-    &httpTaskHandle,
+    SCHEDULE_TASK_PRIORITY,
+    &scheduleTaskHandle,
     0
   );
-  Serial.printf("TUGAS HTTP (CORE 0) - STACK: 8192 BYTE\n");
+  Serial.printf("TUGAS JADWAL (CORE 0) - STACK: %d BYTE\n", SCHEDULE_TASK_STACK_SIZE);
 
-  if (httpTaskHandle) {
-    esp_task_wdt_add(httpTaskHandle);
-    Serial.println("  TUGAS HTTP WDT TERDAFTAR");
+  if (scheduleTaskHandle) {
+    esp_task_wdt_add(scheduleTaskHandle);
+    Serial.println("  TUGAS JADWAL WDT TERDAFTAR");
   }
 
   // ================================
-  // PRAYER TASK
+  // JOB TASK
   // ================================
   xTaskCreatePinnedToCore(
-    prayerTask,
-    "Prayer",
-    PRAYER_TASK_STACK_SIZE,
+    jobTask,
+    "Job",
+    JOB_TASK_STACK_SIZE,
     NULL,
-    PRAYER_TASK_PRIORITY,
-    &prayerTaskHandle,
+    JOB_TASK_PRIORITY,
+    &jobTaskHandle,
     0
   );
-  Serial.printf("TUGAS SHALAT (CORE 0) - STACK: %d BYTE\n", PRAYER_TASK_STACK_SIZE);
-
-  if (prayerTaskHandle) {
-    esp_task_wdt_add(prayerTaskHandle);
-    Serial.println("  TUGAS SHALAT WDT TERDAFTAR");
-  }
+  Serial.printf("TUGAS JOB (CORE 0) - STACK: %d BYTE\n", JOB_TASK_STACK_SIZE);
 
   // ================================
   // CLOCK TASK
@@ -6163,7 +10163,7 @@ void setup() {
     CLOCK_TASK_STACK_SIZE,
     NULL,
     CLOCK_TASK_PRIORITY,
-    NULL,
+    &clockTaskHandle,
     0
   );
   Serial.printf("TUGAS JAM (CORE 0) - STACK: %d BYTE\n", CLOCK_TASK_STACK_SIZE);
@@ -6197,80 +10197,7 @@ void setup() {
     Serial.printf("TUGAS SINKRONISASI RTC (CORE 0) - STACK: %d BYTE\n", RTC_TASK_STACK_SIZE);
   }
 
-  // ================================
-  // PRAYER WATCHDOG TASK
-  // ================================
-  xTaskCreate(
-    [](void* param) {
-      const TickType_t checkInterval = pdMS_TO_TICKS(30000);
-
-      Serial.println("TUGAS WATCHDOG SHALAT - MEMANTAU SETIAP 30 DETIK");
-
-      while (true) {
-        vTaskDelay(checkInterval);
-
-        if (prayerTaskHandle != NULL) {
-          eTaskState state = eTaskGetState(prayerTaskHandle);
-
-          if (state == eDeleted || state == eInvalid) {
-            Serial.println("\n========================================");
-            Serial.println("KRITIS: TUGAS SHALAT CRASH");
-            Serial.println("========================================");
-            Serial.println("STATUS TERDETEKSI: " + String(state == eDeleted ? "DELETED" : "INVALID"));
-            Serial.println("AKSI: MEMULAI ULANG TUGAS OTOMATIS...");
-            Serial.println("========================================");
-
-            xTaskCreatePinnedToCore(
-              prayerTask,
-              "Prayer",
-              PRAYER_TASK_STACK_SIZE,
-              NULL,
-              PRAYER_TASK_PRIORITY,
-              &prayerTaskHandle,
-              0
-            );
-
-            if (prayerTaskHandle) {
-              esp_task_wdt_add(prayerTaskHandle);
-              Serial.println("\nTUGAS SHALAT BERHASIL DIMULAI ULANG");
-              Serial.println("STACK: " + String(PRAYER_TASK_STACK_SIZE) + " BYTE");
-              Serial.println("WDT: TERDAFTAR ULANG");
-              Serial.println("========================================\n");
-            } else {
-              Serial.println("\nGAGAL MEMULAI ULANG TUGAS SHALAT!");
-              Serial.println("SISTEM MUNGKIN TIDAK STABIL");
-              Serial.println("========================================\n");
-            }
-          }
-        } else {
-          Serial.println("\nPERINGATAN: HANDLE TUGAS SHALAT NULL");
-          Serial.println("MENCOBA MEMBUAT TUGAS...");
-
-          xTaskCreatePinnedToCore(
-            prayerTask,
-            "Prayer",
-            PRAYER_TASK_STACK_SIZE,
-            NULL,
-            PRAYER_TASK_PRIORITY,
-            &prayerTaskHandle,
-            0
-          );
-
-          if (prayerTaskHandle) {
-            esp_task_wdt_add(prayerTaskHandle);
-            Serial.println("TUGAS SHALAT BERHASIL DIBUAT\n");
-          }
-        }
-      }
-    },
-    "PrayerWatchdog",
-    2048,
-    NULL,
-    1,
-    NULL
-  );
-
-  vTaskDelay(pdMS_TO_TICKS(500));
+  bootPhaseEnd(phase);
 
   Serial.println("\nMENDAFTARKAN TUGAS KE WATCHDOG:");
 
@@ -6305,15 +10232,14 @@ void setup() {
   Serial.println("\nALOKASI STACK TUGAS:");
   uint32_t totalStack = UI_TASK_STACK_SIZE + WIFI_TASK_STACK_SIZE +
                         NTP_TASK_STACK_SIZE + WEB_TASK_STACK_SIZE +
-                        PRAYER_TASK_STACK_SIZE + CLOCK_TASK_STACK_SIZE +
-                        8192;
+                        SCHEDULE_TASK_STACK_SIZE + CLOCK_TASK_STACK_SIZE +
+                        JOB_TASK_STACK_SIZE;
   if (rtcAvailable) totalStack += RTC_TASK_STACK_SIZE;
 
   Serial.printf("TOTAL:        %d BYTE (%.2F KB)\n", totalStack, totalStack / 1024.0);
   Serial.printf("TUGAS UI:      %d BYTE\n", UI_TASK_STACK_SIZE);
   Serial.printf("TUGAS WEB:     %d BYTE\n", WEB_TASK_STACK_SIZE);
-  Serial.printf("TUGAS HTTP:    8192 BYTE (BARU)\n");
-  Serial.printf("TUGAS SHALAT:  %d BYTE (DIKURANGI DARI 16384)\n", PRAYER_TASK_STACK_SIZE);
+  Serial.printf("TUGAS JADWAL:  %d BYTE (SHALAT + HTTP DIGABUNG)\n", SCHEDULE_TASK_STACK_SIZE);
   Serial.println("========================================\n");
 
   Serial.println("========================================");
@@ -6322,8 +10248,7 @@ void setup() {
   Serial.println("AKSES BERSAMAAN MULTI-KLIEN DIAKTIFKAN");
   Serial.println("SLEEP WIFI DINONAKTIFKAN UNTUK RESPONS LEBIH BAIK");
   Serial.println("OPTIMASI ROUTER AKTIF (KEEP-ALIVE)");
-  Serial.println("PEMULIHAN OTOMATIS TUGAS SHALAT DIAKTIFKAN");
-  Serial.println("TUGAS HTTP DIPISAHKAN (NON-BLOCKING)");
+  Serial.println("LAYANAN JADWAL: STATE MACHINE TUNGGAL");
   Serial.println("PEMANTAUAN STACK AKTIF");
   Serial.println("MEMORI DIOPTIMALKAN (HEMAT ~8KB)");
   Serial.println("========================================\n");
@@ -6343,12 +10268,15 @@ void setup() {
     Serial.println("\nPENGINGAT: PILIH KOTA MELALUI ANTARMUKA WEB");
   }
 
-  Serial.println("\nBOOT SELESAI - SIAP MENERIMA KONEKSI");
+  bootSetupDoneUs = (uint32_t)esp_timer_get_time();
+  traceConfig();
+  traceRecord(TRACE_BOOT, 0, 0, (int32_t)timeConfig.currentTime, bootSetupDoneUs);
+  Serial.printf("\nBOOT SELESAI @%lu MS - SIAP MENERIMA KONEKSI\n",
+                (unsigned long)(bootSetupDoneUs / 1000));
   rgbBootDone();
   Serial.println("LOG PEMANTAUAN AKAN MUNCUL DI BAWAH:");
   Serial.println("  - LAPORAN PENGGUNAAN STACK SETIAP 60 DETIK");
-  Serial.println("  - PEMERIKSAAN KESEHATAN TUGAS SHALAT SETIAP 30 DETIK");
-  Serial.println("  - LOG PEMROSESAN TUGAS HTTP");
+  Serial.println("  - LOG LAYANAN JADWAL ([JADWAL])");
   Serial.println("  - LAPORAN MEMORI SETIAP 30 DETIK (DARI WEBTASK)");
   Serial.println("========================================\n");
 }
@@ -0,0 +1,113 @@
+/*
+ * SKEMA PARAMETER FORM: SATU PASS KE STRUCT BERTIPE
+ * Skema deklaratif membaca setiap parameter POST tepat sekali, menulis langsung
+ * ke field struct (offsetof) dan memeriksa rentangnya. Tanpa tipe Arduino:
+ * jws.ino menyuplai parameter AsyncWebServer, test/route_table_test.cpp
+ * menyuplai daftar buatan untuk uji & benchmark.
+ */
+
+#ifndef JWS_PARAM_SCHEMA_H
+#define JWS_PARAM_SCHEMA_H
+
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum ParamType : uint8_t {
+  PARAM_INT,    // int32_t; min/max = RENTANG NILAI
+  PARAM_STR,    // char[max + 1]; min/max = RENTANG PANJANG SETELAH TRIM
+  PARAM_BOOL    // bool; "true"/"1" = true
+};
+
+#define PARAM_REQUIRED 0x01
+#define PARAM_CLIP     0x02   // STRING KEPANJANGAN DIPOTONG, BUKAN DITOLAK
+
+struct ParamSpec {
+  const char *name;
+  ParamType type;
+  uint8_t flags;
+  int32_t min;
+  int32_t max;
+  uint16_t offset;
+};
+
+#define PARAM_FIELD(type, field) ((uint16_t)offsetof(type, field))
+
+struct ParamResult {
+  uint32_t present;    // BIT i = SKEMA[i] DIKIRIM
+  uint32_t invalid;    // BIT i = SKEMA[i] HILANG (WAJIB) ATAU DI LUAR RENTANG
+};
+
+inline bool parseParamValue(const ParamSpec &spec, const char *v, size_t len, uint8_t *base) {
+  while (len > 0 && isspace((unsigned char)*v)) { v++; len--; }
+  while (len > 0 && isspace((unsigned char)v[len - 1])) len--;
+
+  switch (spec.type) {
+    case PARAM_INT: {
+      if (len == 0 || len > 11) return false;
+      char buf[12];
+      memcpy(buf, v, len);
+      buf[len] = '\0';
+      char *end = NULL;
+      long n = strtol(buf, &end, 10);
+      if (*end != '\0' || n < spec.min || n > spec.max) return false;
+      int32_t out = (int32_t)n;
+      memcpy(base + spec.offset, &out, sizeof(out));
+      return true;
+    }
+
+    case PARAM_STR: {
+      if ((int32_t)len > spec.max) {
+        if (!(spec.flags & PARAM_CLIP)) return false;
+        len = spec.max;
+      }
+      if ((int32_t)len < spec.min) return false;
+      char *out = (char *)(base + spec.offset);
+      memcpy(out, v, len);
+      out[len] = '\0';
+      return true;
+    }
+
+    case PARAM_BOOL: {
+      bool out = (len == 4 && strncmp(v, "true", 4) == 0) || (len == 1 && *v == '1');
+      memcpy(base + spec.offset, &out, sizeof(out));
+      return true;
+    }
+  }
+  return false;
+}
+
+// next(i, name, value, len) MENGISI PARAMETER KE-i; FALSE = LEWATI (MIS. BUKAN POST)
+template <typename T, size_t N, typename Next>
+ParamResult parseParamList(const ParamSpec (&schema)[N], T &out, size_t count, Next next) {
+  static_assert(N <= 32, "Skema parameter maksimal 32 field");
+
+  ParamResult result = { 0, 0 };
+  uint8_t *base = (uint8_t *)&out;
+
+  for (size_t i = 0; i < count; i++) {
+    const char *name;
+    const char *value;
+    size_t len;
+    if (!next(i, name, value, len)) continue;
+
+    for (size_t k = 0; k < N; k++) {
+      if (strcmp(name, schema[k].name) != 0) continue;
+      result.present |= (1UL << k);
+      if (!parseParamValue(schema[k], value, len, base)) result.invalid |= (1UL << k);
+      break;
+    }
+  }
+
+  for (size_t k = 0; k < N; k++) {
+    if ((schema[k].flags & PARAM_REQUIRED) && !(result.present & (1UL << k))) {
+      result.invalid |= (1UL << k);
+    }
+  }
+
+  return result;
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * TABEL RUTE WEB: HASH SEMPURNA DIHITUNG SAAT KOMPILASI
+ * Murni constexpr agar test/route_table_test.cpp bisa memeriksa tabel dan
+ * mengukur lookup di host. Handler (AsyncWebServer) tetap di jws.ino.
+ */
+
+#ifndef JWS_ROUTE_TABLE_H
+#define JWS_ROUTE_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// AsyncWebServer mencocokkan handler satu per satu (perbandingan String per rute).
+// Semua rute API didaftarkan ke tabel ini dan dipanggil dari catch-all
+// onNotFound: satu hash FNV-1a atas URL + satu strcmp, berapa pun jumlah rutenya.
+// Rute baru WAJIB ditambahkan ke ROUTE_PATHS; seed dicari ulang otomatis.
+constexpr const char *ROUTE_PATHS[] = {
+  "/", "/css/foundation.min.css", "/notfound",
+  "/devicestatus", "/restart", "/reset",
+  "/getwificonfig", "/setwifi", "/setap", "/api/connection-type",
+  "/synctime", "/gettimezone", "/settimezone",
+  "/getcities", "/getcityinfo", "/setcity", "/getmethod", "/setmethod",
+  "/getprayertimes", "/getbuzzerconfig", "/setbuzzerpattern", "/setbuzzertoggle",
+  "/setbuzzervolume", "/testbuzzer", "/stopbuzzer",
+  "/touchcalibrate", "/gettouchcalibration", "/getalarmconfig", "/setalarmconfig",
+  "/api/data", "/api/countdown", "/api/boot", "/api/schedule/bulk",
+  "/api/v2/state", "/api/v2/settings", "/api/jobs", "/api/perf", "/api/trace", "/api/heap",
+  "/api/schedule", "/setmirror"
+};
+
+constexpr size_t ROUTE_COUNT = sizeof(ROUTE_PATHS) / sizeof(ROUTE_PATHS[0]);
+constexpr size_t ROUTE_SLOTS = 128;   // PANGKAT 2, ~3.5x JUMLAH RUTE
+constexpr uint8_t ROUTE_EMPTY = 0xFF;
+
+static_assert(ROUTE_COUNT < ROUTE_EMPTY, "ROUTE_PATHS terlalu banyak untuk indeks uint8_t");
+
+constexpr uint32_t routeHash(const char *s, uint32_t seed) {
+  uint32_t h = 2166136261u ^ seed;
+  while (*s) {
+    h = (h ^ (uint8_t)*s++) * 16777619u;
+  }
+  return h ^ (h >> 15);
+}
+
+constexpr bool routeSeedIsPerfect(uint32_t seed) {
+  bool used[ROUTE_SLOTS] = {};
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    uint32_t slot = routeHash(ROUTE_PATHS[i], seed) & (ROUTE_SLOTS - 1);
+    if (used[slot]) return false;
+    used[slot] = true;
+  }
+  return true;
+}
+
+constexpr uint32_t findRouteSeed() {
+  for (uint32_t seed = 1; seed < 4096; seed++) {
+    if (routeSeedIsPerfect(seed)) return seed;
+  }
+  return 0;
+}
+
+constexpr uint32_t ROUTE_SEED = findRouteSeed();
+static_assert(ROUTE_SEED != 0, "Tidak ada seed hash sempurna - perbesar ROUTE_SLOTS");
+
+struct RouteIndex {
+  uint8_t slot[ROUTE_SLOTS];
+};
+
+constexpr RouteIndex buildRouteIndex() {
+  RouteIndex index = {};
+  for (size_t i = 0; i < ROUTE_SLOTS; i++) index.slot[i] = ROUTE_EMPTY;
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    index.slot[routeHash(ROUTE_PATHS[i], ROUTE_SEED) & (ROUTE_SLOTS - 1)] = (uint8_t)i;
+  }
+  return index;
+}
+
+constexpr RouteIndex ROUTE_INDEX = buildRouteIndex();
+
+// INDEKS ROUTE_PATHS, ATAU -1 JIKA BUKAN RUTE TABEL
+inline int routeLookup(const char *path) {
+  uint8_t idx = ROUTE_INDEX.slot[routeHash(path, ROUTE_SEED) & (ROUTE_SLOTS - 1)];
+  if (idx == ROUTE_EMPTY || strcmp(ROUTE_PATHS[idx], path) != 0) return -1;
+  return idx;
+}
+
+#endif
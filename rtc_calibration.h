@@ -0,0 +1,114 @@
+/*
+ * PENGENDALI AGING DS3231 DARI SELISIH RTC VS NTP
+ * Setiap sinkron NTP menghasilkan satu pengukuran fase (offsetMs, POSITIF = RTC
+ * LEBIH CEPAT). Kemiringan selisih antar pengukuran (minimal 6 jam) = galat kristal
+ * dalam ppm; register aging dikoreksi dengan redaman dan batas per langkah, interval
+ * NTP dijarangkan selama akurasi dalam target. Murni: jws.ino menulis register &
+ * file, test/rtc_calibration_test.cpp menjalankannya terhadap RTC simulasi yang drift.
+ */
+
+#ifndef JWS_RTC_CALIBRATION_H
+#define JWS_RTC_CALIBRATION_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define RTC_AGING_PPM_PER_LSB    0.1f    // KIRA-KIRA PADA 25 C, NILAI POSITIF MEMPERLAMBAT
+#define RTC_AGING_LIMIT          100     // REGISTER int8, SISAKAN RUANG DARI BATAS CHIP
+#define RTC_CAL_GAIN             0.5f    // REDAMAN: KOREKSI SEPARUH GALAT PER LANGKAH
+#define RTC_CAL_MAX_STEP         8       // LSB PER LANGKAH
+#define RTC_CAL_MIN_BASELINE_S   21600   // 6 JAM: 1 ms GALAT UKUR = 0.05 ppm
+#define RTC_TARGET_PPM           0.5f
+#define RTC_TARGET_OFFSET_MS     100
+#define RTC_WRITE_THRESHOLD_MS   250     // DI BAWAH INI RTC TIDAK DITULIS ULANG (FASE DIPERTAHANKAN)
+#define NTP_INTERVAL_MIN_S       3600
+#define NTP_INTERVAL_MAX_S       86400
+
+struct RtcCalibration {
+  int8_t aging;
+  float lastPpm;
+  bool baselineValid;
+  time_t baselineUtc;
+  int32_t baselineOffsetMs;
+  int32_t lastOffsetMs;
+};
+
+struct RtcCalDecision {
+  bool segmentClosed;     // ppm/aging/interval DIHITUNG PADA PENGUKURAN INI
+  float ppm;
+  int32_t elapsedS;
+  int aging;              // NILAI YANG HARUS DITULIS (SAMA = TIDAK PERLU MENULIS)
+  uint32_t intervalS;
+  bool rewriteRtc;        // FASE PERLU DITULIS ULANG (LIHAT rtcCalOnMeasurement)
+};
+
+// ppm POSITIF = RTC MAKIN CEPAT
+inline float rtcCalPpm(int32_t offsetMs, int32_t baselineOffsetMs, int32_t elapsedS) {
+  return elapsedS > 0 ? (offsetMs - baselineOffsetMs) * 1000.0f / elapsedS : 0.0f;
+}
+
+// AGING POSITIF MEMPERLAMBAT: GALAT POSITIF -> LANGKAH POSITIF, DIREDAM & DIBATASI
+inline int rtcCalNextAging(int aging, float ppm) {
+  int step = (int)lroundf(ppm / RTC_AGING_PPM_PER_LSB * RTC_CAL_GAIN);
+  if (step > RTC_CAL_MAX_STEP) step = RTC_CAL_MAX_STEP;
+  if (step < -RTC_CAL_MAX_STEP) step = -RTC_CAL_MAX_STEP;
+  int next = aging + step;
+  if (next > RTC_AGING_LIMIT) next = RTC_AGING_LIMIT;
+  if (next < -RTC_AGING_LIMIT) next = -RTC_AGING_LIMIT;
+  return next;
+}
+
+// AKURASI DALAM TARGET: JARANGKAN NTP; KELUAR TARGET: KEMBALI KE 1 JAM
+inline uint32_t rtcCalNextInterval(uint32_t intervalS, float ppm, int32_t offsetMs) {
+  if (fabsf(ppm) <= RTC_TARGET_PPM && abs(offsetMs) <= RTC_TARGET_OFFSET_MS) {
+    uint32_t doubled = intervalS * 2;
+    return doubled < NTP_INTERVAL_MAX_S ? doubled : NTP_INTERVAL_MAX_S;
+  }
+  return NTP_INTERVAL_MIN_S;
+}
+
+// SATU PENGUKURAN BERHASIL. RTC DITULIS ULANG SEGERA JIKA |offset| >= RTC_WRITE_THRESHOLD_MS,
+// ATAU DI AKHIR SEGMEN JIKA DI LUAR RTC_TARGET_OFFSET_MS. MEMPERBARUI baseline/lastPpm/
+// lastOffsetMs; cal.aging DIBIARKAN - PEMANGGIL MENULIS REGISTER DAN BARU MENYIMPAN JIKA BERHASIL
+inline RtcCalDecision rtcCalOnMeasurement(RtcCalibration &cal, uint32_t intervalS, int32_t offsetMs, time_t utcNow) {
+  RtcCalDecision d = { false, cal.lastPpm, 0, cal.aging, intervalS, abs(offsetMs) >= RTC_WRITE_THRESHOLD_MS };
+  cal.lastOffsetMs = offsetMs;
+
+  if (!cal.baselineValid) {
+    cal.baselineValid = true;
+    cal.baselineUtc = utcNow;
+    cal.baselineOffsetMs = offsetMs;
+    return d;
+  }
+  if (utcNow - cal.baselineUtc < RTC_CAL_MIN_BASELINE_S) return d;
+
+  d.segmentClosed = true;
+  d.elapsedS = (int32_t)(utcNow - cal.baselineUtc);
+  d.ppm = rtcCalPpm(offsetMs, cal.baselineOffsetMs, d.elapsedS);
+  d.aging = rtcCalNextAging(cal.aging, d.ppm);
+  d.intervalS = rtcCalNextInterval(intervalS, d.ppm, offsetMs);
+  cal.lastPpm = d.ppm;
+
+  // BASELINE TOH DIMULAI ULANG: FASE DI LUAR TARGET (100-250 ms) IKUT DIPERBAIKI.
+  // TANPA INI SELISIH DI CELAH ITU TIDAK PERNAH DITULIS & INTERVAL TERTAHAN 1 JAM
+  if (abs(offsetMs) > RTC_TARGET_OFFSET_MS) d.rewriteRtc = true;
+
+  // SEGMEN BERIKUTNYA DIUKUR DENGAN AGING BARU
+  cal.baselineUtc = utcNow;
+  cal.baselineOffsetMs = offsetMs;
+  return d;
+}
+
+// PENGUKURAN DI TEPI REGISTER DETIK: rtcUnix BARU SAJA BERGANTI, tv = JAM SNTP (UTC)
+inline int32_t rtcOffsetAtEdge(uint32_t rtcUnix, int64_t tvSec, int32_t tvUsec, int32_t timezoneOffsetH) {
+  int64_t rtcMs = (int64_t)rtcUnix * 1000;
+  int64_t sysMs = (tvSec + (int64_t)timezoneOffsetH * 3600) * 1000 + tvUsec / 1000;
+  int64_t diff = rtcMs - sysMs;
+  if (diff > INT32_MAX) return INT32_MAX;
+  if (diff < INT32_MIN) return INT32_MIN;
+  return (int32_t)diff;
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * BALAPAN (HEDGE) PENYEDIA JADWAL HTTP
+ * Statistik per penyedia (histogram latensi + galat), urutan penyedia dari
+ * skornya, anggaran hedge, dan loop balapan di atas http_client.h: yang terbaik
+ * dimulai dulu, berikutnya dimulai bila yang berjalan belum menjawab dalam hedgeMs
+ * atau sudah gagal, jawaban valid pertama menang. Efek samping firmware (mutex,
+ * log, trace, validasi body) lewat hook; test/schedule_hedge_test.cpp membalap
+ * server stand-in dengan latensi & kegagalan yang disuntikkan.
+ */
+
+#ifndef JWS_SCHEDULE_HEDGE_H
+#define JWS_SCHEDULE_HEDGE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "http_client.h"
+
+#define SCHEDULE_HTTP_PROVIDERS 2          // HARUS <= HTTPC_CONN_SLOTS
+#define SCHEDULE_HTTP_TIMEOUT_MS 20000     // PER PERCOBAAN
+#define SCHEDULE_HEDGE_MIN_MS 500
+#define SCHEDULE_HEDGE_MAX_MS 5000
+#define SCHEDULE_HEDGE_DEFAULT_MS 2000     // PENYEDIA TANPA DATA LATENSI
+#define PROVIDER_LATENCY_BUCKETS 8
+#define PROVIDER_DECAY_AT 64               // HISTOGRAM DIPARUH AGAR URUTAN TETAP ADAPTIF
+
+static_assert(SCHEDULE_HTTP_PROVIDERS <= HTTPC_CONN_SLOTS, "setiap penyedia yang dibalap butuh slot koneksi");
+
+const uint16_t PROVIDER_BUCKET_MS[PROVIDER_LATENCY_BUCKETS - 1] = {
+  250, 500, 1000, 2000, 4000, 8000, 16000
+};
+
+enum ProviderError : uint8_t {
+  PROVIDER_ERR_NETWORK = 0,    // DNS, CONNECT, KONEKSI PUTUS, PROTOKOL
+  PROVIDER_ERR_TIMEOUT,
+  PROVIDER_ERR_HTTP,           // STATUS SELAIN 200
+  PROVIDER_ERR_INVALID,        // 200 TAPI WAKTU TIDAK LENGKAP / TIDAK VALID
+  PROVIDER_ERR_COUNT
+};
+
+const char *const PROVIDER_ERROR_NAMES[PROVIDER_ERR_COUNT] = {
+  "network", "timeout", "http", "invalid"
+};
+
+struct ProviderStats {
+  uint16_t latency[PROVIDER_LATENCY_BUCKETS];
+  uint16_t ok;
+  uint16_t errors[PROVIDER_ERR_COUNT];
+  uint32_t launched;           // SEUMUR BOOT, TIDAK DIPARUH
+  uint32_t hedged;             // DIMULAI SEBAGAI PEMBALAP KEDUA
+  uint32_t wins;
+  uint32_t lost;               // DIBATALKAN KARENA PENYEDIA LAIN MENANG
+  int16_t lastCode;
+};
+
+inline uint32_t providerLatencyTotal(const ProviderStats &st) {
+  uint32_t total = 0;
+  for (uint8_t b = 0; b < PROVIDER_LATENCY_BUCKETS; b++) total += st.latency[b];
+  return total;
+}
+
+inline uint32_t providerQuantileMs(const ProviderStats &st, uint8_t pct) {
+  uint32_t total = providerLatencyTotal(st);
+  if (total == 0) return 0;
+
+  uint32_t need = (total * pct + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < PROVIDER_LATENCY_BUCKETS - 1; b++) {
+    seen += st.latency[b];
+    if (seen >= need) return PROVIDER_BUCKET_MS[b];
+  }
+  return SCHEDULE_HTTP_TIMEOUT_MS;
+}
+
+inline uint32_t providerErrorTotal(const ProviderStats &st) {
+  uint32_t total = 0;
+  for (uint8_t e = 0; e < PROVIDER_ERR_COUNT; e++) total += st.errors[e];
+  return total;
+}
+
+// PERKIRAAN BIAYA: p90 DIBAGI PELUANG SUKSES (LAPLACE). LEBIH KECIL = LEBIH DULU
+inline uint32_t providerScore(const ProviderStats &st) {
+  uint32_t p90 = providerQuantileMs(st, 90);
+  if (p90 == 0) p90 = SCHEDULE_HEDGE_DEFAULT_MS;
+  return p90 * (st.ok + providerErrorTotal(st) + 2) / (st.ok + 1);
+}
+
+// SETIAP SAMPEL DIHITUNG: LATENSI (MENANG & KALAH BALAPAN) DAN GALAT. PENYEDIA
+// YANG SELALU KALAH HANYA MENGISI HISTOGRAM LATENSI - TANPA INI TIDAK PERNAH DIPARUH
+inline void providerDecay(ProviderStats &st) {
+  if (providerLatencyTotal(st) + providerErrorTotal(st) < PROVIDER_DECAY_AT) return;
+  for (uint8_t b = 0; b < PROVIDER_LATENCY_BUCKETS; b++) st.latency[b] /= 2;
+  for (uint8_t e = 0; e < PROVIDER_ERR_COUNT; e++) st.errors[e] /= 2;
+  st.ok /= 2;
+}
+
+inline void providerAddLatency(ProviderStats &st, uint32_t ms) {
+  uint8_t b = 0;
+  while (b < PROVIDER_LATENCY_BUCKETS - 1 && ms > PROVIDER_BUCKET_MS[b]) b++;
+  if (st.latency[b] < UINT16_MAX) st.latency[b]++;
+}
+
+// lost: KALAH BALAPAN. LATENSINYA DICATAT SEBAGAI BATAS BAWAH (SUDAH SELAMA
+// ITU TANPA JAWABAN) AGAR PENYEDIA LAMBAT TURUN URUTAN, TANPA DIHITUNG GALAT.
+inline void providerAccount(ProviderStats &st, int code, bool valid, bool lost, uint32_t ms) {
+  providerDecay(st);
+  if (lost) {
+    st.lost++;
+    providerAddLatency(st, ms);
+  } else if (code == 200 && valid) {
+    st.ok++;
+    st.wins++;
+    providerAddLatency(st, ms);
+  } else {
+    ProviderError kind = PROVIDER_ERR_NETWORK;
+    if (code == FETCH_ERR_TIMEOUT) kind = PROVIDER_ERR_TIMEOUT;
+    else if (code == 200) kind = PROVIDER_ERR_INVALID;
+    else if (code > 0) kind = PROVIDER_ERR_HTTP;
+    st.errors[kind]++;
+  }
+  if (!lost) st.lastCode = (int16_t)code;
+}
+
+// stats[i] == NULL = PENYEDIA NONAKTIF. URUT DARI SKOR TERKECIL, URUTAN TABEL
+// MEMUTUS SERI. ANGGARAN HEDGE = p90 PENYEDIA UTAMA: ~10% PERMINTAAN MEMICU BALAPAN
+inline uint8_t providerOrder(const ProviderStats *const *stats, uint8_t *order, uint32_t &hedgeMs) {
+  uint32_t score[SCHEDULE_HTTP_PROVIDERS];
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < SCHEDULE_HTTP_PROVIDERS; i++) {
+    if (stats[i] == NULL) continue;
+    score[i] = providerScore(*stats[i]);
+    order[count++] = i;
+  }
+
+  for (uint8_t i = 1; i < count; i++) {
+    uint8_t v = order[i];
+    int8_t j = i - 1;
+    while (j >= 0 && score[order[j]] > score[v]) {
+      order[j + 1] = order[j];
+      j--;
+    }
+    order[j + 1] = v;
+  }
+
+  hedgeMs = SCHEDULE_HEDGE_DEFAULT_MS;
+  uint32_t p90 = count > 0 ? providerQuantileMs(*stats[order[0]], 90) : 0;
+  if (p90 > 0) hedgeMs = p90;
+  if (hedgeMs < SCHEDULE_HEDGE_MIN_MS) hedgeMs = SCHEDULE_HEDGE_MIN_MS;
+  if (hedgeMs > SCHEDULE_HEDGE_MAX_MS) hedgeMs = SCHEDULE_HEDGE_MAX_MS;
+  return count;
+}
+
+// HOOK BALAPAN (SLOT = URUTAN DIMULAI, idx = INDEKS PENYEDIA):
+//   void tick()                                        AWAL SETIAP PUTARAN (WDT)
+//   bool superseded()                                  GENERASI DIGANTIKAN
+//   void launch(HttpFetch &f, uint8_t slot, uint8_t idx, bool hedge)  ISI f SEBELUM httpBegin
+//   bool finished(const HttpFetch &f, uint8_t slot, uint8_t idx, bool hedged)
+//        SETIAP FETCH SELESAI (TERMASUK DIBATALKAN); CATAT & VALIDASI, true = VALID
+//   void lost(const HttpFetch &f, uint8_t idx)         DIBATALKAN KARENA SLOT LAIN MENANG
+//   void won(uint8_t slot, uint8_t idx, bool hedged)
+// MENGEMBALIKAN 200 + winner BILA MENANG, SELAIN ITU KODE TERAKHIR
+// (FETCH_ERR_CANCELLED BILA GENERASI DIGANTIKAN).
+template <typename Hooks>
+int hedgeRace(HttpFetch *fetches, const uint8_t *order, uint8_t count, uint32_t hedgeMs, Hooks &h,
+              int8_t &winner) {
+  HttpFetch *active[SCHEDULE_HTTP_PROVIDERS];
+  bool recorded[SCHEDULE_HTTP_PROVIDERS] = {};
+  bool hedged[SCHEDULE_HTTP_PROVIDERS] = {};
+  uint8_t launched = 0;
+  uint32_t lastLaunchMs = 0;
+  int lastCode = FETCH_ERR_CONNECT;
+  winner = -1;
+
+  while (true) {
+    h.tick();
+
+    if (h.superseded()) {
+      for (uint8_t k = 0; k < launched; k++) httpAbort(fetches[k]);
+      return FETCH_ERR_CANCELLED;
+    }
+
+    bool anyActive = false;
+    for (uint8_t k = 0; k < launched; k++) anyActive |= httpFetchActive(fetches[k]);
+
+    // DIMULAI SAAT YANG LAIN MASIH BERJALAN = HEDGE; SETELAH YANG LAIN GAGAL = FAILOVER
+    if (launched < count && (!anyActive || httpcNowMs() - lastLaunchMs >= hedgeMs)) {
+      HttpFetch &f = fetches[launched];
+      hedged[launched] = anyActive;
+      h.launch(f, launched, order[launched], anyActive);
+      httpBegin(f);
+      active[launched] = &f;
+      launched++;
+      lastLaunchMs = httpcNowMs();
+      continue;
+    }
+
+    httpPoll(active, launched);
+
+    for (uint8_t k = 0; k < launched; k++) {
+      HttpFetch &f = fetches[k];
+      if (recorded[k] || httpFetchActive(f)) continue;
+      recorded[k] = true;
+
+      bool valid = h.finished(f, k, order[k], hedged[k]);
+      if (f.result == FETCH_ERR_CANCELLED) {
+        lastCode = f.result;
+        continue;
+      }
+      if (!valid) {
+        lastCode = (f.result == 200) ? FETCH_ERR_PROTOCOL : f.result;
+        continue;
+      }
+
+      // MENANG: SISANYA DIBATALKAN
+      for (uint8_t j = 0; j < launched; j++) {
+        if (j == k || !httpFetchActive(fetches[j])) continue;
+        httpAbort(fetches[j]);
+        recorded[j] = true;
+        h.lost(fetches[j], order[j]);
+      }
+      h.won(k, order[k], hedged[k]);
+      winner = (int8_t)k;
+      return 200;
+    }
+
+    bool pending = (launched < count);
+    for (uint8_t k = 0; k < launched; k++) pending |= httpFetchActive(fetches[k]);
+    if (!pending) return lastCode;
+  }
+}
+
+#endif
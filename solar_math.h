@@ -0,0 +1,334 @@
+/*
+ * MATEMATIKA MATAHARI & KERNEL JADWAL MASSAL
+ * Murni (tanpa FreeRTOS / Arduino) agar bisa diuji di host: test/solar_accuracy.cpp
+ * membandingkannya dengan referensi double selama 30 tahun untuk semua kota.
+ * Profil siklus (PERF_SCOPE) dipasang di pemanggil, bukan di sini.
+ */
+
+#ifndef JWS_SOLAR_MATH_H
+#define JWS_SOLAR_MATH_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================
+// MATEMATIKA MATAHARI: FLOAT + FIXED-POINT UNTUK FPU ESP32
+// FPU ESP32 HANYA SINGLE-PRECISION; double DIEMULASI SOFTWARE.
+// Sudut disimpan sebagai BAM (binary angle, 2^32 = 360 derajat) sehingga
+// reduksi sudut = overflow integer; sin/cos dari tabel constexpr di flash,
+// acos/atan dari polinomial minimax.
+// ============================================
+#ifndef SOLAR_FAST_MATH
+#define SOLAR_FAST_MATH 1              // 0 = sinf/cosf/acosf LIBM (PEMBANDING)
+#endif
+
+#define SIN_TABLE_BITS 10
+#define SIN_TABLE_SIZE (1 << SIN_TABLE_BITS)
+#define SIN_FRAC_BITS (32 - SIN_TABLE_BITS)
+
+constexpr double CT_PI = 3.14159265358979323846;
+constexpr float SOLAR_DEG_TO_RAD = (float)(CT_PI / 180.0);
+
+// DERET TAYLOR DI [-PI/2, PI/2], HANYA DIPAKAI SAAT KOMPILASI
+constexpr double ctSin(double x) {
+  if (x > CT_PI) return -ctSin(x - CT_PI);
+  if (x > CT_PI / 2) return ctSin(CT_PI - x);
+
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 14; n++) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+struct SinTable {
+  float v[SIN_TABLE_SIZE + 1];
+};
+
+constexpr SinTable makeSinTable() {
+  SinTable t{};
+  for (int i = 0; i <= SIN_TABLE_SIZE; i++) {
+    t.v[i] = (float)ctSin(2.0 * CT_PI * i / SIN_TABLE_SIZE);
+  }
+  return t;
+}
+
+// 4 KB DI FLASH; INTERPOLASI LINEAR -> GALAT <= (2PI/1024)^2 / 8 = 4.7e-6
+constexpr SinTable SIN_TABLE = makeSinTable();
+
+constexpr int64_t degToBam48(double deg) {
+  return (int64_t)(deg * (281474976710656.0 / 360.0));
+}
+
+inline uint32_t degToBam(float deg) {
+  return (uint32_t)(int32_t)lroundf(deg * (2147483648.0f / 180.0f));
+}
+
+inline uint32_t radToBam(float rad) {
+  return (uint32_t)(int32_t)lroundf(rad * (2147483648.0f / (float)CT_PI));
+}
+
+inline float bamSin(uint32_t a) {
+  uint32_t idx = a >> SIN_FRAC_BITS;
+  float frac = (a & ((1u << SIN_FRAC_BITS) - 1)) * (1.0f / (1u << SIN_FRAC_BITS));
+  return SIN_TABLE.v[idx] + (SIN_TABLE.v[idx + 1] - SIN_TABLE.v[idx]) * frac;
+}
+
+inline float bamCos(uint32_t a) {
+  return bamSin(a + 0x40000000u);
+}
+
+// ABRAMOWITZ & STEGUN 4.4.46, |GALAT| <= 2e-8 RAD
+inline float fastAcos(float x) {
+  bool negative = x < 0;
+  if (negative) x = -x;
+  if (x > 1.0f) x = 1.0f;
+
+  float p = -0.0012624911f;
+  p = p * x + 0.0066700901f;
+  p = p * x - 0.0170881256f;
+  p = p * x + 0.0308918810f;
+  p = p * x - 0.0501743046f;
+  p = p * x + 0.0889789874f;
+  p = p * x - 0.2145988016f;
+  p = p * x + 1.5707963050f;
+
+  float r = sqrtf(1.0f - x) * p;
+  return negative ? (float)CT_PI - r : r;
+}
+
+// MINIMAX atan DI [-1, 1], |GALAT| <= 1e-5 RAD
+inline float fastAtan2(float y, float x) {
+  float ax = fabsf(x);
+  float ay = fabsf(y);
+  bool swap = ay > ax;
+  float z = swap ? ax / ay : ay / (ax > 0 ? ax : 1e-30f);
+  float z2 = z * z;
+
+  float r = z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f +
+                 z2 * (-0.0851330f + z2 * 0.0208351f))));
+
+  if (swap) r = (float)CT_PI / 2 - r;
+  if (x < 0) r = (float)CT_PI - r;
+  return y < 0 ? -r : r;
+}
+
+#if SOLAR_FAST_MATH
+inline float solarSinDeg(float deg) { return bamSin(degToBam(deg)); }
+inline float solarCosDeg(float deg) { return bamCos(degToBam(deg)); }
+inline float solarSinRad(float rad) { return bamSin(radToBam(rad)); }
+inline float solarCosRad(float rad) { return bamCos(radToBam(rad)); }
+inline float solarAcos(float x)     { return fastAcos(x); }
+inline float solarAtan2(float y, float x) { return fastAtan2(y, x); }
+#else
+inline float solarSinDeg(float deg) { return sinf(deg * SOLAR_DEG_TO_RAD); }
+inline float solarCosDeg(float deg) { return cosf(deg * SOLAR_DEG_TO_RAD); }
+inline float solarSinRad(float rad) { return sinf(rad); }
+inline float solarCosRad(float rad) { return cosf(rad); }
+inline float solarAcos(float x)     { return acosf(fmaxf(-1.0f, fminf(1.0f, x))); }
+inline float solarAtan2(float y, float x) { return atan2f(y, x); }
+#endif
+
+// ============================================
+// JADWAL MASSAL: KERNEL MATAHARI SoA UNTUK BANYAK KOTA
+// Deklinasi & equation of time dihitung sekali per tanggal,
+// lalu setiap besaran dihitung per-array untuk satu batch kota.
+// ============================================
+#define BULK_BATCH_SIZE 16
+
+enum BulkTime {
+  BULK_IMSAK = 0,
+  BULK_SUBUH,
+  BULK_TERBIT,
+  BULK_ZUHUR,
+  BULK_ASHAR,
+  BULK_MAGHRIB,
+  BULK_ISYA,
+  BULK_TIME_COUNT
+};
+
+struct PrayerAngles {
+  float fajr;
+  float isha;                          // DERAJAT, ATAU 0 JIKA PAKAI ishaMinutes
+  float maghrib;                       // 0 = SAAT TERBENAM
+  float ishaMinutes;                   // UMM AL-QURA: MAGHRIB + 90 MENIT
+};
+
+struct SolarDay {
+  float sinDecl;
+  float cosDecl;
+  float decl;                          // RADIAN
+  float eqt;                           // JAM
+};
+
+struct CityBatch {
+  uint8_t count;
+  float lat[BULK_BATCH_SIZE];
+  float lon[BULK_BATCH_SIZE];
+  float tz[BULK_BATCH_SIZE];
+  float times[BULK_TIME_COUNT][BULK_BATCH_SIZE];  // JAM LOKAL
+};
+
+// SUDUT PER ID METODE ALADHAN (LIHAT DROPDOWN METODE DI WEB)
+inline PrayerAngles prayerAnglesFor(int methodId) {
+  switch (methodId) {
+    case 0:  return { 16.0f, 14.0f, 4.0f, 0 };     // SHIA ITHNA-ASHARI
+    case 1:  return { 18.0f, 18.0f, 0, 0 };        // KARACHI
+    case 2:  return { 15.0f, 15.0f, 0, 0 };        // ISNA
+    case 4:  return { 18.5f, 0, 0, 90.0f };        // UMM AL-QURA
+    case 5:  return { 19.5f, 17.5f, 0, 0 };        // MESIR
+    case 7:  return { 17.7f, 14.0f, 4.5f, 0 };     // TEHRAN
+    case 20: return { 20.0f, 18.0f, 0, 0 };        // KEMENAG
+    default: return { 18.0f, 17.0f, 0, 0 };        // MWL
+  }
+}
+
+inline float provinceTimezone(const char *province) {
+  if (strncmp(province, "Papua", 5) == 0 ||
+      strncmp(province, "Maluku", 6) == 0) {
+    return 9.0f;                                    // WIT
+  }
+  if (strncmp(province, "Sulawesi", 8) == 0 ||
+      strcmp(province, "Bali") == 0 ||
+      strcmp(province, "Gorontalo") == 0 ||
+      strncmp(province, "Nusa Tenggara", 13) == 0 ||
+      strcmp(province, "Kalimantan Selatan") == 0 ||
+      strcmp(province, "Kalimantan Timur") == 0 ||
+      strcmp(province, "Kalimantan Utara") == 0) {
+    return 8.0f;                                    // WITA
+  }
+  return 7.0f;                                      // WIB
+}
+
+inline void solarDayCompute(int y, int m, int d, SolarDay &sun) {
+  if (m <= 2) {
+    y -= 1;
+    m += 12;
+  }
+
+  // HARI SEJAK 2000-01-01 00:00 UTC, TANPA double
+  int32_t a = y / 100;
+  int32_t b = 2 - a + a / 4;
+  int32_t days = (1461 * (y + 4716)) / 4 + (306001 * (m + 1)) / 10000 + d + b - 1524 - 2451545;
+
+  // DIEVALUASI ~12:00 WIB (05:00 UTC); SELISIH JAM < 1 MENIT UNTUK SELURUH INDONESIA
+  int32_t hours = days * 24 + 5 - 12;
+  float D = hours / 24.0f;
+
+#if SOLAR_FAST_MATH
+  // ANOMALI & BUJUR RATA-RATA DALAM BAM 48-BIT: REDUKSI MODULO 360 EKSAK
+  constexpr int64_t G0 = degToBam48(357.529);
+  constexpr int64_t G_RATE = degToBam48(0.98560028 / 24.0);
+  constexpr int64_t Q0 = degToBam48(280.459);
+  constexpr int64_t Q_RATE = degToBam48(0.98564736 / 24.0);
+
+  uint32_t g = (uint32_t)((uint64_t)(G0 + G_RATE * hours) >> 16);
+  uint32_t q = (uint32_t)((uint64_t)(Q0 + Q_RATE * hours) >> 16);
+  uint32_t L = q + degToBam(1.915f * bamSin(g) + 0.020f * bamSin(g << 1));
+
+  float qHours = q * (24.0f / 4294967296.0f);
+  float sinL = bamSin(L);
+  float cosL = bamCos(L);
+#else
+  float g = fmodf(357.529f + 0.98560028f * D, 360.0f);
+  float q = fmodf(280.459f + 0.98564736f * D, 360.0f);
+  float L = q + 1.915f * solarSinDeg(g) + 0.020f * solarSinDeg(2 * g);
+
+  float qHours = q / 15.0f;
+  float sinL = solarSinDeg(L);
+  float cosL = solarCosDeg(L);
+#endif
+
+  float e = 23.439f - 0.00000036f * D;
+  float sinE = solarSinDeg(e);
+  float cosE = solarCosDeg(e);
+
+  float ra = solarAtan2(cosE * sinL, cosL) * (12.0f / (float)CT_PI);
+  if (ra < 0) ra += 24.0f;
+
+  float eqt = qHours - ra;
+  eqt -= 24.0f * floorf((eqt + 12.0f) / 24.0f);
+
+  sun.sinDecl = sinE * sinL;
+  sun.decl = (float)CT_PI / 2 - solarAcos(sun.sinDecl);
+  sun.cosDecl = solarCosRad(sun.decl);
+  sun.eqt = eqt;
+}
+
+// SETIAP LOOP MENGERJAKAN SATU BESARAN UNTUK SEMUA KOTA DI BATCH
+inline void solarKernelBatch(const SolarDay &sun, const PrayerAngles &angles, CityBatch &batch) {
+  const float RAD_TO_HOURS = 12.0f / (float)CT_PI;
+  const uint8_t n = batch.count;
+
+  float sinLat[BULK_BATCH_SIZE];
+  float cosLat[BULK_BATCH_SIZE];
+  float inv[BULK_BATCH_SIZE];
+
+  for (uint8_t i = 0; i < n; i++) {
+    sinLat[i] = solarSinDeg(batch.lat[i]);
+    cosLat[i] = solarCosDeg(batch.lat[i]);
+    inv[i] = 1.0f / (cosLat[i] * sun.cosDecl);
+    batch.times[BULK_ZUHUR][i] = 12.0f + batch.tz[i] - batch.lon[i] / 15.0f - sun.eqt;
+  }
+
+  // HOUR ANGLE UNTUK MATAHARI PADA KETINGGIAN -depression
+  auto hourAngle = [&](float depression, float *out) {
+    float s = -solarSinDeg(depression);
+    for (uint8_t i = 0; i < n; i++) {
+      out[i] = solarAcos((s - sinLat[i] * sun.sinDecl) * inv[i]) * RAD_TO_HOURS;
+    }
+  };
+
+  float ha[BULK_BATCH_SIZE];
+
+  hourAngle(angles.fajr, ha);
+  for (uint8_t i = 0; i < n; i++) {
+    batch.times[BULK_SUBUH][i] = batch.times[BULK_ZUHUR][i] - ha[i];
+    batch.times[BULK_IMSAK][i] = batch.times[BULK_SUBUH][i] - 10.0f / 60.0f;
+  }
+
+  hourAngle(0.833f, ha);
+  for (uint8_t i = 0; i < n; i++) {
+    batch.times[BULK_TERBIT][i] = batch.times[BULK_ZUHUR][i] - ha[i];
+    batch.times[BULK_MAGHRIB][i] = batch.times[BULK_ZUHUR][i] + ha[i];
+  }
+
+  if (angles.maghrib > 0) {
+    hourAngle(angles.maghrib, ha);
+    for (uint8_t i = 0; i < n; i++) {
+      batch.times[BULK_MAGHRIB][i] = batch.times[BULK_ZUHUR][i] + ha[i];
+    }
+  }
+
+  if (angles.ishaMinutes > 0) {
+    for (uint8_t i = 0; i < n; i++) {
+      batch.times[BULK_ISYA][i] = batch.times[BULK_MAGHRIB][i] + angles.ishaMinutes / 60.0f;
+    }
+  } else {
+    hourAngle(angles.isha, ha);
+    for (uint8_t i = 0; i < n; i++) {
+      batch.times[BULK_ISYA][i] = batch.times[BULK_ZUHUR][i] + ha[i];
+    }
+  }
+
+  // ASHAR MAZHAB SYAFI'I: PANJANG BAYANGAN = 1 + tan|lat - decl|
+  for (uint8_t i = 0; i < n; i++) {
+    float diff = fabsf(batch.lat[i] * SOLAR_DEG_TO_RAD - sun.decl);
+    float x = 1.0f + solarSinRad(diff) / solarCosRad(diff);
+    float s = 1.0f / sqrtf(1.0f + x * x);
+    batch.times[BULK_ASHAR][i] = batch.times[BULK_ZUHUR][i] +
+                                 solarAcos((s - sinLat[i] * sun.sinDecl) * inv[i]) * RAD_TO_HOURS;
+  }
+}
+
+inline void formatBulkTime(float hours, char *out) {
+  int minutes = (int)lroundf(hours * 60.0f);
+  minutes = ((minutes % 1440) + 1440) % 1440;
+  sprintf(out, "%02d:%02d", minutes / 60, minutes % 60);
+}
+
+#endif
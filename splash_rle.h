@@ -0,0 +1,168 @@
+/*
+ * SNAPSHOT LAYAR BOOT: RLE RGB565 (PACKBITS 16-BIT) TANPA HARDWARE
+ * Encoder dijalankan per strip flush LVGL (selebar layar, berurutan dari atas),
+ * decoder membaca file dan mendorong piksel ke TFT. Penyimpanan keluaran
+ * (blok RAM), pembacaan file dan TFT lewat parameter template; jws.ino memakai
+ * LittleFS + TFT_eSPI, test/splash_rle_test.cpp memakai buffer 320x240 di RAM.
+ */
+
+#ifndef JWS_SPLASH_RLE_H
+#define JWS_SPLASH_RLE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define SPLASH_MAGIC 0x3153574A        // "JWS1"
+#define SPLASH_MAX_BYTES 65536         // LEBIH BESAR = TIDAK LAYAK DIKOMPRES
+#define SPLASH_MAX_PACKET 128          // PIKSEL PER PAKET (RUN ATAU LITERAL)
+
+// Format: header, lalu paket PackBits 16-bit:
+//   b & 0x80 -> ulangi 1 piksel sebanyak (b & 0x7F) + 1
+//   lainnya  -> (b + 1) piksel literal
+struct SplashHeader {
+  uint32_t magic;
+  uint16_t width;
+  uint16_t height;
+};
+
+struct SplashEncoder {
+  bool active;
+  bool failed;
+  uint16_t width;
+  uint16_t height;
+  uint16_t nextRow;
+  uint16_t runColor;
+  uint16_t runCount;
+  uint16_t literal[SPLASH_MAX_PACKET];
+  uint8_t literalCount;
+  uint32_t pixels;
+  uint32_t bytes;
+};
+
+// ============================================
+// ENCODER. Sink: bool put(const uint8_t *data, size_t len, uint32_t offset)
+// offset = POSISI BYTE DI FILE; false = GAGAL (MISAL MALLOC)
+// ============================================
+template <typename Sink>
+void splashPutBytes(SplashEncoder &enc, Sink &out, const uint8_t *data, size_t len) {
+  if (enc.failed) return;
+
+  if (enc.bytes + len > SPLASH_MAX_BYTES || !out.put(data, len, enc.bytes)) {
+    enc.failed = true;
+    return;
+  }
+  enc.bytes += len;
+}
+
+template <typename Sink>
+void splashFlushLiteral(SplashEncoder &enc, Sink &out) {
+  if (enc.literalCount == 0) return;
+
+  uint8_t header = enc.literalCount - 1;
+  splashPutBytes(enc, out, &header, 1);
+  splashPutBytes(enc, out, (const uint8_t *)enc.literal, enc.literalCount * sizeof(uint16_t));
+  enc.literalCount = 0;
+}
+
+template <typename Sink>
+void splashFlushRun(SplashEncoder &enc, Sink &out) {
+  if (enc.runCount >= 2) {
+    splashFlushLiteral(enc, out);
+    uint8_t header = 0x80 | (enc.runCount - 1);
+    splashPutBytes(enc, out, &header, 1);
+    splashPutBytes(enc, out, (const uint8_t *)&enc.runColor, sizeof(uint16_t));
+  } else if (enc.runCount == 1) {
+    enc.literal[enc.literalCount++] = enc.runColor;
+    if (enc.literalCount == SPLASH_MAX_PACKET) splashFlushLiteral(enc, out);
+  }
+
+  enc.runCount = 0;
+}
+
+// RESET STATE DAN TULIS HEADER
+template <typename Sink>
+void splashEncodeBegin(SplashEncoder &enc, Sink &out, uint16_t width, uint16_t height) {
+  memset(&enc, 0, sizeof(enc));
+  enc.width = width;
+  enc.height = height;
+  SplashHeader header = { SPLASH_MAGIC, width, height };
+  splashPutBytes(enc, out, (const uint8_t *)&header, sizeof(header));
+}
+
+// HANYA STRIP SELEBAR LAYAR BERURUTAN DARI ATAS KE BAWAH; SELAIN ITU failed
+template <typename Sink>
+void splashEncodeArea(SplashEncoder &enc, Sink &out, int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                      const uint16_t *pixels) {
+  if (enc.failed) return;
+
+  if (x1 != 0 || x2 != enc.width - 1 || y1 != enc.nextRow || y2 < y1 || y2 >= enc.height) {
+    enc.failed = true;
+    return;
+  }
+
+  uint32_t count = (uint32_t)enc.width * (y2 - y1 + 1);
+  for (uint32_t i = 0; i < count; i++) {
+    uint16_t px = pixels[i];
+    if (enc.runCount > 0 && px == enc.runColor && enc.runCount < SPLASH_MAX_PACKET) {
+      enc.runCount++;
+    } else {
+      splashFlushRun(enc, out);
+      enc.runColor = px;
+      enc.runCount = 1;
+    }
+  }
+
+  enc.pixels += count;
+  enc.nextRow = y2 + 1;
+}
+
+// FLUSH SISA RUN/LITERAL. true = SEMUA PIKSEL TER-ENCODE DALAM BATAS UKURAN
+template <typename Sink>
+bool splashEncodeEnd(SplashEncoder &enc, Sink &out) {
+  splashFlushRun(enc, out);
+  splashFlushLiteral(enc, out);
+  return !enc.failed && enc.pixels == (uint32_t)enc.width * enc.height;
+}
+
+// ============================================
+// DECODER. Reader: bool read(uint8_t *dst, size_t n) - false = FILE HABIS
+// Pixels: void push(const uint16_t *pixels, uint16_t count)
+// ============================================
+template <typename Reader>
+bool splashReadHeader(Reader &r, uint16_t width, uint16_t height) {
+  SplashHeader header;
+  return r.read((uint8_t *)&header, sizeof(header)) &&
+         header.magic == SPLASH_MAGIC &&
+         header.width == width &&
+         header.height == height;
+}
+
+// MENGEMBALIKAN JUMLAH PIKSEL YANG DIDORONG; < total = FILE TERPOTONG ATAU
+// PAKET MELEWATI AKHIR LAYAR (PAKET ITU TIDAK DIDORONG)
+template <typename Reader, typename Pixels>
+uint32_t splashDecodePixels(Reader &r, uint32_t total, Pixels &px) {
+  uint32_t drawn = 0;
+  uint16_t pixels[SPLASH_MAX_PACKET];
+
+  while (drawn < total) {
+    uint8_t packet;
+    if (!r.read(&packet, 1)) break;
+
+    uint16_t count = (packet & 0x7F) + 1;
+    if (drawn + count > total) break;
+
+    if (packet & 0x80) {
+      uint16_t color;
+      if (!r.read((uint8_t *)&color, sizeof(color))) break;
+      for (uint16_t i = 0; i < count; i++) pixels[i] = color;
+    } else {
+      if (!r.read((uint8_t *)pixels, count * sizeof(uint16_t))) break;
+    }
+
+    px.push(pixels, count);
+    drawn += count;
+  }
+  return drawn;
+}
+
+#endif
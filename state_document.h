@@ -0,0 +1,79 @@
+/*
+ * DOKUMEN STATE /api/v2/state
+ * Pemformatan murni (snprintf ke buffer pemanggil) agar bisa diukur di host;
+ * jws.ino mengisi StateDocFields dari konfigurasi di bawah settingsMutex.
+ */
+
+#ifndef JWS_STATE_DOCUMENT_H
+#define JWS_STATE_DOCUMENT_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define STATE_DOC_TIMES 7              // URUTAN ENUM Prayer
+#define STATE_DOC_PATTERNS 8           // 7 WAKTU + ALARM (BUZZER_SLOT_*)
+
+struct StateDocFields {
+  uint32_t version;
+  const char *routerSSID;
+  const char *routerPassword;
+  const char *apSSID;
+  const char *apPassword;
+  const char *apIP;
+  const char *apGateway;
+  const char *apSubnet;
+  int timezoneOffset;
+  int methodId;
+  const char *methodName;
+  const char *selectedCity;
+  const char *latitude;
+  const char *longitude;
+  int tune[STATE_DOC_TIMES];
+  const char *times[STATE_DOC_TIMES];
+  bool buzzer[STATE_DOC_TIMES];
+  bool alarmEnabled;
+  const char *alarmTime;
+  int volume;
+  const char *patterns[STATE_DOC_PATTERNS];
+};
+
+// TANPA '}' PENUTUP: isLocalAP DITAMBAHKAN PER KLIEN. HASIL = snprintf
+inline int formatStateDocument(char *buf, size_t size, const StateDocFields &s) {
+  auto b = [](bool v) { return v ? "true" : "false"; };
+
+  return snprintf(buf, size,
+    "{\"version\":%lu,"
+    "\"wifi\":{\"routerSSID\":\"%s\",\"routerPassword\":\"%s\","
+      "\"apSSID\":\"%s\",\"apPassword\":\"%s\","
+      "\"apIP\":\"%s\",\"apGateway\":\"%s\",\"apSubnet\":\"%s\"},"
+    "\"timezone\":{\"offset\":%d},"
+    "\"method\":{\"methodId\":%d,\"methodName\":\"%s\"},"
+    "\"city\":{\"selectedCity\":\"%s\",\"selectedCityApi\":\"%s\","
+      "\"latitude\":\"%s\",\"longitude\":\"%s\",\"hasSelection\":%s,"
+      "\"tune\":{\"imsak\":%d,\"subuh\":%d,\"terbit\":%d,"
+      "\"zuhur\":%d,\"ashar\":%d,\"maghrib\":%d,\"isya\":%d}},"
+    "\"prayerTimes\":{\"imsak\":\"%s\",\"subuh\":\"%s\",\"terbit\":\"%s\","
+      "\"zuhur\":\"%s\",\"ashar\":\"%s\",\"maghrib\":\"%s\",\"isya\":\"%s\"},"
+    "\"buzzer\":{\"imsak\":%s,\"subuh\":%s,\"terbit\":%s,\"zuhur\":%s,"
+      "\"ashar\":%s,\"maghrib\":%s,\"isya\":%s,"
+      "\"alarm\":%s,\"alarmTime\":\"%s\",\"volume\":%d,"
+      "\"patterns\":{\"imsak\":\"%s\",\"subuh\":\"%s\",\"terbit\":\"%s\",\"zuhur\":\"%s\","
+      "\"ashar\":\"%s\",\"maghrib\":\"%s\",\"isya\":\"%s\",\"alarm\":\"%s\"}},"
+    "\"alarm\":{\"alarmTime\":\"%s\",\"alarmEnabled\":%s}",
+    (unsigned long)s.version,
+    s.routerSSID, s.routerPassword, s.apSSID, s.apPassword,
+    s.apIP, s.apGateway, s.apSubnet,
+    s.timezoneOffset,
+    s.methodId, s.methodName,
+    s.selectedCity, s.selectedCity, s.latitude, s.longitude, b(s.selectedCity[0] != '\0'),
+    s.tune[0], s.tune[1], s.tune[2], s.tune[3], s.tune[4], s.tune[5], s.tune[6],
+    s.times[0], s.times[1], s.times[2], s.times[3], s.times[4], s.times[5], s.times[6],
+    b(s.buzzer[0]), b(s.buzzer[1]), b(s.buzzer[2]), b(s.buzzer[3]),
+    b(s.buzzer[4]), b(s.buzzer[5]), b(s.buzzer[6]),
+    b(s.alarmEnabled), s.alarmTime, s.volume,
+    s.patterns[0], s.patterns[1], s.patterns[2], s.patterns[3],
+    s.patterns[4], s.patterns[5], s.patterns[6], s.patterns[7],
+    s.alarmTime, b(s.alarmEnabled));
+}
+
+#endif
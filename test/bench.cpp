@@ -0,0 +1,300 @@
+/*
+ * BENCHMARK HOST JALUR PANAS FIRMWARE
+ * Memanggil header yang sama dengan jws.ino (tanpa shim tingkah laku):
+ * parseMinuteOfDay, solarDayCompute/solarKernelBatch, formatStateDocument,
+ * jalur sentuh my_touchpad_read + hit-test zona adzan, bulkRenderCity, routeLookup.
+ *
+ *   build/bench [--out FILE.json] [--baseline bench_baseline.json] [--tolerance 1.5]
+ *
+ * Hasil = median ns/op dan siklus/op dari BENCH_REPEATS putaran. Dengan --baseline,
+ * setiap kasus dibandingkan dan exit 1 jika ada yang lebih lambat dari toleransi.
+ * Baseline spesifik mesin: buat ulang dengan `make bench-baseline` di mesin yang sama.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "solar_math.h"
+#include "bulk_schedule.h"
+#include "route_table.h"
+#include "time_format.h"
+#include "touch_math.h"
+#include "state_document.h"
+#include "host/cycles.h"
+
+#define BENCH_REPEATS 7
+#define BENCH_MIN_NS 20000000ULL       // 20 ms PER PUTARAN
+
+struct BenchCase {
+  const char *name;
+  void (*fn)(uint64_t iters);
+};
+
+struct BenchResult {
+  std::string name;
+  double ns;
+  double cycles;
+};
+
+// ============================================
+// KASUS
+// ============================================
+static const char *TIMES[] = { "04:21", "04:31", "05:47", "11:58", "15:14", "17:59", "19:12", "24:00", "7:5" };
+
+static void benchParseMinute(uint64_t iters) {
+  int sum = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    const char *t = TIMES[i % (sizeof(TIMES) / sizeof(TIMES[0]))];
+    hostKeep(t);
+    sum += parseMinuteOfDay(t);
+  }
+  hostKeep(sum);
+}
+
+static void benchSolarDay(uint64_t iters) {
+  for (uint64_t i = 0; i < iters; i++) {
+    SolarDay sun;
+    solarDayCompute(2025, 1 + (int)(i % 12), 1 + (int)(i % 28), sun);
+    hostKeep(sun);
+  }
+}
+
+static CityBatch makeBatch() {
+  CityBatch batch;
+  batch.count = BULK_BATCH_SIZE;
+  for (int i = 0; i < BULK_BATCH_SIZE; i++) {
+    batch.lat[i] = -10.0f + i * 1.1f;
+    batch.lon[i] = 95.0f + i * 2.5f;
+    batch.tz[i] = 7.0f + (i % 3);
+  }
+  return batch;
+}
+
+// PER BATCH 16 KOTA
+static void benchSolarKernel(uint64_t iters) {
+  SolarDay sun;
+  solarDayCompute(2025, 6, 21, sun);
+  PrayerAngles angles = prayerAnglesFor(20);
+  CityBatch batch = makeBatch();
+  for (uint64_t i = 0; i < iters; i++) {
+    hostKeep(sun);
+    solarKernelBatch(sun, angles, batch);
+    hostKeep(batch);
+  }
+}
+
+static void benchStateDocument(uint64_t iters) {
+  StateDocFields s = {};
+  s.version = 42;
+  s.routerSSID = "RumahKu-5G";
+  s.routerPassword = "rahasia123";
+  s.apSSID = "JWS-Masjid";
+  s.apPassword = "12345678";
+  s.apIP = "192.168.4.1";
+  s.apGateway = "192.168.4.1";
+  s.apSubnet = "255.255.255.0";
+  s.timezoneOffset = 7;
+  s.methodId = 20;
+  s.methodName = "Kementerian Agama Republik Indonesia";
+  s.selectedCity = "Kota Bandung";
+  s.latitude = "-6.9218";
+  s.longitude = "107.6071";
+  const char *times[] = { "04:21", "04:31", "05:47", "11:58", "15:14", "17:59", "19:12" };
+  for (int i = 0; i < STATE_DOC_TIMES; i++) {
+    s.tune[i] = i - 3;
+    s.times[i] = times[i];
+    s.buzzer[i] = i % 2;
+  }
+  s.alarmEnabled = true;
+  s.alarmTime = "03:30";
+  s.volume = 80;
+  for (int i = 0; i < STATE_DOC_PATTERNS; i++) s.patterns[i] = "double";
+
+  static char buf[2048];
+  int len = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    s.version = (uint32_t)i;
+    len += formatStateDocument(buf, sizeof(buf), s);
+    hostKeep(buf);
+  }
+  hostKeep(len);
+}
+
+// touchTask: KALIBRASI + publishTouch; LVGL: my_touchpad_read; handleTouchPress: HIT-TEST
+static void benchTouch(uint64_t iters) {
+  const TouchCalibration cal = {
+    (320 << 16) / (3700 - 370), 0, -((320 << 16) / (3700 - 370)) * 370,
+    0, (240 << 16) / (3600 - 400), -((240 << 16) / (3600 - 400)) * 400,
+    true
+  };
+  uint32_t slot = 0;
+  bool lastPressed = false;
+  int hits = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    int16_t rx = (int16_t)(370 + (i * 37) % 3330);
+    int16_t ry = (int16_t)(400 + (i * 53) % 3200);
+    hostKeep(rx);
+    int16_t x, y;
+    touchCalibrationApply(cal, rx, ry, 320, 240, x, y);
+    slot = touchSlotPack(slot, (i & 7) != 0, x, y);
+
+    bool pressed = (slot & TOUCH_SLOT_PRESSED) != 0;
+    int16_t px = TOUCH_SLOT_X(slot);
+    int16_t py = TOUCH_SLOT_Y(slot);
+    if (pressed && !lastPressed) {
+      for (int p = 0; p < PRAYER_TOUCH_ZONE_COUNT; p++) {
+        if (touchZoneHit(PRAYER_TOUCH_ZONES[p], px, py)) {
+          hits += p;
+          break;
+        }
+      }
+    }
+    lastPressed = pressed;
+  }
+  hostKeep(hits);
+}
+
+static void benchBulkRecord(uint64_t iters) {
+  SolarDay sun;
+  solarDayCompute(2025, 6, 21, sun);
+  CityBatch batch = makeBatch();
+  solarKernelBatch(sun, prayerAnglesFor(20), batch);
+  static char out[BULK_RECORD_MAX];
+  size_t total = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    total += bulkRenderCity(out, sizeof(out), false, true, "Kota \"Bandung\"", batch, (uint8_t)(i % BULK_BATCH_SIZE));
+    hostKeep(out);
+  }
+  hostKeep(total);
+}
+
+static void benchRouteLookup(uint64_t iters) {
+  int sum = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    const char *path = i % 8 == 7 ? "/favicon.ico" : ROUTE_PATHS[i % ROUTE_COUNT];
+    hostKeep(path);
+    sum += routeLookup(path);
+  }
+  hostKeep(sum);
+}
+
+static const BenchCase CASES[] = {
+  { "parseMinuteOfDay", benchParseMinute },
+  { "solarDayCompute", benchSolarDay },
+  { "solarKernelBatch16", benchSolarKernel },
+  { "formatStateDocument", benchStateDocument },
+  { "touchReadHitTest", benchTouch },
+  { "bulkRenderCity", benchBulkRecord },
+  { "routeLookup", benchRouteLookup },
+};
+
+// ============================================
+// PELARI
+// ============================================
+static uint64_t nowNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static BenchResult runCase(const BenchCase &c) {
+  uint64_t iters = 1;
+  while (true) {
+    uint64_t start = nowNs();
+    c.fn(iters);
+    if (nowNs() - start >= BENCH_MIN_NS / 4 || iters >= (1ULL << 34)) break;
+    iters *= 2;
+  }
+  iters *= 4;
+
+  std::vector<double> ns, cycles;
+  for (int r = 0; r < BENCH_REPEATS; r++) {
+    uint64_t t0 = nowNs();
+    uint64_t c0 = hostCycles();
+    c.fn(iters);
+    cycles.push_back((double)(hostCycles() - c0) / iters);
+    ns.push_back((double)(nowNs() - t0) / iters);
+  }
+  std::sort(ns.begin(), ns.end());
+  std::sort(cycles.begin(), cycles.end());
+  return { c.name, ns[BENCH_REPEATS / 2], cycles[BENCH_REPEATS / 2] };
+}
+
+static bool writeJson(const char *path, const std::vector<BenchResult> &results) {
+  FILE *f = fopen(path, "w");
+  if (!f) return false;
+  fprintf(f, "{\n  \"unit\": \"ns/op\",\n  \"cycleUnit\": \"%s\",\n  \"results\": {\n", HOST_CYCLE_UNIT);
+  for (size_t i = 0; i < results.size(); i++) {
+    fprintf(f, "    \"%s\": {\"ns\": %.3f, \"cycles\": %.1f}%s\n", results[i].name.c_str(),
+            results[i].ns, results[i].cycles, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(f, "  }\n}\n");
+  fclose(f);
+  return true;
+}
+
+// FORMAT YANG DITULIS writeJson: SATU KASUS PER BARIS
+static std::vector<BenchResult> readJson(const char *path) {
+  std::vector<BenchResult> out;
+  FILE *f = fopen(path, "r");
+  if (!f) return out;
+  char line[256];
+  while (fgets(line, sizeof(line), f)) {
+    char name[64];
+    double ns, cycles;
+    if (sscanf(line, " \"%63[^\"]\": {\"ns\": %lf, \"cycles\": %lf}", name, &ns, &cycles) == 3) {
+      out.push_back({ name, ns, cycles });
+    }
+  }
+  fclose(f);
+  return out;
+}
+
+int main(int argc, char **argv) {
+  const char *outPath = nullptr;
+  const char *baselinePath = nullptr;
+  double tolerance = 1.5;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--out") == 0) outPath = argv[i + 1];
+    else if (strcmp(argv[i], "--baseline") == 0) baselinePath = argv[i + 1];
+    else if (strcmp(argv[i], "--tolerance") == 0) tolerance = atof(argv[i + 1]);
+  }
+
+  std::vector<BenchResult> baseline;
+  if (baselinePath) {
+    baseline = readJson(baselinePath);
+    if (baseline.empty()) fprintf(stderr, "BASELINE %s TIDAK TERBACA - HANYA MENGUKUR\n", baselinePath);
+  }
+
+  std::vector<BenchResult> results;
+  int regressions = 0;
+  printf("%-22s %12s %12s %12s\n", "kasus", "ns/op", HOST_CYCLE_UNIT "/op", "vs baseline");
+  for (const BenchCase &c : CASES) {
+    BenchResult r = runCase(c);
+    results.push_back(r);
+
+    char cmp[32] = "-";
+    for (const BenchResult &b : baseline) {
+      if (b.name != r.name || b.ns <= 0) continue;
+      double ratio = r.ns / b.ns;
+      bool slow = ratio > tolerance;
+      regressions += slow;
+      snprintf(cmp, sizeof(cmp), "%.2fx%s", ratio, slow ? " LAMBAT" : "");
+    }
+    printf("%-22s %12.2f %12.1f %12s\n", r.name.c_str(), r.ns, r.cycles, cmp);
+  }
+
+  if (outPath && !writeJson(outPath, results)) {
+    fprintf(stderr, "GAGAL MENULIS %s\n", outPath);
+    return 2;
+  }
+  if (regressions) {
+    printf("GAGAL: %d kasus lebih lambat dari %.2fx baseline\n", regressions, tolerance);
+    return 1;
+  }
+  return 0;
+}
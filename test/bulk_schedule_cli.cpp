@@ -0,0 +1,122 @@
+/*
+ * CLI HOST UNTUK /api/schedule/bulk
+ * Memakai solar_math.h + bulk_schedule.h yang sama dengan firmware, jadi output
+ * bisa dibandingkan langsung dengan respons perangkat.
+ *
+ *   build/bulk_schedule_cli [--cities ../data/cities.json] [--date YYYY-MM-DD]
+ *                           [--method 20] [--province "Jawa Barat"] [--format json|csv]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+#include "bulk_schedule.h"
+#include "host/cities.h"
+#include "host/cycles.h"
+
+static void usage() {
+  fprintf(stderr, "usage: bulk_schedule_cli [--cities FILE] [--date YYYY-MM-DD] [--method N] "
+                  "[--province NAMA] [--format json|csv]\n");
+}
+
+int main(int argc, char **argv) {
+  const char *path = "../data/cities.json";
+  const char *province = "";
+  int methodId = 20;
+  bool csv = false;
+
+  time_t now = time(nullptr);
+  struct tm tmNow;
+  localtime_r(&now, &tmNow);
+  int y = tmNow.tm_year + 1900, m = tmNow.tm_mon + 1, d = tmNow.tm_mday;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (strcmp(arg, "--cities") == 0) {
+      path = value;
+    } else if (strcmp(arg, "--date") == 0) {
+      if (sscanf(value, "%d-%d-%d", &y, &m, &d) != 3 ||
+          m < 1 || m > 12 || d < 1 || d > 31 || y < 2000 || y > 2100) {
+        fprintf(stderr, "Invalid date, use YYYY-MM-DD\n");
+        return 2;
+      }
+    } else if (strcmp(arg, "--method") == 0) {
+      methodId = atoi(value);
+    } else if (strcmp(arg, "--province") == 0) {
+      province = value;
+    } else if (strcmp(arg, "--format") == 0) {
+      csv = strcmp(value, "csv") == 0;
+    } else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+
+  std::vector<HostCity> cities = hostLoadCities(path);
+  if (cities.empty()) {
+    fprintf(stderr, "Cannot read %s\n", path);
+    return 1;
+  }
+
+  char date[11];
+  snprintf(date, sizeof(date), "%04d-%02d-%02d", y, m, d);
+  PrayerAngles angles = prayerAnglesFor(methodId);
+
+  SolarDay sun;
+  uint64_t cycles = hostCycles();
+  solarDayCompute(y, m, d, sun);
+  uint32_t dayCycles = (uint32_t)(hostCycles() - cycles);
+
+  char out[BULK_RECORD_MAX];
+  fputs(bulkRenderHeader(out, sizeof(out), csv, date) ? out : "", stdout);
+
+  uint16_t count = 0;
+  uint64_t kernelCycles = 0;
+  size_t next = 0;
+  while (next < cities.size()) {
+    CityBatch batch;
+    char name[BULK_BATCH_SIZE][BULK_NAME_LEN];
+    batch.count = 0;
+    for (; next < cities.size() && batch.count < BULK_BATCH_SIZE; next++) {
+      const HostCity &city = cities[next];
+      if (*province && strcasecmp(province, city.province.c_str()) != 0) continue;
+      uint8_t i = batch.count++;
+      bulkCopyName(name[i], city.display.c_str(), BULK_NAME_LEN);
+      batch.lat[i] = (float)city.lat;
+      batch.lon[i] = (float)city.lon;
+      batch.tz[i] = provinceTimezone(city.province.c_str());
+    }
+    if (batch.count == 0) break;
+
+    cycles = hostCycles();
+    solarKernelBatch(sun, angles, batch);
+    kernelCycles += hostCycles() - cycles;
+
+    for (uint8_t i = 0; i < batch.count; i++) {
+      if (!bulkRenderCity(out, sizeof(out), csv, count > 0, name[i], batch, i)) {
+        fprintf(stderr, "Record %u does not fit BULK_RECORD_MAX\n", count);
+        return 1;
+      }
+      fputs(out, stdout);
+      count++;
+    }
+  }
+
+  // kernelUs/citiesPerSec HANYA DIUKUR DI PERANGKAT (micros); DI HOST 0
+  if (bulkRenderFooter(out, sizeof(out), csv, count, dayCycles, (uint32_t)kernelCycles, 0)) {
+    fputs(out, stdout);
+  }
+  if (!csv) fputc('\n', stdout);
+  return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * UJI bulk_schedule.h: POTONG NAMA AMAN UTF-8, ESCAPE JSON/CSV, BATAS REKAMAN,
+ * LALU BENCHMARK SKALAR (1 KOTA PER PANGGILAN) VS BATCH 16 KOTA.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "bulk_schedule.h"
+#include "host/check.h"
+#include "host/cities.h"
+#include "host/cycles.h"
+
+static void testCopyName() {
+  char name[BULK_NAME_LEN];
+  CHECK(bulkCopyName(name, "Kota Bogor", sizeof(name)) == 10);
+  CHECK_STR(name, "Kota Bogor");
+
+  // "é" = C3 A9 TEPAT DI BATAS: HARUS DIBUANG UTUH, BUKAN SETENGAH
+  char small[6];
+  bulkCopyName(small, "abcd\xC3\xA9xyz", sizeof(small));
+  CHECK_STR(small, "abcd");
+  bulkCopyName(small, "abc\xC3\xA9xyz", sizeof(small));
+  CHECK_STR(small, "abc\xC3\xA9");
+  // 3 BYTE (€ = E2 82 AC) TERPOTONG DI BYTE KE-2
+  bulkCopyName(small, "abc\xE2\x82\xAC", sizeof(small));
+  CHECK_STR(small, "abc");
+}
+
+static void testEscape() {
+  char out[BULK_ESCAPED_LEN];
+  bulkEscapeName(out, sizeof(out), "Sa\"b\\c\nd", false);
+  CHECK_STR(out, "Sa\\\"b\\\\c\\u000ad");
+  bulkEscapeName(out, sizeof(out), "Sa\"b\\c\nd", true);
+  CHECK_STR(out, "Sa\"\"b\\c d");
+  bulkEscapeName(out, sizeof(out), "Bau-Bau (Kota)", false);
+  CHECK_STR(out, "Bau-Bau (Kota)");
+}
+
+static void testRecordBounds() {
+  CityBatch batch = {};
+  batch.count = 1;
+  batch.lat[0] = -179.9999f;
+  batch.lon[0] = -179.9999f;
+  for (int k = 0; k < BULK_TIME_COUNT; k++) batch.times[k][0] = 23.99f;
+
+  // NAMA TERBURUK: SEMUA KARAKTER KONTROL -> 6 BYTE PER BYTE
+  char worst[BULK_NAME_LEN];
+  memset(worst, 0x01, sizeof(worst) - 1);
+  worst[sizeof(worst) - 1] = '\0';
+
+  char out[BULK_RECORD_MAX];
+  for (int csv = 0; csv <= 1; csv++) {
+    size_t n = bulkRenderCity(out, sizeof(out), csv, true, worst, batch, 0);
+    CHECK(n > 0 && n < sizeof(out));
+    // TIDAK MUAT -> 0, BUKAN OUTPUT TERPOTONG
+    CHECK(bulkRenderCity(out, 64, csv, true, worst, batch, 0) == 0);
+  }
+
+  size_t n = bulkRenderCity(out, sizeof(out), false, false, "A\"B", batch, 0);
+  CHECK(n > 0);
+  CHECK(strstr(out, "{\"city\":\"A\\\"B\",") == out);
+}
+
+static void testAllCities(const std::vector<HostCity> &cities) {
+  // SETIAP NAMA DI cities.json HARUS MUAT TANPA DIPOTONG
+  size_t longest = 0;
+  for (const HostCity &city : cities) {
+    longest = std::max(longest, city.display.size());
+    char name[BULK_NAME_LEN];
+    bulkCopyName(name, city.display.c_str(), sizeof(name));
+    CHECK(city.display == name);
+  }
+  printf("  %zu kota, nama terpanjang %zu byte (BULK_NAME_LEN %d)\n",
+         cities.size(), longest, BULK_NAME_LEN);
+}
+
+// ============================================
+// BENCHMARK SKALAR VS BATCH
+// ============================================
+static void fill(const std::vector<HostCity> &cities, size_t first, uint8_t max, CityBatch &batch) {
+  batch.count = 0;
+  for (size_t i = first; i < cities.size() && batch.count < max; i++) {
+    uint8_t k = batch.count++;
+    batch.lat[k] = (float)cities[i].lat;
+    batch.lon[k] = (float)cities[i].lon;
+    batch.tz[k] = provinceTimezone(cities[i].province.c_str());
+  }
+}
+
+// SIKLUS PER KOTA, MEDIAN 15 PUTARAN SEMUA KOTA
+static uint64_t benchPerCity(const std::vector<HostCity> &cities, uint8_t batchSize, bool dayPerCity) {
+  PrayerAngles angles = prayerAnglesFor(20);
+  std::vector<uint64_t> runs;
+  for (int run = 0; run < 15; run++) {
+    uint64_t total = 0;
+    SolarDay sun;
+    solarDayCompute(2025, 3 + run % 6, 1 + run, sun);
+    for (size_t first = 0; first < cities.size(); first += batchSize) {
+      CityBatch batch;
+      fill(cities, first, batchSize, batch);
+      uint64_t start = hostCycles();
+      if (dayPerCity) solarDayCompute(2025, 3 + run % 6, 1 + run, sun);
+      solarKernelBatch(sun, angles, batch);
+      total += hostCycles() - start;
+      hostKeep(batch);
+    }
+    runs.push_back(total / cities.size());
+  }
+  std::sort(runs.begin(), runs.end());
+  return runs[runs.size() / 2];
+}
+
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : "../data/cities.json";
+  std::vector<HostCity> cities = hostLoadCities(path);
+  if (cities.empty()) {
+    fprintf(stderr, "GAGAL MEMBACA %s\n", path);
+    return 2;
+  }
+
+  printf("bulk_schedule_test SOLAR_FAST_MATH=%d\n", SOLAR_FAST_MATH);
+  testCopyName();
+  testEscape();
+  testRecordBounds();
+  testAllCities(cities);
+
+  uint64_t scalar = benchPerCity(cities, 1, true);
+  uint64_t shared = benchPerCity(cities, 1, false);
+  uint64_t batched = benchPerCity(cities, BULK_BATCH_SIZE, false);
+  printf("  siklus/kota (%s): skalar+hari %llu, skalar %llu, batch %d %llu (%.2fx vs skalar+hari)\n",
+         HOST_CYCLE_UNIT, (unsigned long long)scalar, (unsigned long long)shared, BULK_BATCH_SIZE,
+         (unsigned long long)batched, batched ? (double)scalar / batched : 0.0);
+
+  return hostResult();
+}
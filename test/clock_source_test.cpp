@@ -0,0 +1,180 @@
+/*
+ * UJI clock_source.h DENGAN SUMBER SQW SIMULASI
+ * Waktu virtual 1 ms. Sumber SQW memancarkan tepi 1 Hz dengan fase acak,
+ * bisa kehilangan tepi tunggal atau mati sama sekali. Loop clockTickTask
+ * dimodelkan apa adanya: ulTaskNotifyTake(RTC_SQW_TIMEOUT_MS) menggabungkan tepi
+ * yang datang saat task sibuk, timeMutex kadang sibuk, timer vTaskDelayUntil setelah
+ * kembali ke timer internal.
+ *
+ * Diperiksa: currentTime = jumlah detik sebenarnya, sinkron NTP otomatis dihitung
+ * dalam detik (penghitung putaran loop lama tertinggal saat tepi tergabung),
+ * tepi hilang tidak menggeser jam, kembali ke timer setelah 5 timeout, dan
+ * penantian tepi di initRtcSqw berhenti saat SQW mati.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "clock_source.h"
+#include "host/check.h"
+
+struct SqwSource {
+  uint32_t phaseMs;                 // TEPI PERTAMA
+  uint64_t deadAtMs;                // TIDAK ADA TEPI SETELAH INI (0 = HIDUP TERUS)
+  uint32_t dropEvery;               // TEPI KE-k DENGAN k % dropEvery == 0 HILANG (0 = TIDAK)
+
+  bool edgeAt(uint64_t k) const {
+    uint64_t t = phaseMs + k * 1000;
+    if (deadAtMs && t >= deadAtMs) return false;
+    return !(dropEvery && k > 0 && k % dropEvery == 0);
+  }
+  // JUMLAH TEPI DI (from, to]
+  uint32_t count(uint64_t from, uint64_t to) const {
+    uint32_t n = 0;
+    for (uint64_t k = firstAfter(from); phaseMs + k * 1000 <= to; k++) n += edgeAt(k);
+    return n;
+  }
+  uint64_t firstAfter(uint64_t t) const {
+    return t < phaseMs ? 0 : (t - phaseMs) / 1000 + 1;
+  }
+  // WAKTU TEPI BERIKUTNYA SETELAH t, 0 JIKA TIDAK ADA DALAM limit ms
+  uint64_t next(uint64_t t, uint32_t limit) const {
+    for (uint64_t k = firstAfter(t); phaseMs + k * 1000 <= t + limit; k++) {
+      if (edgeAt(k)) return phaseMs + k * 1000;
+    }
+    return 0;
+  }
+};
+
+struct SimResult {
+  uint64_t elapsedMs;
+  uint64_t clockSeconds;            // currentTime - AWAL
+  uint32_t syncs;
+  uint32_t loopSyncs;               // PENGHITUNG LAMA: SATU PER PUTARAN LOOP
+  uint32_t missed;
+  uint64_t lostAtMs;                // 0 = SQW TIDAK PERNAH HILANG
+};
+
+// stallEveryS: SETIAP N DETIK TASK TERTAHAN stallMs (TEPI TERGABUNG);
+// busyEveryS: SETIAP N DETIK timeMutex SIBUK (DETIK DITUNDA KE PUTARAN BERIKUTNYA)
+static SimResult simulate(const SqwSource &src, bool sqw, uint64_t durationMs, uint32_t intervalS,
+                          uint32_t stallEveryS, uint32_t stallMs, uint32_t busyEveryS) {
+  SimResult r = {};
+  ClockTickState tick = {};
+  uint64_t t = src.phaseMs;         // initRtcSqw MENYELARASKAN PADA TEPI PERTAMA
+  uint64_t consumed = t;            // TEPI SAMPAI SINI SUDAH DIAMBIL
+  uint64_t lastWake = t;
+  uint32_t loops = 0;
+  uint32_t loopCounter = 0;
+
+  while (t < durationMs) {
+    uint32_t edges = 0;
+    if (sqw) {
+      edges = src.count(consumed, t);
+      if (edges == 0) {
+        uint64_t n = src.next(t, RTC_SQW_TIMEOUT_MS);
+        if (n) {
+          t = n;
+          edges = 1;
+        } else {
+          t += RTC_SQW_TIMEOUT_MS;
+        }
+      }
+      consumed = t;
+    }
+
+    ClockWake wake = clockTickWake(tick, sqw, edges);
+    if (wake == CLOCK_WAKE_MISSED || wake == CLOCK_WAKE_SQW_LOST) r.missed++;
+    if (wake == CLOCK_WAKE_SQW_LOST) {
+      sqw = false;
+      r.lostAtMs = t;
+      lastWake = t;
+    }
+
+    uint32_t applied = 0;
+    loops++;
+    if (!(busyEveryS && loops % busyEveryS == 0)) {
+      applied = clockTickTake(tick);
+      r.clockSeconds += applied;
+    }
+    if (clockSyncDue(tick, applied, intervalS)) r.syncs++;
+    if (++loopCounter >= intervalS) {
+      loopCounter = 0;
+      r.loopSyncs++;
+    }
+
+    if (stallEveryS && loops % stallEveryS == 0) t += stallMs;
+    if (!sqw) {
+      lastWake += 1000;
+      if (lastWake > t) t = lastWake;
+    }
+  }
+  r.elapsedMs = t - src.phaseMs;
+  return r;
+}
+
+int main() {
+  printf("clock_source_test\n");
+  const uint64_t DAY_MS = 86400ULL * 1000;
+
+  // SQW SEHAT, TASK TERTAHAN 2.3 s TIAP 10 MENIT (FLASH WRITE), MUTEX SIBUK TIAP 97 PUTARAN
+  SqwSource healthy = { 137, 0, 0 };
+  SimResult a = simulate(healthy, true, DAY_MS, 3600, 600, 2300, 97);
+  uint64_t truth = healthy.count(healthy.phaseMs, healthy.phaseMs + a.elapsedMs);
+  printf("  SQW sehat 24 jam: jam %llu s, tepi %llu, sinkron %u (penghitung putaran lama %u), hilang %u\n",
+         (unsigned long long)a.clockSeconds, (unsigned long long)truth, a.syncs, a.loopSyncs, a.missed);
+  CHECK(a.clockSeconds + 1 >= truth && a.clockSeconds <= truth);   // SATU DETIK BOLEH MASIH TERTUNDA
+  CHECK(a.missed == 0 && a.lostAtMs == 0);
+  CHECK(a.syncs == 24 || a.syncs == 23);
+  CHECK(a.loopSyncs < a.syncs);                                    // BUG LAMA: PUTARAN < DETIK
+
+  // TEPI HILANG SATU-SATU (TIAP 600 TEPI): JAM TETAP TEPAT, TIDAK KEMBALI KE TIMER
+  SqwSource glitchy = { 480, 0, 600 };
+  SimResult b = simulate(glitchy, true, DAY_MS, 3600, 0, 0, 0);
+  uint64_t secs = (b.elapsedMs + 1000 - 1) / 1000;
+  printf("  SQW kehilangan 1/600 tepi: jam %llu s dari %llu s, timeout %u\n",
+         (unsigned long long)b.clockSeconds, (unsigned long long)secs, b.missed);
+  CHECK(b.clockSeconds + 1 >= secs && b.clockSeconds <= secs + 1);
+  CHECK(b.missed == 143 || b.missed == 144);
+  CHECK(b.lostAtMs == 0);
+  CHECK(b.syncs == 24 || b.syncs == 23);
+
+  // SQW MATI SETELAH 1 JAM: KEMBALI KE TIMER SETELAH 5 TIMEOUT (7.5 s), SELISIH < 2 s
+  SqwSource dies = { 250, 3600ULL * 1000, 0 };
+  SimResult c = simulate(dies, true, 2 * 3600ULL * 1000, 3600, 0, 0, 0);
+  double wall = c.elapsedMs / 1000.0;
+  printf("  SQW mati di jam 1: timer internal sejak %.1f s, jam %llu s dari %.1f s\n",
+         c.lostAtMs / 1000.0, (unsigned long long)c.clockSeconds, wall);
+  CHECK(c.lostAtMs > 3600ULL * 1000 && c.lostAtMs <= 3600ULL * 1000 + RTC_SQW_MAX_MISSED * RTC_SQW_TIMEOUT_MS);
+  CHECK(c.missed == RTC_SQW_MAX_MISSED);
+  CHECK(c.clockSeconds <= wall + 1 && c.clockSeconds + 2 > wall);
+
+  // TIMER INTERNAL DENGAN MUTEX SIBUK: DETIK TERTUNDA TETAP MASUK KE SINKRON
+  SimResult d = simulate(healthy, false, DAY_MS, 600, 0, 0, 7);
+  printf("  timer internal 24 jam: jam %llu s, sinkron %u\n", (unsigned long long)d.clockSeconds, d.syncs);
+  CHECK(d.syncs == 144 || d.syncs == 143);
+
+  // initRtcSqw: PENANTIAN TEPI DENGAN BATAS WAKTU
+  uint32_t virtualMs = 0;
+  volatile uint32_t edges = 7;
+  auto now = [&]() { return virtualMs; };
+  bool got = clockAwaitEdge(edges, 7, RTC_SQW_TIMEOUT_MS, now, [&]() { virtualMs++; });
+  CHECK(!got);
+  CHECK(virtualMs == RTC_SQW_TIMEOUT_MS);
+
+  virtualMs = 0;
+  got = clockAwaitEdge(edges, 7, RTC_SQW_TIMEOUT_MS, now, [&]() {
+    if (++virtualMs == 640) edges = edges + 1;
+  });
+  CHECK(got);
+  CHECK(virtualMs == 640);
+
+  // millis() WRAP SAAT MENUNGGU
+  virtualMs = 0xFFFFFF00u;
+  got = clockAwaitEdge(edges, edges, RTC_SQW_TIMEOUT_MS, now, [&]() { virtualMs++; });
+  CHECK(!got);
+  CHECK(virtualMs == 0xFFFFFF00u + RTC_SQW_TIMEOUT_MS);
+
+  return hostResult();
+}
@@ -0,0 +1,398 @@
+/*
+ * UJI DRIVER DFPLAYER dfplayer_driver.h TERHADAP EMULATOR MODUL
+ * Sisi perangkat meniru jws.ino dengan waktu virtual: dfOnReceive (dfParserFeed
+ * + dfHandleFrame) memproses burst byte sebelum audioTask bangun, audioTask tidur
+ * selama audioPlaybackWaitMs atau sampai ada bit notifikasi, lalu menjalankan
+ * audioPlaybackStep; audioPlay/audioQueue/audioStop seperti API firmware.
+ *
+ * Diperiksa per skenario: callback (track, AudioResult, waktu) dan perintah yang
+ * diterima modul. Frame selesai ganda, track pendek di dalam guard (latched +
+ * query status), duplikat basi di dalam guard, query tanpa balasan, frame terpecah
+ * per byte, checksum rusak / frame terpotong / byte 0xFF salah, frame selesai
+ * basi untuk track lain di burst yang sama, kartu dicabut, REPLACE tanpa onDone,
+ * stop, batas durasi, antrean.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <deque>
+#include <vector>
+
+#include "dfplayer_driver.h"
+#include "host/dfplayer_emulator.h"
+#include "host/check.h"
+
+#define T0 1000                    // WAKTU VIRTUAL AWAL (ms)
+
+struct DoneRecord {
+  char cb;                         // 'A' / 'B': CALLBACK MANA YANG DIPANGGIL
+  uint16_t track;
+  AudioResult result;
+  uint32_t atMs;
+};
+
+static std::vector<DoneRecord> dones;
+static uint32_t virtualNow = 0;
+
+static void onDoneA(uint16_t track, AudioResult result) {
+  dones.push_back({ 'A', track, result, virtualNow });
+}
+static void onDoneB(uint16_t track, AudioResult result) {
+  dones.push_back({ 'B', track, result, virtualNow });
+}
+
+// SISI PERANGKAT: GLUE audioTask / dfOnReceive / API AUDIO DARI jws.ino
+struct Device {
+  DfEmulator &emu;
+  AudioPlayback pb = {};
+  DfParser parser = {};
+  std::deque<AudioJob> queue;
+  uint32_t notified = 0;           // BIT xTaskNotify YANG BELUM DIAMBIL
+  uint8_t playStatus = 0;
+  uint16_t errorCode = 0;
+  uint32_t wakes = 0;
+
+  explicit Device(DfEmulator &e) : emu(e) {}
+
+  void send(uint8_t cmd, uint16_t param) {
+    uint8_t f[DF_FRAME_SIZE];
+    dfBuildFrame(cmd, param, f);
+    emu.receive(f, DF_FRAME_SIZE, virtualNow);
+  }
+
+  void uart(const std::vector<uint8_t> &burst) {
+    for (uint8_t b : burst) {
+      if (!dfParserFeed(parser, b)) continue;
+      uint32_t events = dfFrameEvents(parser.frame, pb.playingTrack);
+      if (events & AUDIO_EVT_ERROR) errorCode = dfFrameParam(parser.frame);
+      if (events & AUDIO_EVT_STATUS) playStatus = dfFrameParam(parser.frame) & 0xFF;
+      notified |= events;
+    }
+  }
+
+  void audioQueue(uint16_t track, AudioDoneCallback cb) {
+    if (queue.size() >= AUDIO_QUEUE_LENGTH) return;
+    queue.push_back({ track, cb });
+    notified |= AUDIO_EVT_QUEUE;
+  }
+  void audioPlay(uint16_t track, AudioDoneCallback cb) {
+    queue.clear();
+    notified |= AUDIO_EVT_REPLACE;
+    audioQueue(track, cb);
+  }
+  void audioStop() {
+    queue.clear();
+    notified |= AUDIO_EVT_STOP;
+  }
+
+  void wake() {
+    wakes++;
+    uint32_t events = notified;
+    notified = 0;
+
+    if (pb.active) {
+      AudioAction act = audioPlaybackStep(pb, events, virtualNow, playStatus, -1);
+      if (act.sendQuery) send(DF_CMD_QUERY_STATUS, 0);
+      if (act.sendStop) send(DF_CMD_STOP, 0);
+      if (act.done && act.job.onDone != NULL) act.job.onDone(act.job.track, act.result);
+    }
+
+    if (!pb.active && !queue.empty()) {
+      AudioJob job = queue.front();
+      queue.pop_front();
+      audioPlaybackStart(pb, job, virtualNow);
+      send(DF_CMD_PLAY_TRACK, job.track);
+    }
+  }
+
+  // JALANKAN SAMPAI endMs: BYTE UART DIPROSES DULU (TASK UART PRIORITAS LEBIH TINGGI),
+  // audioTask BANGUN SAAT ADA BIT ATAU TIMEOUT-NYA HABIS
+  void runUntil(uint32_t endMs) {
+    while (true) {
+      uint32_t wakeAt;
+      if (notified) {
+        wakeAt = virtualNow;
+      } else {
+        uint32_t wait = audioPlaybackWaitMs(pb, virtualNow);
+        wakeAt = (wait == AUDIO_WAIT_FOREVER) ? UINT32_MAX : virtualNow + wait;
+      }
+      uint32_t byteAt = emu.nextAt();
+
+      if (byteAt <= endMs && byteAt < wakeAt) {
+        virtualNow = byteAt > virtualNow ? byteAt : virtualNow;
+        uart(emu.take(virtualNow));
+        continue;
+      }
+      if (wakeAt > endMs) break;
+      virtualNow = wakeAt;
+      wake();
+    }
+    virtualNow = endMs;
+  }
+};
+
+static void reset(DfEmulator &emu) {
+  emu = DfEmulator();
+  for (uint16_t t = 1; t <= 10; t++) emu.trackMs[t] = 60000;
+  dones.clear();
+  virtualNow = T0;
+}
+
+static bool onlyDone(char cb, uint16_t track, AudioResult result, uint32_t atMs) {
+  if (dones.size() != 1) {
+    printf("    %zu callback (harus 1)\n", dones.size());
+    return false;
+  }
+  const DoneRecord &d = dones[0];
+  if (d.cb != cb || d.track != track || d.result != result || d.atMs != atMs) {
+    printf("    callback %c track %u hasil %d pada %u ms (harus %c %u %d %u)\n",
+           d.cb, d.track, d.result, d.atMs - T0, cb, track, result, atMs - T0);
+    return false;
+  }
+  return true;
+}
+
+static void parserChecks() {
+  uint8_t f[DF_FRAME_SIZE];
+  dfBuildFrame(DF_EVT_SD_FINISHED, 0x0102, f);
+  CHECK(f[0] == 0x7E && f[1] == 0xFF && f[2] == 0x06 && f[3] == DF_EVT_SD_FINISHED && f[9] == 0xEF);
+  CHECK(dfFrameParam(f) == 0x0102);
+
+  // CHECKSUM SESUAI CONTOH DATASHEET: PLAY TRACK 1 = 7E FF 06 03 00 00 01 FE F7 EF
+  dfBuildFrame(DF_CMD_PLAY_TRACK, 1, f);
+  CHECK(f[7] == 0xFE && f[8] == 0xF7);
+
+  struct Stream {
+    const char *name;
+    std::vector<uint8_t> bytes;
+    int frames;
+  };
+  dfBuildFrame(DF_EVT_SD_FINISHED, 3, f);
+  std::vector<uint8_t> good(f, f + DF_FRAME_SIZE);
+  std::vector<uint8_t> badSum = good;
+  badSum[8] ^= 0x01;
+  std::vector<uint8_t> badEnd = good;
+  badEnd[9] = 0x00;
+
+  std::vector<Stream> streams = {
+    { "sah", good, 1 },
+    { "sampah di depan", { 0x00, 0xEF, 0x55 }, 1 },
+    { "checksum rusak", badSum, 0 },
+    { "byte akhir rusak", badEnd, 0 },
+    { "0xFF salah", { 0x7E, 0x00, 0x06, 0x3D }, 1 },
+    { "panjang salah", { 0x7E, 0xFF, 0x07 }, 1 },
+    { "terpotong", { 0x7E, 0xFF, 0x06, 0x3D, 0x00 }, 1 },
+    { "7E ganda", { 0x7E }, 1 },
+    { "rusak lalu sah", badSum, 1 },
+  };
+  // SETIAP ALIRAN RUSAK DIIKUTI FRAME SAH (KECUALI YANG MEMANG DIUJI TANPA)
+  for (size_t i = 1; i < streams.size(); i++) {
+    if (streams[i].frames == 1) streams[i].bytes.insert(streams[i].bytes.end(), good.begin(), good.end());
+  }
+  // FRAME SAH DENGAN 0x7E DI PARAMETER SETELAH FRAME TERPOTONG
+  dfBuildFrame(DF_EVT_SD_FINISHED, 0x7E7E, f);
+  streams.push_back({ "7E di parameter", { 0x7E, 0xFF, 0x06 }, 1 });
+  streams.back().bytes.insert(streams.back().bytes.end(), f, f + DF_FRAME_SIZE);
+
+  for (const Stream &s : streams) {
+    DfParser p = {};
+    int frames = 0;
+    uint16_t param = 0;
+    for (uint8_t b : s.bytes) {
+      if (dfParserFeed(p, b)) {
+        frames++;
+        param = dfFrameParam(p.frame);
+      }
+    }
+    bool ok = frames == s.frames && (frames == 0 || param == 3 || param == 0x7E7E);
+    if (!ok) printf("    aliran '%s': %d frame (harus %d), param %04X\n", s.name, frames, s.frames, param);
+    CHECK(ok);
+  }
+
+  // FRAME SELESAI HANYA UNTUK TRACK YANG SEDANG DIPUTAR
+  dfBuildFrame(DF_EVT_SD_FINISHED, 4, f);
+  CHECK(dfFrameEvents(f, 4) == AUDIO_EVT_FINISHED);
+  CHECK(dfFrameEvents(f, 9) == 0);
+  CHECK(dfFrameEvents(f, 0) == 0);
+  dfBuildFrame(DF_EVT_CARD_INSERTED, 2, f);
+  CHECK(dfFrameEvents(f, 4) == 0);
+}
+
+int main() {
+  printf("dfplayer_emulator_test\n");
+  parserChecks();
+
+  DfEmulator emu;
+  Device *dev;
+
+  // 1. SELESAI NORMAL, MODUL MENGIRIM FRAME SELESAI DUA KALI -> SATU CALLBACK
+  reset(emu);
+  emu.trackMs[1] = 3000;
+  dev = new Device(emu);
+  dev->audioPlay(1, onDoneA);
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('A', 1, AUDIO_FINISHED, T0 + 3000));
+  CHECK(emu.count(DF_CMD_PLAY_TRACK) == 1 && emu.count(DF_CMD_QUERY_STATUS) == 0);
+  printf("  selesai ganda: 1 callback pada %u ms, %u kali bangun\n", dones[0].atMs - T0, dev->wakes);
+  delete dev;
+
+  // 2. TRACK 400 ms: FRAME DI DALAM GUARD DITAHAN, QUERY SETELAH GUARD, MODUL BERHENTI
+  reset(emu);
+  emu.trackMs[2] = 400;
+  dev = new Device(emu);
+  dev->audioPlay(2, onDoneA);
+  dev->runUntil(T0 + 5000);
+  CHECK(onlyDone('A', 2, AUDIO_FINISHED, T0 + AUDIO_FINISH_GUARD + DFEMU_REPLY_MS));
+  CHECK(emu.count(DF_CMD_QUERY_STATUS) == 1);
+  delete dev;
+
+  // 3. DUPLIKAT BASI (TRACK SAMA, PEMUTARAN SEBELUMNYA) DI DALAM GUARD: QUERY
+  //    MENJAWAB MASIH MEMUTAR -> TUNGGU FRAME SELESAI YANG ASLI
+  reset(emu);
+  emu.trackMs[3] = 5000;
+  dev = new Device(emu);
+  dev->audioPlay(3, onDoneA);
+  emu.emit(T0 + 200, DF_EVT_SD_FINISHED, 3);
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('A', 3, AUDIO_FINISHED, T0 + 5000));
+  CHECK(emu.count(DF_CMD_QUERY_STATUS) == 1);
+  delete dev;
+
+  // 4. QUERY TIDAK DIJAWAB: PERCAYA FRAME SETELAH AUDIO_STATUS_TIMEOUT
+  reset(emu);
+  emu.trackMs[2] = 400;
+  emu.answerQuery = false;
+  dev = new Device(emu);
+  dev->audioPlay(2, onDoneA);
+  dev->runUntil(T0 + 5000);
+  CHECK(onlyDone('A', 2, AUDIO_FINISHED, T0 + AUDIO_FINISH_GUARD + AUDIO_STATUS_TIMEOUT));
+  delete dev;
+
+  // 5. FRAME TERPECAH: SATU BYTE PER 3 ms, onReceive DIPANGGIL PER BYTE
+  reset(emu);
+  emu.trackMs[4] = 100000;
+  dev = new Device(emu);
+  dev->audioPlay(4, onDoneA);
+  emu.emitSplit(T0 + 2500, DF_EVT_SD_FINISHED, 4, 3);
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('A', 4, AUDIO_FINISHED, T0 + 2500 + 9 * 3));
+  delete dev;
+
+  // 6. CHECKSUM RUSAK DIABAIKAN; FRAME TERPOTONG + 0xFF SALAH TEPAT DI DEPAN FRAME
+  //    SELESAI YANG SAH TIDAK MENELAN FRAME ITU
+  reset(emu);
+  emu.trackMs[5] = 100000;
+  dev = new Device(emu);
+  dev->audioPlay(5, onDoneA);
+  {
+    uint8_t f[DF_FRAME_SIZE];
+    dfBuildFrame(DF_EVT_SD_FINISHED, 5, f);
+    std::vector<uint8_t> corrupt(f, f + DF_FRAME_SIZE);
+    corrupt[7] ^= 0x10;
+    emu.emitRaw(T0 + 1500, corrupt);
+    std::vector<uint8_t> burst = { 0x7E, 0xFF, 0x06, 0x3D, 0x00, 0x7E, 0x00, 0x06 };
+    burst.insert(burst.end(), f, f + DF_FRAME_SIZE);
+    emu.emitRaw(T0 + 4000, burst);
+  }
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('A', 5, AUDIO_FINISHED, T0 + 4000));
+  delete dev;
+
+  // 7. FRAME SELESAI ASLI + FRAME BASI UNTUK TRACK LAIN DALAM SATU BURST:
+  //    YANG BASI TIDAK BOLEH MENIMPA YANG ASLI (DULU: MENGGANTUNG SAMPAI 10 MENIT)
+  reset(emu);
+  emu.trackMs[6] = 3000;
+  emu.doubleFinish = false;
+  dev = new Device(emu);
+  dev->audioPlay(6, onDoneA);
+  emu.emit(T0 + 3000, DF_EVT_USB_FINISHED, 9);
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('A', 6, AUDIO_FINISHED, T0 + 3000));
+  delete dev;
+
+  // 8. KARTU DICABUT SAAT MEMUTAR, LALU TRACK BERIKUTNYA GAGAL (ERROR DARI MODUL)
+  reset(emu);
+  dev = new Device(emu);
+  dev->audioPlay(7, onDoneA);
+  dev->runUntil(T0 + 2000);
+  emu.removeCard(virtualNow);
+  dev->runUntil(T0 + 3000);
+  dev->audioQueue(1, onDoneB);
+  dev->runUntil(T0 + 4000);
+  CHECK(dones.size() == 2);
+  if (dones.size() == 2) {
+    CHECK(dones[0].cb == 'A' && dones[0].track == 7 && dones[0].result == AUDIO_CARD_REMOVED);
+    CHECK(dones[0].atMs == T0 + 2000);
+    CHECK(dones[1].cb == 'B' && dones[1].track == 1 && dones[1].result == AUDIO_ERROR);
+    CHECK(dones[1].atMs == T0 + 3000 + DFEMU_REPLY_MS);
+  }
+  CHECK(dev->errorCode == DFEMU_ERR_NO_CARD);
+  delete dev;
+
+  // 9. REPLACE: JOB LAMA DIHENTIKAN TANPA CALLBACK, JOB BARU SELESAI NORMAL
+  reset(emu);
+  emu.trackMs[8] = 2000;
+  dev = new Device(emu);
+  dev->audioPlay(7, onDoneA);
+  dev->runUntil(T0 + 3000);
+  dev->audioPlay(8, onDoneB);
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('B', 8, AUDIO_FINISHED, T0 + 5000));
+  CHECK(emu.commands.size() == 3 && emu.commands[0].first == DF_CMD_PLAY_TRACK &&
+        emu.commands[1].first == DF_CMD_STOP && emu.commands[2] == std::make_pair((uint8_t)DF_CMD_PLAY_TRACK, (uint16_t)8));
+  delete dev;
+
+  // 10. REPLACE SAAT QUERY STATUS MASIH MENUNGGU BALASAN: BALASAN TERLAMBAT TIDAK
+  //     MENGAKHIRI JOB BARU
+  reset(emu);
+  emu.trackMs[2] = 300;
+  emu.trackMs[9] = 4000;
+  dev = new Device(emu);
+  dev->audioPlay(2, onDoneA);
+  dev->runUntil(T0 + AUDIO_FINISH_GUARD + 5);
+  CHECK(emu.count(DF_CMD_QUERY_STATUS) == 1 && dev->pb.statusQueried);
+  dev->audioPlay(9, onDoneB);
+  dev->runUntil(T0 + 10000);
+  CHECK(onlyDone('B', 9, AUDIO_FINISHED, T0 + AUDIO_FINISH_GUARD + 5 + 4000));
+  delete dev;
+
+  // 11. STOP
+  reset(emu);
+  dev = new Device(emu);
+  dev->audioPlay(10, onDoneA);
+  dev->runUntil(T0 + 1500);
+  dev->audioStop();
+  dev->runUntil(T0 + 70000);
+  CHECK(onlyDone('A', 10, AUDIO_STOPPED, T0 + 1500));
+  CHECK(emu.count(DF_CMD_STOP) == 1);
+  delete dev;
+
+  // 12. MODUL TIDAK PERNAH MELAPOR: BATAS DURASI, STOP DIKIRIM
+  reset(emu);
+  emu.trackMs[1] = AUDIO_MAX_DURATION + 60000;
+  dev = new Device(emu);
+  dev->audioPlay(1, onDoneA);
+  dev->runUntil(T0 + AUDIO_MAX_DURATION + 120000);
+  CHECK(onlyDone('A', 1, AUDIO_TIMEOUT, T0 + AUDIO_MAX_DURATION));
+  CHECK(emu.count(DF_CMD_STOP) == 1);
+  CHECK(dev->wakes <= 3);                       // TIDUR SELAMA MEMUTAR, BUKAN POLLING
+  delete dev;
+
+  // 13. ANTREAN: BERURUTAN, CALLBACK MASING-MASING
+  reset(emu);
+  emu.trackMs[1] = 2000;
+  emu.trackMs[2] = 3000;
+  dev = new Device(emu);
+  dev->audioQueue(1, onDoneA);
+  dev->audioQueue(2, onDoneB);
+  dev->runUntil(T0 + 10000);
+  CHECK(dones.size() == 2);
+  if (dones.size() == 2) {
+    CHECK(dones[0].cb == 'A' && dones[0].track == 1 && dones[0].atMs == T0 + 2000);
+    CHECK(dones[1].cb == 'B' && dones[1].track == 2 && dones[1].atMs == T0 + 5000);
+  }
+  CHECK(emu.badFrames == 0);
+  delete dev;
+
+  return hostResult();
+}
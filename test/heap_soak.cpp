@@ -0,0 +1,388 @@
+/*
+ * SOAK TEST HEAP: SATU TAHUN VIRTUAL DALAM BEBERAPA DETIK
+ *
+ *   build/heap_soak [--days 365] [--leak-ntp BYTES]
+ *
+ * Pola alokasi firmware dimodelkan per call site di atas SoakHeap (240 KB, heap
+ * bebas ESP32 setelah boot): sesi web interface (/devicestatus tiap 5 s, /api/v2/state,
+ * unggah splash), fetch jadwal harian, NTP per jam, /api/schedule/bulk mingguan,
+ * reconnect WiFi. Setiap 30 detik virtual heap bebas & blok terbesar diumpankan ke
+ * heap_trend.h (kode yang sama dengan webTask), millis() 32-bit ikut wrap tiap 49 hari.
+ *
+ * GAGAL jika: alokasi gagal, satu call site tumbuh di sebagian besar hari atau byte
+ * hidupnya di kuartal terakhir tak pernah turun ke puncak kuartal pertama,
+ * heap_trend.h menandai kebocoran/fragmentasi, atau uji regresi heapSlope/rasio gagal.
+ * Dilaporkan: puncak heap, tren blok bebas terbesar, alokasi per jam virtual.
+ * Uji bawaan juga menjalankan 14 hari dengan kebocoran buatan dan mewajibkan
+ * keduanya (call site & heap_trend.h) mendeteksinya.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "heap_trend.h"
+#include "solar_math.h"
+#include "bulk_schedule.h"
+#include "host/check.h"
+#include "host/soak_heap.h"
+
+#define SOAK_HEAP_BYTES 245632         // "Sekarang" DI LOG MEMORI README
+#define SOAK_STEP_S 5                  // PERIODE POLLING /devicestatus
+#define SOAK_SAMPLE_S 30               // PERIODE heapTrendSample DI webTask
+#define SOAK_STATE_DOC 2048            // STATE_DOC_SIZE
+#define SOAK_BULK_OUT 3072             // BULK_OUT_SIZE
+#define SOAK_SPLASH_CHUNK 2048         // SPLASH_RAM_CHUNK
+#define SOAK_SPLASH_CHUNKS 12          // SPLASH ~24 KB SETELAH RLE
+#define SOAK_GROWTH_PCT 50             // SITE TUMBUH DI >= 50% HARI = MONOTON
+#define SOAK_FLOOR_MIN_DAYS 60         // PERBANDINGAN KUARTAL HANYA UNTUK RUN PANJANG
+
+struct SoakOptions {
+  int days = 365;
+  uint32_t leakNtp = 0;                // BYTE BOCOR PER SINKRON NTP (UJI DETEKTOR)
+  bool quiet = false;
+};
+
+struct SoakReport {
+  uint32_t peakUsed;
+  uint32_t minFree;
+  uint32_t capacity;
+  std::vector<int32_t> dailyMinLargest;
+  uint64_t allocations;
+  uint32_t maxPerHour;
+  uint32_t failures;
+  int leakHours;
+  int fragHours;
+  std::vector<const char *> growingSites;
+};
+
+static uint32_t rng = 0x2545F491;
+static uint32_t nextRandom() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+// ALOKASI BERUMUR: DIBEBASKAN SETELAH freeAt (DETIK VIRTUAL)
+struct Pending {
+  int64_t freeAt;
+  int32_t ptr;
+};
+
+class Firmware {
+public:
+  explicit Firmware(SoakHeap &h) : heap(h) {
+    siteRequest = heap.addSite("http_request");
+    siteStatus = heap.addSite("devicestatus_json");
+    sitePbuf = heap.addSite("lwip_pbuf");
+    sitePcb = heap.addSite("lwip_pcb");
+    siteState = heap.addSite("state_doc");
+    siteSplash = heap.addSite("splash_chunk");
+    siteJson = heap.addSite("schedule_json");
+    siteNtp = heap.addSite("ntp");
+    siteBulk = heap.addSite("bulk_job");
+    siteWifi = heap.addSite("wifi_rx");
+  }
+
+  uint32_t leakNtp = 0;
+
+  void step(int64_t t) {
+    expire(t);
+    int64_t sod = t % 86400;
+
+    if (sod == 0) planDay();
+    for (Session &s : sessions) {
+      if (t == s.start) openSession(t, s);
+      if (t >= s.start && t < s.end) pollStatus(t, s);
+      if (t == s.end) closeSession(t, s);
+    }
+
+    if (sod == 5 * 60) fetchSchedule(t);
+    if (t % 3600 == 0) syncNtp(t);
+    if (t % (7 * 86400) == 12 * 3600) bulkSchedule(t);
+    if (t % (7 * 86400) == 3 * 86400 + 2 * 3600) wifiReconnect(t);
+  }
+
+private:
+  SoakHeap &heap;
+  int siteRequest, siteStatus, sitePbuf, sitePcb, siteState, siteSplash, siteJson, siteNtp, siteBulk, siteWifi;
+
+  struct Session {
+    int64_t start;
+    int64_t end;
+    bool uploadSplash;
+    int32_t pcb[2];
+  };
+  std::vector<Session> sessions;
+  std::deque<Pending> pending;
+  std::vector<int32_t> splash;
+  std::vector<int32_t> leaked;
+  int dayIndex = 0;
+
+  void hold(int site, uint32_t size, int64_t freeAt) {
+    int32_t p = heap.alloc(site, size);
+    if (p >= 0) pending.push_back({ freeAt, p });
+  }
+
+  void expire(int64_t t) {
+    for (size_t i = 0; i < pending.size();) {
+      if (pending[i].freeAt <= t) {
+        heap.release(pending[i].ptr);
+        pending[i] = pending.back();
+        pending.pop_back();
+      } else {
+        i++;
+      }
+    }
+  }
+
+  // 0-3 SESI WEB PER HARI, 5-60 MENIT; UNGGAH SPLASH SEKALI SEBULAN
+  void planDay() {
+    int64_t day = (int64_t)dayIndex * 86400;
+    sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+                                  [&](const Session &s) { return s.end < day; }),
+                   sessions.end());   // SESI YANG MELEWATI TENGAH MALAM TETAP DITUTUP
+    int count = nextRandom() % 4;
+    for (int i = 0; i < count; i++) {
+      int64_t start = day + (int64_t)(nextRandom() % (86400 / SOAK_STEP_S)) * SOAK_STEP_S;
+      int64_t len = (int64_t)(60 + nextRandom() % 660) * SOAK_STEP_S;
+      sessions.push_back({ start, start + len, i == 0 && dayIndex % 30 == 10, { -1, -1 } });
+    }
+    dayIndex++;
+  }
+
+  void openSession(int64_t t, Session &s) {
+    s.pcb[0] = heap.alloc(sitePcb, 248);
+    s.pcb[1] = heap.alloc(sitePcb, 248);
+    hold(siteRequest, 420, t + SOAK_STEP_S);
+    hold(sitePbuf, 1600, t + SOAK_STEP_S);
+    // buildStateDocument: malloc(STATE_DOC_SIZE), LALU String(buf) UNTUK RESPONS
+    int32_t doc = heap.alloc(siteState, SOAK_STATE_DOC);
+    hold(siteState, 1180, t + SOAK_STEP_S);
+    heap.release(doc);
+
+    if (s.uploadSplash) {
+      for (int32_t p : splash) heap.release(p);
+      splash.clear();
+    }
+  }
+
+  void pollStatus(int64_t t, Session &s) {
+    hold(siteRequest, 420, t + 1);
+    hold(siteStatus, 880 + nextRandom() % 64, t + SOAK_STEP_S);  // DIKIRIM ASYNC, BEBAS DI POLL BERIKUTNYA
+    hold(sitePbuf, 1600, t + 1);
+
+    // UNGGAH SPLASH: CHUNK RLE DIALOKASI BERSELANG-SELING DENGAN POLLING
+    if (s.uploadSplash && splash.size() < SOAK_SPLASH_CHUNKS) {
+      int32_t p = heap.alloc(siteSplash, SOAK_SPLASH_CHUNK);
+      if (p >= 0) splash.push_back(p);
+    }
+  }
+
+  void closeSession(int64_t t, Session &s) {
+    heap.release(s.pcb[0]);
+    heap.release(s.pcb[1]);
+    s.pcb[0] = s.pcb[1] = -1;
+  }
+
+  // KONEKSI KEEP-ALIVE DITUTUP SETELAH HTTPC_IDLE_CLOSE_MS (20 s)
+  void fetchSchedule(int64_t t) {
+    hold(sitePcb, 248, t + 20);
+    hold(sitePbuf, 1600, t + 1);
+    hold(sitePbuf, 1600, t + 1);
+    hold(siteJson, 3072, t + 1);
+  }
+
+  void syncNtp(int64_t t) {
+    hold(siteNtp, 96, t + 1);
+    if (leakNtp) {
+      int32_t p = heap.alloc(siteNtp, leakNtp);
+      if (p >= 0) leaked.push_back(p);
+    }
+  }
+
+  void bulkSchedule(int64_t t) {
+    uint32_t job = sizeof(CityBatch) + BULK_BATCH_SIZE * BULK_NAME_LEN + SOAK_BULK_OUT + 128;
+    hold(siteBulk, job, t + 2);
+    hold(sitePcb, 248, t + 2);
+  }
+
+  void wifiReconnect(int64_t t) {
+    for (int i = 0; i < 4; i++) hold(siteWifi, 1664, t + 30);
+  }
+};
+
+static SoakReport runSoak(const SoakOptions &opt) {
+  SoakHeap heap(SOAK_HEAP_BYTES);
+  Firmware fw(heap);
+  fw.leakNtp = opt.leakNtp;
+  rng = 0x2545F491;
+
+  HeapTrend trend;
+  memset(&trend, 0, sizeof(trend));
+  SoakReport report = {};
+  report.capacity = heap.capacity();
+  report.minFree = heap.freeBytes();
+
+  uint32_t dayMinLargest = UINT32_MAX;
+  uint64_t hourStartAllocs = 0;
+  uint32_t millisBase = 1200;           // millis() SAAT JAM PERTAMA KALI VALID
+
+  int64_t end = (int64_t)opt.days * 86400;
+  for (int64_t t = 0; t < end; t += SOAK_STEP_S) {
+    fw.step(t);
+
+    if (t % SOAK_SAMPLE_S == 0) {
+      uint32_t freeHeap = heap.freeBytes();
+      uint32_t largest = heap.largestFree();
+      report.minFree = std::min(report.minFree, freeHeap);
+      dayMinLargest = std::min(dayMinLargest, largest);
+
+      uint32_t nowMs = millisBase + (uint32_t)(t * 1000);
+      if (heapTrendAdd(trend, freeHeap, largest, nowMs)) {
+        HeapTrendVerdict v = heapTrendEvaluate(trend);
+        report.leakHours += v.leak;
+        report.fragHours += v.frag;
+        if ((v.leak || v.frag) && !opt.quiet) {
+          printf("  jam %u: %s%s slope %+.0f B/jam, rasio %+.1f permil/jam\n", trend.hours,
+                 v.leak ? "KEBOCORAN " : "", v.frag ? "FRAGMENTASI " : "", v.freeSlope, v.fragSlope);
+        }
+      }
+    }
+
+    if ((t + SOAK_STEP_S) % 3600 == 0) {
+      uint32_t n = (uint32_t)(heap.allocations() - hourStartAllocs);
+      report.maxPerHour = std::max(report.maxPerHour, n);
+      hourStartAllocs = heap.allocations();
+    }
+    if ((t + SOAK_STEP_S) % 86400 == 0) {
+      heap.closeDay();
+      report.dailyMinLargest.push_back((int32_t)dayMinLargest);
+      dayMinLargest = UINT32_MAX;
+    }
+  }
+
+  report.peakUsed = heap.peak();
+  report.allocations = heap.allocations();
+  report.failures = heap.failed();
+
+  for (const SoakSite &s : heap.sites) {
+    int grew = 0;
+    for (size_t d = 1; d < s.daily.size(); d++) grew += s.daily[d] > s.daily[d - 1];
+    bool monotonic = s.daily.size() > 1 && grew * 100 >= (int)(s.daily.size() - 1) * SOAK_GROWTH_PCT;
+    // KEBOCORAN JARANG (MIS. SESI YANG TIDAK PERNAH DITUTUP): LANTAI KUARTAL TERAKHIR
+    // DI ATAS PUNCAK KUARTAL PERTAMA (BUTUH > 1 SIKLUS SPLASH BULANAN)
+    size_t q = s.daily.size() / 4;
+    if (s.daily.size() >= SOAK_FLOOR_MIN_DAYS) {
+      int64_t firstMax = *std::max_element(s.daily.begin(), s.daily.begin() + q);
+      int64_t lastMin = *std::min_element(s.daily.end() - q, s.daily.end());
+      monotonic = monotonic || lastMin > firstMax;
+    }
+    if (monotonic) report.growingSites.push_back(s.name);
+    if (!opt.quiet) {
+      printf("  %-18s %9llu alokasi  puncak %6lld B  akhir %6lld B  tumbuh %3d/%zu hari%s\n", s.name,
+             (unsigned long long)s.allocs, (long long)s.peakLive, (long long)s.live, grew,
+             s.daily.size() ? s.daily.size() - 1 : 0, monotonic ? "  MONOTON" : "");
+    }
+  }
+  return report;
+}
+
+// ============================================
+// REGRESI heap_trend.h
+// ============================================
+static void testHeapTrend() {
+  // LANGKAH DATAR BUKAN LANGKAH TURUN
+  const int32_t flat[HEAP_TREND_WINDOW] = { 9000, 9000, 9000, 9000, 9000, 9000,
+                                            9000, 9000, 9000, 9000, 9000, 6000 };
+  int down = -1;
+  heapSlope(flat, HEAP_TREND_WINDOW, &down);
+  CHECK(down == 1);
+
+  // PLATEAU LALU SATU PENURUNAN BESAR TIDAK DIANGGAP BOCOR MONOTON
+  HeapTrend t;
+  memset(&t, 0, sizeof(t));
+  uint32_t ms = 1000;
+  for (int h = 0; h < HEAP_TREND_WINDOW; h++) {
+    uint32_t freeHeap = h < HEAP_TREND_WINDOW - 1 ? 200000 : 150000;
+    for (int s = 0; s <= 120; s++, ms += 30000) heapTrendAdd(t, freeHeap, freeHeap / 2, ms);
+    ms -= 30000;
+  }
+  HeapTrendVerdict v = heapTrendEvaluate(t);
+  CHECK(v.n == HEAP_TREND_WINDOW);
+  CHECK(v.freeSlope < -HEAP_LEAK_SLOPE_BPH);
+  CHECK(!v.leak);
+
+  // RASIO DARI SAMPEL YANG SAMA: MIN BEBAS & MIN BLOK TERBESAR TERJADI DI MOMEN BERBEDA
+  memset(&t, 0, sizeof(t));
+  heapTrendAdd(t, 100000, 90000, 1000);           // 900 PERMIL
+  heapTrendAdd(t, 150000, 60000, 31000);          // 400 PERMIL
+  heapTrendAdd(t, 160000, 150000, 1000 + HEAP_HOUR_MS);
+  CHECK(t.count == 1);
+  const HeapSample &h = heapTrendAt(t, 0);
+  CHECK(h.minFree == 100000);
+  CHECK(h.minLargest == 60000);
+  CHECK(h.minFragPermil == 400);                   // BUKAN 60000 * 1000 / 100000 = 600
+
+  // millis() WRAP DI TENGAH JAM
+  memset(&t, 0, sizeof(t));
+  heapTrendAdd(t, 1000, 500, 0xFFFFF000u);
+  CHECK(!heapTrendAdd(t, 1000, 500, 0xFFFFF000u + 1800000u));
+  CHECK(heapTrendAdd(t, 1000, 500, 0xFFFFF000u + (uint32_t)HEAP_HOUR_MS));
+}
+
+static void printReport(const char *title, const SoakOptions &opt, const SoakReport &r) {
+  size_t days = r.dailyMinLargest.size();
+  printf("%s: %d hari, heap %u B\n", title, opt.days, r.capacity);
+  printf("  puncak terpakai %u B (%.1f%%), heap bebas terendah %u B, alokasi gagal %u\n", r.peakUsed,
+         100.0 * r.peakUsed / r.capacity, r.minFree, r.failures);
+  printf("  alokasi %llu, rata-rata %.1f/jam virtual, maks %u/jam\n", (unsigned long long)r.allocations,
+         (double)r.allocations / (opt.days * 24.0), r.maxPerHour);
+  if (days) {
+    int down;
+    float slope = heapSlope(r.dailyMinLargest.data(), (int)days, &down);
+    printf("  blok bebas terbesar (min harian): hari 1 %d, hari %zu %d B, terendah %d B; tren %+.1f B/hari\n",
+           r.dailyMinLargest[0], days, r.dailyMinLargest[days - 1],
+           *std::min_element(r.dailyMinLargest.begin(), r.dailyMinLargest.end()), slope);
+  }
+  printf("  jam dengan tanda kebocoran %d, fragmentasi %d; call site monoton %zu\n", r.leakHours, r.fragHours,
+         r.growingSites.size());
+}
+
+int main(int argc, char **argv) {
+  SoakOptions opt;
+  bool selfTest = true;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--days") == 0) opt.days = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--leak-ntp") == 0) opt.leakNtp = (uint32_t)atoi(argv[i + 1]);
+    selfTest = false;
+  }
+  if (opt.days < 1) opt.days = 1;
+
+  testHeapTrend();
+
+  printf("heap_soak\n");
+  SoakReport r = runSoak(opt);
+  printReport("soak", opt, r);
+  CHECK(r.failures == 0);
+  CHECK(r.growingSites.empty());
+  CHECK(r.leakHours == 0);
+  CHECK(r.fragHours == 0);
+
+  if (selfTest) {
+    // DETEKTOR HARUS MENANGKAP KEBOCORAN 256 B PER SINKRON NTP (~6 KB/HARI)
+    SoakOptions leaky;
+    leaky.days = 14;
+    leaky.leakNtp = 256;
+    leaky.quiet = true;
+    SoakReport l = runSoak(leaky);
+    printReport("kebocoran buatan", leaky, l);
+    CHECK(l.leakHours > 0);
+    CHECK(l.growingSites.size() == 1 && strcmp(l.growingSites[0], "ntp") == 0);
+  }
+  return hostResult();
+}
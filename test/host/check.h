@@ -0,0 +1,31 @@
+/*
+ * ASSERT MINIMAL UNTUK UJI HOST: LANJUT SETELAH GAGAL, EXIT CODE DARI hostFailures
+ */
+
+#ifndef JWS_TEST_CHECK_H
+#define JWS_TEST_CHECK_H
+
+#include <stdio.h>
+
+static int hostFailures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+      printf("GAGAL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      hostFailures++; \
+    } \
+  } while (0)
+
+#define CHECK_STR(actual, expected) do { \
+    if (strcmp((actual), (expected)) != 0) { \
+      printf("GAGAL %s:%d: \"%s\" != \"%s\"\n", __FILE__, __LINE__, (actual), (expected)); \
+      hostFailures++; \
+    } \
+  } while (0)
+
+inline int hostResult() {
+  printf(hostFailures ? "GAGAL: %d pemeriksaan\n" : "OK\n", hostFailures);
+  return hostFailures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * PEMBACA data/cities.json UNTUK UJI HOST
+ * Format tetap (array objek datar: api, display, province, lat, lon), jadi cukup
+ * pemindai kecil tanpa pustaka JSON. Escape \" dan \\ didukung, \uXXXX tidak dipakai file ini.
+ */
+
+#ifndef JWS_TEST_CITIES_H
+#define JWS_TEST_CITIES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct HostCity {
+  std::string api;
+  std::string display;
+  std::string province;
+  double lat = 0;
+  double lon = 0;
+};
+
+inline std::string hostReadFile(const char *path) {
+  std::string out;
+  FILE *f = fopen(path, "rb");
+  if (!f) return out;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return out;
+}
+
+inline bool hostParseString(const std::string &s, size_t &i, std::string &out) {
+  if (i >= s.size() || s[i] != '"') return false;
+  out.clear();
+  for (i++; i < s.size(); i++) {
+    char c = s[i];
+    if (c == '"') {
+      i++;
+      return true;
+    }
+    if (c == '\\' && i + 1 < s.size()) c = s[++i];
+    out += c;
+  }
+  return false;
+}
+
+inline void hostSkipSpace(const std::string &s, size_t &i) {
+  while (i < s.size() && (s[i] == ' ' || s[i] == '\n' || s[i] == '\r' || s[i] == '\t' || s[i] == ',')) i++;
+}
+
+// KEMBALIKAN KOSONG JIKA FILE TIDAK ADA ATAU RUSAK
+inline std::vector<HostCity> hostLoadCities(const char *path) {
+  std::vector<HostCity> cities;
+  std::string s = hostReadFile(path);
+  size_t i = s.find('[');
+  if (i == std::string::npos) return cities;
+  i++;
+
+  while (true) {
+    hostSkipSpace(s, i);
+    if (i >= s.size() || s[i] == ']') break;
+    if (s[i] != '{') return {};
+    i++;
+
+    HostCity city;
+    while (true) {
+      hostSkipSpace(s, i);
+      if (i < s.size() && s[i] == '}') {
+        i++;
+        break;
+      }
+      std::string key;
+      if (!hostParseString(s, i, key)) return {};
+      hostSkipSpace(s, i);
+      if (i >= s.size() || s[i] != ':') return {};
+      i++;
+      hostSkipSpace(s, i);
+
+      if (i < s.size() && s[i] == '"') {
+        std::string value;
+        if (!hostParseString(s, i, value)) return {};
+        if (key == "api") city.api = value;
+        else if (key == "display") city.display = value;
+        else if (key == "province") city.province = value;
+      } else {
+        char *end = nullptr;
+        double value = strtod(s.c_str() + i, &end);
+        if (end == s.c_str() + i) return {};
+        i = end - s.c_str();
+        if (key == "lat") city.lat = value;
+        else if (key == "lon") city.lon = value;
+      }
+    }
+    cities.push_back(city);
+  }
+  return cities;
+}
+
+#endif
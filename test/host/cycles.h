@@ -0,0 +1,30 @@
+/*
+ * PENGHITUNG SIKLUS HOST: PADANAN ESP.getCycleCount() UNTUK UJI & BENCHMARK
+ * x86 memakai TSC; arsitektur lain jatuh ke nanodetik steady_clock.
+ */
+
+#ifndef JWS_TEST_CYCLES_H
+#define JWS_TEST_CYCLES_H
+
+#include <stdint.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_CYCLE_UNIT "tsc"
+inline uint64_t hostCycles() { return __rdtsc(); }
+#else
+#define HOST_CYCLE_UNIT "ns"
+inline uint64_t hostCycles() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+// CEGAH OPTIMIZER MEMBUANG HASIL YANG DIUKUR
+template <typename T>
+inline void hostKeep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * EMULATOR DFPLAYER MINI UNTUK UJI HOST (WAKTU VIRTUAL)
+ * Menerima frame perintah dari driver (PLAY, STOP, QUERY STATUS, VOLUME) dan
+ * mengirim balik aliran byte seperti modul asli: frame selesai (default dua kali,
+ * seperti firmware DFPlayer), balasan query, kartu dicabut, error saat kartu tidak
+ * ada. Uji bisa menyisipkan byte mentah: frame terpecah per byte, checksum rusak,
+ * frame terpotong, atau frame selesai basi untuk track lain.
+ */
+
+#ifndef JWS_TEST_DFPLAYER_EMULATOR_H
+#define JWS_TEST_DFPLAYER_EMULATOR_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "dfplayer_driver.h"
+
+#define DFEMU_REPLY_MS 12          // JEDA BALASAN QUERY / ERROR
+#define DFEMU_DUP_FINISH_MS 30     // JEDA FRAME SELESAI KEDUA
+#define DFEMU_ERR_NO_CARD 0x0002
+
+struct DfEmuBytes {
+  uint32_t atMs;
+  uint32_t tag;                    // 0 = TIDAK DIBATALKAN STOP
+  std::vector<uint8_t> bytes;
+};
+
+class DfEmulator {
+ public:
+  std::map<uint16_t, uint32_t> trackMs;      // DURASI PER TRACK
+  bool cardPresent = true;
+  bool answerQuery = true;
+  bool doubleFinish = true;
+  std::vector<std::pair<uint8_t, uint16_t>> commands;   // DITERIMA DARI DRIVER
+  uint32_t badFrames = 0;                               // FRAME DRIVER YANG TIDAK SAH
+
+  // DRIVER -> MODUL
+  void receive(const uint8_t *frame, size_t len, uint32_t now) {
+    for (size_t i = 0; i < len; i++) {
+      if (!dfParserFeed(parser_, frame[i])) continue;
+      handle(parser_.frame[3], dfFrameParam(parser_.frame), now);
+    }
+    if (parser_.pos != 0) badFrames++;
+  }
+
+  // MODUL -> DRIVER
+  void emit(uint32_t at, uint8_t cmd, uint16_t param, uint32_t tag = 0) {
+    uint8_t f[DF_FRAME_SIZE];
+    dfBuildFrame(cmd, param, f);
+    emitRaw(at, std::vector<uint8_t>(f, f + DF_FRAME_SIZE), tag);
+  }
+
+  // FRAME DIKIRIM SATU BYTE PER gapMs (FIFO UART MEMICU onReceive DI TENGAH FRAME)
+  void emitSplit(uint32_t at, uint8_t cmd, uint16_t param, uint32_t gapMs) {
+    uint8_t f[DF_FRAME_SIZE];
+    dfBuildFrame(cmd, param, f);
+    for (int i = 0; i < DF_FRAME_SIZE; i++) emitRaw(at + i * gapMs, std::vector<uint8_t>(1, f[i]));
+  }
+
+  void emitRaw(uint32_t at, const std::vector<uint8_t> &bytes, uint32_t tag = 0) {
+    out_.push_back({ at, tag, bytes });
+    std::stable_sort(out_.begin(), out_.end(),
+                     [](const DfEmuBytes &a, const DfEmuBytes &b) { return a.atMs < b.atMs; });
+  }
+
+  void removeCard(uint32_t now) {
+    cardPresent = false;
+    cancel();
+    emit(now, DF_EVT_CARD_REMOVED, 0x0002);
+  }
+
+  uint32_t nextAt() const {
+    return out_.empty() ? UINT32_MAX : out_.front().atMs;
+  }
+
+  // SEMUA BYTE YANG JATUH TEMPO SAMPAI now, SEBAGAI SATU BURST UART
+  std::vector<uint8_t> take(uint32_t now) {
+    std::vector<uint8_t> burst;
+    while (!out_.empty() && out_.front().atMs <= now) {
+      burst.insert(burst.end(), out_.front().bytes.begin(), out_.front().bytes.end());
+      out_.erase(out_.begin());
+    }
+    return burst;
+  }
+
+  size_t count(uint8_t cmd) const {
+    size_t n = 0;
+    for (const auto &c : commands) n += (c.first == cmd);
+    return n;
+  }
+
+ private:
+  void cancel() {
+    if (playTag_ == 0) return;
+    out_.erase(std::remove_if(out_.begin(), out_.end(), [this](const DfEmuBytes &b) { return b.tag == playTag_; }),
+               out_.end());
+    playTag_ = 0;
+    playEndsAt_ = 0;
+  }
+
+  void handle(uint8_t cmd, uint16_t param, uint32_t now) {
+    commands.push_back({ cmd, param });
+    switch (cmd) {
+      case DF_CMD_PLAY_TRACK: {
+        cancel();
+        auto it = trackMs.find(param);
+        if (!cardPresent || it == trackMs.end()) {
+          emit(now + DFEMU_REPLY_MS, DF_EVT_ERROR, DFEMU_ERR_NO_CARD);
+          break;
+        }
+        playTag_ = ++tags_;
+        playEndsAt_ = now + it->second;
+        emit(playEndsAt_, DF_EVT_SD_FINISHED, param, playTag_);
+        if (doubleFinish) emit(playEndsAt_ + DFEMU_DUP_FINISH_MS, DF_EVT_SD_FINISHED, param, playTag_);
+        break;
+      }
+      case DF_CMD_STOP:
+        cancel();
+        break;
+      case DF_CMD_QUERY_STATUS:
+        if (answerQuery) {
+          bool playing = playTag_ != 0 && (int32_t)(now - playEndsAt_) < 0;
+          emit(now + DFEMU_REPLY_MS, DF_CMD_QUERY_STATUS, 0x0200 | (playing ? 1 : 0));
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  DfParser parser_ = {};
+  std::vector<DfEmuBytes> out_;
+  uint32_t tags_ = 0;
+  uint32_t playTag_ = 0;
+  uint32_t playEndsAt_ = 0;
+};
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * HOOK http_client.h UNTUK HOST: JAM MONOTONIK (BISA DIMAJUKAN) DAN RESOLVER
+ * DNS STAND-IN. Setiap host punya alamat, latensi jawaban dan mode gagal; lookup
+ * selesai hanya ketika httpPoll() memeriksanya setelah latensinya lewat, persis
+ * seperti callback DNS LWIP yang diambil tiap HTTPC_DNS_POLL_MS.
+ */
+
+#ifndef JWS_TEST_HTTP_HOOKS_H
+#define JWS_TEST_HTTP_HOOKS_H
+
+#include <arpa/inet.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <map>
+#include <string>
+
+#include "http_client.h"
+
+struct StandinDnsHost {
+  uint32_t latencyMs;
+  bool fail;
+};
+
+struct StandinDnsTicket {
+  bool busy;
+  std::string host;
+  uint32_t readyAtMs;
+};
+
+static uint32_t hostSkewMs = 0;               // MAJUKAN JAM TANPA MENUNGGU (TTL, IDLE CLOSE)
+static std::map<std::string, StandinDnsHost> standinDnsHosts;
+static StandinDnsTicket standinDnsTickets[HTTPC_CONN_SLOTS];
+static uint32_t standinDnsStarts = 0;
+static uint32_t standinDnsCancels = 0;
+
+uint32_t httpcNowMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000) + hostSkewMs;
+}
+
+void httpcIdle(uint32_t ms) {
+  usleep(ms * 1000);
+}
+
+int httpcDnsStart(const char *host, uint32_t &addr) {
+  standinDnsStarts++;
+  auto it = standinDnsHosts.find(host);
+  if (it == standinDnsHosts.end()) return HTTPC_DNS_FAIL;
+  for (int i = 0; i < HTTPC_CONN_SLOTS; i++) {
+    StandinDnsTicket &t = standinDnsTickets[i];
+    if (t.busy) continue;
+    t.busy = true;
+    t.host = host;
+    t.readyAtMs = httpcNowMs() + it->second.latencyMs;
+    int r = httpcDnsPoll(i, addr);
+    return r == HTTPC_DNS_PENDING ? i : r;
+  }
+  return HTTPC_DNS_FAIL;
+}
+
+int httpcDnsPoll(int ticket, uint32_t &addr) {
+  StandinDnsTicket &t = standinDnsTickets[ticket];
+  if ((int32_t)(httpcNowMs() - t.readyAtMs) < 0) return HTTPC_DNS_PENDING;
+  t.busy = false;
+  const StandinDnsHost &h = standinDnsHosts[t.host];
+  if (h.fail) return HTTPC_DNS_FAIL;
+  addr = htonl(INADDR_LOOPBACK);
+  return HTTPC_DNS_DONE;
+}
+
+void httpcDnsCancel(int ticket) {
+  standinDnsCancels++;
+  standinDnsTickets[ticket].busy = false;
+}
+
+// httpPoll SAMPAI SEMUA FETCH SELESAI (ATAU BATAS PENGAMAN)
+inline void hostHttpRun(HttpFetch *const *fetches, size_t count, uint32_t limitMs = 10000) {
+  uint32_t start = httpcNowMs();
+  while (httpcNowMs() - start < limitMs) {
+    bool active = false;
+    for (size_t i = 0; i < count; i++) active |= httpFetchActive(*fetches[i]);
+    if (!active) return;
+    httpPoll(fetches, count);
+  }
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * HEAP SIMULASI UNTUK SOAK TEST
+ * Arena first-fit dengan header in-band dan penggabungan blok bebas, seperti
+ * heap ESP-IDF secara garis besar: yang diukur sama dengan di perangkat, yaitu
+ * heap bebas total (ESP.getFreeHeap) dan blok bebas terbesar (ESP.getMaxAllocHeap).
+ * Setiap alokasi membawa ID call site agar byte hidup bisa dilacak per site.
+ */
+
+#ifndef JWS_TEST_SOAK_HEAP_H
+#define JWS_TEST_SOAK_HEAP_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#define SOAK_ALIGN 8
+#define SOAK_MIN_SPLIT 32
+
+struct SoakSite {
+  const char *name;
+  uint64_t allocs;
+  uint64_t frees;
+  int64_t live;
+  int64_t peakLive;
+  std::vector<int64_t> daily;    // BYTE HIDUP DI AKHIR SETIAP HARI VIRTUAL
+};
+
+class SoakHeap {
+public:
+  explicit SoakHeap(uint32_t bytes) : arena(bytes & ~(uint32_t)(SOAK_ALIGN - 1)) {
+    Block *b = at(0);
+    b->size = (uint32_t)arena.size();
+    b->site = 0;
+    b->used = 0;
+  }
+
+  int addSite(const char *name) {
+    sites.push_back({ name, 0, 0, 0, 0, {} });
+    return (int)sites.size();   // 0 = BLOK BEBAS
+  }
+
+  // OFFSET PAYLOAD, -1 = GAGAL (TIDAK ADA BLOK CUKUP BESAR)
+  int32_t alloc(int site, uint32_t size) {
+    uint32_t need = (uint32_t)sizeof(Block) + ((size + SOAK_ALIGN - 1) & ~(uint32_t)(SOAK_ALIGN - 1));
+    for (uint32_t off = 0; off < arena.size(); off += at(off)->size) {
+      Block *b = at(off);
+      if (b->used || b->size < need) continue;
+      if (b->size - need >= SOAK_MIN_SPLIT) {
+        Block *rest = at(off + need);
+        rest->size = b->size - need;
+        rest->site = 0;
+        rest->used = 0;
+        b->size = need;
+      }
+      b->used = 1;
+      b->site = (uint16_t)site;
+      SoakSite &s = sites[site - 1];
+      s.allocs++;
+      s.live += b->size;
+      if (s.live > s.peakLive) s.peakLive = s.live;
+      used += b->size;
+      if (used > peakUsed) peakUsed = used;
+      allocCount++;
+      return (int32_t)(off + sizeof(Block));
+    }
+    failures++;
+    return -1;
+  }
+
+  void release(int32_t payload) {
+    if (payload < 0) return;
+    Block *b = at((uint32_t)payload - sizeof(Block));
+    SoakSite &s = sites[b->site - 1];
+    s.frees++;
+    s.live -= b->size;
+    used -= b->size;
+    b->used = 0;
+    b->site = 0;
+    coalesce();
+  }
+
+  uint32_t freeBytes() const { return (uint32_t)arena.size() - used; }
+  uint32_t peak() const { return peakUsed; }
+  uint32_t capacity() const { return (uint32_t)arena.size(); }
+  uint64_t allocations() const { return allocCount; }
+  uint32_t failed() const { return failures; }
+
+  // PAYLOAD TERBESAR YANG MASIH BISA DIALOKASI
+  uint32_t largestFree() const {
+    uint32_t best = 0;
+    for (uint32_t off = 0; off < arena.size(); off += at(off)->size) {
+      const Block *b = at(off);
+      if (!b->used && b->size - sizeof(Block) > best) best = b->size - (uint32_t)sizeof(Block);
+    }
+    return best;
+  }
+
+  void closeDay() {
+    for (SoakSite &s : sites) s.daily.push_back(s.live);
+  }
+
+  std::vector<SoakSite> sites;
+
+private:
+  struct Block {
+    uint32_t size;     // TERMASUK HEADER
+    uint16_t site;
+    uint16_t used;
+  };
+  static_assert(sizeof(Block) == SOAK_ALIGN, "header blok harus 8 byte");
+
+  std::vector<uint8_t> arena;
+  uint32_t used = 0;
+  uint32_t peakUsed = 0;
+  uint64_t allocCount = 0;
+  uint32_t failures = 0;
+
+  Block *at(uint32_t off) { return (Block *)(arena.data() + off); }
+  const Block *at(uint32_t off) const { return (const Block *)(arena.data() + off); }
+
+  void coalesce() {
+    uint32_t off = 0;
+    while (off < arena.size()) {
+      Block *b = at(off);
+      uint32_t next = off + b->size;
+      if (!b->used && next < arena.size() && !at(next)->used) {
+        b->size += at(next)->size;
+        continue;
+      }
+      off = next;
+    }
+  }
+};
+
+#endif
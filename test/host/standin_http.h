@@ -0,0 +1,194 @@
+/*
+ * SERVER HTTP STAND-IN LOKAL UNTUK UJI KLIEN (127.0.0.1, PORT ACAK)
+ * Satu thread menerima koneksi, satu thread per koneksi keep-alive. Setiap
+ * permintaan dijawab menurut StandinBehavior yang bisa diubah di tengah uji:
+ * latensi sebelum header, jeda di tengah body, chunked, tutup setelah respons,
+ * dan kegagalan (status 500, putus tanpa respons, body terpotong) untuk
+ * failCount permintaan berikutnya.
+ */
+
+#ifndef JWS_TEST_STANDIN_HTTP_H
+#define JWS_TEST_STANDIN_HTTP_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum StandinFail : uint8_t {
+  STANDIN_OK = 0,
+  STANDIN_HTTP_500,
+  STANDIN_DROP,           // KONEKSI DITUTUP TANPA SATU BYTE PUN
+  STANDIN_TRUNCATE        // HEADER + SEPARUH BODY, LALU DITUTUP
+};
+
+struct StandinBehavior {
+  uint32_t latencyMs;     // SEBELUM STATUS LINE
+  uint32_t bodyGapMs;     // ANTARA SEPARUH PERTAMA & KEDUA BODY
+  bool chunked;
+  bool closeAfter;        // Connection: close
+  StandinFail fail;
+  uint32_t failCount;     // 0 = SETIAP PERMINTAAN GAGAL SELAMA fail != STANDIN_OK
+};
+
+class StandinServer {
+ public:
+  explicit StandinServer(const std::string &body) : body_(body) {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listenFd_, (sockaddr *)&sa, sizeof(sa));
+    socklen_t len = sizeof(sa);
+    getsockname(listenFd_, (sockaddr *)&sa, &len);
+    port = ntohs(sa.sin_port);
+    listen(listenFd_, 8);
+    acceptor_ = std::thread([this]() { acceptLoop(); });
+  }
+
+  ~StandinServer() {
+    stop_ = true;
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    acceptor_.join();
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      for (int fd : open_) shutdown(fd, SHUT_RDWR);
+    }
+    for (std::thread &t : workers_) t.join();
+  }
+
+  void set(const StandinBehavior &b) {
+    std::lock_guard<std::mutex> lock(mu_);
+    behavior_ = b;
+  }
+
+  uint16_t port = 0;
+  std::atomic<uint32_t> accepts{0};
+  std::atomic<uint32_t> requests{0};
+  std::atomic<uint32_t> failures{0};
+
+ private:
+  void acceptLoop() {
+    while (!stop_) {
+      int fd = accept(listenFd_, NULL, NULL);
+      if (fd < 0) continue;
+      accepts++;
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      std::lock_guard<std::mutex> lock(mu_);
+      open_.push_back(fd);
+      workers_.emplace_back([this, fd]() { serve(fd); });
+    }
+  }
+
+  bool sleepMs(uint32_t ms) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < until) {
+      if (stop_) return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  bool sendAll(int fd, const std::string &s) {
+    size_t off = 0;
+    while (off < s.size()) {
+      ssize_t n = send(fd, s.data() + off, s.size() - off, MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      off += n;
+    }
+    return true;
+  }
+
+  std::string chunk(const std::string &part) {
+    char size[16];
+    snprintf(size, sizeof(size), "%zx\r\n", part.size());
+    return size + part + "\r\n";
+  }
+
+  // false = KONEKSI SELESAI
+  bool respond(int fd) {
+    StandinBehavior b;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      b = behavior_;
+      if (b.fail != STANDIN_OK && b.failCount > 0 && --behavior_.failCount == 0) {
+        behavior_.fail = STANDIN_OK;
+      }
+    }
+    requests++;
+    if (b.fail != STANDIN_OK) failures++;
+    if (!sleepMs(b.latencyMs)) return false;
+    if (b.fail == STANDIN_DROP) return false;
+
+    const std::string body = (b.fail == STANDIN_HTTP_500) ? std::string("{\"code\":500}") : body_;
+    std::string head = (b.fail == STANDIN_HTTP_500) ? "HTTP/1.1 500 Internal Server Error\r\n" : "HTTP/1.1 200 OK\r\n";
+    head += "Content-Type: application/json\r\n";
+    if (b.chunked) {
+      head += "Transfer-Encoding: chunked\r\n";
+    } else {
+      head += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    if (b.closeAfter) head += "Connection: close\r\n";
+    head += "\r\n";
+
+    size_t half = body.size() / 2;
+    std::string first = body.substr(0, half), second = body.substr(half);
+    if (b.chunked) {
+      first = chunk(first);
+      second = chunk(second) + "0\r\n\r\n";
+    }
+    if (!sendAll(fd, head + first)) return false;
+    if (b.fail == STANDIN_TRUNCATE) return false;
+    if (b.bodyGapMs && !sleepMs(b.bodyGapMs)) return false;
+    if (!sendAll(fd, second)) return false;
+    return !b.closeAfter;
+  }
+
+  void serve(int fd) {
+    std::string pending;
+    char buf[512];
+    while (!stop_) {
+      size_t end = pending.find("\r\n\r\n");
+      if (end != std::string::npos) {
+        pending.erase(0, end + 4);
+        if (!respond(fd)) break;
+        continue;
+      }
+      ssize_t n = recv(fd, buf, sizeof(buf), 0);
+      if (n <= 0) break;
+      pending.append(buf, n);
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    shutdown(fd, SHUT_RDWR);
+    close(fd);
+    for (size_t i = 0; i < open_.size(); i++) {
+      if (open_[i] == fd) {
+        open_.erase(open_.begin() + i);
+        break;
+      }
+    }
+  }
+
+  std::string body_;
+  int listenFd_ = -1;
+  std::atomic<bool> stop_{false};
+  std::mutex mu_;
+  StandinBehavior behavior_ = {};
+  std::thread acceptor_;
+  std::vector<std::thread> workers_;
+  std::vector<int> open_;
+};
+
+#endif
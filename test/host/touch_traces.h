@@ -0,0 +1,70 @@
+/*
+ * JEJAK RAW XPT2046 UNTUK UJI KALIBRASI SENTUH
+ * Empat model panel (raw = a*x + b*y + c per sumbu): nominal TS_MIN/TS_MAX, rotasi
+ * 3 derajat, skew 4% + offset, dan sumbu X/Y tertukar. Tiap titik kalibrasi
+ * TOUCH_CAL_TARGET_X/Y berisi 8 sampel berurutan seperti yang dibaca touchTask:
+ * 3 sampel pen-down (yang pertama bergeser karena tekanan ringan), lalu tracking.
+ * Derau gaussian sigma 6 raw dan satu lonjakan SPI ~250 raw per titik.
+ * Dibangkitkan sekali dengan seed tetap.
+ */
+
+#ifndef JWS_TEST_TOUCH_TRACES_H
+#define JWS_TEST_TOUCH_TRACES_H
+
+#include <stdint.h>
+
+#include "touch_math.h"
+
+struct TouchPanelModel {
+  const char *name;
+  double ax, bx, cx;           // RAW X = ax*x + bx*y + cx
+  double ay, by, cy;           // RAW Y = ay*x + by*y + cy
+};
+
+#define TOUCH_TRACE_PANELS 4
+#define TOUCH_TRACE_SAMPLES 8
+
+struct TouchTrace {
+  int16_t x[TOUCH_TRACE_SAMPLES];
+  int16_t y[TOUCH_TRACE_SAMPLES];
+};
+
+static const TouchPanelModel TOUCH_PANELS[TOUCH_TRACE_PANELS] = {
+  { "nominal", 10.4100, 0.0000, 370.0, 0.0000, 13.0400, 470.0 },
+  { "rotasi 3 deg", 10.0862, -0.5286, 420.0, 0.6647, 12.6826, 380.0 },
+  { "skew 4% + offset", 10.8000, 0.4320, 300.0, 0.0000, 13.4000, 520.0 },
+  { "sumbu tertukar", 0.3500, -13.1000, 3650.0, -10.2000, 0.2500, 3620.0 },
+};
+
+static const TouchTrace TOUCH_CAL_TRACES[TOUCH_TRACE_PANELS][TOUCH_CAL_POINTS] = {
+  {   // nominal
+    { {  737,  694,  702,  701,  978,  711,  700,  711 }, {  745,  787,  782,  775,  789,  785,  785,  791 } },
+    { { 3401, 3375, 3363, 3371, 3368, 3374, 3367, 3359 }, {  745,  786,  787,  779,  767,  791,  537,  785 } },
+    { { 2075, 2024, 2033, 2034, 2318, 2032, 2034, 2033 }, { 2006, 2031, 2035, 2028, 2031, 2036, 2041, 2026 } },
+    { {  727,  707,  705,  711,  701,  702,  703,  704 }, { 3253, 3293, 3277, 3290, 3299, 3283, 3047, 3293 } },
+    { { 3406, 3373, 3376, 3373, 3640, 3367, 3374, 3371 }, { 3251, 3290, 3291, 3284, 3276, 3279, 3295, 3286 } },
+  },
+  {   // rotasi 3 deg
+    { {  772,  725,  735,  729, 1009,  722,  725,  736 }, {  681,  697,  708,  705,  708,  711,  700,  700 } },
+    { { 3336, 3321, 3310, 3314, 3320, 3315, 3305, 3305 }, {  857,  881,  889,  869,  874,  877,  625,  871 } },
+    { { 2007, 1966, 1970, 1973, 2254, 1970, 1970, 1957 }, { 1979, 2010, 2005, 2004, 2005, 2020, 2012, 2015 } },
+    { {  661,  634,  626,  627,  632,  621,  620,  636 }, { 3116, 3145, 3141, 3136, 3146, 3144, 2899, 3141 } },
+    { { 3241, 3210, 3196, 3212, 3484, 3210, 3209, 3207 }, { 3276, 3317, 3308, 3310, 3297, 3305, 3302, 3316 } },
+  },
+  {   // skew 4% + offset
+    { {  689,  652,  665,  648,  927,  645,  651,  646 }, {  809,  837,  839,  831,  832,  844,  843,  840 } },
+    { { 3463, 3418, 3423, 3418, 3411, 3417, 3419, 3416 }, {  822,  845,  833,  835,  841,  830,  598,  850 } },
+    { { 2113, 2080, 2082, 2080, 2356, 2075, 2082, 2075 }, { 2102, 2117, 2137, 2137, 2122, 2136, 2128, 2129 } },
+    { {  777,  742,  733,  741,  738,  740,  731,  733 }, { 3370, 3407, 3417, 3419, 3414, 3412, 3185, 3402 } },
+    { { 3537, 3500, 3509, 3503, 3783, 3506, 3498, 3497 }, { 3380, 3419, 3413, 3411, 3415, 3430, 3417, 3404 } },
+  },
+  {   // sumbu tertukar
+    { { 3378, 3357, 3356, 3344, 3623, 3344, 3354, 3355 }, { 3267, 3296, 3302, 3306, 3289, 3316, 3299, 3296 } },
+    { { 3471, 3427, 3434, 3431, 3425, 3439, 3439, 3437 }, {  655,  687,  686,  694,  680,  693,  444,  688 } },
+    { { 2179, 2132, 2118, 2129, 2409, 2140, 2147, 2133 }, { 1992, 2020, 2025, 2014, 2021, 2021, 2030, 2025 } },
+    { {  853,  834,  831,  835,  839,  829,  827,  833 }, { 3316, 3352, 3336, 3348, 3348, 3352, 3110, 3346 } },
+    { {  955,  922,  928,  924, 1197,  917,  918,  927 }, {  708,  736,  736,  739,  736,  735,  738,  729 } },
+  },
+};
+
+#endif
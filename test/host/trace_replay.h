@@ -0,0 +1,331 @@
+/*
+ * PEMUTAR ULANG TRACE /api/trace DENGAN WAKTU VIRTUAL
+ *
+ * Detik +1 yang tidak direkam direkonstruksi dari millis() antar record, lalu
+ * setiap detik virtual dijalankan melalui aturan firmware yang sama:
+ * prayerTriggerIndex/alarmTriggered (clock_trigger.h), routeLookup (route_table.h)
+ * dan touchZoneHit (touch_math.h). State uiTask (kedip 60 s, jendela adzan 10 menit,
+ * alarm menangguhkan kedip) dimodelkan di sini karena bergantung pada LVGL/FreeRTOS.
+ *
+ * Keluaran = daftar event turunan + digest FNV-1a atasnya; digest sama di dua build
+ * berarti logika yang diputar menghasilkan output identik bit-per-bit.
+ */
+
+#ifndef JWS_TEST_TRACE_REPLAY_H
+#define JWS_TEST_TRACE_REPLAY_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "trace_format.h"
+#include "clock_trigger.h"
+#include "route_table.h"
+#include "touch_math.h"
+#include "cycles.h"
+
+#define REPLAY_PRAYERS 7
+#define REPLAY_BLINK_S 60              // BLINK_DURATION
+#define REPLAY_ADZAN_WINDOW_S 600
+#define REPLAY_MAX_GAP_S (2 * 86400)   // CELAH LEBIH PANJANG = TRACE RUSAK
+
+static const char *const REPLAY_PRAYER_KEYS[REPLAY_PRAYERS] = {
+  "imsak", "subuh", "terbit", "zuhur", "ashar", "maghrib", "isya"
+};
+static const bool REPLAY_ADZAN[REPLAY_PRAYERS] = { false, true, false, true, true, true, true };
+static const char *const REPLAY_TYPE_NAMES[] = {
+  "?", "boot", "tick", "ntp", "rtc", "touch", "http_req", "http_api", "wifi", "schedule", "config"
+};
+#define REPLAY_TYPE_COUNT (sizeof(REPLAY_TYPE_NAMES) / sizeof(REPLAY_TYPE_NAMES[0]))
+
+struct ReplayTrace {
+  TraceHeader header;
+  std::vector<TraceRecord> records;
+};
+
+inline bool replayLoad(const char *path, ReplayTrace &trace, std::string &error) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    error = "cannot open file";
+    return false;
+  }
+  bool ok = fread(&trace.header, sizeof(trace.header), 1, f) == 1;
+  if (ok && memcmp(trace.header.magic, "JWST", 4) != 0) {
+    error = "bad magic";
+    ok = false;
+  } else if (ok && trace.header.version != TRACE_FORMAT_VERSION) {
+    error = "unsupported version " + std::to_string(trace.header.version);
+    ok = false;
+  } else if (ok && trace.header.recordSize != sizeof(TraceRecord)) {
+    error = "record size mismatch";
+    ok = false;
+  }
+  if (ok) {
+    trace.records.resize(trace.header.count);
+    if (trace.header.count &&
+        fread(trace.records.data(), sizeof(TraceRecord), trace.header.count, f) != trace.header.count) {
+      error = "truncated";
+      ok = false;
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+inline bool replaySave(const char *path, const ReplayTrace &trace) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(&trace.header, sizeof(trace.header), 1, f) == 1 &&
+            fwrite(trace.records.data(), sizeof(TraceRecord), trace.records.size(), f) == trace.records.size();
+  fclose(f);
+  return ok;
+}
+
+struct ReplayOptions {
+  bool audio = true;                   // dfPlayerAvailable: TANPA AUDIO TIDAK ADA JENDELA ADZAN
+  bool echo = false;                   // CETAK SETIAP EVENT KE stdout
+};
+
+class TraceReplayer {
+public:
+  explicit TraceReplayer(const ReplayOptions &options) : opt(options) {
+    for (int i = 0; i < REPLAY_PRAYERS; i++) minutes[i] = -1;
+  }
+
+  void run(const ReplayTrace &trace) {
+    for (const TraceRecord &r : trace.records) {
+      uint64_t start = hostCycles();
+      feed(r);
+      if (r.type < REPLAY_TYPE_COUNT) {
+        hostCyclesByType[r.type].push_back(hostCycles() - start);
+        if (r.durUs) deviceUsByType[r.type].push_back(r.durUs);
+      }
+    }
+  }
+
+  const std::vector<std::string> &events() const { return log; }
+  uint32_t digest() const { return hash; }
+  int errors() const { return errorCount; }
+
+  // LATENSI PER JENIS: durUs DI PERANGKAT (DIREKAM) DAN SIKLUS REPLAY DI HOST
+  void printLatency(FILE *out) const {
+    fprintf(out, "%-9s %6s %10s %10s %10s %12s\n", "jenis", "n", "dev p50us", "dev p99us", "dev maxus",
+            "host p50 " HOST_CYCLE_UNIT);
+    for (size_t t = 1; t < REPLAY_TYPE_COUNT; t++) {
+      std::vector<uint64_t> host = hostCyclesByType[t];
+      if (host.empty()) continue;
+      std::vector<uint32_t> dev = deviceUsByType[t];
+      std::sort(host.begin(), host.end());
+      std::sort(dev.begin(), dev.end());
+      auto pct = [&](double p) { return dev.empty() ? 0u : dev[(size_t)(p * (dev.size() - 1))]; };
+      fprintf(out, "%-9s %6zu %10u %10u %10u %12llu\n", REPLAY_TYPE_NAMES[t], host.size(),
+              pct(0.5), pct(0.99), dev.empty() ? 0u : dev.back(),
+              (unsigned long long)host[host.size() / 2]);
+    }
+  }
+
+private:
+  ReplayOptions opt;
+  std::vector<std::string> log;
+  uint32_t hash = TRACE_DIGEST_SEED;
+  int errorCount = 0;
+  std::vector<uint64_t> hostCyclesByType[REPLAY_TYPE_COUNT];
+  std::vector<uint32_t> deviceUsByType[REPLAY_TYPE_COUNT];
+
+  // JAM VIRTUAL: EPOCH LOKAL = anchorTime + (ms - anchorMs) / 1000
+  bool haveClock = false;
+  int64_t anchorTime = 0;
+  uint32_t anchorMs = 0;
+  int64_t lastSecond = 0;
+
+  // KONFIGURASI & JADWAL DARI TRACE_CONFIG / TRACE_SCHEDULE
+  int16_t minutes[REPLAY_PRAYERS];
+  uint8_t enabledMask = 0;
+  bool alarmEnabled = false;
+  int alarmMinute = -1;
+
+  // MODEL uiTask
+  bool blinking = false;
+  int64_t blinkEnd = 0;
+  int lastBlinkMinute = -1;
+  int lastAlarmMinute = -1;
+  bool ringing = false;
+  bool canTouch = false;
+  int adzanPrayer = -1;
+  int64_t adzanDeadline = 0;
+
+  void emit(int64_t t, const char *fmt, ...) __attribute__((format(printf, 3, 4))) {
+    char line[160];
+    time_t tt = (time_t)t;
+    struct tm tm;
+    gmtime_r(&tt, &tm);            // currentTime SUDAH WAKTU LOKAL
+    int n = (int)strftime(line, sizeof(line), "%Y-%m-%d %H:%M:%S ", &tm);
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line + n, sizeof(line) - n, fmt, args);
+    va_end(args);
+    log.push_back(line);
+    hash = traceDigest(hash, line, strlen(line));
+    hash = traceDigest(hash, "\n", 1);
+    if (opt.echo) printf("%s\n", line);
+  }
+
+  void error(const char *what, const TraceRecord &r) {
+    errorCount++;
+    emit(haveClock ? lastSecond : 0, "ERROR %s (ms=%u type=%u arg=%u value=%d)",
+         what, r.ms, r.type, r.arg, r.value);
+  }
+
+  // SATU DETIK uiTask: checkPrayerTime LALU checkAlarmTime, SEPERTI URUTAN DI FIRMWARE
+  void second(int64_t t) {
+    int64_t day = t / 86400;
+    if (day != (lastSecond / 86400)) emit(t, "HARI_BARU");
+    lastSecond = t;
+
+    int minuteKey = (int)((t % 86400) / 60);
+    int sec = (int)(t % 60);
+
+    if (blinking && t >= blinkEnd) blinking = false;
+
+    if (!ringing && !blinking && !canTouch) {
+      int due = prayerTriggerIndex(minutes, enabledMask, REPLAY_PRAYERS, minuteKey, sec, lastBlinkMinute);
+      if (due >= 0) {
+        lastBlinkMinute = minuteKey;
+        blinking = true;
+        blinkEnd = t + REPLAY_BLINK_S;
+        if (REPLAY_ADZAN[due] && opt.audio) {
+          canTouch = true;
+          adzanPrayer = due;
+          adzanDeadline = t + REPLAY_ADZAN_WINDOW_S;
+        }
+        emit(t, "KEDIP %s%s", REPLAY_PRAYER_KEYS[due], canTouch ? " ADZAN_SIAP" : "");
+      }
+    }
+
+    if (canTouch && t >= adzanDeadline) {
+      emit(t, "ADZAN_KEDALUWARSA %s", REPLAY_PRAYER_KEYS[adzanPrayer]);
+      canTouch = false;
+      adzanPrayer = -1;
+      lastBlinkMinute = -1;
+    }
+
+    if (alarmEnabled && !ringing && alarmTriggered(alarmMinute, minuteKey, sec, lastAlarmMinute)) {
+      lastAlarmMinute = minuteKey;
+      blinking = false;
+      canTouch = false;
+      ringing = true;
+      emit(t, "ALARM");
+    }
+  }
+
+  // MAJUKAN JAM VIRTUAL KE WAKTU record DENGAN DETIK +1 YANG TERSIRAT
+  void advanceTo(uint32_t ms) {
+    if (!haveClock) return;
+    int64_t target = anchorTime + (int64_t)(uint32_t)(ms - anchorMs) / 1000;
+    if (target - lastSecond > REPLAY_MAX_GAP_S) {
+      lastSecond = target;
+      return;
+    }
+    while (lastSecond < target) second(lastSecond + 1);
+  }
+
+  void setClock(uint32_t ms, int64_t t, bool jump) {
+    if (!haveClock) {
+      haveClock = true;
+      lastSecond = t;
+    } else if (jump) {
+      emit(t, "WAKTU_LOMPAT %+lld s", (long long)(t - lastSecond));
+      lastSecond = t - 1;
+      second(t);
+    } else {
+      while (lastSecond < t) second(lastSecond + 1);
+    }
+    anchorTime = t;
+    anchorMs = ms;
+  }
+
+  void feed(const TraceRecord &r) {
+    if (r.type != TRACE_BOOT && r.type != TRACE_TICK) advanceTo(r.ms);
+
+    switch (r.type) {
+      case TRACE_BOOT:
+        emit(r.value, "BOOT %u us", r.durUs);
+        setClock(r.ms, r.value, false);
+        break;
+
+      case TRACE_TICK:
+        advanceTo(r.ms);
+        setClock(r.ms, r.value, (r.flags & TRACE_F_JUMP) != 0 && haveClock && r.value != lastSecond + 1);
+        break;
+
+      case TRACE_NTP:
+        emit(lastSecond, "NTP %s percobaan=%u", r.value ? "OK" : "GAGAL", r.arg);
+        break;
+
+      case TRACE_RTC:
+        emit(lastSecond, "RTC %s", r.arg ? "VALID" : "TIDAK_VALID");
+        break;
+
+      case TRACE_TOUCH: {
+        if (!(r.flags & TRACE_F_PRESS)) break;
+        int16_t x = (int16_t)(r.value >> 16);
+        int16_t y = (int16_t)(r.value & 0xFFFF);
+        if (ringing) {
+          ringing = false;
+          emit(lastSecond, "ALARM_STOP");
+        } else if (canTouch && adzanPrayer >= 0 && touchZoneHit(PRAYER_TOUCH_ZONES[adzanPrayer], x, y)) {
+          canTouch = false;
+          emit(lastSecond, "ADZAN_PUTAR %s", REPLAY_PRAYER_KEYS[adzanPrayer]);
+          adzanPrayer = -1;
+        }
+        break;
+      }
+
+      case TRACE_HTTP_REQ:
+        if (r.arg >= ROUTE_COUNT || routeLookup(ROUTE_PATHS[r.arg]) != (int)r.arg) {
+          error("route index", r);
+          break;
+        }
+        emit(lastSecond, "HTTP %s m=%u param=%08x", ROUTE_PATHS[r.arg], r.flags, (uint32_t)r.value);
+        break;
+
+      case TRACE_HTTP_API:
+        emit(lastSecond, "API penyedia=%u kode=%d body=%d%s%s", r.flags >> 4, (int16_t)r.arg, r.value,
+             (r.flags & TRACE_F_WARM) ? " warm" : "", (r.flags & TRACE_F_HEDGE) ? " hedge" : "");
+        break;
+
+      case TRACE_WIFI:
+        emit(lastSecond, "WIFI event=%u alasan=%d", r.arg, r.value);
+        break;
+
+      case TRACE_SCHEDULE:
+        if (r.arg >= REPLAY_PRAYERS || r.value < -1 || r.value >= 1440) {
+          error("schedule", r);
+          break;
+        }
+        minutes[r.arg] = (int16_t)r.value;
+        if (r.arg == REPLAY_PRAYERS - 1) {
+          emit(lastSecond, "JADWAL %02d:%02d..%02d:%02d", minutes[0] / 60, minutes[0] % 60,
+               minutes[6] / 60, minutes[6] % 60);
+        }
+        break;
+
+      case TRACE_CONFIG:
+        enabledMask = r.arg & 0x7F;
+        alarmEnabled = (r.arg & TRACE_CONFIG_ALARM) != 0;
+        alarmMinute = r.value;
+        emit(lastSecond, "CONFIG buzzer=%02x alarm=%s %d", enabledMask, alarmEnabled ? "on" : "off", alarmMinute);
+        break;
+
+      default:
+        error("unknown type", r);
+        break;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ * UJI KLIEN HTTP http_client.h TERHADAP SERVER STAND-IN LOKAL
+ * Soket sungguhan ke 127.0.0.1, resolver DNS stand-in dengan latensi yang
+ * disuntikkan. Diukur: latensi dingin (lookup DNS + koneksi TCP baru) vs hangat
+ * (cache DNS + keep-alive), dan dingin lagi setelah TTL DNS & idle close lewat.
+ *
+ * Diperiksa: DNS asinkron (fetch ke host dengan DNS lambat tidak menahan fetch
+ * lain), kegagalan & tenggat saat DNS, body dialirkan utuh (Content-Length dan
+ * chunked), keep-alive yang ditutup server diulang sekali lewat soket baru, dan
+ * pembatalan di tengah body menutup koneksi.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "host/http_hooks.h"
+#include "host/standin_http.h"
+#include "host/check.h"
+
+#define DNS_COLD_MS 40
+#define WARM_RUNS 20
+
+struct BodySink {
+  std::string data;
+  uint32_t calls;
+  uint32_t cancelAfterBytes;   // 0 = TIDAK PERNAH
+};
+
+static bool sinkBody(const uint8_t *data, size_t len, void *ctx) {
+  BodySink &s = *(BodySink *)ctx;
+  s.data.append((const char *)data, len);
+  s.calls++;
+  return true;
+}
+
+static bool sinkCancelled(void *ctx) {
+  BodySink &s = *(BodySink *)ctx;
+  return s.cancelAfterBytes && s.data.size() >= s.cancelAfterBytes;
+}
+
+static void prepare(HttpFetch &f, BodySink &sink, const char *host, uint16_t port, uint32_t timeoutMs = 5000) {
+  memset(&f, 0, sizeof(f));
+  sink = BodySink();
+  f.host = host;
+  f.port = port;
+  f.path = "/v1/timings/19-12-2024?latitude=-6.2&longitude=106.8&method=20";
+  f.deadlineMs = httpcNowMs() + timeoutMs;
+  f.onBody = sinkBody;
+  f.cancelled = sinkCancelled;
+  f.ctx = &sink;
+}
+
+static void fetchOnce(HttpFetch &f) {
+  HttpFetch *list[] = { &f };
+  httpBegin(f);
+  hostHttpRun(list, 1);
+}
+
+// BENTUK RESPONS ALADHAN, ~2 KB AGAR BODY DATANG DALAM BEBERAPA recv()
+static std::string aladhanBody() {
+  std::string s = "{\"code\":200,\"status\":\"OK\",\"data\":{\"timings\":{\"Fajr\":\"04:08\",\"Sunrise\":\"05:25\","
+                  "\"Dhuhr\":\"11:44\",\"Asr\":\"15:10\",\"Maghrib\":\"18:02\",\"Isha\":\"19:17\",\"Imsak\":\"03:58\"},"
+                  "\"meta\":{\"method\":{\"id\":20,\"name\":\"KEMENAG\"},\"padding\":\"";
+  while (s.size() < 2000) s += "0123456789abcdef";
+  return s + "\"}}}";
+}
+
+static uint32_t median(std::vector<uint32_t> v) {
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+int main() {
+  printf("http_client_test\n");
+  signal(SIGPIPE, SIG_IGN);
+
+  const std::string body = aladhanBody();
+  StandinServer primary(body);
+  StandinServer slowDns(body);
+  standinDnsHosts["api.aladhan.test"] = { DNS_COLD_MS, false };
+  standinDnsHosts["lambat.test"] = { 600, false };
+  standinDnsHosts["nxdomain.test"] = { 20, true };
+  standinDnsHosts["macet.test"] = { 5000, false };
+
+  HttpFetch f;
+  BodySink sink;
+
+  // DINGIN: LOOKUP DNS + SOKET BARU
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == 200);
+  CHECK(!f.dnsCached && !f.reused);
+  CHECK(f.dnsMs >= DNS_COLD_MS);
+  CHECK(sink.data == body);
+  CHECK(sink.calls > 1);                             // DIALIRKAN, BUKAN SATU BLOK
+  uint32_t coldMs = f.totalMs;
+  printf("  dingin: total %u ms (DNS %u, connect %u, TTFB %u)\n", f.totalMs, f.dnsMs, f.connectMs, f.ttfbMs);
+
+  // HANGAT: CACHE DNS + KEEP-ALIVE, SATU KONEKSI UNTUK SEMUA
+  std::vector<uint32_t> warm;
+  bool allWarm = true;
+  for (int i = 0; i < WARM_RUNS; i++) {
+    prepare(f, sink, "api.aladhan.test", primary.port);
+    fetchOnce(f);
+    allWarm &= (f.result == 200 && f.reused && f.dnsCached && sink.data == body);
+    warm.push_back(f.totalMs);
+  }
+  CHECK(allWarm);
+  CHECK(primary.accepts == 1);
+  CHECK(standinDnsStarts == 1);
+  CHECK(median(warm) < coldMs);
+  printf("  hangat x%d: median %u ms, maks %u ms, koneksi diterima server %u, lookup DNS %u\n", WARM_RUNS,
+         median(warm), *std::max_element(warm.begin(), warm.end()), primary.accepts.load(), standinDnsStarts);
+
+  // SETELAH 10 MENIT: TTL DNS & IDLE CLOSE LEWAT -> DINGIN LAGI
+  hostSkewMs += HTTPC_DNS_TTL_MS;
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == 200 && !f.reused && !f.dnsCached);
+  CHECK(standinDnsStarts == 2);
+  CHECK(primary.accepts == 2);
+  printf("  dingin setelah TTL: total %u ms (DNS %u)\n", f.totalMs, f.dnsMs);
+
+  // DNS ASINKRON: HOST DENGAN DNS 600 ms TIDAK MENAHAN FETCH KE HOST YANG SUDAH DI CACHE
+  HttpFetch slow, fast;
+  BodySink slowSink, fastSink;
+  prepare(slow, slowSink, "lambat.test", slowDns.port);
+  prepare(fast, fastSink, "api.aladhan.test", primary.port);
+  HttpFetch *both[] = { &slow, &fast };
+  httpBegin(slow);
+  httpBegin(fast);
+  CHECK(slow.phase == HTTP_RESOLVING);
+  bool slowStillResolving = false;
+  while (httpFetchActive(slow) || httpFetchActive(fast)) {
+    httpPoll(both, 2);
+    if (!httpFetchActive(fast) && fast.result != 0 && slowSink.calls == 0) {
+      slowStillResolving |= (slow.phase == HTTP_RESOLVING);
+    }
+  }
+  CHECK(fast.result == 200 && fast.totalMs < 300);
+  CHECK(slowStillResolving);
+  CHECK(slow.result == 200 && slow.dnsMs >= 600);
+  printf("  DNS lambat 600 ms: fetch lain selesai %u ms, fetch DNS lambat %u ms (DNS %u)\n",
+         fast.totalMs, slow.totalMs, slow.dnsMs);
+
+  // DNS GAGAL / LEWAT TENGGAT: LOOKUP DIBATALKAN, JAWABAN TERLAMBAT DIBUANG
+  prepare(f, sink, "nxdomain.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == FETCH_ERR_DNS);
+
+  uint32_t cancels = standinDnsCancels;
+  prepare(f, sink, "macet.test", primary.port, 150);
+  fetchOnce(f);
+  CHECK(f.result == FETCH_ERR_TIMEOUT);
+  CHECK(f.totalMs >= 150 && f.totalMs < 400);
+  CHECK(standinDnsCancels == cancels + 1);
+  CHECK(!standinDnsTickets[0].busy && !standinDnsTickets[1].busy);
+
+  // CHUNKED DENGAN JEDA DI TENGAH BODY
+  primary.set({ 0, 30, true, false, STANDIN_OK, 0 });
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == 200 && sink.data == body);
+
+  // KEEP-ALIVE DITUTUP SERVER TANPA RESPONS: DIULANG SEKALI LEWAT SOKET BARU
+  uint32_t accepts = primary.accepts;
+  primary.set({ 0, 0, false, false, STANDIN_DROP, 1 });
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == 200 && sink.data == body);
+  CHECK(f.retried && !f.reused);
+  CHECK(primary.accepts == accepts + 1);
+
+  // STATUS 500 DIBACA HABIS, BODY TIDAK DIALIRKAN KE CALLBACK, KONEKSI TETAP DIPAKAI
+  primary.set({ 0, 0, false, false, STANDIN_HTTP_500, 1 });
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == 500 && sink.calls == 0 && f.bodyBytes > 0);
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == 200 && f.reused);
+
+  // BODY TERPOTONG: GALAT PROTOKOL
+  primary.set({ 0, 0, false, false, STANDIN_TRUNCATE, 1 });
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  fetchOnce(f);
+  CHECK(f.result == FETCH_ERR_PROTOCOL);
+
+  // DIBATALKAN DI TENGAH BODY: KONEKSI DITUTUP, TIDAK DIKEMBALIKAN KE POOL
+  primary.set({ 0, 200, false, false, STANDIN_OK, 0 });
+  prepare(f, sink, "api.aladhan.test", primary.port);
+  sink.cancelAfterBytes = 1;
+  fetchOnce(f);
+  CHECK(f.result == FETCH_ERR_CANCELLED);
+  CHECK(f.totalMs < 200);
+  bool pooled = false;
+  for (const HttpConn &c : httpConns) pooled |= (c.fd >= 0 && c.port == primary.port);
+  CHECK(!pooled);
+
+  // TENGGAT SAAT MENUNGGU RESPONS
+  primary.set({ 1000, 0, false, false, STANDIN_OK, 0 });
+  prepare(f, sink, "api.aladhan.test", primary.port, 200);
+  fetchOnce(f);
+  CHECK(f.result == FETCH_ERR_TIMEOUT && f.totalMs < 400);
+
+  return hostResult();
+}
@@ -0,0 +1,408 @@
+/*
+ * UJI BEBAN /api/data SAAT /setcity & /setmethod BERSAMAAN (SIMULASI WAKTU VIRTUAL)
+ *
+ * AsyncTCP menjalankan semua callback rute di SATU task: handler yang tidur atau
+ * menulis flash menahan setiap request di belakangnya. Simulasi ini memutar dua
+ * jalur handler yang sama di atas satu server FIFO + jobTask:
+ *   ANTRE  (sekarang): rute memvalidasi, jobBoardOpen + antrean JOB_QUEUE_LENGTH,
+ *                      202 / 503; jobTask menerapkan patch lalu menulis flash.
+ *   INLINE (sebelum 7134c9f): rute mengirim 200, vTaskDelay(50), menulis LittleFS,
+ *                      vTaskDelay(100) bila WiFi terhubung - semua di task AsyncTCP.
+ * Tulis flash ESP32 mematikan cache kedua core: selama jendela itu handler lain
+ * juga berhenti, jadi jalur ANTRE tetap merasakan sebagian biaya flash.
+ *
+ * Biaya per langkah (konstanta SIM_*) adalah ASUMSI, bukan hasil ukur perangkat;
+ * yang diuji adalah bentuk antrean (head-of-line blocking) dan logika job_queue.h.
+ * Diperiksa: p99 /api/data jalur ANTRE di bawah batas dan jauh di bawah INLINE,
+ * setiap job yang diterima selesai dengan slot status utuh walau badai 503
+ * menghabiskan id, dan geseran slider (/setbuzzer beruntun) menghasilkan paling
+ * banyak satu job persist yang menunggu.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "job_queue.h"
+#include "host/check.h"
+
+#define SIM_STEP_US 50
+#define SIM_DURATION_MS 60000
+#define SIM_DRAIN_MAX_MS 600000
+#define SIM_API_DATA_US 1500           // snprintf JSON 1 KB + kirim
+#define SIM_PARSE_US 600               // parseParams + validasi + respons 202
+#define SIM_PERSIST_REQ_US 300         // /setbuzzer: ubah RAM + requestPersist
+#define SIM_APPLY_US 800               // applySettingsPatch DI BAWAH settingsMutex
+#define SIM_FLASH_STALL_US 6000        // CACHE MATI (ERASE/PROGRAM) PER FILE
+#define SIM_FLASH_BUSY_US 30000        // SISA TULIS LITTLEFS (CACHE HIDUP)
+#define SIM_INLINE_PRE_SLEEP_MS 50     // vTaskDelay SETELAH request->send
+#define SIM_INLINE_POST_SLEEP_MS 100   // vTaskDelay SEBELUM MEMICU PEMBARUAN SHALAT
+
+#define SIM_POLLERS 4                  // KLIEN IoT / HOME ASSISTANT
+#define SIM_POLL_MS 500
+#define SIM_WRITERS 2
+#define SIM_WRITE_MS 2000              // TIAP PENULIS, DI LUAR BADAI
+#define SIM_STORM_FROM_MS 20000        // BADAI: SKRIP / TOMBOL SIMPAN DITEKAN BERULANG
+#define SIM_STORM_TO_MS 25000
+#define SIM_STORM_WRITE_MS 60
+#define SIM_SLIDER_FROM_MS 40000       // GESER SLIDER VOLUME
+#define SIM_SLIDER_TO_MS 42000
+#define SIM_SLIDER_MS 20
+
+#define SIM_API_P99_LIMIT_US 12000     // JALUR ANTRE
+#define SIM_INLINE_P99_MIN_US 100000   // JALUR INLINE HARUS TERLIHAT BURUK
+
+enum SimRoute : uint8_t { ROUTE_API_DATA, ROUTE_SET_CITY, ROUTE_SET_METHOD, ROUTE_SET_BUZZER };
+enum SimMode : uint8_t { MODE_QUEUE, MODE_INLINE };
+
+// FASE HANDLER / JOB: CPU (BERHENTI SAAT CACHE MATI), TIDUR, TULIS FLASH
+enum PhaseKind : uint8_t { PH_CPU, PH_SLEEP, PH_FLASH_STALL, PH_FLASH_BUSY, PH_RESPOND, PH_ENQUEUE };
+
+struct Phase {
+  PhaseKind kind;
+  int32_t us;
+};
+
+struct Request {
+  int64_t arriveUs;
+  SimRoute route;
+};
+
+struct Worker {
+  std::vector<Phase> phases;
+  size_t index = 0;
+  int32_t left = 0;
+
+  bool idle() const { return index >= phases.size(); }
+  void start(std::vector<Phase> p) {
+    phases = std::move(p);
+    index = 0;
+    left = phases.empty() ? 0 : phases[0].us;
+  }
+  const Phase *current() const { return idle() ? NULL : &phases[index]; }
+  void next() {
+    index++;
+    if (!idle()) left = phases[index].us;
+  }
+};
+
+struct SimReport {
+  std::vector<int64_t> apiUs;
+  std::vector<int64_t> writeUs;
+  std::vector<int64_t> jobWaitUs;
+  uint32_t accepted = 0;
+  uint32_t rejected = 0;
+  uint32_t jobsDone = 0;
+  uint32_t slotLost = 0;
+  uint32_t persistJobs = 0;
+  uint32_t persistRequests = 0;
+  uint32_t maxPersistQueued = 0;
+};
+
+struct Lcg {
+  uint32_t s;
+  uint32_t next() { return s = s * 1664525u + 1013904223u; }
+  int32_t jitter(int32_t range) { return (int32_t)(next() % (2 * range + 1)) - range; }
+};
+
+static std::vector<Request> makeLoad() {
+  std::vector<Request> load;
+  Lcg rng = { 20241219 };
+
+  for (int c = 0; c < SIM_POLLERS; c++) {
+    for (int64_t t = c * (SIM_POLL_MS / SIM_POLLERS); t < SIM_DURATION_MS; t += SIM_POLL_MS) {
+      load.push_back({ (t * 1000) + rng.jitter(20000), ROUTE_API_DATA });
+    }
+  }
+  for (int w = 0; w < SIM_WRITERS; w++) {
+    int64_t t = 100 + w * 37;
+    bool city = (w == 0);
+    while (t < SIM_DURATION_MS) {
+      load.push_back({ t * 1000 + rng.jitter(5000), city ? ROUTE_SET_CITY : ROUTE_SET_METHOD });
+      city = !city;
+      bool storm = t >= SIM_STORM_FROM_MS && t < SIM_STORM_TO_MS;
+      t += storm ? SIM_STORM_WRITE_MS : SIM_WRITE_MS;
+    }
+  }
+  for (int64_t t = SIM_SLIDER_FROM_MS; t < SIM_SLIDER_TO_MS; t += SIM_SLIDER_MS) {
+    load.push_back({ t * 1000, ROUTE_SET_BUZZER });
+  }
+
+  for (Request &r : load) r.arriveUs = std::max<int64_t>(0, r.arriveUs);
+  std::stable_sort(load.begin(), load.end(),
+                   [](const Request &a, const Request &b) { return a.arriveUs < b.arriveUs; });
+  return load;
+}
+
+static void addFlashWrite(std::vector<Phase> &p) {
+  p.push_back({ PH_FLASH_STALL, SIM_FLASH_STALL_US });
+  p.push_back({ PH_FLASH_BUSY, SIM_FLASH_BUSY_US });
+}
+
+static std::vector<Phase> handlerPhases(SimRoute route, SimMode mode) {
+  std::vector<Phase> p;
+  switch (route) {
+    case ROUTE_API_DATA:
+      p.push_back({ PH_CPU, SIM_API_DATA_US });
+      p.push_back({ PH_RESPOND, 0 });
+      break;
+    case ROUTE_SET_BUZZER:
+      p.push_back({ PH_CPU, SIM_PERSIST_REQ_US });
+      p.push_back({ PH_ENQUEUE, 0 });
+      p.push_back({ PH_RESPOND, 0 });
+      break;
+    case ROUTE_SET_CITY:
+    case ROUTE_SET_METHOD:
+      p.push_back({ PH_CPU, SIM_PARSE_US });
+      if (mode == MODE_QUEUE) {
+        p.push_back({ PH_ENQUEUE, 0 });
+        p.push_back({ PH_RESPOND, 0 });
+      } else {
+        p.push_back({ PH_RESPOND, 0 });
+        p.push_back({ PH_SLEEP, SIM_INLINE_PRE_SLEEP_MS * 1000 });
+        p.push_back({ PH_CPU, SIM_APPLY_US });
+        addFlashWrite(p);
+        p.push_back({ PH_SLEEP, SIM_INLINE_POST_SLEEP_MS * 1000 });
+      }
+      break;
+  }
+  return p;
+}
+
+static int64_t percentile(std::vector<int64_t> v, int pct) {
+  if (v.empty()) return 0;
+  std::sort(v.begin(), v.end());
+  size_t rank = (v.size() * pct + 99) / 100;
+  return v[rank - 1];
+}
+
+static SimReport simulate(SimMode mode) {
+  const std::vector<Request> load = makeLoad();
+  SimReport rep;
+
+  JobBoard board = {};
+  std::deque<Job> queue;                       // xQueueSend / xQueueReceive
+  size_t nextArrival = 0;
+  std::deque<Request> backlog;                 // KONEKSI MENUNGGU TASK AsyncTCP
+
+  Worker server, jobTask;
+  Request serving = {};
+  Job running = {};
+  int64_t runningStartUs = 0;
+  int64_t idleSinceUs = 0;                     // xQueueReceive TIMEOUT -> drainPersist
+
+  // SETELAH BEBAN BERHENTI, JALAN TERUS SAMPAI SEMUA REQUEST & JOB TUNTAS
+  for (int64_t now = 0; now < (int64_t)(SIM_DURATION_MS + SIM_DRAIN_MAX_MS) * 1000; now += SIM_STEP_US) {
+    if (now >= (int64_t)SIM_DURATION_MS * 1000 && nextArrival == load.size() && backlog.empty() &&
+        server.idle() && queue.empty() && jobTask.idle() && running.id == 0) {
+      break;
+    }
+    while (nextArrival < load.size() && load[nextArrival].arriveUs <= now) backlog.push_back(load[nextArrival++]);
+
+    // FASE TANPA DURASI DIPROSES SEGERA
+    while (!server.idle() && server.current()->us == 0) {
+      PhaseKind k = server.current()->kind;
+      if (k == PH_RESPOND) {
+        int64_t latency = now - serving.arriveUs;
+        if (serving.route == ROUTE_API_DATA) rep.apiUs.push_back(latency);
+        else if (serving.route != ROUTE_SET_BUZZER) rep.writeUs.push_back(latency);
+      } else if (k == PH_ENQUEUE) {
+        Job job = {};
+        bool send = true;
+        if (serving.route == ROUTE_SET_BUZZER) {
+          // requestPersist -> queuePersist
+          rep.persistRequests++;
+          job.type = JOB_PERSIST;
+          send = jobBoardAddPersist(board, PERSIST_BUZZER);
+        } else {
+          job.type = JOB_APPLY_SETTINGS;
+          job.settings.force = true;
+          job.settings.hasMethod = (serving.route == ROUTE_SET_METHOD);
+          job.settings.hasCity = (serving.route == ROUTE_SET_CITY);
+        }
+        if (send) {
+          jobBoardOpen(board, job, (unsigned long)(now / 1000));
+          job.queuedAt = (unsigned long)(now / 1000);
+          if (queue.size() < JOB_QUEUE_LENGTH) {
+            queue.push_back(job);
+            if (job.type == JOB_APPLY_SETTINGS) rep.accepted++;
+          } else {
+            // 503 HANYA SAAT ANTREAN PENUH; SLOT JOB YANG MASIH HIDUP TIDAK TERSENTUH
+            jobBoardDrop(board, job.id);
+            if (job.type == JOB_APPLY_SETTINGS) rep.rejected++;
+          }
+        }
+        uint32_t persistQueued = 0;
+        for (const Job &q : queue) persistQueued += (q.type == JOB_PERSIST);
+        rep.maxPersistQueued = std::max(rep.maxPersistQueued, persistQueued);
+      }
+      server.next();
+    }
+    if (server.idle() && !backlog.empty()) {
+      serving = backlog.front();
+      backlog.pop_front();
+      server.start(handlerPhases(serving.route, mode));
+      continue;
+    }
+
+    if (jobTask.idle()) {
+      if (!queue.empty()) {
+        running = queue.front();
+        queue.pop_front();
+        runningStartUs = now;
+        uint32_t waitMs = (uint32_t)(now / 1000 - running.queuedAt);
+        jobBoardUpdate(board, running.id, JOB_RUNNING, waitMs, 0, NULL);
+        rep.jobWaitUs.push_back(now - (int64_t)running.queuedAt * 1000);
+
+        std::vector<Phase> p;
+        if (running.type == JOB_PERSIST) {
+          if (jobBoardTakePersist(board)) addFlashWrite(p);
+        } else {
+          p.push_back({ PH_CPU, SIM_APPLY_US });
+          addFlashWrite(p);
+        }
+        if (p.empty()) p.push_back({ PH_CPU, 1 });
+        jobTask.start(p);
+        idleSinceUs = -1;
+      } else if (idleSinceUs < 0) {
+        idleSinceUs = now;
+      } else if (now - idleSinceUs >= JOB_PERSIST_DRAIN_MS * 1000) {
+        idleSinceUs = now;
+        jobBoardTakePersist(board);
+      }
+    }
+
+    // CACHE MATI SAAT SALAH SATU PIHAK MENULIS FLASH
+    bool stall = (!server.idle() && server.current()->kind == PH_FLASH_STALL) ||
+                 (!jobTask.idle() && jobTask.current()->kind == PH_FLASH_STALL);
+    bool serverCpu = !server.idle() && server.current()->kind == PH_CPU;
+
+    for (Worker *w : { &server, &jobTask }) {
+      const Phase *ph = w->current();
+      if (ph == NULL || ph->us == 0) continue;
+      bool runs = true;
+      if (ph->kind == PH_CPU) {
+        runs = !stall;
+        // jobTask PRIORITAS 1 < AsyncTCP: TIDAK JALAN SELAMA HANDLER MEMAKAI CPU
+        if (w == &jobTask && serverCpu) runs = false;
+      }
+      if (!runs) continue;
+      w->left -= SIM_STEP_US;
+      if (w->left <= 0) w->next();
+    }
+
+    if (!jobTask.idle() || running.id == 0) continue;
+    // JOB SELESAI
+    uint32_t runMs = (uint32_t)((now - runningStartUs) / 1000);
+    if (jobBoardFind(board.status, running.id) == NULL) rep.slotLost++;
+    jobBoardUpdate(board, running.id, JOB_DONE, 0, runMs, "{}");
+    if (running.type == JOB_PERSIST) rep.persistJobs++;
+    else rep.jobsDone++;
+    running = Job();
+    idleSinceUs = now;
+  }
+
+  return rep;
+}
+
+static void print(const char *name, const SimReport &r) {
+  printf("  %-6s /api/data n=%zu p50 %.1f ms, p99 %.1f ms, maks %.1f ms | tulis p99 %.1f ms | "
+         "job %u diterima, %u ditolak 503, tunggu p99 %.0f ms\n",
+         name, r.apiUs.size(), percentile(r.apiUs, 50) / 1000.0, percentile(r.apiUs, 99) / 1000.0,
+         percentile(r.apiUs, 100) / 1000.0, percentile(r.writeUs, 99) / 1000.0, r.accepted, r.rejected,
+         percentile(r.jobWaitUs, 99) / 1000.0);
+}
+
+static void boardChecks() {
+  JobBoard b = {};
+  Job job = {};
+  job.type = JOB_APPLY_SETTINGS;
+
+  // ID MULAI DARI 1, SLOT = id % JOB_STATUS_SLOTS
+  CHECK(jobBoardOpen(b, job, 10) == 1);
+  CHECK(b.status[1].id == 1 && b.status[1].state == JOB_QUEUED && b.status[1].queuedAt == 10);
+  jobBoardUpdate(b, 1, JOB_DONE, 2, 40, "{\"changed\":{}}");
+  const JobStatus *st = jobBoardFind(b.status, 1);
+  CHECK(st != NULL && st->runMs == 40 && strcmp(st->result, "{\"changed\":{}}") == 0);
+  CHECK(jobBoardFind(b.status, 0) == NULL && jobBoardFind(b.status, 9) == NULL);
+
+  // DITOLAK (ANTREAN PENUH): SLOT DIKOSONGKAN, STATUS LAMA DI SLOT LAIN TETAP
+  CHECK(jobBoardOpen(b, job, 11) == 2);
+  jobBoardDrop(b, 2);
+  CHECK(jobBoardFind(b.status, 2) == NULL && jobBoardFind(b.status, 1) != NULL);
+
+  // SLOT JOB SELESAI BOLEH DIPAKAI ULANG: UPDATE UNTUK ID LAMA DIABAIKAN
+  for (int i = 0; i < JOB_STATUS_SLOTS - 1; i++) {
+    uint32_t id = jobBoardOpen(b, job, 12);
+    jobBoardUpdate(b, id, JOB_DONE, 0, 0, NULL);
+  }
+  CHECK(jobBoardFind(b.status, 1) == NULL && jobBoardFind(b.status, 9) != NULL);
+  jobBoardUpdate(b, 1, JOB_FAILED, 0, 0, "basi");
+  CHECK(b.status[1].id == 9 && b.status[1].state == JOB_DONE);
+
+  // BADAI 503: 1 BERJALAN + ANTREAN PENUH, LALU ID DITOLAK BERUNTUN. ID YANG
+  // SLOTNYA MASIH HIDUP DILEWATI, STATUS JOB BERJALAN TIDAK PERNAH HILANG
+  JobBoard storm = {};
+  uint32_t live[JOB_QUEUE_LENGTH + 1];
+  for (int i = 0; i <= JOB_QUEUE_LENGTH; i++) live[i] = jobBoardOpen(storm, job, 20);
+  jobBoardUpdate(storm, live[0], JOB_RUNNING, 0, 0, NULL);
+  for (int i = 0; i < 3 * JOB_STATUS_SLOTS; i++) {
+    uint32_t id = jobBoardOpen(storm, job, 21);
+    for (uint32_t l : live) CHECK(id % JOB_STATUS_SLOTS != l % JOB_STATUS_SLOTS);
+    jobBoardDrop(storm, id);
+  }
+  for (uint32_t l : live) CHECK(jobBoardFind(storm.status, l) != NULL);
+
+  // WRAP 32-BIT: ID 0 DILEWATI
+  b.nextId = UINT32_MAX;
+  CHECK(jobBoardOpen(b, job, 13) == UINT32_MAX);
+  CHECK(jobBoardOpen(b, job, 13) == 1);
+
+  // HASIL PANJANG DIPOTONG, TETAP BERAKHIR NUL
+  char longResult[JOB_RESULT_LEN * 2];
+  memset(longResult, 'x', sizeof(longResult) - 1);
+  longResult[sizeof(longResult) - 1] = '\0';
+  jobBoardUpdate(b, 1, JOB_DONE, 0, 0, longResult);
+  CHECK(strlen(b.status[1].result) == JOB_RESULT_LEN - 1);
+
+  // PERSIST: HANYA BIT PERTAMA YANG MEMINTA JOB
+  CHECK(jobBoardAddPersist(b, PERSIST_BUZZER));
+  CHECK(!jobBoardAddPersist(b, PERSIST_BUZZER));
+  CHECK(!jobBoardAddPersist(b, PERSIST_ALARM));
+  CHECK(jobBoardTakePersist(b) == (PERSIST_BUZZER | PERSIST_ALARM));
+  CHECK(jobBoardTakePersist(b) == 0);
+  CHECK(jobBoardAddPersist(b, PERSIST_SPLASH));
+}
+
+int main() {
+  printf("job_queue_load_test\n");
+  boardChecks();
+
+  SimReport queued = simulate(MODE_QUEUE);
+  SimReport inlined = simulate(MODE_INLINE);
+  print("ANTRE", queued);
+  print("INLINE", inlined);
+  printf("  persist: %u request slider -> %u job, maks %u menunggu di antrean\n",
+         queued.persistRequests, queued.persistJobs, queued.maxPersistQueued);
+
+  CHECK(queued.apiUs.size() == inlined.apiUs.size());
+  CHECK(percentile(queued.apiUs, 99) <= SIM_API_P99_LIMIT_US);
+  CHECK(percentile(inlined.apiUs, 99) >= SIM_INLINE_P99_MIN_US);
+  CHECK(percentile(queued.writeUs, 99) <= SIM_API_P99_LIMIT_US);
+
+  // BADAI MELEBIHI KAPASITAS jobTask: ADA 503, TAPI SEMUA YANG DITERIMA SELESAI
+  CHECK(queued.rejected > 0);
+  CHECK(queued.jobsDone == queued.accepted);
+  CHECK(queued.slotLost == 0);
+  CHECK(percentile(queued.jobWaitUs, 100) <=
+        (int64_t)(JOB_QUEUE_LENGTH + 1) * (SIM_APPLY_US + SIM_FLASH_STALL_US + SIM_FLASH_BUSY_US) * 2);
+
+  // TIAP JOB PERSIST MENULIS FLASH SEKALI UNTUK SEMUA GESERAN SELAMA IA MENUNGGU
+  CHECK(queued.maxPersistQueued <= 1);
+  CHECK(queued.persistJobs >= 1 &&
+        queued.persistJobs <= (SIM_SLIDER_TO_MS - SIM_SLIDER_FROM_MS) * 1000 /
+                              (SIM_FLASH_STALL_US + SIM_FLASH_BUSY_US) + 2);
+  return hostResult();
+}
@@ -0,0 +1,308 @@
+/*
+ * SELF-CHECK route_table.h & param_schema.h + MICROBENCHMARK
+ * - Setiap ROUTE_PATHS menemukan dirinya, path mirip jatuh ke slot kosong.
+ * - Setiap routeOn("...") di jws.ino ada di ROUTE_PATHS dan sebaliknya.
+ * - Skema parameter: wajib, rentang, trim, clip, bool.
+ * - Benchmark: hash sempurna vs pencocokan linear ala AsyncWebServer, dan
+ *   parseParamList vs hasParam/getParam berulang (siklus + alokasi heap).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "route_table.h"
+#include "param_schema.h"
+#include "host/check.h"
+#include "host/cities.h"
+#include "host/cycles.h"
+
+// HITUNG ALOKASI HEAP SELAMA BENCHMARK
+static size_t allocCount = 0;
+
+void *operator new(size_t size) {
+  allocCount++;
+  void *p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// ============================================
+// TABEL RUTE
+// ============================================
+static bool isRoute(const std::string &path) {
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    if (path == ROUTE_PATHS[i]) return true;
+  }
+  return false;
+}
+
+static void testRouteTable() {
+  size_t used = 0;
+  for (size_t i = 0; i < ROUTE_SLOTS; i++) used += ROUTE_INDEX.slot[i] != ROUTE_EMPTY;
+  CHECK(used == ROUTE_COUNT);
+  printf("  %zu rute, %zu slot, seed %u\n", ROUTE_COUNT, ROUTE_SLOTS, ROUTE_SEED);
+
+  size_t nearMiss = 0;
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    std::string path = ROUTE_PATHS[i];
+    CHECK(routeLookup(path.c_str()) == (int)i);
+
+    std::vector<std::string> variants = {
+      path + "/", path + "x", path.substr(0, path.size() - 1), "/api" + path, path + "?a=1",
+    };
+    if (path.size() > 1) {
+      std::string upper = path;
+      upper[1] = (char)toupper((unsigned char)upper[1]);
+      variants.push_back(upper);
+    }
+    for (const std::string &v : variants) {
+      if (isRoute(v)) continue;
+      if (routeLookup(v.c_str()) != -1) {
+        printf("GAGAL: \"%s\" dianggap rute\n", v.c_str());
+        hostFailures++;
+      }
+      nearMiss++;
+    }
+  }
+  CHECK(routeLookup("") == -1);
+  printf("  %zu path mirip ditolak\n", nearMiss);
+}
+
+// routeOn("...") YANG TIDAK ADA DI TABEL HANYA KETAHUAN SAAT BOOT (Serial), JADI DICEK DI SINI
+static void testRoutesRegistered(const char *inoPath) {
+  std::string src = hostReadFile(inoPath);
+  CHECK(!src.empty());
+
+  std::vector<std::string> registered;
+  const std::string key = "routeOn(\"";
+  for (size_t pos = src.find(key); pos != std::string::npos; pos = src.find(key, pos + 1)) {
+    size_t start = pos + key.size();
+    size_t end = src.find('"', start);
+    registered.push_back(src.substr(start, end - start));
+  }
+
+  for (const std::string &path : registered) {
+    if (routeLookup(path.c_str()) < 0) {
+      printf("GAGAL: routeOn(\"%s\") tidak ada di ROUTE_PATHS\n", path.c_str());
+      hostFailures++;
+    }
+  }
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    if (std::find(registered.begin(), registered.end(), ROUTE_PATHS[i]) == registered.end()) {
+      printf("GAGAL: ROUTE_PATHS \"%s\" tanpa routeOn()\n", ROUTE_PATHS[i]);
+      hostFailures++;
+    }
+  }
+  printf("  %zu routeOn() di jws.ino\n", registered.size());
+}
+
+// ============================================
+// SKEMA PARAMETER
+// ============================================
+struct TestPatch {
+  char city[21];
+  int32_t tune[3];
+  bool enabled;
+};
+
+const ParamSpec TEST_SCHEMA[] = {
+  { "city",    PARAM_STR,  PARAM_REQUIRED | PARAM_CLIP, 1, 20, PARAM_FIELD(TestPatch, city) },
+  { "tuneA",   PARAM_INT,  0, -99, 99, PARAM_FIELD(TestPatch, tune[0]) },
+  { "tuneB",   PARAM_INT,  0, -99, 99, PARAM_FIELD(TestPatch, tune[1]) },
+  { "tuneC",   PARAM_INT,  PARAM_REQUIRED, -99, 99, PARAM_FIELD(TestPatch, tune[2]) },
+  { "enabled", PARAM_BOOL, 0, 0, 0, PARAM_FIELD(TestPatch, enabled) }
+};
+
+struct FormParam {
+  std::string name;
+  std::string value;
+  bool post;
+};
+
+static ParamResult parseForm(const std::vector<FormParam> &form, TestPatch &out) {
+  return parseParamList(TEST_SCHEMA, out, form.size(),
+    [&form](size_t i, const char *&name, const char *&value, size_t &len) {
+      if (!form[i].post) return false;
+      name = form[i].name.c_str();
+      value = form[i].value.c_str();
+      len = form[i].value.size();
+      return true;
+    });
+}
+
+static void testParamSchema() {
+  TestPatch patch = {};
+  ParamResult r = parseForm({
+    { "city", "  Kota Bandung Jawa Barat Indonesia  ", true },
+    { "tuneA", " -5 ", true },
+    { "tuneB", "100", true },
+    { "tuneC", "7", false },           // QUERY STRING, BUKAN POST
+    { "enabled", "true", true },
+    { "other", "x", true },
+  }, patch);
+
+  CHECK(r.present == 0x17);
+  CHECK(r.invalid == 0x0C);            // tuneB DI LUAR RENTANG, tuneC WAJIB TAPI TIDAK ADA
+  CHECK_STR(patch.city, "Kota Bandung Jawa Ba");
+  CHECK(patch.tune[0] == -5);
+  CHECK(patch.tune[1] == 0);
+  CHECK(patch.enabled);
+
+  patch = {};
+  r = parseForm({ { "city", "   ", true }, { "tuneC", "12abc", true } }, patch);
+  CHECK(r.invalid == 0x09);            // city KOSONG SETELAH TRIM, tuneC BUKAN ANGKA
+}
+
+// ============================================
+// BENCHMARK
+// ============================================
+struct BenchResult {
+  uint64_t cycles;
+  size_t allocs;
+};
+
+template <typename Fn>
+static BenchResult bench(size_t rounds, Fn fn) {
+  std::vector<uint64_t> runs;
+  size_t allocs = 0;
+  for (int run = 0; run < 21; run++) {
+    size_t before = allocCount;
+    uint64_t start = hostCycles();
+    for (size_t i = 0; i < rounds; i++) fn(i);
+    runs.push_back((hostCycles() - start) / rounds);
+    allocs = (allocCount - before) / rounds;
+  }
+  std::sort(runs.begin(), runs.end());
+  return { runs[runs.size() / 2], allocs };
+}
+
+static void benchRoutes() {
+  // MODEL AsyncCallbackWebHandler::canHandle() PER HANDLER:
+  // _uri != url && !url.startsWith(_uri + "/") -> String SEMENTARA PER HANDLER YANG GAGAL
+  std::vector<std::string> handlers(ROUTE_PATHS, ROUTE_PATHS + ROUTE_COUNT);
+  std::vector<std::string> urls(ROUTE_PATHS, ROUTE_PATHS + ROUTE_COUNT);
+  urls.push_back("/favicon.ico");
+
+  int sink = 0;
+  BenchResult linear = bench(urls.size() * 100, [&](size_t i) {
+    const std::string &url = urls[i % urls.size()];
+    int found = -1;
+    for (size_t k = 0; k < handlers.size(); k++) {
+      if (handlers[k] == url || url.compare(0, handlers[k].size() + 1, handlers[k] + "/") == 0) {
+        found = (int)k;
+        break;
+      }
+    }
+    sink += found;
+  });
+  BenchResult hashed = bench(urls.size() * 100, [&](size_t i) {
+    sink += routeLookup(urls[i % urls.size()].c_str());
+  });
+  hostKeep(sink);
+
+  printf("  lookup rute (%s/request, rata-rata %zu URL): linear %llu + %zu alokasi, "
+         "hash sempurna %llu + %zu alokasi (%.1fx)\n",
+         HOST_CYCLE_UNIT, urls.size(), (unsigned long long)linear.cycles, linear.allocs,
+         (unsigned long long)hashed.cycles, hashed.allocs,
+         hashed.cycles ? (double)linear.cycles / hashed.cycles : 0.0);
+  CHECK(hashed.allocs == 0);
+}
+
+// FORM /setcity: 11 FIELD, POLA LAMA hasParam(n) + getParam(n)->value().toInt() PER FIELD
+static void benchParams() {
+  static const char *NAMES[] = {
+    "city", "cityName", "lat", "lon", "tuneImsak", "tuneSubuh",
+    "tuneTerbit", "tuneZuhur", "tuneAshar", "tuneMaghrib", "tuneIsya"
+  };
+  std::vector<FormParam> form;
+  form.push_back({ "city", "Kota Bandung", true });
+  form.push_back({ "cityName", "Bandung (Kota)", true });
+  form.push_back({ "lat", "-6.9218", true });
+  form.push_back({ "lon", "107.6071", true });
+  for (int k = 4; k < 11; k++) form.push_back({ NAMES[k], std::to_string(k - 6), true });
+
+  struct CityPatch {
+    char city[101];
+    char cityName[101];
+    char lat[21];
+    char lon[21];
+    int32_t tune[7];
+  };
+  static const ParamSpec SCHEMA[] = {
+    { "city",        PARAM_STR, PARAM_REQUIRED | PARAM_CLIP, 0, 100, PARAM_FIELD(CityPatch, city) },
+    { "cityName",    PARAM_STR, PARAM_CLIP, 0, 100, PARAM_FIELD(CityPatch, cityName) },
+    { "lat",         PARAM_STR, PARAM_CLIP, 0, 20,  PARAM_FIELD(CityPatch, lat) },
+    { "lon",         PARAM_STR, PARAM_CLIP, 0, 20,  PARAM_FIELD(CityPatch, lon) },
+    { "tuneImsak",   PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[0]) },
+    { "tuneSubuh",   PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[1]) },
+    { "tuneTerbit",  PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[2]) },
+    { "tuneZuhur",   PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[3]) },
+    { "tuneAshar",   PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[4]) },
+    { "tuneMaghrib", PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[5]) },
+    { "tuneIsya",    PARAM_INT, 0, -99, 99, PARAM_FIELD(CityPatch, tune[6]) }
+  };
+
+  int sink = 0;
+  BenchResult scan = bench(2000, [&](size_t) {
+    // hasParam/getParam MEMBANDINGKAN String NAMA, value() DISALIN KE String SEMENTARA
+    std::string city, cityName, lat, lon;
+    int tune[7] = {};
+    for (int k = 0; k < 11; k++) {
+      std::string name = NAMES[k];
+      bool has = false;
+      for (const FormParam &p : form) {
+        if (p.post && p.name == name) { has = true; break; }
+      }
+      if (!has) continue;
+      for (const FormParam &p : form) {
+        if (!p.post || p.name != name) continue;
+        std::string value = p.value;
+        if (k == 0) city = value;
+        else if (k == 1) cityName = value;
+        else if (k == 2) lat = value;
+        else if (k == 3) lon = value;
+        else tune[k - 4] = atoi(value.c_str());
+        break;
+      }
+    }
+    sink += tune[6] + (int)city.size() + (int)cityName.size() + (int)lat.size() + (int)lon.size();
+  });
+
+  BenchResult schema = bench(2000, [&](size_t) {
+    CityPatch patch;
+    ParamResult r = parseParamList(SCHEMA, patch, form.size(),
+      [&form](size_t i, const char *&name, const char *&value, size_t &len) {
+        name = form[i].name.c_str();
+        value = form[i].value.c_str();
+        len = form[i].value.size();
+        return true;
+      });
+    sink += patch.tune[6] + (int)r.invalid;
+  });
+  hostKeep(sink);
+
+  printf("  parameter /setcity (11 field): hasParam/getParam %llu %s + %zu alokasi, "
+         "skema %llu %s + %zu alokasi\n",
+         (unsigned long long)scan.cycles, HOST_CYCLE_UNIT, scan.allocs,
+         (unsigned long long)schema.cycles, HOST_CYCLE_UNIT, schema.allocs);
+  CHECK(schema.allocs == 0);
+}
+
+int main(int argc, char **argv) {
+  const char *inoPath = argc > 1 ? argv[1] : "../jws.ino";
+
+  printf("route_table_test\n");
+  testRouteTable();
+  testRoutesRegistered(inoPath);
+  testParamSchema();
+  benchRoutes();
+  benchParams();
+  return hostResult();
+}
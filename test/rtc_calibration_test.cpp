@@ -0,0 +1,191 @@
+/*
+ * UJI PENGENDALI AGING rtc_calibration.h TERHADAP DS3231 SIMULASI YANG DRIFT
+ * RTC simulasi: galat kristal tetap + variasi suhu harian, register aging
+ * -0.1 ppm/LSB. Setiap sinkron NTP mengukur fase dengan derau ±2 ms lalu
+ * menjalankan urutan ntpTask: rtcCalOnMeasurement, tulis aging, tulis ulang RTC
+ * jika selisih >= 250 ms (fase direset, baseline diukur ulang).
+ *
+ * Diperiksa: tanda (kristal cepat -> aging positif), gain & batas langkah,
+ * batas register, kemiringan ppm, konvergensi ke target dan interval NTP.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rtc_calibration.h"
+#include "host/check.h"
+
+struct DriftRtc {
+  double crystalPpm;                 // + = CEPAT
+  double tempSwingPpm;               // AMPLITUDO VARIASI HARIAN
+  double offsetMs;                   // FASE RTC - NTP
+  int aging;
+
+  double ratePpm(double t) const {
+    double day = fmod(t, 86400.0) / 86400.0;
+    return crystalPpm + tempSwingPpm * sin(2 * M_PI * day) - RTC_AGING_PPM_PER_LSB * aging;
+  }
+  void advance(double t, double dt) {
+    // INTEGRASI PER MENIT: VARIASI SUHU IKUT TERAKUMULASI
+    for (double s = 0; s < dt; s += 60) {
+      double step = dt - s < 60 ? dt - s : 60;
+      offsetMs += ratePpm(t + s) * step / 1000.0;
+    }
+  }
+};
+
+struct CalRun {
+  int firstStep;                     // AGING SETELAH SEGMEN PERTAMA
+  float firstPpm;
+  int finalAging;
+  int minAging, maxAging;
+  int maxStep;
+  double finalRatePpm;
+  uint32_t finalInterval;
+  double daysToTarget;               // -1 = TIDAK PERNAH
+  int rewrites;
+  int segments;
+};
+
+static uint32_t rng = 12345;
+static double noiseMs() {
+  rng = rng * 1103515245u + 12345u;
+  return ((rng >> 16) % 5) - 2.0;    // -2..+2 ms
+}
+
+static CalRun runCalibration(double crystalPpm, double tempSwingPpm, int days, int initialOffsetMs) {
+  DriftRtc rtc = { crystalPpm, tempSwingPpm, (double)initialOffsetMs, 0 };
+  RtcCalibration cal = { 0, 0.0f, false, 0, 0, 0 };
+  uint32_t interval = NTP_INTERVAL_MIN_S;
+  CalRun run = {};
+  run.daysToTarget = -1;
+  run.firstStep = INT32_MIN;
+
+  const time_t start = 1735689600;   // 2025-01-01 UTC
+  double t = 0;
+  while (t < days * 86400.0) {
+    rtc.advance(t, interval);
+    t += interval;
+
+    int32_t measured = (int32_t)lround(rtc.offsetMs + noiseMs());
+    RtcCalDecision d = rtcCalOnMeasurement(cal, interval, measured, start + (time_t)t);
+    if (d.segmentClosed) {
+      int step = d.aging - cal.aging;
+      if (abs(step) > run.maxStep) run.maxStep = abs(step);
+      cal.aging = (int8_t)d.aging;
+      rtc.aging = d.aging;
+      interval = d.intervalS;
+      run.segments++;
+      if (run.firstStep == INT32_MIN) {
+        run.firstStep = d.aging;
+        run.firstPpm = d.ppm;
+      }
+      if (d.aging < run.minAging) run.minAging = d.aging;
+      if (d.aging > run.maxAging) run.maxAging = d.aging;
+      if (run.daysToTarget < 0 && fabs(rtc.ratePpm(t) - tempSwingPpm * sin(2 * M_PI * fmod(t, 86400.0) / 86400.0)) <= RTC_TARGET_PPM) {
+        run.daysToTarget = t / 86400.0;
+      }
+    }
+    if (d.rewriteRtc) {
+      // saveTimeToRTCAligned + rtcCalibrationRebase
+      rtc.offsetMs = noiseMs() / 2;
+      cal.baselineValid = false;
+      rtcCalOnMeasurement(cal, interval, (int32_t)lround(rtc.offsetMs), start + (time_t)t);
+      run.rewrites++;
+    }
+  }
+  run.finalAging = cal.aging;
+  run.finalRatePpm = crystalPpm - RTC_AGING_PPM_PER_LSB * cal.aging;
+  run.finalInterval = interval;
+  return run;
+}
+
+static void report(const char *name, double ppm, const CalRun &r) {
+  printf("  %-22s kristal %+5.1f ppm: langkah 1 -> aging %d (ukur %+.2f ppm), akhir aging %d, sisa %+.2f ppm, "
+         "target hari %.1f, interval %lu s, tulis ulang RTC %d, segmen %d\n",
+         name, ppm, r.firstStep, r.firstPpm, r.finalAging, r.finalRatePpm, r.daysToTarget,
+         (unsigned long)r.finalInterval, r.rewrites, r.segments);
+}
+
+int main() {
+  printf("rtc_calibration_test\n");
+
+  // KEMIRINGAN: +120 ms DALAM 6 JAM = 5.56 ppm; SEGMEN DIMULAI DARI BASELINE NEGATIF
+  CHECK(fabsf(rtcCalPpm(120, 0, 21600) - 5.5556f) < 0.001f);
+  CHECK(fabsf(rtcCalPpm(-40, 20, 43200) + 1.3889f) < 0.001f);
+  CHECK(rtcCalPpm(10, 0, 0) == 0.0f);
+
+  // TANDA & GAIN: 0.8 ppm -> 8 LSB * 0.5 = 4; -0.8 -> -4; BATAS LANGKAH 8; BATAS REGISTER 100
+  CHECK(rtcCalNextAging(0, 0.8f) == 4);
+  CHECK(rtcCalNextAging(0, -0.8f) == -4);
+  CHECK(rtcCalNextAging(10, 0.04f) == 10);
+  CHECK(rtcCalNextAging(0, 6.0f) == RTC_CAL_MAX_STEP);
+  CHECK(rtcCalNextAging(0, -6.0f) == -RTC_CAL_MAX_STEP);
+  CHECK(rtcCalNextAging(96, 6.0f) == RTC_AGING_LIMIT);
+  CHECK(rtcCalNextAging(-96, -6.0f) == -RTC_AGING_LIMIT);
+
+  // INTERVAL: DALAM TARGET DIGANDAKAN SAMPAI 24 JAM, KELUAR TARGET KEMBALI 1 JAM
+  CHECK(rtcCalNextInterval(3600, 0.2f, 30) == 7200);
+  CHECK(rtcCalNextInterval(57600, 0.2f, 30) == NTP_INTERVAL_MAX_S);
+  CHECK(rtcCalNextInterval(86400, 0.6f, 30) == NTP_INTERVAL_MIN_S);
+  CHECK(rtcCalNextInterval(86400, 0.1f, 150) == NTP_INTERVAL_MIN_S);
+
+  // SEGMEN < 6 JAM TIDAK MENGUBAH APA PUN; TULIS ULANG RTC DI >= 250 ms
+  RtcCalibration cal = { 0, 0.0f, false, 0, 0, 0 };
+  RtcCalDecision d = rtcCalOnMeasurement(cal, 3600, 12, 1000000);
+  CHECK(!d.segmentClosed && cal.baselineValid && cal.baselineOffsetMs == 12);
+  d = rtcCalOnMeasurement(cal, 3600, 300, 1000000 + 3600);
+  CHECK(!d.segmentClosed && d.rewriteRtc && cal.baselineOffsetMs == 12 && cal.lastOffsetMs == 300);
+  d = rtcCalOnMeasurement(cal, 3600, -260, 1000000 + 21600);
+  CHECK(d.segmentClosed && d.rewriteRtc && d.ppm < 0 && d.aging == -RTC_CAL_MAX_STEP);
+  CHECK(cal.aging == 0);                          // PEMANGGIL YANG MENULIS REGISTER
+  CHECK(cal.baselineUtc == 1000000 + 21600 && cal.baselineOffsetMs == -260);
+
+  // FASE 150 ms (DI ANTARA TARGET & AMBANG TULIS): TIDAK DITULIS DI TENGAH SEGMEN,
+  // DITULIS DI AKHIR SEGMEN
+  cal = { 0, 0.0f, false, 0, 0, 0 };
+  rtcCalOnMeasurement(cal, 3600, 150, 2000000);
+  CHECK(!rtcCalOnMeasurement(cal, 3600, 150, 2000000 + 3600).rewriteRtc);
+  d = rtcCalOnMeasurement(cal, 3600, 150, 2000000 + 21600);
+  CHECK(d.segmentClosed && d.rewriteRtc && d.intervalS == NTP_INTERVAL_MIN_S);
+
+  // rtcOffsetAtEdge: ZONA WAKTU, TANDA, PEMBULATAN MILIDETIK
+  CHECK(rtcOffsetAtEdge(1735689600 + 7 * 3600 + 1, 1735689600, 250000, 7) == 750);
+  CHECK(rtcOffsetAtEdge(1735689600 + 7 * 3600, 1735689600, 999999, 7) == -999);
+  CHECK(rtcOffsetAtEdge(0, 1735689600, 0, 0) == INT32_MIN);
+
+  // SIMULASI DRIFT 60 HARI
+  CalRun fast = runCalibration(6.3, 0.3, 60, 0);
+  report("kristal cepat", 6.3, fast);
+  CHECK(fast.firstStep == RTC_CAL_MAX_STEP);
+  CHECK(fabsf(fast.firstPpm - 6.3f) < 0.4f);
+  CHECK(fast.maxStep <= RTC_CAL_MAX_STEP);
+  CHECK(fast.finalAging > 55 && fast.finalAging < 71);
+  CHECK(fabs(fast.finalRatePpm) <= RTC_TARGET_PPM);
+  CHECK(fast.daysToTarget > 0 && fast.daysToTarget < 10);
+  CHECK(fast.finalInterval == NTP_INTERVAL_MAX_S);
+
+  CalRun slow = runCalibration(-2.7, 0.3, 60, 400);
+  report("kristal lambat", -2.7, slow);
+  CHECK(slow.firstStep < 0 && slow.firstStep >= -RTC_CAL_MAX_STEP);
+  CHECK(slow.finalAging < -20 && slow.finalAging > -34);
+  CHECK(fabs(slow.finalRatePpm) <= RTC_TARGET_PPM);
+  CHECK(slow.rewrites >= 1);                      // FASE AWAL 400 ms DITULIS ULANG
+  CHECK(slow.finalInterval == NTP_INTERVAL_MAX_S);
+
+  CalRun near = runCalibration(0.8, 0.0, 30, 0);
+  report("kristal hampir tepat", 0.8, near);
+  CHECK(near.firstStep == 4);
+  CHECK(fabs(near.finalRatePpm) <= RTC_TARGET_PPM);
+
+  // DI LUAR JANGKAUAN REGISTER: AGING TERTAHAN DI BATAS, NTP TETAP TIAP JAM
+  CalRun pinned = runCalibration(14.0, 0.3, 30, 0);
+  report("di luar jangkauan", 14.0, pinned);
+  CHECK(pinned.maxAging == RTC_AGING_LIMIT && pinned.finalAging == RTC_AGING_LIMIT);
+  CHECK(pinned.maxStep <= RTC_CAL_MAX_STEP);
+  CHECK(pinned.finalInterval == NTP_INTERVAL_MIN_S);
+  CHECK(pinned.daysToTarget < 0);
+
+  return hostResult();
+}
@@ -0,0 +1,299 @@
+/*
+ * UJI BALAPAN PENYEDIA schedule_hedge.h TERHADAP SERVER STAND-IN
+ * Dua penyedia (aladhan, mirror) adalah StandinServer lokal dengan latensi dan
+ * kegagalan yang disuntikkan; fetch memakai http_client.h dengan soket sungguhan.
+ * Hook uji mencatat urutan kejadian (mulai, selesai, kalah, menang) beserta waktunya.
+ *
+ * Diperiksa: penyedia kedua tidak dimulai bila yang pertama menjawab dalam anggaran;
+ * hedge tepat setelah hedgeMs saat yang pertama lambat (termasuk saat DNS-nya lambat);
+ * failover segera setelah galat; jawaban tidak valid tidak menang; semua gagal
+ * mengembalikan kode terakhir; generasi digantikan membatalkan semuanya; urutan
+ * berbalik setelah penyedia utama kalah; histogram penyedia yang selalu kalah diparuh.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "host/http_hooks.h"
+#include "host/standin_http.h"
+#include "schedule_hedge.h"
+#include "host/check.h"
+
+#define HEDGE_MS 300
+
+struct RaceEvent {
+  char kind;                   // L = MULAI, F = SELESAI, X = KALAH, W = MENANG
+  uint8_t idx;
+  bool hedge;
+  int code;
+  uint32_t atMs;
+};
+
+struct TestHooks {
+  const char *hosts[SCHEDULE_HTTP_PROVIDERS];
+  uint16_t ports[SCHEDULE_HTTP_PROVIDERS];
+  ProviderStats stats[SCHEDULE_HTTP_PROVIDERS];
+  uint32_t cancelAtMs;         // 0 = GENERASI TIDAK PERNAH DIGANTIKAN
+  uint32_t startMs;
+  std::string bodies[SCHEDULE_HTTP_PROVIDERS];
+  std::vector<RaceEvent> events;
+
+  uint32_t elapsed() {
+    return httpcNowMs() - startMs;
+  }
+  void tick() {}
+  bool superseded() {
+    return cancelAtMs && elapsed() >= cancelAtMs;
+  }
+  void launch(HttpFetch &f, uint8_t slot, uint8_t idx, bool hedge) {
+    memset(&f, 0, sizeof(f));
+    bodies[slot].clear();
+    f.host = hosts[idx];
+    f.port = ports[idx];
+    f.path = "/v1/timings/19-12-2024?latitude=-6.2&longitude=106.8&method=20";
+    f.onBody = [](const uint8_t *data, size_t len, void *ctx) {
+      ((std::string *)ctx)->append((const char *)data, len);
+      return true;
+    };
+    f.ctx = &bodies[slot];
+    f.deadlineMs = httpcNowMs() + 5000;
+    stats[idx].launched++;
+    if (hedge) stats[idx].hedged++;
+    events.push_back({ 'L', idx, hedge, 0, elapsed() });
+  }
+  bool finished(const HttpFetch &f, uint8_t slot, uint8_t idx, bool hedged) {
+    events.push_back({ 'F', idx, hedged, f.result, elapsed() });
+    if (f.result == FETCH_ERR_CANCELLED) return false;
+    bool valid = f.result == 200 && bodies[slot].find("\"Fajr\"") != std::string::npos;
+    providerAccount(stats[idx], f.result, valid, false, f.totalMs);
+    return valid;
+  }
+  void lost(const HttpFetch &f, uint8_t idx) {
+    providerAccount(stats[idx], FETCH_ERR_CANCELLED, false, true, f.totalMs);
+    events.push_back({ 'X', idx, false, FETCH_ERR_CANCELLED, elapsed() });
+  }
+  void won(uint8_t slot, uint8_t idx, bool hedged) {
+    events.push_back({ 'W', idx, hedged, 200, elapsed() });
+  }
+
+  // URUTAN KEJADIAN RINGKAS, MISAL "L0 L1+ F1 X0 W1" (+ = HEDGE)
+  std::string trace() const {
+    std::string s;
+    for (const RaceEvent &e : events) {
+      if (!s.empty()) s += ' ';
+      s += e.kind;
+      s += (char)('0' + e.idx);
+      if (e.kind == 'L' && e.hedge) s += '+';
+    }
+    return s;
+  }
+  const RaceEvent *find(char kind, uint8_t idx) const {
+    for (const RaceEvent &e : events) {
+      if (e.kind == kind && e.idx == idx) return &e;
+    }
+    return NULL;
+  }
+};
+
+static int race(TestHooks &h, const uint8_t *order, uint8_t count, uint32_t hedgeMs, int8_t &winnerIdx) {
+  HttpFetch fetches[SCHEDULE_HTTP_PROVIDERS];
+  memset(fetches, 0, sizeof(fetches));
+  h.events.clear();
+  h.startMs = httpcNowMs();
+  int8_t slot;
+  int code = hedgeRace(fetches, order, count, hedgeMs, h, slot);
+  winnerIdx = slot >= 0 ? (int8_t)order[slot] : -1;
+  printf("    kode %d, %u ms: %s\n", code, h.elapsed(), h.trace().c_str());
+  return code;
+}
+
+static const char *TIMINGS =
+  "{\"code\":200,\"data\":{\"timings\":{\"Fajr\":\"04:08\",\"Sunrise\":\"05:25\",\"Dhuhr\":\"11:44\","
+  "\"Asr\":\"15:10\",\"Maghrib\":\"18:02\",\"Isha\":\"19:17\",\"Imsak\":\"03:58\"}}}";
+
+static void unitChecks() {
+  // PENYEDIA YANG SELALU KALAH: SAMPEL LATENSINYA IKUT MEMICU PARUH
+  ProviderStats loser = {};
+  for (int i = 0; i < 500; i++) providerAccount(loser, FETCH_ERR_CANCELLED, false, true, 3000);
+  CHECK(providerLatencyTotal(loser) <= PROVIDER_DECAY_AT);
+  CHECK(loser.lost == 500);                              // PENGHITUNG SEUMUR BOOT TIDAK DIPARUH
+  CHECK(providerQuantileMs(loser, 90) == 4000);
+
+  // ... DAN PULIH: SETELAH MENANG CEPAT, p90 TURUN DALAM DUA JENDELA PARUH
+  // (TANPA PARUH, 500 SAMPEL KALAH BUTUH ~4500 KEMENANGAN)
+  int recovered = -1;
+  for (int i = 0; i < 4 * PROVIDER_DECAY_AT && recovered < 0; i++) {
+    providerAccount(loser, 200, true, false, 120);
+    if (providerQuantileMs(loser, 90) == 250) recovered = i + 1;
+  }
+  CHECK(recovered > 0 && recovered <= 2 * PROVIDER_DECAY_AT);
+  printf("  penyedia kalah 500x: sampel %u, pulih ke p90 250 ms setelah %d kemenangan\n",
+         providerLatencyTotal(loser), recovered);
+
+  // GALAT & OK SAMA-SAMA DIPARUH
+  ProviderStats flaky = {};
+  for (int i = 0; i < 300; i++) providerAccount(flaky, i % 3 ? 200 : 500, i % 3 != 0, false, 400);
+  CHECK(providerLatencyTotal(flaky) + providerErrorTotal(flaky) <= PROVIDER_DECAY_AT);
+  CHECK(flaky.errors[PROVIDER_ERR_HTTP] > 0 && flaky.ok > flaky.errors[PROVIDER_ERR_HTTP]);
+
+  // KLASIFIKASI GALAT
+  ProviderStats e = {};
+  providerAccount(e, FETCH_ERR_TIMEOUT, false, false, 20000);
+  providerAccount(e, FETCH_ERR_DNS, false, false, 5);
+  providerAccount(e, 503, false, false, 80);
+  providerAccount(e, 200, false, false, 80);
+  CHECK(e.errors[PROVIDER_ERR_TIMEOUT] == 1 && e.errors[PROVIDER_ERR_NETWORK] == 1);
+  CHECK(e.errors[PROVIDER_ERR_HTTP] == 1 && e.errors[PROVIDER_ERR_INVALID] == 1);
+  CHECK(e.ok == 0 && e.lastCode == 200 && providerLatencyTotal(e) == 0);
+
+  // URUTAN: TANPA DATA = URUTAN TABEL, ANGGARAN DEFAULT; NONAKTIF DILEWATI
+  ProviderStats a = {}, b = {};
+  const ProviderStats *both[SCHEDULE_HTTP_PROVIDERS] = { &a, &b };
+  uint8_t order[SCHEDULE_HTTP_PROVIDERS];
+  uint32_t hedgeMs;
+  CHECK(providerOrder(both, order, hedgeMs) == 2 && order[0] == 0 && order[1] == 1);
+  CHECK(hedgeMs == SCHEDULE_HEDGE_DEFAULT_MS);
+  const ProviderStats *onlyMirror[SCHEDULE_HTTP_PROVIDERS] = { NULL, &b };
+  CHECK(providerOrder(onlyMirror, order, hedgeMs) == 1 && order[0] == 1);
+
+  // PENYEDIA CEPAT TAPI SERING GAGAL KALAH DARI YANG LEBIH LAMBAT TAPI ANDAL
+  for (int i = 0; i < 10; i++) providerAccount(a, i < 1 ? 200 : FETCH_ERR_CONNECT, i < 1, false, 200);
+  for (int i = 0; i < 10; i++) providerAccount(b, 200, true, false, 700);
+  CHECK(providerOrder(both, order, hedgeMs) == 2 && order[0] == 1);
+  CHECK(hedgeMs == 1000);
+
+  // ANGGARAN DIJEPIT KE [MIN, MAX]
+  ProviderStats fast = {}, slow = {};
+  providerAccount(fast, 200, true, false, 50);
+  const ProviderStats *fastFirst[SCHEDULE_HTTP_PROVIDERS] = { &fast, NULL };
+  providerOrder(fastFirst, order, hedgeMs);
+  CHECK(hedgeMs == SCHEDULE_HEDGE_MIN_MS);
+  providerAccount(slow, 200, true, false, 30000);
+  const ProviderStats *slowFirst[SCHEDULE_HTTP_PROVIDERS] = { &slow, NULL };
+  providerOrder(slowFirst, order, hedgeMs);
+  CHECK(hedgeMs == SCHEDULE_HEDGE_MAX_MS);
+  CHECK(providerQuantileMs(slow, 50) == SCHEDULE_HTTP_TIMEOUT_MS);
+}
+
+int main() {
+  printf("schedule_hedge_test\n");
+  signal(SIGPIPE, SIG_IGN);
+  unitChecks();
+
+  StandinServer aladhan(TIMINGS);
+  StandinServer mirror(TIMINGS);
+  StandinServer broken("{\"code\":200,\"data\":{}}");
+  standinDnsHosts["aladhan.test"] = { 0, false };
+  standinDnsHosts["mirror.test"] = { 0, false };
+  standinDnsHosts["lambat.test"] = { 800, false };
+
+  TestHooks h = {};
+  h.hosts[0] = "aladhan.test";
+  h.hosts[1] = "mirror.test";
+  h.ports[0] = aladhan.port;
+  h.ports[1] = mirror.port;
+  const uint8_t primaryFirst[] = { 0, 1 };
+  int8_t winner;
+  int code;
+
+  // UTAMA MENJAWAB DALAM ANGGARAN: PENYEDIA KEDUA TIDAK DIMULAI
+  printf("  utama 20 ms, anggaran hedge %d ms\n", HEDGE_MS);
+  aladhan.set({ 20, 0, false, false, STANDIN_OK, 0 });
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == 200 && winner == 0);
+  CHECK(h.trace() == "L0 F0 W0");
+  CHECK(mirror.requests == 0);
+
+  // UTAMA LAMBAT: HEDGE TEPAT SETELAH ANGGARAN, MIRROR MENANG, UTAMA DIBATALKAN
+  printf("  utama 1500 ms, mirror 30 ms\n");
+  aladhan.set({ 1500, 0, false, false, STANDIN_OK, 0 });
+  mirror.set({ 30, 0, false, false, STANDIN_OK, 0 });
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == 200 && winner == 1);
+  CHECK(h.trace() == "L0 L1+ F1 X0 W1");
+  const RaceEvent *hedge = h.find('L', 1);
+  CHECK(hedge && hedge->atMs >= HEDGE_MS && hedge->atMs < HEDGE_MS + 50);
+  CHECK(h.elapsed() < 600);
+  CHECK(h.stats[0].lost == 1 && h.stats[1].wins == 1 && h.stats[1].hedged == 1);
+
+  // UTAMA GAGAL CEPAT (500): FAILOVER SEGERA, BUKAN MENUNGGU ANGGARAN
+  printf("  utama HTTP 500\n");
+  aladhan.set({ 10, 0, false, false, STANDIN_HTTP_500, 1 });
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == 200 && winner == 1);
+  CHECK(h.trace() == "L0 F0 L1 F1 W1");
+  const RaceEvent *failover = h.find('L', 1);
+  CHECK(failover && !failover->hedge && failover->atMs < 100);
+  CHECK(h.stats[0].errors[PROVIDER_ERR_HTTP] == 1 && h.stats[0].lastCode == 500);
+
+  // 200 TANPA WAKTU SHALAT BUKAN JAWABAN VALID
+  printf("  utama 200 tanpa timings\n");
+  h.ports[0] = broken.port;
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == 200 && winner == 1);
+  CHECK(h.trace() == "L0 F0 L1 F1 W1");
+  CHECK(h.stats[0].errors[PROVIDER_ERR_INVALID] == 1);
+  h.ports[0] = aladhan.port;
+
+  // SEMUA GAGAL: KODE TERAKHIR (MIRROR 500 SETELAH UTAMA PUTUS)
+  printf("  utama putus, mirror 500\n");
+  aladhan.set({ 0, 0, false, false, STANDIN_DROP, 0 });
+  mirror.set({ 0, 0, false, false, STANDIN_HTTP_500, 0 });
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == 500 && winner == -1);
+  CHECK(h.trace() == "L0 F0 L1 F1");
+  CHECK(h.find('F', 0) && h.find('F', 0)->code < 0);
+
+  // DNS UTAMA LAMBAT: HEDGE TETAP JALAN SAAT UTAMA MASIH MENUNGGU DNS
+  printf("  DNS utama 800 ms\n");
+  aladhan.set({ 0, 0, false, false, STANDIN_OK, 0 });
+  mirror.set({ 30, 0, false, false, STANDIN_OK, 0 });
+  h.hosts[0] = "lambat.test";
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == 200 && winner == 1);
+  CHECK(h.trace() == "L0 L1+ F1 X0 W1");
+  CHECK(h.find('L', 1) && h.find('L', 1)->atMs < HEDGE_MS + 50);
+  CHECK(h.elapsed() < 800);
+  h.hosts[0] = "aladhan.test";
+
+  // GENERASI DIGANTIKAN DI TENGAH BALAPAN: SEMUA DIBATALKAN, TANPA PEMENANG
+  printf("  digantikan di 450 ms\n");
+  aladhan.set({ 2000, 0, false, false, STANDIN_OK, 0 });
+  mirror.set({ 2000, 0, false, false, STANDIN_OK, 0 });
+  h.cancelAtMs = 450;
+  code = race(h, primaryFirst, 2, HEDGE_MS, winner);
+  CHECK(code == FETCH_ERR_CANCELLED && winner == -1);
+  CHECK(h.trace() == "L0 L1+");
+  CHECK(h.elapsed() >= 450 && h.elapsed() < 600);
+  h.cancelAtMs = 0;
+
+  // URUTAN ADAPTIF: UTAMA 2500 ms KALAH DARI HEDGE PADA ANGGARAN DEFAULT,
+  // BALAPAN BERIKUTNYA MIRROR DIMULAI DULUAN DENGAN ANGGARAN DARI p90-NYA
+  printf("  urutan adaptif: utama 2500 ms\n");
+  TestHooks fresh = {};
+  memcpy(fresh.hosts, h.hosts, sizeof(h.hosts));
+  memcpy(fresh.ports, h.ports, sizeof(h.ports));
+  aladhan.set({ 2500, 0, false, false, STANDIN_OK, 0 });
+  mirror.set({ 30, 0, false, false, STANDIN_OK, 0 });
+  const ProviderStats *stats[SCHEDULE_HTTP_PROVIDERS] = { &fresh.stats[0], &fresh.stats[1] };
+  uint8_t order[SCHEDULE_HTTP_PROVIDERS];
+  uint32_t hedgeMs;
+  uint8_t count = providerOrder(stats, order, hedgeMs);
+  CHECK(order[0] == 0 && hedgeMs == SCHEDULE_HEDGE_DEFAULT_MS);
+  code = race(fresh, order, count, hedgeMs, winner);
+  CHECK(code == 200 && winner == 1);
+  CHECK(fresh.trace() == "L0 L1+ F1 X0 W1");
+
+  count = providerOrder(stats, order, hedgeMs);
+  CHECK(order[0] == 1 && order[1] == 0);
+  CHECK(hedgeMs == SCHEDULE_HEDGE_MIN_MS);
+  code = race(fresh, order, count, hedgeMs, winner);
+  CHECK(code == 200 && winner == 1);
+  CHECK(fresh.trace() == "L1 F1 W1");
+  CHECK(fresh.elapsed() < 200);
+
+  return hostResult();
+}
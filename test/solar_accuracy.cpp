@@ -0,0 +1,223 @@
+/*
+ * UJI AKURASI solar_math.h
+ * Sapuan 30 tahun (2020-2049) x semua kota data/cities.json x semua metode
+ * prayerAnglesFor(), dibandingkan dengan model yang sama dalam double + libm.
+ * Gagal jika galat maksimum > SOLAR_MAX_ERROR_SEC. Juga melaporkan siklus per
+ * solarDayCompute, per kota di solarKernelBatch, dan per hari terhitung.
+ *
+ * Dibangun dua kali oleh Makefile: SOLAR_FAST_MATH=1 (tabel BAM) dan =0 (libm).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "solar_math.h"
+#include "host/cities.h"
+#include "host/cycles.h"
+
+#define SOLAR_MAX_ERROR_SEC 30.0
+#define SWEEP_FIRST_YEAR 2020
+#define SWEEP_YEARS 30
+
+static const int METHODS[] = { 0, 1, 2, 3, 4, 5, 7, 20 };
+static const char *TIME_NAMES[BULK_TIME_COUNT] = {
+  "imsak", "subuh", "terbit", "zuhur", "ashar", "maghrib", "isya"
+};
+
+// ============================================
+// REFERENSI DOUBLE: RUMUS IDENTIK, TANPA BAM/TABEL/POLINOMIAL
+// ============================================
+struct RefDay {
+  double sinDecl;
+  double cosDecl;
+  double decl;
+  double eqt;
+};
+
+static const double REF_DEG = M_PI / 180.0;
+
+static RefDay refDayCompute(int y, int m, int d) {
+  if (m <= 2) {
+    y -= 1;
+    m += 12;
+  }
+  int32_t a = y / 100;
+  int32_t b = 2 - a + a / 4;
+  int32_t days = (1461 * (y + 4716)) / 4 + (306001 * (m + 1)) / 10000 + d + b - 1524 - 2451545;
+  int32_t hours = days * 24 + 5 - 12;
+  double D = hours / 24.0;
+
+  double g = fmod(357.529 + 0.98560028 * D, 360.0);
+  double q = fmod(280.459 + 0.98564736 * D, 360.0);
+  double L = q + 1.915 * sin(g * REF_DEG) + 0.020 * sin(2 * g * REF_DEG);
+  double e = 23.439 - 0.00000036 * D;
+
+  double ra = atan2(cos(e * REF_DEG) * sin(L * REF_DEG), cos(L * REF_DEG)) * 12.0 / M_PI;
+  if (ra < 0) ra += 24.0;
+  double eqt = q / 15.0 - ra;
+  eqt -= 24.0 * floor((eqt + 12.0) / 24.0);
+
+  RefDay sun;
+  sun.sinDecl = sin(e * REF_DEG) * sin(L * REF_DEG);
+  sun.decl = asin(sun.sinDecl);
+  sun.cosDecl = cos(sun.decl);
+  sun.eqt = eqt;
+  return sun;
+}
+
+static void refKernel(const RefDay &sun, const PrayerAngles &angles,
+                      double lat, double lon, double tz, double out[BULK_TIME_COUNT]) {
+  double sinLat = sin(lat * REF_DEG);
+  double cosLat = cos(lat * REF_DEG);
+  auto hourAngle = [&](double depression) {
+    double x = (-sin(depression * REF_DEG) - sinLat * sun.sinDecl) / (cosLat * sun.cosDecl);
+    return acos(fmax(-1.0, fmin(1.0, x))) * 12.0 / M_PI;
+  };
+
+  double zuhur = 12.0 + tz - lon / 15.0 - sun.eqt;
+  out[BULK_ZUHUR] = zuhur;
+  out[BULK_SUBUH] = zuhur - hourAngle(angles.fajr);
+  out[BULK_IMSAK] = out[BULK_SUBUH] - 10.0 / 60.0;
+
+  double sunset = hourAngle(0.833);
+  out[BULK_TERBIT] = zuhur - sunset;
+  out[BULK_MAGHRIB] = zuhur + (angles.maghrib > 0 ? hourAngle(angles.maghrib) : sunset);
+  out[BULK_ISYA] = angles.ishaMinutes > 0 ? out[BULK_MAGHRIB] + angles.ishaMinutes / 60.0
+                                          : zuhur + hourAngle(angles.isha);
+
+  double x = 1.0 + tan(fabs(lat * REF_DEG - sun.decl));
+  double s = 1.0 / sqrt(1.0 + x * x);
+  double ashar = acos(fmax(-1.0, fmin(1.0, (s - sinLat * sun.sinDecl) / (cosLat * sun.cosDecl))));
+  out[BULK_ASHAR] = zuhur + ashar * 12.0 / M_PI;
+}
+
+// ============================================
+// SAPUAN
+// ============================================
+struct WorstCase {
+  double sec = 0;
+  int cityIndex = -1;
+  int method = 0;
+  int y = 0, m = 0, d = 0;
+};
+
+static int daysInMonth(int y, int m) {
+  static const int DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+  bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+  return m == 2 && leap ? 29 : DAYS[m - 1];
+}
+
+static void fillBatch(const std::vector<HostCity> &cities, size_t first, CityBatch &batch) {
+  batch.count = 0;
+  for (size_t i = first; i < cities.size() && batch.count < BULK_BATCH_SIZE; i++) {
+    uint8_t k = batch.count++;
+    batch.lat[k] = (float)cities[i].lat;
+    batch.lon[k] = (float)cities[i].lon;
+    batch.tz[k] = provinceTimezone(cities[i].province.c_str());
+  }
+}
+
+static uint64_t median(std::vector<uint64_t> &v) {
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : "../data/cities.json";
+  std::vector<HostCity> cities = hostLoadCities(path);
+  if (cities.empty()) {
+    fprintf(stderr, "GAGAL MEMBACA %s\n", path);
+    return 2;
+  }
+
+  printf("solar_accuracy SOLAR_FAST_MATH=%d: %zu kota, %d-%d, %zu metode\n",
+         SOLAR_FAST_MATH, cities.size(), SWEEP_FIRST_YEAR, SWEEP_FIRST_YEAR + SWEEP_YEARS - 1,
+         sizeof(METHODS) / sizeof(METHODS[0]));
+
+  WorstCase worst[BULK_TIME_COUNT];
+  uint64_t samples = 0;
+
+  for (int y = SWEEP_FIRST_YEAR; y < SWEEP_FIRST_YEAR + SWEEP_YEARS; y++) {
+    for (int m = 1; m <= 12; m++) {
+      for (int d = 1; d <= daysInMonth(y, m); d++) {
+        SolarDay sun;
+        solarDayCompute(y, m, d, sun);
+        RefDay ref = refDayCompute(y, m, d);
+
+        for (int method : METHODS) {
+          PrayerAngles angles = prayerAnglesFor(method);
+          for (size_t first = 0; first < cities.size(); first += BULK_BATCH_SIZE) {
+            CityBatch batch;
+            fillBatch(cities, first, batch);
+            solarKernelBatch(sun, angles, batch);
+
+            for (uint8_t k = 0; k < batch.count; k++) {
+              double expect[BULK_TIME_COUNT];
+              refKernel(ref, angles, cities[first + k].lat, cities[first + k].lon, batch.tz[k], expect);
+              for (int t = 0; t < BULK_TIME_COUNT; t++) {
+                double err = fabs(batch.times[t][k] - expect[t]) * 3600.0;
+                if (!(err <= worst[t].sec)) {
+                  worst[t] = { err, (int)(first + k), method, y, m, d };
+                }
+              }
+              samples++;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  double maxErr = 0;
+  for (int t = 0; t < BULK_TIME_COUNT; t++) {
+    const WorstCase &w = worst[t];
+    printf("  %-8s max %7.3f s  (%s, metode %d, %04d-%02d-%02d)\n", TIME_NAMES[t], w.sec,
+           w.cityIndex >= 0 ? cities[w.cityIndex].display.c_str() : "-", w.method, w.y, w.m, w.d);
+    if (!(w.sec <= maxErr)) maxErr = w.sec;
+  }
+  printf("  %llu kota-hari, galat maksimum %.3f s (batas %.0f s)\n",
+         (unsigned long long)samples, maxErr, SOLAR_MAX_ERROR_SEC);
+
+  // ============================================
+  // SIKLUS: MEDIAN DARI 365 HARI, SEMUA KOTA, METODE KEMENAG
+  // ============================================
+  std::vector<uint64_t> dayCycles, batchCycles;
+  PrayerAngles angles = prayerAnglesFor(20);
+  uint64_t totalStart = hostCycles();
+  int computedDays = 0;
+  for (int m = 1; m <= 12; m++) {
+    for (int d = 1; d <= daysInMonth(2030, m); d++) {
+      SolarDay sun;
+      uint64_t c0 = hostCycles();
+      solarDayCompute(2030, m, d, sun);
+      dayCycles.push_back(hostCycles() - c0);
+      hostKeep(sun);
+
+      for (size_t first = 0; first < cities.size(); first += BULK_BATCH_SIZE) {
+        CityBatch batch;
+        fillBatch(cities, first, batch);
+        uint64_t c1 = hostCycles();
+        solarKernelBatch(sun, angles, batch);
+        batchCycles.push_back((hostCycles() - c1) / batch.count);
+        hostKeep(batch);
+      }
+      computedDays++;
+    }
+  }
+  uint64_t totalCycles = hostCycles() - totalStart;
+
+  printf("  siklus (%s): solarDayCompute %llu, solarKernelBatch %llu/kota, "
+         "per hari terhitung %llu (1 kota) / %llu (%zu kota)\n",
+         HOST_CYCLE_UNIT, (unsigned long long)median(dayCycles), (unsigned long long)median(batchCycles),
+         (unsigned long long)(median(dayCycles) + median(batchCycles)),
+         (unsigned long long)(totalCycles / computedDays), cities.size());
+
+  if (!(maxErr <= SOLAR_MAX_ERROR_SEC)) {
+    printf("GAGAL: galat %.3f s melebihi %.0f s\n", maxErr, SOLAR_MAX_ERROR_SEC);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
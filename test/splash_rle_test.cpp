@@ -0,0 +1,297 @@
+/*
+ * UJI RLE SNAPSHOT LAYAR splash_rle.h
+ * Encoder diberi strip selebar layar seperti flush LVGL (tinggi strip bervariasi),
+ * hasilnya di-decode ke buffer 320x240 dan dibandingkan piksel demi piksel.
+ *
+ * Diperiksa: byte format pada gambar kecil, batas paket 128 (run & literal),
+ * gambar mirip UI, strip tidak berurutan / tidak selebar layar / melewati bawah,
+ * gambar tidak lengkap, gambar acak melewati SPLASH_MAX_BYTES, sink gagal (malloc),
+ * header salah, file terpotong di setiap jenis posisi, paket run / literal yang
+ * melewati akhir layar, dan sisa byte setelah piksel terakhir.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "splash_rle.h"
+#include "host/check.h"
+
+#define W 320
+#define H 240
+#define TOTAL ((uint32_t)W * H)
+
+struct MemSink {
+  std::vector<uint8_t> data;
+  uint32_t failAt = UINT32_MAX;        // SIMULASI MALLOC GAGAL DI OFFSET INI
+
+  bool put(const uint8_t *p, size_t len, uint32_t offset) {
+    if (offset + len > failAt) return false;
+    CHECK(offset == data.size());
+    data.insert(data.end(), p, p + len);
+    return true;
+  }
+};
+
+struct MemReader {
+  const std::vector<uint8_t> &data;
+  size_t pos;
+
+  bool read(uint8_t *dst, size_t n) {
+    if (pos + n > data.size()) {
+      pos = data.size();
+      return false;
+    }
+    memcpy(dst, data.data() + pos, n);
+    pos += n;
+    return true;
+  }
+};
+
+struct FrameBuffer {
+  std::vector<uint16_t> px;
+  uint32_t pushes = 0;
+  uint16_t maxPush = 0;
+
+  void push(const uint16_t *pixels, uint16_t count) {
+    px.insert(px.end(), pixels, pixels + count);
+    pushes++;
+    if (count > maxPush) maxPush = count;
+  }
+};
+
+// ENCODE DALAM STRIP stripRows BARIS (STRIP TERAKHIR BOLEH LEBIH PENDEK)
+static bool encode(const std::vector<uint16_t> &img, uint16_t w, uint16_t h, int stripRows, MemSink &out,
+                   SplashEncoder &enc) {
+  splashEncodeBegin(enc, out, w, h);
+  enc.active = true;
+  for (int y = 0; y < h; y += stripRows) {
+    int y2 = y + stripRows - 1;
+    if (y2 >= h) y2 = h - 1;
+    splashEncodeArea(enc, out, 0, y, w - 1, y2, img.data() + (size_t)y * w);
+  }
+  enc.active = false;
+  return splashEncodeEnd(enc, out);
+}
+
+// HEADER + PIKSEL; MENGEMBALIKAN PIKSEL YANG DIDORONG, -1 = HEADER DITOLAK
+static long decode(const std::vector<uint8_t> &file, uint16_t w, uint16_t h, FrameBuffer &fb) {
+  MemReader r = { file, 0 };
+  if (!splashReadHeader(r, w, h)) return -1;
+  return (long)splashDecodePixels(r, (uint32_t)w * h, fb);
+}
+
+static void formatChecks() {
+  // A A A B C D D E -> RUN 3, LITERAL 2, RUN 2, LITERAL 1
+  const uint16_t A = 0x1111, B = 0x2222, C = 0x3333, D = 0x4444, E = 0x5555;
+  std::vector<uint16_t> img = { A, A, A, B, C, D, D, E };
+  MemSink out;
+  SplashEncoder enc;
+  CHECK(encode(img, 4, 2, 1, out, enc));
+
+  const uint8_t expect[] = {
+    0x4A, 0x57, 0x53, 0x31, 4, 0, 2, 0,          // "JWS1", 4x2 (LITTLE ENDIAN)
+    0x82, 0x11, 0x11,
+    0x01, 0x22, 0x22, 0x33, 0x33,
+    0x81, 0x44, 0x44,
+    0x00, 0x55, 0x55,
+  };
+  CHECK(out.data.size() == sizeof(expect));
+  CHECK(memcmp(out.data.data(), expect, sizeof(expect)) == 0);
+  CHECK(enc.bytes == sizeof(expect));
+
+  FrameBuffer fb;
+  CHECK(decode(out.data, 4, 2, fb) == 8);
+  CHECK(fb.px == img);
+}
+
+// SATU BARIS PER KASUS: RUN / LITERAL PANJANG DI SEKITAR BATAS 128
+static std::vector<uint16_t> boundaryImage() {
+  std::vector<uint16_t> img(TOTAL, 0x0000);
+  const int lengths[] = { 1, 2, 127, 128, 129, 255, 256, 257, 320 };
+  int row = 0;
+  for (int len : lengths) {
+    // RUN len PIKSEL, LALU LITERAL len PIKSEL (BERGANTIAN 2 WARNA)
+    uint16_t *run = &img[(size_t)row++ * W];
+    for (int i = 0; i < len; i++) run[i] = 0xF800;
+    uint16_t *lit = &img[(size_t)row++ * W];
+    for (int i = 0; i < len; i++) lit[i] = (i & 1) ? 0x07E0 : 0x001F;
+  }
+  // RUN YANG MELINTASI AKHIR BARIS DAN AKHIR STRIP
+  for (int i = W - 50; i < W + 50; i++) img[(size_t)40 * W + i] = 0xFFE0;
+  return img;
+}
+
+// MIRIP LAYAR JWS: LATAR POLOS, KOTAK WAKTU SHOLAT, TEKS (PIKSEL ANTI-ALIAS)
+static std::vector<uint16_t> uiImage() {
+  std::vector<uint16_t> img(TOTAL, 0x18C3);
+  for (int box = 0; box < 6; box++) {
+    int x0 = 8 + (box % 3) * 104, y0 = 120 + (box / 3) * 56;
+    for (int y = y0; y < y0 + 48; y++)
+      for (int x = x0; x < x0 + 96; x++) img[(size_t)y * W + x] = (y == y0 || y == y0 + 47) ? 0xFFFF : 0x2945;
+  }
+  srand(7);
+  for (int glyph = 0; glyph < 400; glyph++) {
+    int x0 = rand() % (W - 8), y0 = rand() % (H - 12);
+    for (int k = 0; k < 20; k++) img[(size_t)(y0 + rand() % 12) * W + x0 + rand() % 8] = (uint16_t)rand();
+  }
+  return img;
+}
+
+static void roundTrip(const char *name, const std::vector<uint16_t> &img, int stripRows) {
+  MemSink out;
+  SplashEncoder enc;
+  bool ok = encode(img, W, H, stripRows, out, enc);
+  CHECK(ok);
+  CHECK(out.data.size() == enc.bytes && enc.bytes <= SPLASH_MAX_BYTES);
+  CHECK(enc.pixels == TOTAL);
+
+  FrameBuffer fb;
+  CHECK(decode(out.data, W, H, fb) == (long)TOTAL);
+  CHECK(fb.px == img);
+  CHECK(fb.maxPush <= SPLASH_MAX_PACKET);
+  printf("  %-10s strip %2d baris: %6u byte (%.1f%% dari raw), %u paket\n", name, stripRows,
+         (unsigned)enc.bytes, enc.bytes * 100.0 / (TOTAL * 2), fb.pushes);
+}
+
+static void encoderFailChecks() {
+  std::vector<uint16_t> img = uiImage();
+  MemSink out;
+  SplashEncoder enc;
+
+  // STRIP MELOMPAT (AREA INVALIDASI PARSIAL, BUKAN RENDER PENUH)
+  splashEncodeBegin(enc, out, W, H);
+  splashEncodeArea(enc, out, 0, 0, W - 1, 9, img.data());
+  splashEncodeArea(enc, out, 0, 20, W - 1, 29, img.data() + 20 * W);
+  CHECK(enc.failed && !splashEncodeEnd(enc, out));
+
+  // TIDAK SELEBAR LAYAR
+  out = MemSink();
+  splashEncodeBegin(enc, out, W, H);
+  splashEncodeArea(enc, out, 0, 0, W - 2, 9, img.data());
+  CHECK(enc.failed);
+  out = MemSink();
+  splashEncodeBegin(enc, out, W, H);
+  splashEncodeArea(enc, out, 1, 0, W - 1, 9, img.data());
+  CHECK(enc.failed);
+
+  // MELEWATI BAWAH LAYAR
+  out = MemSink();
+  splashEncodeBegin(enc, out, W, H);
+  for (int y = 0; y < H - 10; y += 10) splashEncodeArea(enc, out, 0, y, W - 1, y + 9, img.data() + y * W);
+  CHECK(!enc.failed);
+  splashEncodeArea(enc, out, 0, H - 10, W - 1, H, img.data() + (H - 10) * W);
+  CHECK(enc.failed);
+
+  // RENDER BERHENTI DI TENGAH: TIDAK LENGKAP
+  out = MemSink();
+  splashEncodeBegin(enc, out, W, H);
+  for (int y = 0; y < 200; y += 10) splashEncodeArea(enc, out, 0, y, W - 1, y + 9, img.data() + y * W);
+  CHECK(!enc.failed && !splashEncodeEnd(enc, out));
+
+  // GAMBAR ACAK: MELEWATI SPLASH_MAX_BYTES, TIDAK ADA BYTE YANG DITULIS LEWAT BATAS
+  std::vector<uint16_t> noise(TOTAL);
+  srand(11);
+  for (uint16_t &p : noise) p = (uint16_t)rand();
+  out = MemSink();
+  CHECK(!encode(noise, W, H, 24, out, enc));
+  CHECK(enc.failed && out.data.size() <= SPLASH_MAX_BYTES);
+
+  // SINK GAGAL (MALLOC BLOK KE-2 GAGAL)
+  out = MemSink();
+  out.failAt = 2048;
+  CHECK(!encode(boundaryImage(), W, H, 24, out, enc));
+  CHECK(enc.failed && out.data.size() <= 2048);
+}
+
+static void decoderCorruptChecks() {
+  std::vector<uint16_t> img = boundaryImage();
+  MemSink out;
+  SplashEncoder enc;
+  CHECK(encode(img, W, H, 24, out, enc));
+  const std::vector<uint8_t> good = out.data;
+  FrameBuffer fb;
+
+  // HEADER: MAGIC, UKURAN LAYAR, FILE KOSONG / TERPOTONG DI HEADER
+  std::vector<uint8_t> f = good;
+  f[0] ^= 0x01;
+  CHECK(decode(f, W, H, fb) == -1);
+  CHECK(decode(good, H, W, fb) == -1);
+  CHECK(decode(std::vector<uint8_t>(), W, H, fb) == -1);
+  CHECK(decode(std::vector<uint8_t>(good.begin(), good.begin() + 5), W, H, fb) == -1);
+
+  // TERPOTONG DI SETIAP POSISI: PIKSEL YANG DIDORONG SELALU AWALAN YANG BENAR,
+  // TIDAK PERNAH LENGKAP, DAN TIDAK ADA PAKET SETENGAH JADI
+  int cuts = 0;
+  for (size_t len = sizeof(SplashHeader); len < good.size(); len++) {
+    std::vector<uint8_t> cut(good.begin(), good.begin() + len);
+    FrameBuffer part;
+    long drawn = decode(cut, W, H, part);
+    bool prefix = drawn >= 0 && drawn < (long)TOTAL && part.px.size() == (size_t)drawn &&
+                  std::equal(part.px.begin(), part.px.end(), img.begin());
+    if (!prefix) {
+      CHECK(prefix);
+      printf("    terpotong di %zu: %ld piksel\n", len, drawn);
+      break;
+    }
+    cuts++;
+  }
+  printf("  %d posisi potong diperiksa (file %zu byte)\n", cuts, good.size());
+
+  // PAKET RUN YANG MELEWATI AKHIR LAYAR: HANYA DUA PIKSEL TERSISA
+  std::vector<uint16_t> tiny = { 1, 2, 3, 4, 5, 6 };
+  out = MemSink();
+  CHECK(encode(tiny, 3, 2, 1, out, enc));
+  f.assign(out.data.begin(), out.data.begin() + sizeof(SplashHeader));
+  const uint8_t overRun[] = { 0x03, 1, 0, 2, 0, 3, 0, 4, 0, 0x82, 9, 0 };   // 4 LITERAL + RUN 3 > 6
+  f.insert(f.end(), overRun, overRun + sizeof(overRun));
+  fb = FrameBuffer();
+  CHECK(decode(f, 3, 2, fb) == 4);
+  CHECK(fb.px.size() == 4 && fb.pushes == 1);
+
+  // PAKET LITERAL YANG MELEWATI AKHIR LAYAR
+  f.resize(sizeof(SplashHeader));
+  const uint8_t overLit[] = { 0x06, 1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 0, 7, 0 };   // LITERAL 7 > 6
+  f.insert(f.end(), overLit, overLit + sizeof(overLit));
+  fb = FrameBuffer();
+  CHECK(decode(f, 3, 2, fb) == 0 && fb.pushes == 0);
+
+  // FILE BUATAN TANGAN: 600 RUN 128 (0xFF) MENGISI 320x240 PERSIS
+  f.resize(sizeof(SplashHeader));
+  f[4] = W & 0xFF;
+  f[5] = W >> 8;
+  f[6] = H;
+  f[7] = 0;
+  for (uint32_t n = 0; n < TOTAL / 128; n++) {
+    f.push_back(0xFF);
+    f.push_back(0x34);
+    f.push_back(0x12);
+  }
+  fb = FrameBuffer();
+  CHECK(decode(f, W, H, fb) == (long)TOTAL && fb.px[TOTAL - 1] == 0x1234);
+  // SATU RUN DIHAPUS DARI TENGAH: KURANG 128 PIKSEL
+  f.erase(f.begin() + sizeof(SplashHeader) + 300 * 3, f.begin() + sizeof(SplashHeader) + 301 * 3);
+  fb = FrameBuffer();
+  CHECK(decode(f, W, H, fb) == (long)(TOTAL - 128));
+
+  // SISA BYTE SETELAH PIKSEL TERAKHIR DIABAIKAN (FORMAT TIDAK MENYIMPAN PANJANG)
+  f = good;
+  f.push_back(0x7F);
+  fb = FrameBuffer();
+  CHECK(decode(f, W, H, fb) == (long)TOTAL && fb.px == img);
+}
+
+int main() {
+  printf("splash_rle_test\n");
+  formatChecks();
+  roundTrip("batas-128", boundaryImage(), 24);
+  roundTrip("batas-128", boundaryImage(), 7);
+  roundTrip("ui", uiImage(), 24);
+  roundTrip("ui", uiImage(), 240);
+  roundTrip("polos", std::vector<uint16_t>(TOTAL, 0x18C3), 1);
+  encoderFailChecks();
+  decoderCorruptChecks();
+  return hostResult();
+}
@@ -0,0 +1,233 @@
+/*
+ * UJI FAN-OUT STATE HALAMAN WEB: ENDPOINT /get* LAMA vs SATU /api/v2/state
+ *
+ * Sebelum 074c3c7 halaman mengambil konfigurasi per seksi: /api/connection-type
+ * saat skrip dimuat, lalu tiap tab memanggil loader-nya berurutan (tab Lokasi:
+ * kota lalu metode, tab Jadwal: waktu, metode, buzzer). Sekarang semua loader
+ * memanggil getState() yang digabung jadi satu request, dan browser
+ * merevalidasi dengan If-None-Match sehingga state yang sama dijawab 304.
+ *
+ * Body diukur dari formatStateDocument dengan nilai yang sama seperti bench:
+ * format snprintf rute lama identik dengan seksi dokumen, jadi body rute lama =
+ * seksi yang dipotong dari dokumen. Yang dihitung: jumlah request, jumlah
+ * round-trip berurutan (jalur kritis) dan byte body JSON; header HTTP dan
+ * /getcities (di luar state, sama di kedua versi) tidak dihitung.
+ * Diperiksa juga: setiap getStateSection('x', '/url') di ../data/index.html
+ * menunjuk seksi yang ada di dokumen dan endpoint lama yang dikenal.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "state_document.h"
+#include "host/check.h"
+
+#define FANOUT_POLL_PER_MIN 12         // loadSavedPrayerTimes TIAP 5 DETIK DI TAB JADWAL
+
+struct LegacySection {
+  const char *section;                 // KUNCI DI DOKUMEN STATE ("" = TIDAK ADA)
+  const char *url;
+};
+
+static const LegacySection LEGACY[] = {
+  { "wifi",        "/getwificonfig" },
+  { "timezone",    "/gettimezone" },
+  { "method",      "/getmethod" },
+  { "city",        "/getcityinfo" },
+  { "prayerTimes", "/getprayertimes" },
+  { "buzzer",      "/getbuzzerconfig" },
+  { "",            "/api/connection-type" },
+};
+#define LEGACY_COUNT (sizeof(LEGACY) / sizeof(LEGACY[0]))
+
+// SATU AKSI HALAMAN: TAHAP BERURUTAN, TIAP TAHAP BERISI REQUEST PARALEL
+struct PageAction {
+  const char *name;
+  std::vector<std::vector<const char *>> before;
+  int afterStages;                     // TAHAP /api/v2/state (PALING BANYAK 1 REQUEST)
+};
+
+static const std::vector<PageAction> &pageActions() {
+  static const std::vector<PageAction> actions = {
+    { "muat halaman", { { "/api/connection-type" } }, 1 },
+    { "tab WiFi",     { { "/getwificonfig" } }, 1 },
+    { "tab Waktu",    { { "/gettimezone" } }, 1 },
+    { "tab Lokasi",   { { "/getcityinfo" }, { "/getmethod" } }, 1 },
+    { "tab Jadwal",   { { "/getprayertimes" }, { "/getmethod" }, { "/getbuzzerconfig" } }, 1 },
+  };
+  return actions;
+}
+
+static void fillFields(StateDocFields &s) {
+  memset(&s, 0, sizeof(s));
+  s.version = 42;
+  s.routerSSID = "Masjid-AlIkhlas";
+  s.routerPassword = "rahasia123";
+  s.apSSID = "JWS-Masjid";
+  s.apPassword = "12345678";
+  s.apIP = "192.168.4.1";
+  s.apGateway = "192.168.4.1";
+  s.apSubnet = "255.255.255.0";
+  s.timezoneOffset = 7;
+  s.methodId = 20;
+  s.methodName = "Kementerian Agama Republik Indonesia";
+  s.selectedCity = "Kota Bandung";
+  s.latitude = "-6.9218";
+  s.longitude = "107.6071";
+  static const char *times[] = { "04:21", "04:31", "05:47", "11:58", "15:14", "17:59", "19:12" };
+  for (int i = 0; i < STATE_DOC_TIMES; i++) {
+    s.tune[i] = i - 3;
+    s.times[i] = times[i];
+    s.buzzer[i] = i % 2;
+  }
+  s.alarmEnabled = true;
+  s.alarmTime = "03:30";
+  s.volume = 80;
+  for (int i = 0; i < STATE_DOC_PATTERNS; i++) s.patterns[i] = "double";
+}
+
+// OBJEK "key":{...} DARI DOKUMEN (KURUNG DIPASANGKAN), "" BILA TIDAK ADA
+static std::string sectionOf(const std::string &doc, const char *key) {
+  std::string needle = std::string("\"") + key + "\":{";
+  size_t start = doc.find(needle);
+  if (start == std::string::npos) return "";
+  start += needle.size() - 1;
+
+  int depth = 0;
+  bool inString = false;
+  for (size_t i = start; i < doc.size(); i++) {
+    char c = doc[i];
+    if (c == '"' && doc[i - 1] != '\\') inString = !inString;
+    if (inString) continue;
+    if (c == '{') depth++;
+    if (c == '}' && --depth == 0) return doc.substr(start, i - start + 1);
+  }
+  return "";
+}
+
+static size_t legacyBytes(const std::string &doc, const char *url) {
+  for (size_t i = 0; i < LEGACY_COUNT; i++) {
+    if (strcmp(LEGACY[i].url, url) != 0) continue;
+    if (LEGACY[i].section[0] != '\0') return sectionOf(doc, LEGACY[i].section).size();
+
+    // SAMA DENGAN snprintf DI RUTE /api/connection-type
+    char buf[192];
+    return snprintf(buf, sizeof(buf),
+      "{\"isLocalAP\":%s,\"clientIP\":\"%s\",\"apIP\":\"%s\",\"apSubnet\":\"%s\"}",
+      "false", "192.168.1.37", "192.168.4.1", "255.255.255.0");
+  }
+  CHECK(!"url lama tidak dikenal");
+  return 0;
+}
+
+static std::string readFile(const char *path) {
+  std::string out;
+  FILE *f = fopen(path, "rb");
+  if (!f) return out;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return out;
+}
+
+// ============================================
+// HALAMAN: SETIAP getStateSection MENUNJUK SEKSI YANG ADA
+// ============================================
+static void pageChecks(const std::string &doc, const char *htmlPath) {
+  std::string html = readFile(htmlPath);
+  CHECK(!html.empty());
+  if (html.empty()) return;
+
+  const std::string call = "getStateSection('";
+  size_t found = 0;
+  for (size_t pos = html.find(call); pos != std::string::npos; pos = html.find(call, pos + 1)) {
+    size_t keyStart = pos + call.size();
+    size_t keyEnd = html.find('\'', keyStart);
+    size_t urlStart = html.find('\'', keyEnd + 1) + 1;
+    size_t urlEnd = html.find('\'', urlStart);
+    std::string key = html.substr(keyStart, keyEnd - keyStart);
+    std::string url = html.substr(urlStart, urlEnd - urlStart);
+
+    bool known = false;
+    for (size_t i = 0; i < LEGACY_COUNT; i++) {
+      if (key == LEGACY[i].section && url == LEGACY[i].url) known = true;
+    }
+    CHECK(known);
+    CHECK(!sectionOf(doc, key.c_str()).empty());
+    if (!known) printf("  seksi tidak dikenal: %s -> %s\n", key.c_str(), url.c_str());
+    found++;
+  }
+  CHECK(found == LEGACY_COUNT - 1);
+  CHECK(html.find("state.isLocalAP") != std::string::npos);
+  CHECK(doc.find(",\"isLocalAP\":") != std::string::npos);
+}
+
+// ============================================
+// REQUEST, ROUND-TRIP DAN BYTE: SEBELUM vs SESUDAH
+// ============================================
+static void fanoutFigures(const std::string &doc) {
+  size_t beforeReq = 0, beforeRtt = 0, beforeBytes = 0;
+  size_t afterReq = 0, afterRtt = 0, afterBytes = 0;
+
+  printf("  %-14s %8s %5s %7s | %8s %5s %7s\n",
+         "aksi", "req lama", "rtt", "byte", "req baru", "rtt", "byte");
+  bool first = true;
+  for (const PageAction &a : pageActions()) {
+    size_t req = 0, bytes = 0;
+    for (const auto &stage : a.before) {
+      for (const char *url : stage) {
+        req++;
+        bytes += legacyBytes(doc, url);
+      }
+    }
+    // PERTAMA 200 DENGAN BODY PENUH, BERIKUTNYA 304 TANPA BODY
+    size_t newBytes = first ? doc.size() : 0;
+    first = false;
+
+    printf("  %-14s %8zu %5zu %7zu | %8d %5d %7zu\n",
+           a.name, req, a.before.size(), bytes, a.afterStages, a.afterStages, newBytes);
+    beforeReq += req;
+    beforeRtt += a.before.size();
+    beforeBytes += bytes;
+    afterReq += a.afterStages;
+    afterRtt += a.afterStages;
+    afterBytes += newBytes;
+  }
+  printf("  %-14s %8zu %5zu %7zu | %8zu %5zu %7zu\n",
+         "total", beforeReq, beforeRtt, beforeBytes, afterReq, afterRtt, afterBytes);
+
+  size_t pollBefore = FANOUT_POLL_PER_MIN * legacyBytes(doc, "/getprayertimes");
+  printf("  polling tab Jadwal per menit: %d req / %zu byte -> %d req / 0 byte (304)\n",
+         FANOUT_POLL_PER_MIN, pollBefore, FANOUT_POLL_PER_MIN);
+
+  CHECK(afterReq < beforeReq);
+  CHECK(afterRtt < beforeRtt);
+  CHECK(afterBytes < beforeBytes);
+
+  // TAB JADWAL: 3 ROUND-TRIP BERURUTAN JADI 1 REQUEST TERGABUNG
+  CHECK(pageActions().back().before.size() == 3);
+  CHECK(pageActions().back().afterStages == 1);
+}
+
+int main(int argc, char **argv) {
+  printf("state_fanout_test\n");
+  const char *htmlPath = argc > 1 ? argv[1] : "../data/index.html";
+
+  StateDocFields s;
+  fillFields(s);
+  char buf[2048];
+  int len = formatStateDocument(buf, sizeof(buf), s);
+  CHECK(len > 0 && len < (int)sizeof(buf));
+
+  std::string doc(buf);
+  doc += ",\"isLocalAP\":false}";
+  CHECK(sectionOf(doc, "wifi").size() > 0);
+  printf("  dokumen state: %zu byte\n", doc.size());
+
+  pageChecks(doc, htmlPath);
+  fanoutFigures(doc);
+  return hostResult();
+}
@@ -0,0 +1,231 @@
+/*
+ * UJI KALIBRASI SENTUH touch_math.h DENGAN JEJAK RAW
+ * Jejak 5 titik di test/host/touch_traces.h (derau, tekanan ringan saat pen-down,
+ * lonjakan SPI) diputar lewat filter median-3 + IIR persis seperti touchTask,
+ * raw saat jari dilepas masuk solveTouchCalibration.
+ *
+ * Diperiksa: galat RMS per panel, batas koefisien Q16.16 (tidak ada overflow int32
+ * untuk raw 0..4095), penolakan titik segaris / skala di luar batas / titik
+ * tertukar, dan hit rate tap di setiap zona PRAYER_TOUCH_ZONES memakai keluaran
+ * pen-down (yang dipakai handleTouchPress), dibanding matriks default TS_MIN/TS_MAX.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "touch_math.h"
+#include "host/touch_traces.h"
+#include "host/check.h"
+
+#define SCREEN_W 320
+#define SCREEN_H 240
+#define TAP_NOISE_RAW 6.0
+#define TAP_STEP_PX 2
+#define TAP_INSET_PX 3            // TAP DIARAHKAN KE DALAM LABEL, BUKAN DI GARIS TEPINYA
+#define CAL_MAX_RMS_PX 2.0
+#define MIN_HIT_RATE 0.99
+
+// SAMA DENGAN touchCal DEFAULT DI jws.ino (TS_MIN_X 370, TS_MAX_X 3700, TS_MIN_Y 470, TS_MAX_Y 3600)
+static const TouchCalibration DEFAULT_CAL = {
+  (SCREEN_W << 16) / (3700 - 370), 0, -((SCREEN_W << 16) / (3700 - 370)) * 370,
+  0, (SCREEN_H << 16) / (3600 - 470), -((SCREEN_H << 16) / (3600 - 470)) * 470,
+  false
+};
+
+// DERAU DETERMINISTIK: xorshift32 + Box-Muller
+static uint32_t rng = 0x4A575331;
+static double uniform() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return (rng >> 8) * (1.0 / 16777216.0) + 1e-9;
+}
+static double gauss(double sigma) {
+  return sigma * sqrt(-2.0 * log(uniform())) * cos(2.0 * M_PI * uniform());
+}
+
+static int16_t clampRaw(double v) {
+  if (v < 0) return 0;
+  if (v > TOUCH_RAW_MAX) return TOUCH_RAW_MAX;
+  return (int16_t)lround(v);
+}
+
+// JARI DITEMPEL LALU DILEPAS: 3 SAMPEL PEN-DOWN + TRACKING -> RAW SAAT LEPAS
+static void replayRelease(const TouchTrace &t, int16_t &rx, int16_t &ry) {
+  TouchFilter f;
+  for (int i = 0; i < 3; i++) {
+    f.rawX[i] = t.x[i];
+    f.rawY[i] = t.y[i];
+  }
+  touchFilterStart(f);
+  for (int i = 3; i < TOUCH_TRACE_SAMPLES; i++) touchFilterTrack(f, t.x[i], t.y[i]);
+  touchFilterOutput(f, rx, ry);
+}
+
+// TAP DI (x, y): 3 SAMPEL PEN-DOWN BERDERAU (YANG PERTAMA BERGESER) -> RAW PEN-DOWN
+static void synthTap(const TouchPanelModel &p, int16_t x, int16_t y, int16_t &rx, int16_t &ry) {
+  double mx = p.ax * x + p.bx * y + p.cx;
+  double my = p.ay * x + p.by * y + p.cy;
+  TouchFilter f;
+  for (int i = 0; i < 3; i++) {
+    f.rawX[i] = clampRaw(mx + gauss(TAP_NOISE_RAW) + (i == 0 ? 35 : 0));
+    f.rawY[i] = clampRaw(my + gauss(TAP_NOISE_RAW) - (i == 0 ? 30 : 0));
+  }
+  touchFilterStart(f);
+  touchFilterOutput(f, rx, ry);
+}
+
+static double hitRate(const TouchPanelModel &p, const TouchCalibration &cal, const TouchZone &z) {
+  uint32_t taps = 0, hits = 0;
+  int16_t y2 = (z.y2 < SCREEN_H - 1 ? z.y2 : SCREEN_H - 1) - TAP_INSET_PX;
+  for (int16_t y = z.y1 + TAP_INSET_PX; y <= y2; y += TAP_STEP_PX) {
+    for (int16_t x = z.x1 + TAP_INSET_PX; x <= z.x2 - TAP_INSET_PX; x += TAP_STEP_PX) {
+      int16_t rx, ry, sx, sy;
+      synthTap(p, x, y, rx, ry);
+      touchCalibrationApply(cal, rx, ry, SCREEN_W, SCREEN_H, sx, sy);
+      taps++;
+      if (touchZoneHit(z, sx, sy)) hits++;
+    }
+  }
+  return (double)hits / taps;
+}
+
+// NILAI MUTLAK TERBESAR a*rx + b*ry + c UNTUK RAW 0..TOUCH_RAW_MAX, DIHITUNG 64-BIT
+static int64_t worstSum(int32_t a, int32_t b, int32_t c) {
+  int64_t m = (int64_t)llabs(a) * TOUCH_RAW_MAX + (int64_t)llabs(b) * TOUCH_RAW_MAX + llabs(c);
+  return m;
+}
+
+static void checkBounds(const TouchCalibration &cal) {
+  CHECK(labs(cal.a) < TOUCH_CAL_SCALE_LIMIT && labs(cal.b) < TOUCH_CAL_SCALE_LIMIT);
+  CHECK(labs(cal.d) < TOUCH_CAL_SCALE_LIMIT && labs(cal.e) < TOUCH_CAL_SCALE_LIMIT);
+  CHECK(labs(cal.c) < TOUCH_CAL_OFFSET_LIMIT && labs(cal.f) < TOUCH_CAL_OFFSET_LIMIT);
+  CHECK(worstSum(cal.a, cal.b, cal.c) <= INT32_MAX);
+  CHECK(worstSum(cal.d, cal.e, cal.f) <= INT32_MAX);
+}
+
+static void filterChecks() {
+  CHECK(median3(3, 1, 2) == 2 && median3(1, 3, 2) == 2 && median3(2, 2, 9) == 2);
+
+  // LONJAKAN TUNGGAL SAAT TRACKING DIBUANG MEDIAN, IIR TETAP DI TEMPAT
+  TouchFilter f = { { 1000, 1002, 998 }, { 2000, 2001, 1999 }, 0, 0, 0 };
+  touchFilterStart(f);
+  touchFilterTrack(f, 1400, 2000);
+  int16_t rx, ry;
+  touchFilterOutput(f, rx, ry);
+  CHECK(rx >= 998 && rx <= 1002 && ry >= 1999 && ry <= 2001);
+
+  // JARI BERGESER: IIR MENGEJAR (alpha 1/2) DALAM BEBERAPA SAMPEL
+  for (int i = 0; i < 6; i++) touchFilterTrack(f, 1200, 2000);
+  touchFilterOutput(f, rx, ry);
+  CHECK(rx >= 1195 && rx <= 1200);
+}
+
+static void fitChecks(TouchCalibration cal[TOUCH_TRACE_PANELS]) {
+  for (int p = 0; p < TOUCH_TRACE_PANELS; p++) {
+    int16_t rawX[TOUCH_CAL_POINTS], rawY[TOUCH_CAL_POINTS];
+    for (int i = 0; i < TOUCH_CAL_POINTS; i++) replayRelease(TOUCH_CAL_TRACES[p][i], rawX[i], rawY[i]);
+
+    float errorPx = -1;
+    TouchCalFit fit = solveTouchCalibration(rawX, rawY, TOUCH_CAL_TARGET_X, TOUCH_CAL_TARGET_Y,
+                                            TOUCH_CAL_POINTS, cal[p], errorPx);
+    CHECK(fit == TOUCH_FIT_OK);
+    CHECK(cal[p].calibrated);
+    CHECK(errorPx >= 0 && errorPx <= CAL_MAX_RMS_PX);
+    checkBounds(cal[p]);
+
+    // GALAT TERHADAP MODEL PANEL DI SELURUH LAYAR (BUKAN HANYA DI 5 TITIK)
+    const TouchPanelModel &m = TOUCH_PANELS[p];
+    double sumSq = 0, worst = 0;
+    uint32_t n = 0;
+    for (int16_t y = 0; y < SCREEN_H; y += 8) {
+      for (int16_t x = 0; x < SCREEN_W; x += 8) {
+        int16_t sx, sy;
+        touchCalibrationApply(cal[p], clampRaw(m.ax * x + m.bx * y + m.cx), clampRaw(m.ay * x + m.by * y + m.cy),
+                              SCREEN_W, SCREEN_H, sx, sy);
+        double e = hypot(sx - x, sy - y);
+        sumSq += e * e;
+        if (e > worst) worst = e;
+        n++;
+      }
+    }
+    double screenRms = sqrt(sumSq / n);
+    CHECK(screenRms <= CAL_MAX_RMS_PX);
+    CHECK(worst <= 2 * CAL_MAX_RMS_PX + 1);
+    printf("  %-18s RMS 5 titik %.2f px, layar RMS %.2f px maks %.2f px, a=%d b=%d c=%d d=%d e=%d f=%d\n",
+           m.name, errorPx, screenRms, worst, cal[p].a, cal[p].b, cal[p].c, cal[p].d, cal[p].e, cal[p].f);
+  }
+}
+
+static void rejectChecks() {
+  TouchCalibration out;
+  float errorPx = 0;
+
+  // RAW TIDAK BERUBAH (KABEL TOUCH LEPAS)
+  int16_t flatX[TOUCH_CAL_POINTS] = { 2048, 2048, 2048, 2048, 2048 };
+  int16_t flatY[TOUCH_CAL_POINTS] = { 2048, 2048, 2048, 2048, 2048 };
+  CHECK(solveTouchCalibration(flatX, flatY, TOUCH_CAL_TARGET_X, TOUCH_CAL_TARGET_Y,
+                              TOUCH_CAL_POINTS, out, errorPx) == TOUCH_FIT_DEGENERATE);
+
+  // SEMUA RAW SEGARIS
+  int16_t lineX[TOUCH_CAL_POINTS] = { 500, 1000, 1500, 2000, 2500 };
+  int16_t lineY[TOUCH_CAL_POINTS] = { 600, 1100, 1600, 2100, 2600 };
+  CHECK(solveTouchCalibration(lineX, lineY, TOUCH_CAL_TARGET_X, TOUCH_CAL_TARGET_Y,
+                              TOUCH_CAL_POINTS, out, errorPx) == TOUCH_FIT_DEGENERATE);
+
+  // RENTANG RAW ~50 UNTUK SELURUH LAYAR: SKALA > 1.0 -> a*rx BISA OVERFLOW
+  int16_t tinyX[TOUCH_CAL_POINTS], tinyY[TOUCH_CAL_POINTS];
+  for (int i = 0; i < TOUCH_CAL_POINTS; i++) {
+    tinyX[i] = 2000 + TOUCH_CAL_TARGET_X[i] / 6;
+    tinyY[i] = 2000 + TOUCH_CAL_TARGET_Y[i] / 6;
+  }
+  CHECK(solveTouchCalibration(tinyX, tinyY, TOUCH_CAL_TARGET_X, TOUCH_CAL_TARGET_Y,
+                              TOUCH_CAL_POINTS, out, errorPx) == TOUCH_FIT_RANGE);
+
+  // DUA SUDUT ATAS TERTUKAR (USER MENYENTUH TARGET YANG SALAH): GALAT RMS DI ATAS BATAS.
+  // (SUDUT DIAGONAL YANG TERTUKAR = ROTASI 180 DERAJAT, MASIH AFFINE DAN LOLOS)
+  int16_t rawX[TOUCH_CAL_POINTS], rawY[TOUCH_CAL_POINTS];
+  for (int i = 0; i < TOUCH_CAL_POINTS; i++) replayRelease(TOUCH_CAL_TRACES[0][i], rawX[i], rawY[i]);
+  int16_t t = rawX[0]; rawX[0] = rawX[1]; rawX[1] = t;
+  t = rawY[0]; rawY[0] = rawY[1]; rawY[1] = t;
+  CHECK(solveTouchCalibration(rawX, rawY, TOUCH_CAL_TARGET_X, TOUCH_CAL_TARGET_Y,
+                              TOUCH_CAL_POINTS, out, errorPx) == TOUCH_FIT_ERROR);
+  CHECK(errorPx > TOUCH_CAL_MAX_ERROR);
+
+  // MATRIKS DI TEPAT BATAS MASIH AMAN DI INT32
+  CHECK(worstSum(TOUCH_CAL_SCALE_LIMIT - 1, TOUCH_CAL_SCALE_LIMIT - 1, TOUCH_CAL_OFFSET_LIMIT - 1) <= INT32_MAX);
+  CHECK(worstSum(DEFAULT_CAL.a, DEFAULT_CAL.b, DEFAULT_CAL.c) <= INT32_MAX);
+}
+
+static void hitChecks(const TouchCalibration cal[TOUCH_TRACE_PANELS]) {
+  static const char *ZONE_NAMES[PRAYER_TOUCH_ZONE_COUNT] = {
+    "imsak", "subuh", "terbit", "zuhur", "ashar", "maghrib", "isya"
+  };
+
+  for (int p = 0; p < TOUCH_TRACE_PANELS; p++) {
+    printf("  %-18s", TOUCH_PANELS[p].name);
+    for (int z = 0; z < PRAYER_TOUCH_ZONE_COUNT; z++) {
+      const TouchZone &zone = PRAYER_TOUCH_ZONES[z];
+      if (zone.x2 == 0 && zone.y2 == 0) continue;
+      double rate = hitRate(TOUCH_PANELS[p], cal[p], zone);
+      double before = hitRate(TOUCH_PANELS[p], DEFAULT_CAL, zone);
+      CHECK(rate >= MIN_HIT_RATE);
+      printf(" %s %.1f%% (default %.1f%%)", ZONE_NAMES[z], rate * 100, before * 100);
+    }
+    printf("\n");
+  }
+}
+
+int main() {
+  printf("touch_calibration_test\n");
+  filterChecks();
+
+  TouchCalibration cal[TOUCH_TRACE_PANELS];
+  memset(cal, 0, sizeof(cal));
+  fitChecks(cal);
+  rejectChecks();
+  hitChecks(cal);
+
+  return hostResult();
+}
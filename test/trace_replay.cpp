@@ -0,0 +1,54 @@
+/*
+ * PEMUTAR ULANG REKAMAN /api/trace DI HOST
+ *
+ *   curl -o trace.bin http://<ip>/api/trace
+ *   build/trace_replay trace.bin [--expect HEX] [--quiet] [--no-audio]
+ *
+ * Mencetak event turunan (kedip, adzan, alarm, request) per detik virtual,
+ * tabel latensi per jenis input, lalu digest keluaran. Dengan --expect,
+ * exit 1 jika digest berbeda: cara membandingkan dua build terhadap trace sama.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/trace_replay.h"
+
+int main(int argc, char **argv) {
+  const char *path = nullptr;
+  const char *expect = nullptr;
+  ReplayOptions opt;
+  opt.echo = true;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) expect = argv[++i];
+    else if (strcmp(argv[i], "--quiet") == 0) opt.echo = false;
+    else if (strcmp(argv[i], "--no-audio") == 0) opt.audio = false;
+    else path = argv[i];
+  }
+  if (!path) {
+    fprintf(stderr, "pakai: %s trace.bin [--expect HEX] [--quiet] [--no-audio]\n", argv[0]);
+    return 2;
+  }
+
+  ReplayTrace trace;
+  std::string error;
+  if (!replayLoad(path, trace, error)) {
+    fprintf(stderr, "TRACE %s TIDAK VALID: %s\n", path, error.c_str());
+    return 2;
+  }
+
+  TraceReplayer replayer(opt);
+  replayer.run(trace);
+
+  printf("\nrecord=%u tertimpa=%u bootId=%08x event=%zu error=%d\n", trace.header.count,
+         trace.header.dropped, trace.header.bootId, replayer.events().size(), replayer.errors());
+  replayer.printLatency(stdout);
+  printf("digest=%08x\n", replayer.digest());
+
+  if (expect && strtoul(expect, nullptr, 16) != replayer.digest()) {
+    printf("GAGAL: digest %08x != %s\n", replayer.digest(), expect);
+    return 1;
+  }
+  return replayer.errors() ? 1 : 0;
+}
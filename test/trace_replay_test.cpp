@@ -0,0 +1,141 @@
+/*
+ * UJI PEMUTAR ULANG TRACE
+ * Trace sintetis satu malam: boot 23:59:30, pergantian hari, koreksi jam +120 s,
+ * alarm 04:00 dihentikan sentuhan, subuh 04:30 berkedip lalu adzan diputar lewat
+ * zona sentuh, request web. Diperiksa: event yang diharapkan muncul tepat waktu,
+ * replay deterministik (digest sama dua kali), round-trip file, trace rusak ditolak.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "host/trace_replay.h"
+#include "host/check.h"
+
+#define T0 1734652770          // 2024-12-19 23:59:30 WAKTU LOKAL
+#define BOOT_MS 1100u
+
+static void add(ReplayTrace &trace, uint32_t ms, TraceType type, uint8_t flags, uint16_t arg, int32_t value,
+                uint32_t durUs = 0) {
+  trace.records.push_back({ ms, (uint8_t)type, flags, arg, value, durUs });
+}
+
+// millis() SAAT JAM VIRTUAL MENUNJUK t, SETELAH KOREKSI +120 s DI BOOT_MS + 3600 s
+static uint32_t msAt(int64_t t) {
+  return BOOT_MS + 3600000u + (uint32_t)((t - (T0 + 3720)) * 1000);
+}
+
+static ReplayTrace makeTrace() {
+  ReplayTrace trace;
+  memcpy(trace.header.magic, "JWST", 4);
+  trace.header.version = TRACE_FORMAT_VERSION;
+  trace.header.recordSize = sizeof(TraceRecord);
+  trace.header.bootId = 0x1234;
+  trace.header.dropped = 0;
+
+  // BUZZER SUBUH & ZUHUR, ALARM 04:00
+  add(trace, 1000, TRACE_CONFIG, 0, (1 << 1) | (1 << 3) | TRACE_CONFIG_ALARM, 4 * 60);
+  const int16_t minutes[REPLAY_PRAYERS] = { 260, 270, 340, 718, 914, 1079, 1152 };
+  for (uint16_t i = 0; i < REPLAY_PRAYERS; i++) add(trace, 1000, TRACE_SCHEDULE, 0, i, minutes[i]);
+  add(trace, BOOT_MS, TRACE_BOOT, 0, 0, T0, 2400000);
+
+  add(trace, BOOT_MS + 600000, TRACE_TICK, 0, 0, T0 + 600);
+  const char params[] = "ssid=RumahKu&password=#10";
+  add(trace, BOOT_MS + 700000, TRACE_HTTP_REQ, 2, (uint16_t)routeLookup(ROUTE_PATHS[0]),
+      (int32_t)traceDigest(TRACE_DIGEST_SEED, params, strlen(params)), 850);
+  add(trace, BOOT_MS + 3600000, TRACE_TICK, TRACE_F_JUMP, 0, T0 + 3720);
+
+  const int64_t day2 = T0 + 30;
+  add(trace, msAt(day2 + 4 * 3600 + 3), TRACE_TOUCH, TRACE_F_PRESS, 0, (160 << 16) | 120, 300);
+  add(trace, msAt(day2 + 4 * 3600 + 3) + 80, TRACE_TOUCH, 0, 0, (160 << 16) | 120);
+  add(trace, msAt(day2 + 4 * 3600 + 600), TRACE_TICK, 0, 0, (int32_t)(day2 + 4 * 3600 + 600));
+  add(trace, msAt(day2 + 270 * 60 + 2), TRACE_TOUCH, TRACE_F_PRESS, 0, (10 << 16) | 10, 250);
+  add(trace, msAt(day2 + 270 * 60 + 5), TRACE_TOUCH, TRACE_F_PRESS, 0, (250 << 16) | 80, 410);
+  add(trace, msAt(day2 + 5 * 3600), TRACE_HTTP_API, (1 << 4) | TRACE_F_WARM, 200, 1480, 320000);
+
+  trace.header.count = (uint16_t)trace.records.size();
+  return trace;
+}
+
+static bool hasEvent(const std::vector<std::string> &events, const char *line) {
+  for (const std::string &e : events) {
+    if (e == line) return true;
+  }
+  return false;
+}
+
+static bool hasPrefix(const std::vector<std::string> &events, const char *prefix) {
+  for (const std::string &e : events) {
+    if (e.compare(0, strlen(prefix), prefix) == 0) return true;
+  }
+  return false;
+}
+
+static bool hasWord(const std::vector<std::string> &events, const char *word) {
+  for (const std::string &e : events) {
+    if (e.find(word) != std::string::npos) return true;
+  }
+  return false;
+}
+
+int main() {
+  ReplayTrace trace = makeTrace();
+
+  TraceReplayer replayer{ ReplayOptions() };
+  replayer.run(trace);
+  const std::vector<std::string> &ev = replayer.events();
+
+  CHECK(replayer.errors() == 0);
+  CHECK(hasEvent(ev, "2024-12-19 23:59:30 BOOT 2400000 us"));
+  CHECK(hasEvent(ev, "2024-12-20 00:00:00 HARI_BARU"));
+  CHECK(hasEvent(ev, "2024-12-20 01:01:30 WAKTU_LOMPAT +120 s"));
+  CHECK(hasPrefix(ev, "2024-12-20 00:11:10 HTTP /"));
+  CHECK(hasEvent(ev, "2024-12-20 04:00:00 ALARM"));
+  CHECK(hasEvent(ev, "2024-12-20 04:00:03 ALARM_STOP"));
+  CHECK(!hasWord(ev, "KEDIP imsak"));                        // BUZZER IMSAK MATI
+  CHECK(hasEvent(ev, "2024-12-20 04:30:00 KEDIP subuh ADZAN_SIAP"));
+  CHECK(hasEvent(ev, "2024-12-20 04:30:05 ADZAN_PUTAR subuh"));
+  CHECK(!hasWord(ev, "ADZAN_KEDALUWARSA"));
+  CHECK(hasEvent(ev, "2024-12-20 05:00:00 API penyedia=1 kode=200 body=1480 warm"));
+
+  // DETERMINISTIK & ROUND-TRIP FILE
+  TraceReplayer again{ ReplayOptions() };
+  again.run(trace);
+  CHECK(again.digest() == replayer.digest());
+
+  const char *path = "build/trace_replay_test.bin";
+  ReplayTrace loaded;
+  std::string error;
+  CHECK(replaySave(path, trace));
+  CHECK(replayLoad(path, loaded, error));
+  CHECK(loaded.records.size() == trace.records.size());
+  TraceReplayer fromFile{ ReplayOptions() };
+  fromFile.run(loaded);
+  CHECK(fromFile.digest() == replayer.digest());
+
+  // TANPA DFPlayer: KEDIP TETAP ADA, JENDELA ADZAN TIDAK, DIGEST BERBEDA
+  ReplayOptions silent;
+  silent.audio = false;
+  TraceReplayer mute(silent);
+  mute.run(trace);
+  CHECK(hasEvent(mute.events(), "2024-12-20 04:30:00 KEDIP subuh"));
+  CHECK(!hasWord(mute.events(), "ADZAN_PUTAR"));
+  CHECK(mute.digest() != replayer.digest());
+
+  // TRACE RUSAK: INDEKS ROUTE DI LUAR TABEL, VERSI LAMA
+  ReplayTrace bad = makeTrace();
+  bad.records[10].arg = ROUTE_COUNT;
+  TraceReplayer broken{ ReplayOptions() };
+  broken.run(bad);
+  CHECK(broken.errors() == 1);
+
+  bad.header.version = 1;
+  CHECK(replaySave(path, bad));
+  CHECK(!replayLoad(path, loaded, error));
+
+  printf("event=%zu digest=%08x\n", ev.size(), replayer.digest());
+  replayer.printLatency(stdout);
+  return hostResult();
+}
@@ -0,0 +1,243 @@
+/*
+ * UJI TANGGA KONEKSI ULANG WIFI wifi_reconnect.h DENGAN DRIVER PALSU
+ * Driver mencatat setiap panggilan (begin langsung / begin biasa / scan) dan
+ * menjawab scan dari skrip. Urutan event meniru wifiTask + event GOT_IP di jws.ino:
+ * putus -> connectToBestAP (wifiConnectStep) -> GOT_IP atau putus lagi.
+ *
+ * Diperiksa: konek langsung gagal -> scan terarah berhasil ke AP terkuat,
+ * tahap kembali ke 1 setelah GOT_IP, SSID cache tidak cocok melewati tahap 1,
+ * scan kosong -> begin biasa lalu naik ke scan penuh dan bertahan di sana,
+ * cache link hanya ditandai berubah bila SSID/BSSID/channel berbeda (GOT_IP ulang ke AP
+ * yang sama tidak menulis flash), statistik per tahap, dan persentil nearest-rank p50/p90/p99 dari sampel yang diketahui.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "wifi_reconnect.h"
+#include "host/check.h"
+
+struct FakeAp {
+  const char *ssid;
+  int32_t rssi;
+  int32_t channel;
+  uint8_t bssid[6];
+};
+
+struct FakeWiFiDriver {
+  std::vector<FakeAp> air;             // AP YANG TERLIHAT SAAT SCAN
+  std::vector<std::string> calls;
+  int32_t lastChannel = 0;
+  uint8_t lastBssid[6] = {};
+  int scanFailures = 0;                // SCAN BERIKUTNYA YANG KOSONG / TIMEOUT
+  std::vector<const FakeAp *> results;
+
+  void beginDirect(uint8_t stage, int32_t channel, const uint8_t *bssid) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "direct%u ch%d %02x", stage + 1, channel, bssid[5]);
+    calls.push_back(buf);
+    lastChannel = channel;
+    memcpy(lastBssid, bssid, 6);
+  }
+  void beginAny(const char *reason) {
+    calls.push_back("any");
+  }
+  int scan(const char *ssid, uint32_t dwellMs) {
+    calls.push_back(ssid ? std::string("scan ") + ssid : std::string("scan *"));
+    results.clear();
+    if (scanFailures > 0) {
+      scanFailures--;
+      return -1;
+    }
+    // SCAN TERARAH HANYA MENGEMBALIKAN SSID YANG DIMINTA (PROBE SSID)
+    for (const FakeAp &ap : air) {
+      if (ssid == NULL || strcmp(ap.ssid, ssid) == 0) results.push_back(&ap);
+    }
+    CHECK(dwellMs == (ssid ? WIFI_SCAN_DWELL_TARGETED : WIFI_SCAN_DWELL_FULL));
+    return (int)results.size();
+  }
+  bool scanEntry(int i, const char *ssid, int32_t &rssi, int32_t &channel, uint8_t *bssid) {
+    const FakeAp &ap = *results[i];
+    if (strcmp(ap.ssid, ssid) != 0) return false;
+    rssi = ap.rssi;
+    channel = ap.channel;
+    memcpy(bssid, ap.bssid, 6);
+    return true;
+  }
+  void scanDone() {
+    results.clear();
+    calls.push_back("scanDone");
+  }
+
+  std::string trace() const {
+    std::string s;
+    for (const std::string &c : calls) s += (s.empty() ? "" : ", ") + c;
+    return s;
+  }
+};
+
+// EVENT GOT_IP SEPERTI recordWiFiConnected: STATISTIK, CACHE LINK, TAHAP DIRESET.
+// true = CACHE BERUBAH (wifiLinkDirty -> DISIMPAN KE FLASH)
+static bool gotIp(WiFiLadder &l, WiFiReconnectStats &st, WiFiLinkInfo &cache, const char *ssid,
+                  const FakeWiFiDriver &d, uint32_t elapsedMs) {
+  wifiStatsRecord(st, elapsedMs, l.activeStage);
+  WiFiLinkInfo fresh = {};
+  snprintf(fresh.ssid, sizeof(fresh.ssid), "%s", ssid);
+  memcpy(fresh.bssid, d.lastBssid, 6);
+  fresh.channel = d.lastChannel;
+  fresh.valid = true;
+  wifiLadderConnected(l);
+  return wifiLinkUpdate(cache, fresh);
+}
+
+static void ladderChecks() {
+  const char *home = "RumahKu";
+  FakeWiFiDriver d;
+  d.air = {
+    { "Tetangga", -40, 1, { 0xAA, 0, 0, 0, 0, 0x01 } },
+    { home, -72, 6, { 0x24, 0, 0, 0, 0, 0x06 } },
+    { home, -55, 11, { 0x24, 0, 0, 0, 0, 0x0B } },    // MESH NODE TERKUAT
+  };
+
+  WiFiLinkInfo cache = {};
+  snprintf(cache.ssid, sizeof(cache.ssid), "%s", home);
+  cache.bssid[0] = 0x24;
+  cache.bssid[5] = 0x06;
+  cache.channel = 6;
+  cache.valid = true;
+
+  WiFiLadder l = { WIFI_STAGE_DIRECTED, WIFI_STAGE_FULL };
+  WiFiReconnectStats st = {};
+
+  // PUTUS #1: KONEK LANGSUNG KE BSSID CACHE GAGAL (AP CH 6 MATI), SCAN TERARAH BERHASIL
+  CHECK(wifiConnectStep(l, cache, home, d) == WIFI_STAGE_DIRECTED);
+  CHECK(wifiConnectStep(l, cache, home, d) == WIFI_STAGE_TARGETED);
+  CHECK(d.trace() == "direct1 ch6 06, scan RumahKu, scanDone, direct2 ch11 0b");
+  printf("  putus #1: %s\n", d.trace().c_str());
+  CHECK(gotIp(l, st, cache, home, d, 2400));
+  CHECK(cache.channel == 11 && cache.bssid[5] == 0x0B);
+  CHECK(st.stageWins[WIFI_STAGE_TARGETED] == 1 && st.count == 1);
+
+  // PUTUS #2: TAHAP SUDAH DIRESET GOT_IP -> LANGSUNG KE AP YANG BARU, BERHASIL
+  d.calls.clear();
+  CHECK(wifiConnectStep(l, cache, home, d) == WIFI_STAGE_DIRECTED);
+  CHECK(d.trace() == "direct1 ch11 0b");
+  // AP SAMA: TIDAK ADA PENULISAN FLASH
+  CHECK(!gotIp(l, st, cache, home, d, 310));
+  CHECK(st.stageWins[WIFI_STAGE_DIRECTED] == 1);
+
+  // SSID DIGANTI DI WEB: CACHE UNTUK SSID LAMA -> TAHAP 1 DILEWATI
+  const char *office = "Kantor";
+  d.air.push_back({ office, -60, 3, { 0x40, 0, 0, 0, 0, 0x03 } });
+  d.calls.clear();
+  CHECK(!wifiLinkUsable(cache, office));
+  CHECK(wifiConnectStep(l, cache, office, d) == WIFI_STAGE_TARGETED);
+  CHECK(d.trace() == "scan Kantor, scanDone, direct2 ch3 03");
+  CHECK(gotIp(l, st, cache, office, d, 1900));
+  CHECK(strcmp(cache.ssid, office) == 0 && cache.channel == 3);
+
+  // CACHE TIDAK VALID (BELUM PERNAH KONEK / FILE RUSAK) -> SAMA
+  WiFiLinkInfo empty = {};
+  WiFiLadder fresh = { WIFI_STAGE_DIRECTED, WIFI_STAGE_FULL };
+  d.calls.clear();
+  CHECK(wifiConnectStep(fresh, empty, office, d) == WIFI_STAGE_TARGETED);
+
+  // SCAN TERARAH KOSONG -> BEGIN BIASA; BERIKUTNYA SCAN PENUH DAN BERTAHAN DI SANA
+  WiFiLadder l2 = { WIFI_STAGE_DIRECTED, WIFI_STAGE_FULL };
+  d.calls.clear();
+  d.scanFailures = 1;
+  CHECK(wifiConnectStep(l2, cache, office, d) == WIFI_STAGE_DIRECTED);
+  CHECK(wifiConnectStep(l2, cache, office, d) == WIFI_STAGE_TARGETED);
+  CHECK(wifiConnectStep(l2, cache, office, d) == WIFI_STAGE_FULL);
+  CHECK(wifiConnectStep(l2, cache, office, d) == WIFI_STAGE_FULL);
+  CHECK(d.trace() == "direct1 ch3 03, scan Kantor, any, scan *, scanDone, direct3 ch3 03, "
+                     "scan *, scanDone, direct3 ch3 03");
+  printf("  scan kosong: %s\n", d.trace().c_str());
+
+  // SCAN PENUH TANPA SSID YANG DICARI -> BEGIN BIASA (ROUTER MUNGKIN SSID TERSEMBUNYI)
+  d.calls.clear();
+  CHECK(wifiConnectStep(l2, cache, "Tersembunyi", d) == WIFI_STAGE_FULL);
+  CHECK(d.trace() == "scan *, scanDone, any");
+}
+
+// wifiLinkUpdate: SETIAP FIELD MEMICU SIMPAN, SISA BUFFER SSID SETELAH NUL TIDAK IKUT
+static void linkUpdateChecks() {
+  WiFiLinkInfo base = {};
+  snprintf(base.ssid, sizeof(base.ssid), "%s", "RumahKu");
+  base.bssid[5] = 0x06;
+  base.channel = 6;
+  base.valid = true;
+
+  WiFiLinkInfo cache = {};
+  CHECK(wifiLinkUpdate(cache, base));
+  CHECK(!wifiLinkUpdate(cache, base));
+
+  WiFiLinkInfo f = base;
+  f.channel = 11;
+  CHECK(wifiLinkUpdate(cache, f));
+  f = base;
+  f.bssid[0] = 0x24;
+  CHECK(wifiLinkUpdate(cache, f));
+  f = base;
+  snprintf(f.ssid, sizeof(f.ssid), "%s", "RumahKu5G");
+  CHECK(wifiLinkUpdate(cache, f));
+  f = base;
+  f.valid = false;
+  CHECK(wifiLinkUpdate(cache, f));
+  CHECK(wifiLinkUpdate(cache, base));
+
+  f = base;
+  f.ssid[20] = 'x';
+  CHECK(!wifiLinkUpdate(cache, f));
+
+  // SSID 32 KARAKTER (MAKS 802.11) TIDAK MELEWATI BUFFER
+  snprintf(f.ssid, sizeof(f.ssid), "%s", "ABCDEFGHIJKLMNOPQRSTUVWXYZ012345");
+  CHECK(strlen(f.ssid) == 32);
+  CHECK(wifiLinkUpdate(cache, f));
+  CHECK(!wifiLinkUpdate(cache, f));
+}
+
+static void percentileChecks() {
+  uint32_t p50, p90, p99, maxMs;
+
+  uint32_t none[WIFI_RECONNECT_SAMPLES] = {};
+  wifiReconnectPercentiles(none, 0, p50, p90, p99, maxMs);
+  CHECK(p50 == 0 && p90 == 0 && p99 == 0 && maxMs == 0);
+
+  uint32_t one[WIFI_RECONNECT_SAMPLES] = { 870 };
+  wifiReconnectPercentiles(one, 1, p50, p90, p99, maxMs);
+  CHECK(p50 == 870 && p90 == 870 && p99 == 870 && maxMs == 870);
+
+  // 10 SAMPEL ACAK 100..1000: RANK ceil(0.5*10)=5, ceil(0.9*10)=9, ceil(0.99*10)=10
+  uint32_t ten[WIFI_RECONNECT_SAMPLES] = { 700, 100, 1000, 300, 900, 200, 500, 800, 400, 600 };
+  wifiReconnectPercentiles(ten, 10, p50, p90, p99, maxMs);
+  CHECK(p50 == 500 && p90 == 900 && p99 == 1000 && maxMs == 1000);
+
+  // RING PENUH LEWAT wifiStatsRecord: 40 SAMPEL 1..40 -> YANG TERSISA 9..40
+  WiFiReconnectStats st = {};
+  for (uint32_t v = 1; v <= 40; v++) wifiStatsRecord(st, v * 10, WIFI_STAGE_DIRECTED);
+  CHECK(st.count == WIFI_RECONNECT_SAMPLES && st.stageWins[WIFI_STAGE_DIRECTED] == 40);
+  uint32_t copy[WIFI_RECONNECT_SAMPLES];
+  memcpy(copy, st.samples, sizeof(copy));
+  wifiReconnectPercentiles(copy, st.count, p50, p90, p99, maxMs);
+  // 32 SAMPEL 90..400: RANK 16 -> 240, RANK 29 -> 370, RANK 32 -> 400
+  CHECK(p50 == 240 && p90 == 370 && p99 == 400 && maxMs == 400);
+  printf("  32 sampel 90..400 ms: p50 %u, p90 %u, p99 %u, maks %u\n", p50, p90, p99, maxMs);
+
+  // EKOR PANJANG: SATU SCAN PENUH 8 s DI ANTARA 31 KONEK LANGSUNG ~300 ms
+  uint32_t tail[WIFI_RECONNECT_SAMPLES];
+  for (int i = 0; i < 31; i++) tail[i] = 280 + i;
+  tail[31] = 8000;
+  wifiReconnectPercentiles(tail, 32, p50, p90, p99, maxMs);
+  CHECK(p50 == 295 && p90 == 308 && p99 == 8000 && maxMs == 8000);
+}
+
+int main() {
+  printf("wifi_reconnect_test\n");
+  ladderChecks();
+  linkUpdateChecks();
+  percentileChecks();
+  return hostResult();
+}
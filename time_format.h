@@ -0,0 +1,24 @@
+/*
+ * PARSE "JJ:MM" TANPA ALOKASI
+ * Dipakai jalur 1 Hz (schedulePublish/checkPrayerTime) dan diukur di host oleh test/bench.cpp.
+ */
+
+#ifndef JWS_TIME_FORMAT_H
+#define JWS_TIME_FORMAT_H
+
+#include <ctype.h>
+
+// "JJ:MM" -> MENIT SEJAK 00:00, -1 JIKA FORMAT TIDAK VALID (TANPA ALOKASI).
+// DIPERIKSA KIRI KE KANAN AGAR BERHENTI DI NUL SEBELUM MEMBACA LEWAT STRING.
+inline int parseMinuteOfDay(const char *t) {
+  if (!isdigit((unsigned char)t[0]) || !isdigit((unsigned char)t[1]) || t[2] != ':' ||
+      !isdigit((unsigned char)t[3]) || !isdigit((unsigned char)t[4])) {
+    return -1;
+  }
+  int h = (t[0] - '0') * 10 + (t[1] - '0');
+  int m = (t[3] - '0') * 10 + (t[4] - '0');
+  if (h > 23 || m > 59) return -1;
+  return h * 60 + m;
+}
+
+#endif
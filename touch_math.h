@@ -0,0 +1,204 @@
+/*
+ * JALUR SENTUH TANPA HARDWARE: SLOT ATOMIK, FILTER RAW, KALIBRASI AFFINE, ZONA SENTUH ADZAN
+ * touchTask -> publishTouch (touchSlotPack) -> my_touchpad_read (TOUCH_SLOT_*),
+ * touchTask -> readTouchRaw (touchFilter*) -> applyTouchCalibration -> handleTouchPress
+ * (PRAYER_TOUCH_ZONES), dan touchCalibrationTask -> solveTouchCalibration.
+ * Diuji di host oleh test/touch_calibration_test.cpp.
+ */
+
+#ifndef JWS_TOUCH_MATH_H
+#define JWS_TOUCH_MATH_H
+
+#include <math.h>
+#include <stdint.h>
+
+// SLOT TITIK SENTUH: DITULIS touchTask, DIBACA my_touchpad_read.
+// SATU WORD 32-BIT (ATOMIK DI ESP32) -> TANPA MUTEX:
+//   BIT 0-8   : X (0-319)
+//   BIT 9-16  : Y (0-239)
+//   BIT 17    : DITEKAN
+//   BIT 18-31 : NOMOR URUT (BERTAMBAH SETIAP PUBLISH)
+#define TOUCH_SLOT_X(s)        ((int16_t)((s) & 0x1FF))
+#define TOUCH_SLOT_Y(s)        ((int16_t)(((s) >> 9) & 0xFF))
+#define TOUCH_SLOT_PRESSED     (1UL << 17)
+#define TOUCH_SLOT_SEQ_SHIFT   18
+
+inline uint32_t touchSlotPack(uint32_t prev, bool pressed, int16_t x, int16_t y) {
+  uint32_t seq = (prev >> TOUCH_SLOT_SEQ_SHIFT) + 1;
+  return (seq << TOUCH_SLOT_SEQ_SHIFT) |
+         (pressed ? TOUCH_SLOT_PRESSED : 0) |
+         ((uint32_t)y << 9) |
+         (uint32_t)x;
+}
+
+// MATRIKS AFFINE Q16.16 (RAW -> PIKSEL):
+//   X = (a*rx + b*ry + c) >> 16
+//   Y = (d*rx + e*ry + f) >> 16
+struct TouchCalibration {
+  int32_t a, b, c;
+  int32_t d, e, f;
+  bool calibrated;
+};
+
+inline void touchCalibrationApply(const TouchCalibration &cal, int16_t rx, int16_t ry,
+                                  int16_t width, int16_t height, int16_t &x, int16_t &y) {
+  int32_t sx = (cal.a * rx + cal.b * ry + cal.c) >> 16;
+  int32_t sy = (cal.d * rx + cal.e * ry + cal.f) >> 16;
+  x = (int16_t)(sx < 0 ? 0 : (sx > width - 1 ? width - 1 : sx));
+  y = (int16_t)(sy < 0 ? 0 : (sy > height - 1 ? height - 1 : sy));
+}
+
+// FILTER RAW: MEDIAN-3 + IIR (Q4)
+// JARI BARU MENEMPEL : 3 SAMPEL -> MEDIAN, FILTER DIISI ULANG (touchFilterStart)
+// JARI DITAHAN      : 1 SAMPEL -> MEDIAN 3 TERAKHIR -> IIR (touchFilterTrack)
+#define TOUCH_IIR_SHIFT        1    // IIR: alpha = 1/2 SELAMA TRACKING
+
+struct TouchFilter {
+  int16_t rawX[3];
+  int16_t rawY[3];
+  uint8_t index;
+  int32_t iirX;
+  int32_t iirY;
+};
+
+inline int16_t median3(int16_t a, int16_t b, int16_t c) {
+  if (a > b) { int16_t t = a; a = b; b = t; }
+  if (b > c) b = c;
+  return (a > b) ? a : b;
+}
+
+// rawX/rawY SUDAH DIISI 3 SAMPEL PEN-DOWN
+inline void touchFilterStart(TouchFilter &f) {
+  f.index = 0;
+  f.iirX = (int32_t)median3(f.rawX[0], f.rawX[1], f.rawX[2]) << 4;
+  f.iirY = (int32_t)median3(f.rawY[0], f.rawY[1], f.rawY[2]) << 4;
+}
+
+inline void touchFilterTrack(TouchFilter &f, int16_t sx, int16_t sy) {
+  f.rawX[f.index] = sx;
+  f.rawY[f.index] = sy;
+  f.index = (f.index + 1) % 3;
+
+  int32_t mx = (int32_t)median3(f.rawX[0], f.rawX[1], f.rawX[2]) << 4;
+  int32_t my = (int32_t)median3(f.rawY[0], f.rawY[1], f.rawY[2]) << 4;
+  f.iirX += (mx - f.iirX) >> TOUCH_IIR_SHIFT;
+  f.iirY += (my - f.iirY) >> TOUCH_IIR_SHIFT;
+}
+
+inline void touchFilterOutput(const TouchFilter &f, int16_t &rx, int16_t &ry) {
+  rx = f.iirX >> 4;
+  ry = f.iirY >> 4;
+}
+
+// ============================================
+// KALIBRASI 5 TITIK: KUADRAT TERKECIL -> Q16.16
+// ============================================
+#define TOUCH_CAL_POINTS       5
+#define TOUCH_CAL_MAX_ERROR    12   // px - RMS MAKSIMUM AGAR KALIBRASI DITERIMA
+#define TOUCH_RAW_MAX          4095 // XPT2046 12-BIT
+
+// BATAS AGAR a*rx + b*ry + c TIDAK OVERFLOW INT32 (RAW <= TOUCH_RAW_MAX):
+// |a|,|b| < 1.0 (Q16.16 < 2^16) DAN |c| < 2^27 -> |JUMLAH| < 2^28 + 2^28 + 2^27
+#define TOUCH_CAL_SCALE_LIMIT  (1L << 16)
+#define TOUCH_CAL_OFFSET_LIMIT (1L << 27)
+
+// TARGET DI LAYAR 320x240: EMPAT SUDUT (INSET 10%) + TENGAH
+constexpr int16_t TOUCH_CAL_TARGET_X[TOUCH_CAL_POINTS] = { 32, 288, 160, 32, 288 };
+constexpr int16_t TOUCH_CAL_TARGET_Y[TOUCH_CAL_POINTS] = { 24, 24, 120, 216, 216 };
+
+enum TouchCalFit : uint8_t {
+  TOUCH_FIT_OK = 0,
+  TOUCH_FIT_DEGENERATE,        // TITIK SEGARIS / RAW TIDAK BERUBAH
+  TOUCH_FIT_RANGE,             // KOEFISIEN BISA OVERFLOW JALUR FIXED-POINT
+  TOUCH_FIT_ERROR              // GALAT RMS > TOUCH_CAL_MAX_ERROR
+};
+
+inline double det3(const double m[3][3]) {
+  return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+       - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+       + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+// KUADRAT TERKECIL: [rx ry 1] * [a b c]^T = layar, UNTUK X DAN Y.
+// errorPx DIUKUR DENGAN JALUR FIXED-POINT YANG SAMA DENGAN RUNTIME; out HANYA
+// BOLEH DIPAKAI BILA HASILNYA TOUCH_FIT_OK
+inline TouchCalFit solveTouchCalibration(const int16_t *rawX, const int16_t *rawY,
+                                         const int16_t *scrX, const int16_t *scrY, int n,
+                                         TouchCalibration &out, float &errorPx) {
+  double m[3][3] = {{0}};
+  double vx[3] = {0};
+  double vy[3] = {0};
+
+  for (int i = 0; i < n; i++) {
+    double row[3] = { (double)rawX[i], (double)rawY[i], 1.0 };
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) m[r][c] += row[r] * row[c];
+      vx[r] += row[r] * scrX[i];
+      vy[r] += row[r] * scrY[i];
+    }
+  }
+
+  double det = det3(m);
+  if (fabs(det) < 1e-6) return TOUCH_FIT_DEGENERATE;
+
+  double coefX[3], coefY[3];
+  for (int col = 0; col < 3; col++) {
+    double mx[3][3], my[3][3];
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        mx[r][c] = (c == col) ? vx[r] : m[r][c];
+        my[r][c] = (c == col) ? vy[r] : m[r][c];
+      }
+    }
+    coefX[col] = det3(mx) / det;
+    coefY[col] = det3(my) / det;
+  }
+
+  const double scaleLimit = TOUCH_CAL_SCALE_LIMIT / 65536.0;
+  const double offsetLimit = TOUCH_CAL_OFFSET_LIMIT / 65536.0;
+  if (fabs(coefX[0]) >= scaleLimit || fabs(coefX[1]) >= scaleLimit ||
+      fabs(coefY[0]) >= scaleLimit || fabs(coefY[1]) >= scaleLimit ||
+      fabs(coefX[2]) >= offsetLimit || fabs(coefY[2]) >= offsetLimit) {
+    return TOUCH_FIT_RANGE;
+  }
+
+  out.a = lround(coefX[0] * 65536.0);
+  out.b = lround(coefX[1] * 65536.0);
+  out.c = lround(coefX[2] * 65536.0);
+  out.d = lround(coefY[0] * 65536.0);
+  out.e = lround(coefY[1] * 65536.0);
+  out.f = lround(coefY[2] * 65536.0);
+  out.calibrated = true;
+
+  double sumSq = 0;
+  for (int i = 0; i < n; i++) {
+    int32_t px = (out.a * rawX[i] + out.b * rawY[i] + out.c) >> 16;
+    int32_t py = (out.d * rawX[i] + out.e * rawY[i] + out.f) >> 16;
+    sumSq += (double)(px - scrX[i]) * (px - scrX[i]) + (double)(py - scrY[i]) * (py - scrY[i]);
+  }
+  errorPx = sqrt(sumSq / n);
+
+  return errorPx > TOUCH_CAL_MAX_ERROR ? TOUCH_FIT_ERROR : TOUCH_FIT_OK;
+}
+
+struct TouchZone {
+  int16_t x1, y1, x2, y2;
+};
+
+inline bool touchZoneHit(const TouchZone &zone, int16_t x, int16_t y) {
+  return x >= zone.x1 && x <= zone.x2 && y >= zone.y1 && y <= zone.y2;
+}
+
+// LABEL WAKTU DI LAYAR UTAMA, URUTAN ENUM Prayer; {0} = TIDAK BISA DISENTUH
+#define PRAYER_TOUCH_ZONE_COUNT 7
+constexpr TouchZone PRAYER_TOUCH_ZONES[PRAYER_TOUCH_ZONE_COUNT] = {
+  {   0,   0,   0,   0 },   // IMSAK
+  { 200,  70, 310,  95 },   // SUBUH
+  {   0,   0,   0,   0 },   // TERBIT
+  { 200, 130, 310, 155 },   // ZUHUR
+  { 200, 160, 310, 185 },   // ASHAR
+  { 200, 190, 310, 215 },   // MAGHRIB
+  { 200, 220, 310, 240 }    // ISYA
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * FORMAT REKAMAN INPUT /api/trace
+ * Dipakai bersama oleh firmware (perekam) dan test/trace_replay.cpp (pemutar ulang)
+ * agar format tidak bisa menyimpang. Biner little-endian: TraceHeader (16 byte)
+ * lalu `count` TraceRecord (16 byte), terlama dulu.
+ *
+ * Yang direkam: metadata + digest, BUKAN payload. Isi form web bisa memuat
+ * password WiFi dan body API ~1.5 KB tidak muat di record 16 byte; sebagai
+ * gantinya request web membawa digest parameter, API membawa panjang body, dan
+ * hasil yang dipakai firmware (jadwal aktif, konfigurasi buzzer/alarm) direkam
+ * sebagai record tersendiri.
+ */
+
+#ifndef JWS_TRACE_FORMAT_H
+#define JWS_TRACE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_FORMAT_VERSION 2
+
+enum TraceType : uint8_t {
+  TRACE_BOOT = 1,   // value = currentTime SAAT setup() SELESAI; durUs = DURASI BOOT
+  TRACE_TICK,       // value = currentTime; flags = TRACE_F_JUMP JIKA BUKAN +1 DETIK
+  TRACE_NTP,        // value = WAKTU UTC DARI SNTP (0 = GAGAL); arg = JUMLAH PERCOBAAN 250 ms
+  TRACE_RTC,        // value = unixtime RTC; arg = 1 VALID / 0 TIDAK VALID
+  TRACE_TOUCH,      // value = (x << 16) | y; flags = TRACE_F_PRESS / 0 (LEPAS)
+  TRACE_HTTP_REQ,   // arg = INDEKS ROUTE_PATHS; flags = METODE HTTP; value = traceDigest PARAMETER; durUs = HANDLER
+  TRACE_HTTP_API,   // arg = KODE HTTP / FETCH_ERR_* (int16); value = PANJANG BODY; flags = TRACE_F_WARM/HEDGE
+  TRACE_WIFI,       // arg = WiFiEvent_t; value = KODE ALASAN (DISCONNECT)
+  TRACE_SCHEDULE,   // arg = INDEKS Prayer; value = MENIT JADWAL AKTIF (-1 = KOSONG); 7 RECORD PER PUBLISH
+  TRACE_CONFIG      // arg = BIT 0-6 BUZZER PER Prayer, BIT 7 ALARM AKTIF; value = MENIT ALARM
+};
+
+#define TRACE_F_JUMP  0x01
+#define TRACE_F_PRESS 0x01
+#define TRACE_F_WARM  0x01              // KONEKSI KEEP-ALIVE DIPAKAI ULANG
+#define TRACE_F_HEDGE 0x02              // API: DIMULAI SEBAGAI PEMBALAP; BIT 4-7 = INDEKS PENYEDIA
+
+#define TRACE_CONFIG_ALARM 0x80
+
+struct TraceRecord {
+  uint32_t ms;       // millis() SAAT INPUT DITERIMA
+  uint8_t type;
+  uint8_t flags;
+  uint16_t arg;
+  int32_t value;
+  uint32_t durUs;    // LATENSI PENANGANAN DI PERANGKAT, 0 JIKA TIDAK DIUKUR
+};
+
+struct TraceHeader {
+  char magic[4];     // "JWST"
+  uint8_t version;
+  uint8_t recordSize;
+  uint16_t count;
+  uint32_t bootId;
+  uint32_t dropped;  // RECORD TERTIMPA SEJAK BOOT / CLEAR
+};
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord HARUS 16 BYTE");
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader HARUS 16 BYTE");
+
+// FNV-1a 32-BIT: DIGEST PARAMETER REQUEST (NAMA=NILAI&...) UNTUK MEMBANDINGKAN
+// REKAMAN, BUKAN UNTUK MEREKONSTRUKSI ISINYA
+#define TRACE_DIGEST_SEED 2166136261u
+
+inline uint32_t traceDigest(uint32_t h, const char *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ (uint8_t)data[i]) * 16777619u;
+  }
+  return h;
+}
+
+#endif
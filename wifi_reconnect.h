@@ -0,0 +1,150 @@
+/*
+ * KONEKSI ULANG WIFI BERTAHAP TANPA HARDWARE
+ * Tangga tahap (langsung ke BSSID/channel tersimpan -> scan terarah SSID -> scan
+ * penuh), cache link terakhir, dan persentil waktu konek ulang. Panggilan WiFi
+ * lewat driver (template): jws.ino memakai WiFi Arduino, test/wifi_reconnect_test.cpp
+ * memakai driver palsu yang diskrip.
+ */
+
+#ifndef JWS_WIFI_RECONNECT_H
+#define JWS_WIFI_RECONNECT_H
+
+#include <stdint.h>
+#include <string.h>
+
+// TAHAP: 0 = LANGSUNG KE BSSID/CHANNEL TERAKHIR
+//        1 = SCAN TERARAH (SSID SAJA, DWELL PENDEK)
+//        2 = SCAN PENUH SEMUA CHANNEL
+#define WIFI_STAGE_DIRECTED 0
+#define WIFI_STAGE_TARGETED 1
+#define WIFI_STAGE_FULL     2
+#define WIFI_STAGE_COUNT    3
+#define WIFI_RECONNECT_SAMPLES  32
+#define WIFI_SCAN_DWELL_TARGETED 120   // ms PER CHANNEL
+#define WIFI_SCAN_DWELL_FULL     300
+
+struct WiFiLinkInfo {
+  char ssid[33];
+  uint8_t bssid[6];
+  int32_t channel;
+  bool valid;
+};
+
+// TELEMETRI: DURASI PUTUS -> GOT_IP (ms)
+struct WiFiReconnectStats {
+  uint32_t samples[WIFI_RECONNECT_SAMPLES];
+  uint8_t count;
+  uint8_t next;
+  uint32_t stageWins[WIFI_STAGE_COUNT];
+};
+
+struct WiFiLadder {
+  uint8_t nextStage;           // TAHAP UNTUK PANGGILAN BERIKUTNYA
+  uint8_t activeStage;         // TAHAP YANG SEDANG DICOBA (DICATAT SAAT GOT_IP)
+};
+
+inline bool wifiLinkUsable(const WiFiLinkInfo &link, const char *ssid) {
+  return link.valid && strcmp(link.ssid, ssid) == 0;
+}
+
+// SALIN fresh KE cache; true = SSID, BSSID, CHANNEL ATAU VALID BERUBAH (PERLU DISIMPAN).
+// GOT_IP ULANG KE AP YANG SAMA TIDAK MENULIS FLASH
+inline bool wifiLinkUpdate(WiFiLinkInfo &cache, const WiFiLinkInfo &fresh) {
+  bool changed = cache.valid != fresh.valid || cache.channel != fresh.channel ||
+                 memcmp(cache.bssid, fresh.bssid, sizeof(cache.bssid)) != 0 ||
+                 strncmp(cache.ssid, fresh.ssid, sizeof(cache.ssid)) != 0;
+  cache = fresh;
+  return changed;
+}
+
+inline void wifiStatsRecord(WiFiReconnectStats &st, uint32_t elapsedMs, uint8_t stage) {
+  st.samples[st.next] = elapsedMs;
+  st.next = (st.next + 1) % WIFI_RECONNECT_SAMPLES;
+  if (st.count < WIFI_RECONNECT_SAMPLES) st.count++;
+  if (stage < WIFI_STAGE_COUNT) st.stageWins[stage]++;
+}
+
+// PERSENTIL NEAREST-RANK. samples DIURUTKAN DI TEMPAT (BERIKAN SALINAN)
+inline void wifiReconnectPercentiles(uint32_t *samples, uint8_t count, uint32_t &p50, uint32_t &p90,
+                                     uint32_t &p99, uint32_t &maxMs) {
+  p50 = p90 = p99 = maxMs = 0;
+  if (count == 0) return;
+
+  for (int i = 1; i < count; i++) {
+    uint32_t v = samples[i];
+    int j = i - 1;
+    while (j >= 0 && samples[j] > v) {
+      samples[j + 1] = samples[j];
+      j--;
+    }
+    samples[j + 1] = v;
+  }
+
+  p50 = samples[(count * 50 + 99) / 100 - 1];
+  p90 = samples[(count * 90 + 99) / 100 - 1];
+  p99 = samples[(count * 99 + 99) / 100 - 1];
+  maxMs = samples[count - 1];
+}
+
+inline void wifiLadderConnected(WiFiLadder &l) {
+  l.nextStage = WIFI_STAGE_DIRECTED;
+}
+
+// TAHAP UNTUK PANGGILAN INI; TANPA CACHE YANG COCOK TAHAP 1 DILEWATI.
+// TAHAP NAIK SETIAP KALI DIPANGGIL ULANG, KEMBALI KE 1 SETELAH GOT_IP
+inline uint8_t wifiLadderNext(WiFiLadder &l, bool cacheUsable) {
+  if (!cacheUsable && l.nextStage == WIFI_STAGE_DIRECTED) l.nextStage = WIFI_STAGE_TARGETED;
+
+  uint8_t stage = l.nextStage;
+  if (l.nextStage < WIFI_STAGE_FULL) l.nextStage++;
+  l.activeStage = stage;
+  return stage;
+}
+
+// DRIVER:
+//   void beginDirect(uint8_t stage, int32_t channel, const uint8_t *bssid)  WiFi.begin KE AP TERTENTU
+//   void beginAny(const char *reason)                  WiFi.begin TANPA BSSID (reason UNTUK LOG)
+//   int  scan(const char *ssidOrNull, uint32_t dwellMs) JUMLAH HASIL, <= 0 = GAGAL / KOSONG
+//   bool scanEntry(int i, const char *ssid, int32_t &rssi, int32_t &channel, uint8_t *bssid)
+//        true = HASIL KE-i BER-SSID ssid
+//   void scanDone()                                    BEBASKAN HASIL SCAN
+// MENGEMBALIKAN TAHAP YANG DICOBA
+template <typename Driver>
+uint8_t wifiConnectStep(WiFiLadder &l, const WiFiLinkInfo &cache, const char *ssid, Driver &d) {
+  uint8_t stage = wifiLadderNext(l, wifiLinkUsable(cache, ssid));
+
+  if (stage == WIFI_STAGE_DIRECTED) {
+    d.beginDirect(stage, cache.channel, cache.bssid);
+    return stage;
+  }
+
+  int found = (stage == WIFI_STAGE_TARGETED) ? d.scan(ssid, WIFI_SCAN_DWELL_TARGETED)
+                                             : d.scan(NULL, WIFI_SCAN_DWELL_FULL);
+  if (found <= 0) {
+    d.beginAny("TIDAK ADA JARINGAN DITEMUKAN");
+    return stage;
+  }
+
+  int32_t bestRssi = -999;
+  int32_t bestChannel = 0;
+  uint8_t bestBssid[6];
+  bool hasBssid = false;
+  for (int i = 0; i < found; i++) {
+    int32_t rssi, channel;
+    uint8_t bssid[6];
+    if (!d.scanEntry(i, ssid, rssi, channel, bssid)) continue;
+    if (rssi > bestRssi) {
+      bestRssi = rssi;
+      bestChannel = channel;
+      memcpy(bestBssid, bssid, 6);
+      hasBssid = true;
+    }
+  }
+  d.scanDone();
+
+  if (hasBssid) d.beginDirect(stage, bestChannel, bestBssid);
+  else d.beginAny("SSID TIDAK DITEMUKAN DI SCAN");
+  return stage;
+}
+
+#endif